@@ -0,0 +1,61 @@
+#ifndef BEAMFORMER_H
+#define BEAMFORMER_H
+
+#include "signal_buffer.h"
+#include "lagrange_matrix.h"
+#include <complex>
+#include <cstddef>
+
+/**
+ * @brief Формирование лучей задержкой и суммированием (delay-and-sum) на CPU
+ *
+ * Для каждого направления d:
+ *   out[d][n] = sum_e w[d][e] * delay(x[e], tau[d][e])[n]
+ * где delay - та же дробная задержка Лагранжа 48×5, что в ExecuteFractionalDelayCPU.
+ * Задержанные сигналы элементов не записываются в память: накопление идёт
+ * в тайле из float массивов (re/im раздельно, векторизуется компилятором),
+ * в память попадает только num_directions × num_samples.
+ * Работа делится по парам (направление, тайл отсчётов) в ThreadPool::Instance().
+ *
+ * @param elements Сигналы элементов решётки [num_elements][num_samples]
+ * @param lagrange_matrix Указатель на матрицу Лагранжа 48×5
+ * @param delays Задержки [num_directions][num_elements] (в отсчётах)
+ * @param weights Комплексные веса [num_directions][num_elements] (nullptr - все 1)
+ * @param num_directions Количество направлений (выходных лучей)
+ * @param output Выходной буфер [num_directions][num_samples], размер подгоняется
+ * @return true если успешно, false при ошибке
+ */
+bool ExecuteDelayAndSumCPU(
+    const SignalBuffer& elements,
+    const LagrangeMatrix* lagrange_matrix,
+    const float* delays,
+    const std::complex<float>* weights,
+    size_t num_directions,
+    SignalBuffer* output
+);
+
+/**
+ * @brief Delay-and-sum над непрерывными массивами (для backend'ов с host памятью)
+ *
+ * @param elements Сигналы элементов [num_elements * num_samples]
+ * @param num_elements Количество элементов решётки
+ * @param num_samples Количество отсчётов
+ * @param lagrange_data Данные матрицы Лагранжа [48 * 5]
+ * @param delays Задержки [num_directions][num_elements] (в отсчётах)
+ * @param weights Комплексные веса [num_directions][num_elements] (nullptr - все 1)
+ * @param num_directions Количество направлений
+ * @param output Выходные лучи [num_directions * num_samples]
+ * @return true если успешно, false при ошибке
+ */
+bool ExecuteDelayAndSumCPU(
+    const std::complex<float>* elements,
+    size_t num_elements,
+    size_t num_samples,
+    const float* lagrange_data,
+    const float* delays,
+    const std::complex<float>* weights,
+    size_t num_directions,
+    std::complex<float>* output
+);
+
+#endif // BEAMFORMER_H
@@ -0,0 +1,60 @@
+#ifndef CPU_FFT_H
+#define CPU_FFT_H
+
+#include <complex>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+/**
+ * @brief План БПФ на CPU для фиксированного размера
+ *
+ * Степень двойки - итеративный radix-2 с предвычисленными поворотными
+ * множителями (в double, затем float). Остальные размеры - алгоритм
+ * Блюстейна через radix-2 БПФ размера >= 2N-1.
+ * Соглашение как у clFFT: прямое преобразование без нормировки,
+ * обратное нормируется на 1/N.
+ * Execute потокобезопасен: план после создания не изменяется.
+ */
+class CpuFFT {
+public:
+    using ComplexType = std::complex<float>;
+
+    /**
+     * @brief Создать план
+     * @param size Размер преобразования (> 0)
+     */
+    explicit CpuFFT(size_t size);
+
+    /**
+     * @brief Выполнить преобразование in-place
+     * @param data Данные [size]
+     * @param forward true - прямое, false - обратное (с нормировкой 1/N)
+     */
+    void Execute(ComplexType* data, bool forward) const;
+
+    /**
+     * @brief Размер преобразования
+     */
+    size_t GetSize() const { return size_; }
+
+    static bool IsPowerOfTwo(size_t n) { return n != 0 && (n & (n - 1)) == 0; }
+
+private:
+    size_t size_;
+    bool power_of_two_;
+
+    // radix-2: twiddles_[j] = exp(-2*pi*i*j/N), j < N/2
+    std::vector<ComplexType> twiddles_;
+    std::vector<size_t> bit_reverse_;
+
+    // Блюстейн: chirp_[k] = exp(-i*pi*k^2/N), chirp_fft_ = FFT(conj(chirp)), размер M
+    std::vector<ComplexType> chirp_;
+    std::vector<ComplexType> chirp_fft_;
+    std::unique_ptr<CpuFFT> inner_;
+
+    void Radix2(ComplexType* data, bool forward) const;
+    void Bluestein(ComplexType* data, bool forward) const;
+};
+
+#endif // CPU_FFT_H
@@ -0,0 +1,175 @@
+#ifndef DECIMATOR_H
+#define DECIMATOR_H
+
+#include "signal_buffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Прореживание лучей с фильтрацией (полифазная структура)
+ *
+ * Фильтр нижних частот и понижение частоты выполняются совместно: считаются
+ * только оставляемые отсчёты y[m] = sum_k h[k] · x[m·M - k], поэтому на входной
+ * отсчёт приходится L/M умножений вместо L. Вход раскладывается на M фаз
+ * (x_r[i] = x[i·M + r]), и каждый отвод фильтра - непрерывный проход по одной
+ * фазе, что векторизуется так же, как прямая форма FirFilter.
+ *
+ * Назначение - после гетеродинирования (LFMSignalGenerator::Heterodyne) полезная
+ * полоса мала, и прореживание на устройстве перед D2H сокращает передачу
+ * и хранение в M раз (ProcessingPipeline::ExecuteDecimation).
+ */
+
+/**
+ * @brief Тип фильтра прореживателя
+ *
+ * LOWPASS - оконный sinc (Хэмминг) с частотой среза 0.5/M входной частоты.
+ * CIC     - отклик каскада из N интеграторов-гребёнок (N скользящих средних
+ *           длины M), нормированный на единичное усиление на нуле частоты.
+ *           Выполняется как КИХ: рекурсивная форма в float накапливает ошибку
+ *           интеграторов, а умножения на устройстве не дороже сложений.
+ * CUSTOM  - коэффициенты пользователя.
+ */
+enum class DecimatorFilter : uint8_t {
+    LOWPASS = 0,
+    CIC = 1,
+    CUSTOM = 2
+};
+
+/**
+ * @brief Коэффициенты ФНЧ прореживателя (оконный sinc, окно Хэмминга)
+ * @param factor Коэффициент прореживания M (>= 1)
+ * @param taps_per_phase Отводов на фазу (длина фильтра = M · taps_per_phase)
+ * @return Коэффициенты с единичным усилением на нуле частоты
+ */
+std::vector<float> DesignDecimatorLowPass(size_t factor, size_t taps_per_phase);
+
+/**
+ * @brief Импульсный отклик CIC фильтра (N каскадов длины M)
+ * @param factor Коэффициент прореживания M (>= 1)
+ * @param num_stages Число каскадов N (>= 1)
+ * @return Коэффициенты [N·(M-1)+1], нормированные на M^N
+ */
+std::vector<float> DesignCicResponse(size_t factor, size_t num_stages);
+
+/**
+ * @brief Параметры одного блока потока
+ */
+struct DecimateBlock {
+    size_t first_position;      // Индекс в ext (история + блок) самого нового отсчёта первого выхода
+    size_t num_output_samples;  // Выходных отсчётов в блоке
+};
+
+/**
+ * @brief Проредить блок одного луча с сохранением состояния
+ *
+ * ext = history[L-1] + input[num_input_samples];
+ * output[j] = sum_k h[k] · ext[first_position + j·M - k].
+ * После вызова history содержит последние L-1 отсчётов ext.
+ *
+ * @param coefficients Коэффициенты h[0..num_taps-1]
+ * @param num_taps Длина фильтра L
+ * @param factor Коэффициент прореживания M
+ * @param history История луча [L-1] (обновляется)
+ * @param input Входной блок [num_input_samples]
+ * @param num_input_samples Отсчётов во входном блоке
+ * @param first_position Позиция первого выхода в ext (>= L-1)
+ * @param output Выходной блок [num_output_samples]
+ * @param num_output_samples Выходных отсчётов
+ */
+void DecimateBeamCPU(
+    const float* coefficients,
+    size_t num_taps,
+    size_t factor,
+    SignalBuffer::ComplexType* history,
+    const SignalBuffer::ComplexType* input,
+    size_t num_input_samples,
+    size_t first_position,
+    SignalBuffer::ComplexType* output,
+    size_t num_output_samples
+);
+
+/**
+ * @brief Потоковый прореживатель лучей
+ *
+ * Хранит положение потока (выдано выходных / принято входных отсчётов),
+ * поэтому блоки любой длины (не кратной M) дают тот же результат, что
+ * прореживание сигнала целиком. Для GPU backend'а история живёт на
+ * устройстве: PlanBlock даёт параметры для IGPUBackend::ExecuteDecimate,
+ * Advance сдвигает поток после его выполнения.
+ */
+class Decimator {
+public:
+    using ComplexType = SignalBuffer::ComplexType;
+
+    Decimator();
+
+    /**
+     * @brief Задать коэффициент и фильтр (сбрасывает поток)
+     * @param factor Коэффициент прореживания M (>= 1)
+     * @param filter LOWPASS или CIC (для CUSTOM - перегрузка с коэффициентами)
+     * @param order Отводов на фазу для LOWPASS, число каскадов для CIC
+     * @return true если успешно
+     */
+    bool Configure(size_t factor, DecimatorFilter filter = DecimatorFilter::LOWPASS, size_t order = 8);
+
+    /**
+     * @brief Задать коэффициент и свои коэффициенты фильтра (сбрасывает поток)
+     */
+    bool Configure(size_t factor, const std::vector<float>& coefficients);
+
+    /**
+     * @brief Проредить очередной блок всех лучей на CPU
+     *
+     * @param input Входной блок (float хранилище)
+     * @param output Выходной буфер (переразмечается под блок)
+     * @return true если успешно
+     */
+    bool Process(const SignalBuffer& input, SignalBuffer* output);
+
+    /**
+     * @brief Параметры следующего блока из num_input_samples отсчётов (состояние не меняется)
+     */
+    DecimateBlock PlanBlock(size_t num_input_samples) const;
+
+    /**
+     * @brief Сдвинуть поток на выполненный блок
+     */
+    void Advance(size_t num_input_samples, size_t num_output_samples);
+
+    /**
+     * @brief Начать новый поток (история обнуляется)
+     */
+    void Reset();
+
+    size_t GetFactor() const { return factor_; }
+
+    DecimatorFilter GetFilter() const { return filter_; }
+
+    const std::vector<float>& GetCoefficients() const { return coefficients_; }
+
+    size_t GetNumTaps() const { return coefficients_.size(); }
+
+    /**
+     * @brief Длина истории луча (L-1)
+     */
+    size_t GetHistorySize() const { return coefficients_.empty() ? 0 : coefficients_.size() - 1; }
+
+    /**
+     * @brief Следующий блок - начало потока (история должна быть нулевой)
+     */
+    bool IsStreamStart() const { return input_position_ == 0; }
+
+private:
+    size_t factor_;
+    DecimatorFilter filter_;
+    std::vector<float> coefficients_;
+
+    uint64_t output_position_;         // Выдано выходных отсчётов
+    uint64_t input_position_;          // Принято входных отсчётов
+
+    size_t num_beams_;
+    std::vector<ComplexType> history_; // [num_beams][L-1] (для Process)
+};
+
+#endif // DECIMATOR_H
@@ -0,0 +1,60 @@
+#ifndef DELAY_FANOUT_H
+#define DELAY_FANOUT_H
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief План fan-out дробной задержки: K наборов задержек за один проход по входу
+ *
+ * Для каждого луча наборы задержек сортируются по целой части задержки и
+ * разбиваются на группы, у которых разброс целых частей не больше max_span.
+ * Тогда окно входа [тайл + разброс + 4 отсчёта] читается один раз и из него
+ * считаются выходы всех наборов группы. План общий для CPU и OpenCL
+ * (структуры совпадают с FanOutEntry/FanOutGroup в kernel_fractional_delay.cl).
+ */
+
+/**
+ * @brief Параметры задержки одного набора для одного луча
+ */
+struct FanOutEntry {
+    int delay_integer;    // Целая часть задержки
+    int lagrange_row;     // Индекс строки матрицы Лагранжа [0, 47]
+    int set_index;        // Номер набора задержек (выходного буфера)
+};
+
+/**
+ * @brief Группа наборов с близкими целыми задержками для одного луча
+ */
+struct FanOutGroup {
+    int beam;                  // Индекс луча
+    int first_entry;           // Первый элемент в FanOutPlan::entries
+    int num_entries;           // Количество наборов в группе
+    int min_delay_integer;     // Минимальная целая задержка в группе
+    int max_delay_integer;     // Максимальная целая задержка в группе
+};
+
+struct FanOutPlan {
+    std::vector<FanOutEntry> entries;   // Сгруппированы по FanOutGroup
+    std::vector<FanOutGroup> groups;
+};
+
+/**
+ * @brief Построить план fan-out
+ *
+ * @param delay_sets Задержки [num_delay_sets][num_beams] (в отсчётах)
+ * @param num_delay_sets Количество наборов задержек K
+ * @param num_beams Количество лучей
+ * @param max_span Максимальный разброс целых задержек в группе (ограничивает ореол окна)
+ * @param plan Выходной план
+ * @return true если успешно
+ */
+bool BuildFanOutPlan(
+    const float* delay_sets,
+    size_t num_delay_sets,
+    size_t num_beams,
+    int max_span,
+    FanOutPlan* plan
+);
+
+#endif // DELAY_FANOUT_H
@@ -0,0 +1,154 @@
+#ifndef FARROW_RESAMPLER_H
+#define FARROW_RESAMPLER_H
+
+#include "signal_buffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Передискретизация в произвольное отношение частот (структура Фарроу)
+ *
+ * Выходной отсчёт m луча b берётся в позиции входа p = m · step - delay[b]
+ * (step = input_rate / output_rate, задержка - в отсчётах входа).
+ * Интерполяция - тот же полином Лагранжа по 5 узлам [-2..2], что в матрице
+ * LagrangeMatrix 48×5 (строка r - полином при μ = r/48), но в форме Фарроу:
+ * 5 подфильтров дают коэффициенты c0..c4, значение - схема Горнера по μ,
+ * поэтому дробная позиция не квантуется до 1/48. Задержка луча учитывается
+ * в том же проходе, отдельная стадия дробной задержки не нужна.
+ *
+ * Позиция считается от номера выходного отсчёта в потоке m (произведение
+ * m · step раскладывается точно), поэтому на CPU результат не зависит от
+ * разбиения потока на блоки: поблочная обработка побитово совпадает с
+ * обработкой одним блоком.
+ *
+ * При понижении частоты полосу нужно предварительно ограничить (FirFilter):
+ * 5-точечный интерполятор не подавляет наложение спектров.
+ */
+
+/**
+ * @brief Параметры одного блока потока
+ */
+struct ResampleBlock {
+    double start_position;         // Позиция первого выходного отсчёта (без задержки) в координатах история + блок
+    size_t num_output_samples;     // Выходных отсчётов в блоке (одинаково для всех лучей)
+    uint64_t first_output_sample;  // Номер первого выходного отсчёта в потоке
+    int64_t ext_origin;            // Номер входного отсчёта потока в ext[0] (в начале потока < 0)
+};
+
+/**
+ * @brief Передискретизировать блок одного луча
+ *
+ * Вход луча расширяется историей: ext = history[history_size] + input[num_input_samples].
+ * output[j] = поток(m·step - delay), m = first_output_sample + j, что в ext
+ * соответствует позиции start_position + j·step - delay; после вызова history
+ * содержит последние history_size отсчётов ext.
+ *
+ * @param history История [history_size] (обновляется)
+ * @param history_size Длина истории (FarrowResampler::GetHistorySize)
+ * @param input Входной блок [num_input_samples]
+ * @param num_input_samples Отсчётов во входном блоке
+ * @param block Параметры блока (FarrowResampler::PlanBlock)
+ * @param step Шаг по входу на выходной отсчёт
+ * @param delay Задержка луча (отсчёты входа)
+ * @param output Выходной блок [block.num_output_samples]
+ */
+void FarrowResampleBeamCPU(
+    SignalBuffer::ComplexType* history,
+    size_t history_size,
+    const SignalBuffer::ComplexType* input,
+    size_t num_input_samples,
+    const ResampleBlock& block,
+    double step,
+    float delay,
+    SignalBuffer::ComplexType* output
+);
+
+/**
+ * @brief Потоковый передискретизатор лучей
+ *
+ * Хранит положение потока (выдано выходных / принято входных отсчётов) и
+ * историю лучей на CPU. Для GPU backend'а история живёт на устройстве:
+ * PlanBlock даёт параметры блока для IGPUBackend::ExecuteResample,
+ * Advance сдвигает поток после его выполнения.
+ */
+class FarrowResampler {
+public:
+    using ComplexType = SignalBuffer::ComplexType;
+
+    FarrowResampler();
+
+    /**
+     * @brief Задать частоты и задержки лучей (сбрасывает поток)
+     * @param input_rate Частота дискретизации входа (Гц)
+     * @param output_rate Частота дискретизации выхода (Гц)
+     * @param delays Задержки лучей в отсчётах входа (пусто - без задержки)
+     * @return true если успешно
+     */
+    bool Configure(double input_rate, double output_rate,
+                   const std::vector<float>& delays = std::vector<float>());
+
+    /**
+     * @brief Передискретизировать очередной блок всех лучей на CPU
+     *
+     * Выходных отсчётов в блоке ≈ num_samples · output_rate / input_rate
+     * (точное число - PlanBlock). Выход переразмечается под блок.
+     *
+     * @param input Входной блок (float хранилище)
+     * @param output Выходной буфер
+     * @return true если успешно
+     */
+    bool Process(const SignalBuffer& input, SignalBuffer* output);
+
+    /**
+     * @brief Параметры следующего блока из num_input_samples отсчётов (состояние не меняется)
+     */
+    ResampleBlock PlanBlock(size_t num_input_samples) const;
+
+    /**
+     * @brief Сдвинуть поток на выполненный блок
+     */
+    void Advance(size_t num_input_samples, size_t num_output_samples);
+
+    /**
+     * @brief Наибольшее число выходных отсчётов блока (для выделения памяти)
+     */
+    size_t GetMaxOutputSamples(size_t num_input_samples) const;
+
+    /**
+     * @brief Начать новый поток (история обнуляется)
+     */
+    void Reset();
+
+    /**
+     * @brief Длина истории луча: ореол интерполятора + разброс задержек
+     */
+    size_t GetHistorySize() const { return history_size_; }
+
+    double GetStep() const { return step_; }
+
+    /**
+     * @brief Следующий блок - начало потока (история должна быть нулевой)
+     */
+    bool IsStreamStart() const { return input_position_ == 0; }
+
+    /**
+     * @brief Задержки лучей для num_beams лучей (пустой список - нули)
+     */
+    std::vector<float> GetBeamDelays(size_t num_beams) const;
+
+private:
+    double step_;                      // input_rate / output_rate
+    std::vector<float> delays_;
+    float min_delay_;
+    float max_delay_;
+    size_t history_size_;
+
+    uint64_t output_position_;         // Выдано выходных отсчётов
+    uint64_t input_position_;          // Принято входных отсчётов
+
+    size_t num_beams_;
+    std::vector<ComplexType> history_; // [num_beams][history_size] (для Process)
+};
+
+#endif // FARROW_RESAMPLER_H
@@ -0,0 +1,184 @@
+#ifndef FIR_FILTER_H
+#define FIR_FILTER_H
+
+#include "signal_buffer.h"
+#include "filter_bank.h"
+#include "cpu_fft.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Способ вычисления свёртки FIR
+ *
+ * DIRECT       - прямая форма: L умножений на отсчёт (выгодна для коротких фильтров).
+ * OVERLAP_SAVE - БПФ по сегментам размера M с перекрытием L-1 отсчётов:
+ *                ~2·M·log2(M) / (M-L+1) операций на отсчёт (для длинных фильтров).
+ * AUTO         - выбор по измеренной точке пересечения (MeasureFirCrossover).
+ */
+enum class FirMethod : uint8_t {
+    AUTO = 0,
+    DIRECT = 1,
+    OVERLAP_SAVE = 2
+};
+
+/**
+ * @brief Размер БПФ overlap-save с минимальной стоимостью обработки блока
+ *
+ * Перебирает степени двойки от 2·L: стоимость = сегменты × M·log2(M).
+ * Не больше степени двойки, покрывающей весь блок с историей.
+ *
+ * @param num_taps Длина фильтра L
+ * @param num_samples Отсчётов в блоке
+ * @return Размер БПФ M (степень двойки, M >= L)
+ */
+size_t SelectOverlapSaveFftSize(size_t num_taps, size_t num_samples);
+
+/**
+ * @brief Найти точку пересечения методов по замерам
+ *
+ * Для L = 4, 8, 16, ... , max_taps сравнивает время обоих методов;
+ * результат - наименьшая L, при которой overlap-save быстрее.
+ *
+ * @param time_method Время обработки (секунды) фильтром из num_taps отсчётов методом method
+ * @param max_taps Наибольшая проверяемая длина
+ * @return Длина фильтра, с которой выбирается OVERLAP_SAVE (SIZE_MAX - всегда DIRECT)
+ */
+size_t MeasureFirCrossover(
+    const std::function<double(size_t num_taps, FirMethod method)>& time_method,
+    size_t max_taps
+);
+
+/**
+ * @brief План FIR на CPU для фиксированных коэффициентов и размера блока
+ *
+ * Для OVERLAP_SAVE хранит план БПФ и спектр коэффициентов (дополненных нулями до M).
+ * После построения не изменяется: один план используется всеми потоками.
+ */
+struct FirPlanCPU {
+    FirMethod method = FirMethod::DIRECT;
+    std::vector<float> coefficients;                      // h[0..L-1]
+    size_t num_samples = 0;                               // Размер блока, для которого построен план
+    size_t fft_size = 0;                                  // M (только OVERLAP_SAVE)
+    std::unique_ptr<CpuFFT> fft;
+    std::vector<SignalBuffer::ComplexType> coefficients_fft;   // FFT(h) [M]
+
+    size_t GetNumTaps() const { return coefficients.size(); }
+    size_t GetHistorySize() const { return coefficients.empty() ? 0 : coefficients.size() - 1; }
+};
+
+/**
+ * @brief Построить план FIR на CPU
+ *
+ * @param coefficients Коэффициенты h[0..num_taps-1]
+ * @param num_taps Длина фильтра (> 0)
+ * @param method DIRECT или OVERLAP_SAVE (AUTO - по FirFilter::GetCpuCrossover)
+ * @param num_samples Отсчётов в блоке
+ * @param plan Выходной план
+ * @return true если успешно
+ */
+bool BuildFirPlanCPU(
+    const float* coefficients,
+    size_t num_taps,
+    FirMethod method,
+    size_t num_samples,
+    FirPlanCPU* plan
+);
+
+/**
+ * @brief Отфильтровать блок одного луча с сохранением состояния
+ *
+ * y[n] = sum_k h[k] · x[n-k], где x[-1..-(L-1)] берутся из history.
+ * После вызова history содержит последние L-1 входных отсчётов (вход
+ * копируется во внутренний буфер, поэтому output может совпадать с input).
+ *
+ * @param plan План (num_samples блока должен совпадать с планом)
+ * @param history История луча [L-1] (старые отсчёты первыми)
+ * @param input Входной блок [num_samples]
+ * @param output Выходной блок [num_samples]
+ */
+void FirFilterBeamCPU(
+    const FirPlanCPU& plan,
+    SignalBuffer::ComplexType* history,
+    const SignalBuffer::ComplexType* input,
+    SignalBuffer::ComplexType* output
+);
+
+/**
+ * @brief Потоковый FIR фильтр лучей с коэффициентами FilterBank
+ *
+ * Лучи обрабатываются блоками: каждый вызов Process продолжает сигнал с места
+ * предыдущего (история L-1 отсчётов на луч), поэтому фильтрация блоками
+ * совпадает с фильтрацией всего сигнала целиком. Метод выбирается один раз
+ * на размер блока; лучи распределяются по ThreadPool::Instance() с учётом NUMA.
+ */
+class FirFilter {
+public:
+    using ComplexType = SignalBuffer::ComplexType;
+
+    FirFilter();
+
+    /**
+     * @brief Задать коэффициенты и метод (сбрасывает состояние)
+     * @param coefficients Коэффициенты h[0..L-1] (не пусто)
+     * @param method Метод свёртки (AUTO - по измеренной точке пересечения)
+     * @return true если успешно
+     */
+    bool Configure(const std::vector<float>& coefficients, FirMethod method = FirMethod::AUTO);
+
+    /**
+     * @brief Задать коэффициенты из банка фильтров
+     */
+    bool Configure(const FilterBank& filter_bank, FirMethod method = FirMethod::AUTO);
+
+    /**
+     * @brief Отфильтровать очередной блок всех лучей (in-place)
+     *
+     * При смене числа лучей состояние сбрасывается; размер блока может меняться
+     * между вызовами (план перестраивается, история сохраняется).
+     *
+     * @param buffer Буфер лучей (float хранилище)
+     * @return true если успешно
+     */
+    bool Process(SignalBuffer* buffer);
+
+    /**
+     * @brief Обнулить историю (начать новый сигнал)
+     */
+    void Reset();
+
+    /**
+     * @brief Метод, выбранный для последнего блока
+     */
+    FirMethod GetActiveMethod() const { return plan_.method; }
+
+    size_t GetNumTaps() const { return coefficients_.size(); }
+
+    /**
+     * @brief История лучей [num_beams][L-1] (для переноса состояния на устройство)
+     */
+    const std::vector<ComplexType>& GetHistory() const { return history_; }
+
+    /**
+     * @brief Точка пересечения методов на CPU для размера блока
+     *
+     * Замер выполняется один раз на класс размера блока (степень двойки,
+     * не больше 16384 отсчётов: дальше стоимость на отсчёт не меняется)
+     * и кэшируется на время процесса.
+     *
+     * @param num_samples Отсчётов в блоке
+     * @return Длина фильтра, с которой выбирается OVERLAP_SAVE
+     */
+    static size_t GetCpuCrossover(size_t num_samples);
+
+private:
+    std::vector<float> coefficients_;
+    FirMethod requested_method_;
+    FirPlanCPU plan_;
+    size_t num_beams_;
+    std::vector<ComplexType> history_;   // [num_beams][L-1]
+};
+
+#endif // FIR_FILTER_H
@@ -3,7 +3,26 @@
 
 #include "signal_buffer.h"
 #include "lagrange_matrix.h"
+#include "result_comparator.h"
 #include <cstddef>
+#include <vector>
+
+/**
+ * @brief Параметры задержки луча: целая часть и строка матрицы Лагранжа
+ * 
+ * Раскладка совпадает с DelayParams в kernel_fractional_delay.cl:
+ * массив передаётся на устройство без преобразования.
+ */
+struct FractionalDelayParams {
+    int delay_integer;
+    int lagrange_row;
+};
+
+/**
+ * @brief Целая часть задержки и строка матрицы Лагранжа 48×5 (общие для CPU и GPU)
+ * @param delay Задержка в отсчётах
+ */
+FractionalDelayParams ComputeDelayParams(float delay);
 
 /**
  * @brief Выполнить дробную задержку сигнала с интерполяцией Лагранжа на CPU
@@ -26,5 +45,176 @@ bool ExecuteFractionalDelayCPU(
     size_t num_samples
 );
 
+/**
+ * @brief Дробная задержка одного луча (непрерывные массивы)
+ * 
+ * Тот же алгоритм и порядок суммирования, что в ExecuteFractionalDelayCPU:
+ * внутренние отсчёты считаются без проверок границ, отражение только у краёв.
+ * 
+ * @param input Входной луч [num_samples]
+ * @param output Выходной луч [num_samples] (не совпадает с input)
+ * @param num_samples Количество отсчётов
+ * @param delay Задержка в отсчётах
+ * @param lagrange_data Данные матрицы Лагранжа [48 * 5]
+ */
+void FractionalDelayBeamCPU(
+    const SignalBuffer::ComplexType* input,
+    SignalBuffer::ComplexType* output,
+    size_t num_samples,
+    float delay,
+    const float* lagrange_data
+);
+
+/**
+ * @brief Один выходной отсчёт дробной задержки луча
+ * 
+ * Интерполятор локален (5 соседних входных отсчётов), поэтому эталон в
+ * отдельной точке не требует обработки луча; результат побитово совпадает
+ * с отсчётом sample у ExecuteFractionalDelayCPU / FractionalDelayBeamCPU.
+ * 
+ * @param input Входной луч [num_samples]
+ * @param num_samples Количество отсчётов
+ * @param delay Задержка в отсчётах
+ * @param lagrange_data Данные матрицы Лагранжа [48 * 5]
+ * @param sample Номер выходного отсчёта (< num_samples)
+ * @return Выходной отсчёт
+ */
+SignalBuffer::ComplexType FractionalDelaySampleCPU(
+    const SignalBuffer::ComplexType* input,
+    size_t num_samples,
+    float delay,
+    const float* lagrange_data,
+    size_t sample
+);
+
+/**
+ * @brief Дробная задержка над упакованным хранилищем (int16 IQ / fp16)
+ * 
+ * Отсчёты расширяются до float при чтении, интерполяция идёт во float,
+ * результат упаковывается обратно в тот же формат и масштаб (int16 - с насыщением).
+ * Float хранилище буфера не используется и может быть освобождено.
+ * 
+ * @param input_output Буфер с упакованными данными (in-place обработка)
+ * @param lagrange_matrix Указатель на матрицу Лагранжа 48×5
+ * @param delay_coefficients Массив коэффициентов задержки для каждого луча
+ * @param num_beams Количество лучей
+ * @param num_samples Количество отсчётов на луч
+ * @return true если успешно, false при ошибке
+ */
+bool ExecuteFractionalDelayCPUPacked(
+    SignalBuffer* input_output,
+    const LagrangeMatrix* lagrange_matrix,
+    const float* delay_coefficients,
+    size_t num_beams,
+    size_t num_samples
+);
+
+/**
+ * @brief Дробная задержка одного упакованного луча (int16 IQ / fp16)
+ * 
+ * Тот же расчёт, что в ExecuteFractionalDelayCPUPacked; int16 результат
+ * насыщается до ±32767 (как SignalBuffer::Pack и kernel fractional_delay_int16).
+ * 
+ * @param input Входной луч [num_samples * 2] (I, Q)
+ * @param output Выходной луч [num_samples * 2] (не совпадает с input)
+ * @param num_samples Количество отсчётов
+ * @param format INT16_IQ или FP16
+ * @param delay Задержка в отсчётах
+ * @param lagrange_data Данные матрицы Лагранжа [48 * 5]
+ */
+void FractionalDelayPackedBeamCPU(
+    const uint16_t* input,
+    uint16_t* output,
+    size_t num_samples,
+    SampleFormat format,
+    float delay,
+    const float* lagrange_data
+);
+
+/**
+ * @brief Fan-out дробной задержки: K наборов задержек за один проход по входу
+ * 
+ * Вход читается блоками (тайл отсчётов + ореол по разбросу целых задержек),
+ * каждый блок остаётся в кэше, пока из него считаются выходы всех наборов
+ * с близкими задержками (см. BuildFanOutPlan). Результат совпадает с K вызовами
+ * ExecuteFractionalDelayCPU на копиях входа.
+ * 
+ * @param input Входной буфер сигналов (не изменяется)
+ * @param lagrange_matrix Указатель на матрицу Лагранжа 48×5
+ * @param delay_sets Задержки [num_delay_sets][num_beams] (в отсчётах)
+ * @param num_delay_sets Количество наборов задержек K (например, сетка углов)
+ * @param outputs Выходные буферы [num_delay_sets], размер подгоняется под вход
+ * @return true если успешно, false при ошибке
+ */
+bool ExecuteFractionalDelayFanOutCPU(
+    const SignalBuffer& input,
+    const LagrangeMatrix* lagrange_matrix,
+    const float* delay_sets,
+    size_t num_delay_sets,
+    std::vector<SignalBuffer>* outputs
+);
+
+/**
+ * @brief Отчёт о погрешности упакованного формата относительно float пути
+ */
+struct PackedPrecisionReport {
+    SampleFormat format;           // Проверенный формат
+    float scale;                   // Масштаб int16 (1.0 для fp16)
+    ComparisonMetrics metrics;     // Разница с float результатом
+    double snr_db;                 // Отношение мощности сигнала к мощности ошибки, дБ
+    size_t bytes_per_sample;       // Байт на отсчёт в упакованном формате
+
+    PackedPrecisionReport()
+        : format(SampleFormat::FLOAT32), scale(1.0f), snr_db(0.0), bytes_per_sample(0) {}
+};
+
+/**
+ * @brief Оценить погрешность дробной задержки в упакованном формате
+ * 
+ * Упаковывает копию входа, выполняет ExecuteFractionalDelayCPUPacked,
+ * распаковывает и сравнивает с float результатом.
+ * 
+ * @param input Исходный float сигнал
+ * @param float_reference Результат ExecuteFractionalDelayCPU для того же входа
+ * @param lagrange_matrix Указатель на матрицу Лагранжа 48×5
+ * @param delay_coefficients Массив коэффициентов задержки для каждого луча
+ * @param format INT16_IQ или FP16
+ * @param tolerance Допустимая погрешность для подсчёта превышений
+ * @param report Выходной отчёт
+ * @param packed_result Распакованный результат упакованного пути (nullptr - не нужен)
+ * @return true если успешно, false при ошибке
+ */
+bool EvaluatePackedDelayError(
+    const SignalBuffer& input,
+    const SignalBuffer& float_reference,
+    const LagrangeMatrix* lagrange_matrix,
+    const float* delay_coefficients,
+    SampleFormat format,
+    float tolerance,
+    PackedPrecisionReport* report,
+    SignalBuffer* packed_result = nullptr
+);
+
+/**
+ * @brief Погрешность уже распакованного результата упакованного пути
+ *        (например, с устройства) относительно float пути
+ * 
+ * @param float_reference Результат ExecuteFractionalDelayCPU
+ * @param packed_result Распакованный результат упакованного пути
+ * @param format Формат, в котором шёл расчёт
+ * @param scale Масштаб int16 (1.0 для fp16)
+ * @param tolerance Допустимая погрешность для подсчёта превышений
+ * @param report Выходной отчёт
+ * @return true если успешно, false при ошибке
+ */
+bool EvaluatePackedResultError(
+    const SignalBuffer& float_reference,
+    const SignalBuffer& packed_result,
+    SampleFormat format,
+    float scale,
+    float tolerance,
+    PackedPrecisionReport* report
+);
+
 #endif // FRACTIONAL_DELAY_CPU_H
 
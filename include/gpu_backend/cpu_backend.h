@@ -0,0 +1,153 @@
+#ifndef CPU_BACKEND_H
+#define CPU_BACKEND_H
+
+#include "igpu_backend.h"
+#include "cpu_fft.h"
+#include "fir_filter.h"
+#include <string>
+#include <vector>
+#include <memory>
+
+/**
+ * @brief Реализация backend на CPU (многопоточная)
+ *
+ * "Память устройства" - выровненная память хоста, копирования - memcpy.
+ * Дробная задержка, FIR, передискретизация, прореживание, FFT и поэлементное умножение
+ * выполняются в общем пуле потоков (ThreadPool::Instance(), число потоков задаётся там же);
+ * внутренние циклы написаны для автовекторизации компилятором.
+ * Используется на узлах без OpenCL устройства и по запросу (GPUFactory).
+ */
+class CpuBackend : public IGPUBackend {
+public:
+    /**
+     * @brief Конструктор
+     */
+    CpuBackend();
+
+    /**
+     * @brief Деструктор
+     */
+    ~CpuBackend();
+
+    // IGPUBackend interface
+    bool Initialize() override;
+    void Cleanup() override;
+    void* AllocateDeviceMemory(size_t size_bytes) override;
+    void FreeDeviceMemory(void* ptr) override;
+    bool CopyHostToDevice(void* dst, const void* src, size_t size_bytes) override;
+    bool CopyDeviceToHost(void* dst, const void* src, size_t size_bytes) override;
+    bool CopyDeviceToHostRegion(void* dst, const void* src, size_t offset_bytes, size_t size_bytes) override;
+    bool ExecuteFractionalDelay(
+        void* device_buffer,
+        const float* delay_coefficients,
+        size_t num_beams,
+        size_t num_samples
+    ) override;
+    bool ExecuteFractionalDelayPacked(
+        const void* device_input,
+        void* device_output,
+        SampleFormat format,
+        const float* delay_coefficients,
+        size_t num_beams,
+        size_t num_samples
+    ) override;
+    bool ExecuteDelayAndSum(
+        const void* device_input,
+        void* device_output,
+        const float* delays,
+        const ComplexType* weights,
+        size_t num_elements,
+        size_t num_directions,
+        size_t num_samples
+    ) override;
+    bool ExecuteFIR(
+        const void* device_input,
+        void* device_output,
+        void* device_history,
+        const float* coefficients,
+        size_t num_taps,
+        FirMethod method,
+        size_t num_beams,
+        size_t num_samples
+    ) override;
+    bool ExecuteResample(
+        const void* device_input,
+        void* device_output,
+        void* device_history,
+        const float* delays,
+        size_t history_size,
+        const ResampleBlock& block,
+        double step,
+        size_t num_beams,
+        size_t num_input_samples
+    ) override;
+    bool ExecuteDecimate(
+        const void* device_input,
+        void* device_output,
+        void* device_history,
+        const float* coefficients,
+        size_t num_taps,
+        size_t factor,
+        size_t first_position,
+        size_t num_beams,
+        size_t num_input_samples,
+        size_t num_output_samples
+    ) override;
+    bool ExecuteAddNoise(
+        void* device_buffer,
+        uint64_t seed,
+        float sigma,
+        size_t num_beams,
+        size_t num_samples
+    ) override;
+    bool ExecuteFFT(
+        void* device_buffer,
+        size_t num_beams,
+        size_t num_samples,
+        bool forward
+    ) override;
+    bool ExecuteHadamardMultiply(
+        void* device_buffer,
+        const void* reference_fft,
+        size_t num_beams,
+        size_t num_samples
+    ) override;
+    bool ExecuteHeterodyne(
+        void* device_buffer,
+        const void* device_reference,
+        size_t num_reference_beams,
+        size_t num_beams,
+        size_t num_samples
+    ) override;
+    bool ExecuteTileDigests(
+        const void* device_buffer,
+        float quantum,
+        size_t tile_samples,
+        size_t num_beams,
+        size_t num_samples,
+        uint64_t* digests
+    ) override;
+    std::string GetBackendName() const override;
+    std::string GetDeviceName() const override;
+    size_t GetDeviceMemorySize() const override;
+    bool UploadLagrangeMatrix(const float* lagrange_data) override;
+
+private:
+    bool initialized_;
+
+    std::string device_name_;
+    size_t memory_size_;
+
+    // Матрица Лагранжа [48 * 5]
+    std::vector<float> lagrange_matrix_;
+    bool lagrange_matrix_uploaded_;
+
+    // План FFT (пересоздаётся при смене размера)
+    std::unique_ptr<CpuFFT> fft_plan_;
+
+    // План FIR (пересоздаётся при смене коэффициентов, метода или размера блока)
+    FirPlanCPU fir_plan_;
+    FirMethod fir_requested_method_;
+};
+
+#endif // CPU_BACKEND_H
@@ -3,6 +3,16 @@
 
 #include "igpu_backend.h"
 #include <memory>
+#include <vector>
+
+/**
+ * @brief Тип backend для GPUFactory::CreateBackend
+ */
+enum class BackendType {
+    AUTO,      // OpenCL при наличии устройства, иначе CPU
+    OPENCL,    // Только OpenCL
+    CPU        // Многопоточный CPU backend
+};
 
 /**
  * @brief Фабрика для создания GPU backend
@@ -12,16 +22,20 @@
 class GPUFactory {
 public:
     /**
-     * @brief Создать GPU backend
+     * @brief Создать backend
      * 
-     * Приоритет:
+     * Приоритет для AUTO:
      * 1. OpenCL (NVIDIA RTX3060)
      * 2. OpenCL (AMD GPU)
      * 3. Другие OpenCL устройства
+     * 4. CPU backend (нет OpenCL устройства или ошибка инициализации)
      * 
+     * Переменная окружения LCH_FARROW_BACKEND ("cpu" / "opencl") переопределяет AUTO.
+     * 
+     * @param type Тип backend
      * @return Умный указатель на backend или nullptr при ошибке
      */
-    static std::unique_ptr<IGPUBackend> CreateBackend();
+    static std::unique_ptr<IGPUBackend> CreateBackend(BackendType type = BackendType::AUTO);
     
     /**
      * @brief Создать OpenCL backend
@@ -29,6 +43,23 @@ public:
      */
     static std::unique_ptr<IGPUBackend> CreateOpenCLBackend();
     
+    /**
+     * @brief Создать OpenCL backend'ы для всех устройств (по одному на устройство)
+     * 
+     * Для MultiDeviceExecutor. Устройства, не прошедшие инициализацию, пропускаются.
+     * Несколько CPU устройств для проверки без GPU даёт PoCL: POCL_DEVICES="cpu cpu".
+     * 
+     * @param include_cpu_devices Включать OpenCL устройства типа CPU
+     * @return Инициализированные backend'ы (пусто, если устройств нет)
+     */
+    static std::vector<std::unique_ptr<IGPUBackend>> CreateOpenCLBackends(bool include_cpu_devices = false);
+    
+    /**
+     * @brief Создать CPU backend (потоки - общий ThreadPool::Instance())
+     * @return Умный указатель на CPU backend или nullptr при ошибке
+     */
+    static std::unique_ptr<IGPUBackend> CreateCpuBackend();
+    
     /**
      * @brief Проверить доступность OpenCL
      * @return true если OpenCL доступен
@@ -40,4 +71,3 @@ private:
 };
 
 #endif // GPU_FACTORY_H
-
@@ -4,6 +4,10 @@
 #include <string>
 #include <cstddef>
 #include <complex>
+#include <cstdint>
+#include "signal_buffer.h"
+#include "fir_filter.h"
+#include "farrow_resampler.h"
 
 /**
  * @brief Абстрактный интерфейс для GPU backend
@@ -59,6 +63,80 @@ public:
      */
     virtual bool CopyDeviceToHost(void* dst, const void* src, size_t size_bytes) = 0;
     
+    /**
+     * @brief Копировать часть буфера устройства на хост
+     * @param dst Указатель на память хоста
+     * @param src Указатель на память устройства
+     * @param offset_bytes Смещение в буфере устройства (байты)
+     * @param size_bytes Размер в байтах
+     * @return true если успешно (false - не поддерживается backend'ом)
+     */
+    virtual bool CopyDeviceToHostRegion(void* dst, const void* src, size_t offset_bytes, size_t size_bytes) {
+        (void)dst;
+        (void)src;
+        (void)offset_bytes;
+        (void)size_bytes;
+        return false;
+    }
+    
+    /**
+     * @brief Количество независимых потоков команд для асинхронных методов
+     *
+     * Команды одного потока выполняются по порядку, разных потоков - могут
+     * перекрываться (копирование одного потока с вычислением другого).
+     * 1 - асинхронные методы выполняются синхронно.
+     */
+    virtual size_t GetNumStreams() const {
+        return 1;
+    }
+    
+    /**
+     * @brief Асинхронное копирование H2D в потоке stream
+     *
+     * Память хоста src должна оставаться неизменной до Synchronize(stream).
+     *
+     * @param dst Указатель на память устройства
+     * @param src Указатель на память хоста
+     * @param size_bytes Размер в байтах
+     * @param stream Номер потока [0, GetNumStreams())
+     * @return true если успешно поставлено в очередь
+     */
+    virtual bool CopyHostToDeviceAsync(void* dst, const void* src, size_t size_bytes, size_t stream) {
+        (void)stream;
+        return CopyHostToDevice(dst, src, size_bytes);
+    }
+    
+    /**
+     * @brief Асинхронное копирование D2H в потоке stream (данные готовы после Synchronize)
+     */
+    virtual bool CopyDeviceToHostAsync(void* dst, const void* src, size_t size_bytes, size_t stream) {
+        (void)stream;
+        return CopyDeviceToHost(dst, src, size_bytes);
+    }
+    
+    /**
+     * @brief Дробная задержка в потоке stream (см. ExecuteFractionalDelay)
+     */
+    virtual bool ExecuteFractionalDelayAsync(
+        void* device_buffer,
+        const float* delay_coefficients,
+        size_t num_beams,
+        size_t num_samples,
+        size_t stream
+    ) {
+        (void)stream;
+        return ExecuteFractionalDelay(device_buffer, delay_coefficients, num_beams, num_samples);
+    }
+    
+    /**
+     * @brief Дождаться завершения всех команд потока stream
+     * @return true если все команды выполнены успешно
+     */
+    virtual bool Synchronize(size_t stream) {
+        (void)stream;
+        return true;
+    }
+    
     /**
      * @brief Выполнить дробную задержку сигнала
      * @param device_buffer Указатель на буфер на устройстве
@@ -74,6 +152,255 @@ public:
         size_t num_samples
     ) = 0;
     
+    /**
+     * @brief Выполнить дробную задержку над упакованными отсчётами (int16 IQ / fp16)
+     * 
+     * Отсчёты расширяются до float на устройстве, результат записывается
+     * в том же формате (для int16 - тот же масштаб, с насыщением).
+     * Размер буферов: num_beams * num_samples * SignalBuffer::BytesPerSample(format).
+     * 
+     * @param device_input Входной буфер на устройстве
+     * @param device_output Выходной буфер на устройстве (не совпадает с входным)
+     * @param format INT16_IQ или FP16
+     * @param delay_coefficients Коэффициенты задержки для каждого луча
+     * @param num_beams Количество лучей
+     * @param num_samples Количество отсчётов на луч
+     * @return true если успешно (false - формат не поддерживается backend'ом)
+     */
+    virtual bool ExecuteFractionalDelayPacked(
+        const void* device_input,
+        void* device_output,
+        SampleFormat format,
+        const float* delay_coefficients,
+        size_t num_beams,
+        size_t num_samples
+    ) {
+        (void)device_input;
+        (void)device_output;
+        (void)format;
+        (void)delay_coefficients;
+        (void)num_beams;
+        (void)num_samples;
+        return false;
+    }
+    
+    /**
+     * @brief Fan-out дробной задержки: K наборов задержек за один проход по входу
+     * 
+     * @param device_input Входной буфер [num_beams * num_samples] на устройстве
+     * @param device_output Выходной буфер [num_delay_sets * num_beams * num_samples]
+     * @param delay_sets Задержки [num_delay_sets][num_beams] (в отсчётах)
+     * @param num_delay_sets Количество наборов задержек K
+     * @param num_beams Количество лучей
+     * @param num_samples Количество отсчётов на луч
+     * @return true если успешно (false - не поддерживается backend'ом)
+     */
+    virtual bool ExecuteFractionalDelayFanOut(
+        const void* device_input,
+        void* device_output,
+        const float* delay_sets,
+        size_t num_delay_sets,
+        size_t num_beams,
+        size_t num_samples
+    ) {
+        (void)device_input;
+        (void)device_output;
+        (void)delay_sets;
+        (void)num_delay_sets;
+        (void)num_beams;
+        (void)num_samples;
+        return false;
+    }
+    
+    /**
+     * @brief Формирование лучей задержкой и суммированием (delay-and-sum)
+     * 
+     * out[d][n] = sum_e w[d][e] * delay(x[e], tau[d][e])[n]; в память устройства
+     * записывается только num_directions × num_samples.
+     * 
+     * @param device_input Сигналы элементов [num_elements * num_samples] на устройстве
+     * @param device_output Выходные лучи [num_directions * num_samples] на устройстве
+     * @param delays Задержки [num_directions][num_elements] (в отсчётах)
+     * @param weights Комплексные веса [num_directions][num_elements] (nullptr - все 1)
+     * @param num_elements Количество элементов решётки
+     * @param num_directions Количество направлений
+     * @param num_samples Количество отсчётов
+     * @return true если успешно (false - не поддерживается backend'ом)
+     */
+    virtual bool ExecuteDelayAndSum(
+        const void* device_input,
+        void* device_output,
+        const float* delays,
+        const ComplexType* weights,
+        size_t num_elements,
+        size_t num_directions,
+        size_t num_samples
+    ) {
+        (void)device_input;
+        (void)device_output;
+        (void)delays;
+        (void)weights;
+        (void)num_elements;
+        (void)num_directions;
+        (void)num_samples;
+        return false;
+    }
+    
+    /**
+     * @brief Потоковый FIR фильтр блока лучей (коэффициенты вещественные)
+     *
+     * y[n] = sum_k h[k] * x[n-k], где отсчёты до начала блока берутся из истории.
+     * После вызова device_history содержит последние num_taps-1 входных отсчётов
+     * каждого луча, поэтому последовательные блоки дают тот же результат, что
+     * фильтрация сигнала целиком. Перед первым блоком историю нужно обнулить.
+     *
+     * @param device_input Входной блок [num_beams * num_samples] на устройстве
+     * @param device_output Выходной блок [num_beams * num_samples] (не совпадает с входным)
+     * @param device_history История [num_beams * (num_taps - 1)] на устройстве (обновляется)
+     * @param coefficients Коэффициенты h[0..num_taps-1] (на хосте)
+     * @param num_taps Длина фильтра
+     * @param method DIRECT, OVERLAP_SAVE или AUTO (по точке пересечения, измеренной backend'ом)
+     * @param num_beams Количество лучей
+     * @param num_samples Отсчётов в блоке
+     * @return true если успешно (false - не поддерживается backend'ом)
+     */
+    virtual bool ExecuteFIR(
+        const void* device_input,
+        void* device_output,
+        void* device_history,
+        const float* coefficients,
+        size_t num_taps,
+        FirMethod method,
+        size_t num_beams,
+        size_t num_samples
+    ) {
+        (void)device_input;
+        (void)device_output;
+        (void)device_history;
+        (void)coefficients;
+        (void)num_taps;
+        (void)method;
+        (void)num_beams;
+        (void)num_samples;
+        return false;
+    }
+    
+    /**
+     * @brief Передискретизация блока лучей (интерполятор Фарроу, см. FarrowResampler)
+     *
+     * output[b][j] = ext_b(start_position + j * step - delays[b]), где
+     * ext_b = история луча + входной блок; после вызова device_history содержит
+     * последние history_size отсчётов ext_b. Параметры блока - FarrowResampler::PlanBlock.
+     * CPU backend считает позицию от счётчика потока (block.first_output_sample)
+     * и совпадает с FarrowResampler::Process побитово; OpenCL - в float,
+     * относительно block.start_position (см. kernel farrow_resample).
+     *
+     * @param device_input Входной блок [num_beams * num_input_samples] на устройстве
+     * @param device_output Выходной блок [num_beams * num_output_samples] на устройстве
+     * @param device_history История [num_beams * history_size] на устройстве (обновляется)
+     * @param delays Задержки лучей [num_beams] (отсчёты входа, на хосте)
+     * @param history_size Длина истории луча
+     * @param block Параметры блока (позиция, число выходных отсчётов)
+     * @param step Шаг по входу на выходной отсчёт (input_rate / output_rate)
+     * @param num_beams Количество лучей
+     * @param num_input_samples Отсчётов во входном блоке
+     * @return true если успешно (false - не поддерживается backend'ом)
+     */
+    virtual bool ExecuteResample(
+        const void* device_input,
+        void* device_output,
+        void* device_history,
+        const float* delays,
+        size_t history_size,
+        const ResampleBlock& block,
+        double step,
+        size_t num_beams,
+        size_t num_input_samples
+    ) {
+        (void)device_input;
+        (void)device_output;
+        (void)device_history;
+        (void)delays;
+        (void)history_size;
+        (void)block;
+        (void)step;
+        (void)num_beams;
+        (void)num_input_samples;
+        return false;
+    }
+    
+    /**
+     * @brief Прореживание блока лучей с фильтрацией (полифазная структура, см. Decimator)
+     *
+     * output[b][j] = sum_k h[k] * ext_b[first_position + j * factor - k], где
+     * ext_b = история луча [num_taps-1] + входной блок; после вызова device_history
+     * содержит последние num_taps-1 отсчётов ext_b. Параметры блока - Decimator::PlanBlock.
+     *
+     * @param device_input Входной блок [num_beams * num_input_samples] на устройстве
+     * @param device_output Выходной блок [num_beams * num_output_samples] на устройстве
+     * @param device_history История [num_beams * (num_taps - 1)] на устройстве (обновляется)
+     * @param coefficients Коэффициенты h[0..num_taps-1] (на хосте)
+     * @param num_taps Длина фильтра
+     * @param factor Коэффициент прореживания
+     * @param first_position Позиция первого выхода в ext_b (>= num_taps-1)
+     * @param num_beams Количество лучей
+     * @param num_input_samples Отсчётов во входном блоке
+     * @param num_output_samples Отсчётов в выходном блоке
+     * @return true если успешно (false - не поддерживается backend'ом)
+     */
+    virtual bool ExecuteDecimate(
+        const void* device_input,
+        void* device_output,
+        void* device_history,
+        const float* coefficients,
+        size_t num_taps,
+        size_t factor,
+        size_t first_position,
+        size_t num_beams,
+        size_t num_input_samples,
+        size_t num_output_samples
+    ) {
+        (void)device_input;
+        (void)device_output;
+        (void)device_history;
+        (void)coefficients;
+        (void)num_taps;
+        (void)factor;
+        (void)first_position;
+        (void)num_beams;
+        (void)num_input_samples;
+        (void)num_output_samples;
+        return false;
+    }
+    
+    /**
+     * @brief Прибавить комплексный гауссов шум к лучам (in-place)
+     *
+     * Шум счётчикового генератора (см. noise_generator.h): отсчёт n луча b
+     * зависит только от (seed, b, n), поэтому кадр воспроизводим при заданном seed.
+     *
+     * @param device_buffer Лучи [num_beams * num_samples] на устройстве
+     * @param seed Seed генератора
+     * @param sigma СКО компоненты (re, im)
+     * @param num_beams Количество лучей
+     * @param num_samples Количество отсчётов на луч
+     * @return true если успешно (false - не поддерживается backend'ом)
+     */
+    virtual bool ExecuteAddNoise(
+        void* device_buffer,
+        uint64_t seed,
+        float sigma,
+        size_t num_beams,
+        size_t num_samples
+    ) {
+        (void)device_buffer;
+        (void)seed;
+        (void)sigma;
+        (void)num_beams;
+        (void)num_samples;
+        return false;
+    }
+    
     /**
      * @brief Выполнить FFT или IFFT
      * @param device_buffer Указатель на буфер на устройстве (in-place)
@@ -104,6 +431,65 @@ public:
         size_t num_samples
     ) = 0;
     
+    /**
+     * @brief Гетеродинирование лучей на месте: beams[b][n] *= conj(ref_b[n])
+     *
+     * При num_reference_beams == 1 опорная строка общая для всех лучей
+     * (без копирования опоры по лучам), иначе у каждого луча своя.
+     *
+     * @param device_buffer Лучи [num_beams * num_samples] на устройстве (in-place)
+     * @param device_reference Опора [num_reference_beams * num_samples] на устройстве
+     * @param num_reference_beams 1 или num_beams
+     * @param num_beams Количество лучей
+     * @param num_samples Количество отсчётов на луч
+     * @return true если успешно (false - не поддерживается backend'ом)
+     */
+    virtual bool ExecuteHeterodyne(
+        void* device_buffer,
+        const void* device_reference,
+        size_t num_reference_beams,
+        size_t num_beams,
+        size_t num_samples
+    ) {
+        (void)device_buffer;
+        (void)device_reference;
+        (void)num_reference_beams;
+        (void)num_beams;
+        (void)num_samples;
+        return false;
+    }
+    
+    /**
+     * @brief Дайджесты тайлов буфера (см. tile_digest.h)
+     *
+     * Результат побитово совпадает с ComputeTileDigestsCPU для тех же данных,
+     * quantum и tile_samples; на хост читаются только дайджесты.
+     *
+     * @param device_buffer Лучи [num_beams * num_samples] на устройстве
+     * @param quantum Шаг квантования (> 0)
+     * @param tile_samples Отсчётов в тайле
+     * @param num_beams Количество лучей
+     * @param num_samples Количество отсчётов на луч
+     * @param digests Выход на хосте [num_beams * DigestTilesPerBeam(num_samples, tile_samples)]
+     * @return true если успешно (false - не поддерживается backend'ом)
+     */
+    virtual bool ExecuteTileDigests(
+        const void* device_buffer,
+        float quantum,
+        size_t tile_samples,
+        size_t num_beams,
+        size_t num_samples,
+        uint64_t* digests
+    ) {
+        (void)device_buffer;
+        (void)quantum;
+        (void)tile_samples;
+        (void)num_beams;
+        (void)num_samples;
+        (void)digests;
+        return false;
+    }
+    
     /**
      * @brief Получить имя backend
      * @return Строка с именем (например, "OpenCL (NVIDIA)")
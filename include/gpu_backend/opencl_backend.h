@@ -2,6 +2,8 @@
 #define OPENCL_BACKEND_H
 
 #include "igpu_backend.h"
+#include "work_group_tuner.h"
+#include "program_binary_cache.h"
 #define CL_HPP_ENABLE_EXCEPTIONS
 #include <CL/cl.hpp>
 
@@ -18,6 +20,9 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <functional>
+#include <map>
+#include <utility>
 
 /**
  * @brief Реализация GPU backend через OpenCL
@@ -27,10 +32,27 @@
 class OpenCLBackend : public IGPUBackend {
 public:
     /**
-     * @brief Конструктор
+     * @brief Конструктор (устройство выбирается при Initialize: приоритет RTX 3060, затем первый GPU)
      */
     OpenCLBackend();
     
+    /**
+     * @brief Конструктор для заданного устройства (любого типа, включая CPU)
+     * 
+     * У каждого экземпляра свои context, очереди и буферы - несколько
+     * backend'ов работают с разными устройствами независимо (MultiDeviceExecutor).
+     * 
+     * @param device OpenCL устройство
+     */
+    explicit OpenCLBackend(const cl::Device& device);
+    
+    /**
+     * @brief Перечислить OpenCL устройства всех платформ
+     * @param device_type Тип устройств (CL_DEVICE_TYPE_GPU, CL_DEVICE_TYPE_ALL, ...)
+     * @return Список устройств (пустой при отсутствии платформ)
+     */
+    static std::vector<cl::Device> EnumerateDevices(cl_device_type device_type);
+    
     /**
      * @brief Деструктор
      */
@@ -43,12 +65,89 @@ public:
     void FreeDeviceMemory(void* ptr) override;
     bool CopyHostToDevice(void* dst, const void* src, size_t size_bytes) override;
     bool CopyDeviceToHost(void* dst, const void* src, size_t size_bytes) override;
+    bool CopyDeviceToHostRegion(void* dst, const void* src, size_t offset_bytes, size_t size_bytes) override;
+    size_t GetNumStreams() const override;
+    bool CopyHostToDeviceAsync(void* dst, const void* src, size_t size_bytes, size_t stream) override;
+    bool CopyDeviceToHostAsync(void* dst, const void* src, size_t size_bytes, size_t stream) override;
+    bool ExecuteFractionalDelayAsync(
+        void* device_buffer,
+        const float* delay_coefficients,
+        size_t num_beams,
+        size_t num_samples,
+        size_t stream
+    ) override;
+    bool Synchronize(size_t stream) override;
     bool ExecuteFractionalDelay(
         void* device_buffer,
         const float* delay_coefficients,
         size_t num_beams,
         size_t num_samples
     ) override;
+    bool ExecuteFractionalDelayPacked(
+        const void* device_input,
+        void* device_output,
+        SampleFormat format,
+        const float* delay_coefficients,
+        size_t num_beams,
+        size_t num_samples
+    ) override;
+    bool ExecuteFractionalDelayFanOut(
+        const void* device_input,
+        void* device_output,
+        const float* delay_sets,
+        size_t num_delay_sets,
+        size_t num_beams,
+        size_t num_samples
+    ) override;
+    bool ExecuteDelayAndSum(
+        const void* device_input,
+        void* device_output,
+        const float* delays,
+        const ComplexType* weights,
+        size_t num_elements,
+        size_t num_directions,
+        size_t num_samples
+    ) override;
+    bool ExecuteFIR(
+        const void* device_input,
+        void* device_output,
+        void* device_history,
+        const float* coefficients,
+        size_t num_taps,
+        FirMethod method,
+        size_t num_beams,
+        size_t num_samples
+    ) override;
+    bool ExecuteResample(
+        const void* device_input,
+        void* device_output,
+        void* device_history,
+        const float* delays,
+        size_t history_size,
+        const ResampleBlock& block,
+        double step,
+        size_t num_beams,
+        size_t num_input_samples
+    ) override;
+    bool ExecuteDecimate(
+        const void* device_input,
+        void* device_output,
+        void* device_history,
+        const float* coefficients,
+        size_t num_taps,
+        size_t factor,
+        size_t first_position,
+        size_t num_beams,
+        size_t num_input_samples,
+        size_t num_output_samples
+    ) override;
+    bool ExecuteAddNoise(
+        void* device_buffer,
+        uint64_t seed,
+        float sigma,
+        size_t num_beams,
+        size_t num_samples
+    ) override;
     bool ExecuteFFT(
         void* device_buffer,
         size_t num_beams,
@@ -61,6 +160,21 @@ public:
         size_t num_beams,
         size_t num_samples
     ) override;
+    bool ExecuteHeterodyne(
+        void* device_buffer,
+        const void* device_reference,
+        size_t num_reference_beams,
+        size_t num_beams,
+        size_t num_samples
+    ) override;
+    bool ExecuteTileDigests(
+        const void* device_buffer,
+        float quantum,
+        size_t tile_samples,
+        size_t num_beams,
+        size_t num_samples,
+        uint64_t* digests
+    ) override;
     std::string GetBackendName() const override;
     std::string GetDeviceName() const override;
     size_t GetDeviceMemorySize() const override;
@@ -135,30 +249,63 @@ public:
 private:
     cl::Platform platform_;
     cl::Device device_;
+    bool device_preselected_;          // Устройство задано в конструкторе
     cl::Context context_;
     cl::CommandQueue queue_;
+    
+    // Очереди асинхронных потоков (чанки pipeline: копирование одного
+    // потока перекрывается с вычислением другого)
+    static const size_t NUM_STREAMS = 2;
+    std::vector<cl::CommandQueue> stream_queues_;
     cl::Program program_;
     
     // Kernels
     cl::Kernel kernel_fractional_delay_;
+    cl::Kernel kernel_fractional_delay_int16_;
+    cl::Kernel kernel_fractional_delay_half_;
+    cl::Kernel kernel_fractional_delay_fanout_;
+    cl::Kernel kernel_delay_and_sum_;
     cl::Kernel kernel_hadamard_;
+    cl::Kernel kernel_heterodyne_;
+    cl::Kernel kernel_fir_direct_;
+    cl::Kernel kernel_fir_update_history_;
+    cl::Kernel kernel_fir_os_gather_;
+    cl::Kernel kernel_fir_os_scatter_;
+    cl::Kernel kernel_farrow_resample_;
+    cl::Kernel kernel_fir_decimate_;
+    cl::Kernel kernel_add_gaussian_noise_;
+    cl::Kernel kernel_tile_digest_;
     
-    // clFFT plans
+    // clFFT plans (пересоздаются при смене размера или batch)
 #if CLFFT_FOUND
     clfftPlanHandle fft_plan_forward_;
     clfftPlanHandle fft_plan_inverse_;
     bool fft_plans_created_;
+    size_t fft_plan_samples_;
+    size_t fft_plan_batch_;
+    bool clfft_acquired_;              // Держит ссылку на библиотеку clFFT
 #endif
     
+    // Точки пересечения методов FIR: (лучи, класс размера блока) -> длина фильтра
+    std::map<std::pair<size_t, size_t>, size_t> fir_crossover_;
+    
     // Матрица Лагранжа для дробной задержки
     cl::Buffer lagrange_matrix_buffer_;
     bool lagrange_matrix_uploaded_;
     
     // Информация об устройстве
     std::string device_name_;
+    std::string driver_version_;
     size_t device_memory_size_;
+    size_t max_work_group_size_;
     bool initialized_;
     
+    // Автотюнер размера work group (кэш на диске по устройству и драйверу)
+    WorkGroupTuner work_group_tuner_;
+    
+    // Кэш скомпилированных бинарников программы
+    ProgramBinaryCache program_binary_cache_;
+    
     /**
      * @brief Найти и выбрать оптимальное OpenCL устройство
      * @return true если устройство найдено
@@ -167,10 +314,35 @@ private:
     
     /**
      * @brief Загрузить и скомпилировать OpenCL программы
+     * 
+     * Сначала ищет бинарник в кэше (ключ - хэш исходников, опций, устройства
+     * и драйвера); при отсутствии или несовпадении компилирует из исходников
+     * и сохраняет бинарник в кэш.
+     * 
      * @return true если успешно
      */
     bool BuildProgram();
     
+    /**
+     * @brief Создать объекты kernel из program_
+     * @return true если успешно
+     */
+    bool CreateKernels();
+    
+    /**
+     * @brief Создать программу из бинарника в кэше (clCreateProgramWithBinary)
+     * @param key Ключ кэша
+     * @param build_options Опции, с которыми был собран бинарник
+     * @return true если программа и kernel'ы созданы
+     */
+    bool LoadProgramFromBinaryCache(const std::string& key, const std::string& build_options);
+    
+    /**
+     * @brief Сохранить бинарник собранной программы в кэш
+     * @param key Ключ кэша
+     */
+    void StoreProgramBinary(const std::string& key);
+    
     /**
      * @brief Загрузить kernel из файла
      * @param filename Имя файла .cl
@@ -178,6 +350,139 @@ private:
      */
     std::string LoadKernelSource(const std::string& filename) const;
     
+    /**
+     * @brief Получить параметры запуска kernel (из кэша или автотюнингом)
+     * 
+     * При первом обращении для (устройство, kernel, класс формы) перебирает
+     * кандидатов размера work group и отсчётов на work item на временных буферах,
+     * замеряет время через OpenCL Events и сохраняет победителя в кэш.
+     * Кандидат, отвергнутый устройством, пропускается; прерванный замер или
+     * замер без единого успешного кандидата в кэш не сохраняется.
+     * 
+     * @param kernel Kernel для замера
+     * @param kernel_name Имя kernel (часть ключа кэша)
+     * @param num_beams Количество лучей
+     * @param num_samples Количество отсчётов на луч
+     * @param bind_scratch_args Создать временные буферы (число лучей, контейнер,
+     *                          удерживающий их до конца замера) и установить на них аргументы kernel
+     * @return Параметры запуска
+     */
+    WorkGroupTuner::LaunchConfig GetLaunchConfig(
+        cl::Kernel& kernel,
+        const std::string& kernel_name,
+        size_t num_beams,
+        size_t num_samples,
+        const std::function<bool(size_t, std::vector<cl::Buffer>&)>& bind_scratch_args
+    );
+    
+    /**
+     * @brief Поставить в очередь kernel дробной задержки
+     * @param buffer Буфер сигналов на устройстве (in-place)
+     * @param delay_coefficients Задержка для каждого луча (в отсчётах)
+     * @param num_beams Количество лучей
+     * @param num_samples Количество отсчётов на луч
+     * @param event_out Event для профилирования (может быть nullptr)
+     * @param queue Очередь (queue_ или очередь асинхронного потока)
+     * @return true если успешно
+     */
+    bool EnqueueFractionalDelay(
+        cl::Buffer& buffer,
+        const float* delay_coefficients,
+        size_t num_beams,
+        size_t num_samples,
+        cl::Event* event_out,
+        cl::CommandQueue& queue
+    );
+    
+    /**
+     * @brief Буфер параметров задержки (целая часть, строка матрицы Лагранжа) по лучам
+     * @param delay_coefficients Задержка для каждого луча (в отсчётах)
+     * @param num_beams Количество лучей
+     */
+    cl::Buffer CreateDelayParamsBuffer(const float* delay_coefficients, size_t num_beams);
+    
+    /**
+     * @brief Поставить в очередь kernel дробной задержки над упакованными данными
+     * @param input Входной буфер (int16 IQ или fp16)
+     * @param output Выходной буфер того же формата
+     * @param format INT16_IQ или FP16
+     * @param delay_coefficients Задержка для каждого луча (в отсчётах)
+     * @param num_beams Количество лучей
+     * @param num_samples Количество отсчётов на луч
+     * @param event_out Event для профилирования (может быть nullptr)
+     * @return true если успешно
+     */
+    bool EnqueueFractionalDelayPacked(
+        const cl::Buffer& input,
+        cl::Buffer& output,
+        SampleFormat format,
+        const float* delay_coefficients,
+        size_t num_beams,
+        size_t num_samples,
+        cl::Event* event_out
+    );
+    
+    /**
+     * @brief Поставить в очередь FIR фильтр блока (метод задан явно)
+     *
+     * DIRECT - kernel fir_direct; OVERLAP_SAVE - fir_os_gather, FFT сегментов,
+     * hadamard_multiply со спектром фильтра, обратное FFT, fir_os_scatter.
+     * В обоих случаях затем обновляется история (fir_update_history).
+     *
+     * @param input Входной блок
+     * @param output Выходной блок
+     * @param history История (не меньше одного элемента, даже при num_taps == 1)
+     * @param coefficients Коэффициенты h[num_taps]
+     * @param num_taps Длина фильтра
+     * @param method DIRECT или OVERLAP_SAVE
+     * @param num_beams Количество лучей
+     * @param num_samples Отсчётов в блоке
+     * @return true если успешно
+     */
+    bool EnqueueFIR(
+        const cl::Buffer& input,
+        cl::Buffer& output,
+        cl::Buffer& history,
+        const float* coefficients,
+        size_t num_taps,
+        FirMethod method,
+        size_t num_beams,
+        size_t num_samples
+    );
+    
+    /**
+     * @brief Обновить историю потока: последние history_size отсчётов (история + блок)
+     * 
+     * Общая для FIR и передискретизации (kernel fir_update_history).
+     * 
+     * @param input Входной блок [num_beams * num_samples]
+     * @param history История [num_beams * history_size] (обновляется)
+     * @param history_size Длина истории луча (0 - ничего не делать)
+     * @param num_beams Количество лучей
+     * @param num_samples Отсчётов в блоке
+     * @return true если успешно
+     */
+    bool EnqueueHistoryUpdate(
+        const cl::Buffer& input,
+        cl::Buffer& history,
+        size_t history_size,
+        size_t num_beams,
+        size_t num_samples
+    );
+    
+    /**
+     * @brief Точка пересечения методов FIR на устройстве (замер один раз на класс формы)
+     * @param num_beams Количество лучей
+     * @param num_samples Отсчётов в блоке
+     * @return Длина фильтра, с которой выбирается OVERLAP_SAVE
+     */
+    size_t GetFirCrossover(size_t num_beams, size_t num_samples);
+    
+    /**
+     * @brief Запустить grid-stride kernel на total_items элементов (размер группы выбирает драйвер)
+     */
+    cl_int EnqueueGridStride(cl::Kernel& kernel, size_t total_items);
+    
     /**
      * @brief Создать FFT планы для clFFT
      * @param num_samples Размер FFT
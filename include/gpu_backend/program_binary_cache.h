@@ -0,0 +1,76 @@
+#ifndef PROGRAM_BINARY_CACHE_H
+#define PROGRAM_BINARY_CACHE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief Кэш скомпилированных бинарников OpenCL программ на диске
+ *
+ * Ключ - хэш (FNV-1a, 64 бит) от исходного текста kernel'ов, опций сборки,
+ * устройства, драйвера и платформы. Любое изменение одного из них даёт новый
+ * ключ, поэтому устаревший бинарник никогда не будет загружен.
+ * Файлы: <директория>/<ключ>.bin
+ */
+class ProgramBinaryCache {
+public:
+    /**
+     * @brief Конструктор
+     * @param cache_dir Директория кэша (пустая строка - директория по умолчанию)
+     */
+    explicit ProgramBinaryCache(const std::string& cache_dir = "");
+
+    /**
+     * @brief Сформировать ключ кэша
+     * @param source Исходный текст программы
+     * @param build_options Опции компиляции
+     * @param device_name Имя устройства
+     * @param driver_version Версия драйвера
+     * @param platform_version Версия платформы
+     * @return Ключ (16 hex-символов)
+     */
+    static std::string MakeKey(
+        const std::string& source,
+        const std::string& build_options,
+        const std::string& device_name,
+        const std::string& driver_version,
+        const std::string& platform_version
+    );
+
+    /**
+     * @brief Загрузить бинарник
+     * @param key Ключ кэша
+     * @param binary Выходной бинарник
+     * @return true если найден и прочитан
+     */
+    bool Load(const std::string& key, std::vector<unsigned char>* binary) const;
+
+    /**
+     * @brief Сохранить бинарник (запись через временный файл и rename)
+     * @param key Ключ кэша
+     * @param binary Бинарник программы
+     * @return true если успешно
+     */
+    bool Store(const std::string& key, const std::vector<unsigned char>& binary) const;
+
+    /**
+     * @brief Удалить запись (например, если бинарник отвергнут драйвером)
+     * @param key Ключ кэша
+     */
+    void Remove(const std::string& key) const;
+
+    /**
+     * @brief Директория кэша
+     */
+    const std::string& GetCacheDirectory() const { return cache_dir_; }
+
+private:
+    std::string cache_dir_;
+
+    std::string PathForKey(const std::string& key) const;
+
+    static uint64_t Fnv1a64(const std::string& data, uint64_t hash);
+};
+
+#endif // PROGRAM_BINARY_CACHE_H
@@ -0,0 +1,146 @@
+#ifndef WORK_GROUP_TUNER_H
+#define WORK_GROUP_TUNER_H
+
+#include <string>
+#include <map>
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Автотюнер размера work group с постоянным кэшем на диске
+ *
+ * Хранит лучшие параметры запуска kernel'ов для пары (устройство, драйвер),
+ * имени kernel'а и класса формы данных (лучи × отсчёты, округлённые до степени 2).
+ * Сам замер времени выполняет backend, тюнер отвечает только за кандидатов,
+ * ключи и файл кэша.
+ *
+ * Формат файла (одна запись на строку, поля через TAB):
+ *   device|driver|kernel|shape  local_size  items_per_work_item  time_ms
+ */
+class WorkGroupTuner {
+public:
+    /**
+     * @brief Параметры запуска kernel
+     */
+    struct LaunchConfig {
+        size_t local_size;             // Размер work group
+        size_t items_per_work_item;    // Отсчётов на один work item (grid-stride)
+        double time_ms;                // Измеренное время лучшего варианта
+
+        LaunchConfig() : local_size(0), items_per_work_item(1), time_ms(0.0) {}
+        LaunchConfig(size_t local, size_t items, double time = 0.0)
+            : local_size(local), items_per_work_item(items), time_ms(time) {}
+    };
+
+    /**
+     * @brief Конструктор
+     * @param cache_filename Путь к файлу кэша (пустая строка - путь по умолчанию)
+     */
+    explicit WorkGroupTuner(const std::string& cache_filename = "");
+
+    /**
+     * @brief Загрузить кэш с диска (отсутствие файла не считается ошибкой)
+     * @return true если файл прочитан или отсутствует
+     */
+    bool Load();
+
+    /**
+     * @brief Сохранить кэш на диск
+     *
+     * Записи, появившиеся в файле после Load (другие устройства или процессы),
+     * сохраняются; файл заменяется атомарно (временный файл + rename).
+     *
+     * @return true если успешно
+     */
+    bool Save() const;
+
+    /**
+     * @brief Найти сохранённые параметры запуска
+     * @param key Ключ (см. MakeKey)
+     * @param config Выходные параметры
+     * @return true если запись найдена
+     */
+    bool Lookup(const std::string& key, LaunchConfig* config) const;
+
+    /**
+     * @brief Запомнить параметры запуска (без записи на диск)
+     */
+    void Store(const std::string& key, const LaunchConfig& config);
+
+    /**
+     * @brief Путь к файлу кэша
+     */
+    const std::string& GetCacheFilename() const { return cache_filename_; }
+
+    /**
+     * @brief Сформировать ключ кэша
+     * @param device_name Имя устройства (SystemInfo::device_name)
+     * @param driver_version Версия драйвера (SystemInfo::driver_version)
+     * @param kernel_name Имя kernel
+     * @param num_beams Количество лучей
+     * @param num_samples Количество отсчётов на луч
+     */
+    static std::string MakeKey(
+        const std::string& device_name,
+        const std::string& driver_version,
+        const std::string& kernel_name,
+        size_t num_beams,
+        size_t num_samples
+    );
+
+    /**
+     * @brief Класс формы данных: "b<2^k>_s<2^m>" (округление вверх до степени 2)
+     */
+    static std::string ShapeClass(size_t num_beams, size_t num_samples);
+
+    /**
+     * @brief Кандидаты размера work group
+     *
+     * Степени двойки от preferred_multiple до min(device_max, kernel_max).
+     *
+     * @param device_max_wg CL_DEVICE_MAX_WORK_GROUP_SIZE
+     * @param kernel_max_wg CL_KERNEL_WORK_GROUP_SIZE
+     * @param preferred_multiple CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE
+     */
+    static std::vector<size_t> CandidateLocalSizes(
+        size_t device_max_wg,
+        size_t kernel_max_wg,
+        size_t preferred_multiple
+    );
+
+    /**
+     * @brief Кандидаты количества отсчётов на work item
+     */
+    static std::vector<size_t> CandidateItemsPerWorkItem();
+
+    /**
+     * @brief Глобальный размер grid, выровненный на local_size
+     * @param total_items Общее количество элементов
+     * @param config Параметры запуска
+     * @return Количество work items (кратно local_size, не меньше local_size)
+     */
+    static size_t PaddedGlobalSize(size_t total_items, const LaunchConfig& config);
+
+    /**
+     * @brief Директория кэша по умолчанию
+     *
+     * Переменная окружения LCH_FARROW_CACHE_DIR, иначе "Results/cache".
+     */
+    static std::string DefaultCacheDirectory();
+
+    /**
+     * @brief Уникальное имя временного файла рядом с path (pid + счётчик)
+     *
+     * Для записи кэша через временный файл и rename: параллельные писатели
+     * (потоки и процессы) не делят один временный файл.
+     */
+    static std::string TempPathFor(const std::string& path);
+
+private:
+    std::string cache_filename_;
+    std::map<std::string, LaunchConfig> entries_;
+
+    static size_t RoundUpPow2(size_t value);
+};
+
+#endif // WORK_GROUP_TUNER_H
@@ -0,0 +1,94 @@
+#ifndef HALF_FLOAT_H
+#define HALF_FLOAT_H
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Преобразования float <-> IEEE 754 binary16 (half) без зависимостей
+ *
+ * Совпадают с vload_half/vstore_half_rte в OpenCL: округление к ближайшему
+ * чётному, поддержка субнормальных чисел, бесконечностей и NaN.
+ */
+namespace half_float {
+
+/**
+ * @brief float -> half (round to nearest even)
+ */
+inline uint16_t FromFloat(float value) noexcept {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    const uint32_t abs_bits = bits & 0x7FFFFFFFu;
+
+    if (abs_bits >= 0x7F800000u) {
+        // Inf или NaN (NaN остаётся тихим NaN)
+        return static_cast<uint16_t>(sign | 0x7C00u | (abs_bits > 0x7F800000u ? 0x0200u : 0u));
+    }
+    if (abs_bits >= 0x477FF000u) {
+        // Переполнение после округления -> бесконечность
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    }
+    if (abs_bits < 0x38800000u) {
+        // Субнормальный half или ноль
+        if (abs_bits < 0x33000000u) {
+            return static_cast<uint16_t>(sign);
+        }
+        const uint32_t exponent = abs_bits >> 23;
+        const uint32_t mantissa = (abs_bits & 0x007FFFFFu) | 0x00800000u;
+        const uint32_t shift = 126u - exponent;  // 14..24
+        uint32_t half_mantissa = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        const uint32_t halfway = 1u << (shift - 1u);
+        if (remainder > halfway || (remainder == halfway && (half_mantissa & 1u))) {
+            ++half_mantissa;
+        }
+        return static_cast<uint16_t>(sign | half_mantissa);
+    }
+
+    // Нормальное число: перенос экспоненты и округление мантиссы
+    uint32_t half_bits = ((abs_bits - 0x38000000u) >> 13);
+    const uint32_t remainder = abs_bits & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half_bits & 1u))) {
+        ++half_bits;
+    }
+    return static_cast<uint16_t>(sign | half_bits);
+}
+
+/**
+ * @brief half -> float (точно)
+ */
+inline float ToFloat(uint16_t value) noexcept {
+    const uint32_t sign = (static_cast<uint32_t>(value) & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1Fu;
+    uint32_t mantissa = value & 0x03FFu;
+    uint32_t bits;
+
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        } else {
+            // Субнормальный half -> нормальный float
+            uint32_t e = 113;  // 127 - 15 + 1
+            while ((mantissa & 0x0400u) == 0) {
+                mantissa <<= 1;
+                --e;
+            }
+            mantissa &= 0x03FFu;
+            bits = sign | (e << 23) | (mantissa << 13);
+        }
+    } else if (exponent == 0x1F) {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    }
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+} // namespace half_float
+
+#endif // HALF_FLOAT_H
@@ -9,6 +9,9 @@
  * 
  * Матрица 48×5 для интерполяции дробной задержки 5-го порядка.
  * Используется для точной дробной задержки сигнала.
+ *
+ * Для рабочих запусков используйте общий неизменяемый экземпляр Shared():
+ * он создаётся один раз на процесс и передаётся CPU движку и каждому GPU backend.
  */
 class LagrangeMatrix {
 public:
@@ -20,6 +23,24 @@ public:
      */
     LagrangeMatrix();
     
+    /**
+     * @brief Общая неизменяемая матрица процесса
+     * 
+     * Создаётся при первом обращении (потокобезопасно) из встроенной таблицы
+     * lagrange_matrix_data.h. Если задана переменная окружения LCH_FARROW_LAGRANGE_JSON,
+     * матрица один раз загружается из указанного файла (при ошибке - встроенная таблица).
+     * 
+     * @return Ссылка на общую матрицу
+     */
+    static const LagrangeMatrix& Shared();
+    
+    /**
+     * @brief Загрузить матрицу из массива
+     * @param data Указатель на массив [ROWS * COLS]
+     * @return true если успешно
+     */
+    bool LoadFromArray(const float* data);
+    
     /**
      * @brief Загрузить матрицу из JSON файла
      * @param filename Путь к файлу lagrange_matrix.json
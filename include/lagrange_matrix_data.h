@@ -0,0 +1,73 @@
+#ifndef LAGRANGE_MATRIX_DATA_H
+#define LAGRANGE_MATRIX_DATA_H
+
+#include <cstddef>
+
+/**
+ * @brief Встроенная матрица коэффициентов Лагранжа 48×5
+ *
+ * Сгенерирована из Doc/Example/lagrange_matrix.json (строка i - дробная задержка i/48,
+ * столбцы - веса отсчётов [n-2, n-1, n, n+1, n+2]).
+ * Используется LagrangeMatrix::Shared() как источник по умолчанию, чтобы
+ * не разбирать JSON при каждом запуске.
+ * При изменении JSON файла таблицу нужно перегенерировать.
+ */
+namespace lagrange_data {
+
+constexpr size_t ROWS = 48;
+constexpr size_t COLS = 5;
+
+constexpr float kMatrix[ROWS * COLS] = {
+    0.000000000e0f, -0.000000000e0f, 1.000000000e0f, 0.000000000e0f, -0.000000000e0f,  //  0: delay 0/48
+    1.717280949e-3f, -1.359806139e-2f, 9.994575124e-1f, 1.417670230e-2f, -1.753434232e-3f,  //  1: delay 1/48
+    3.393981682e-3f, -2.660881639e-2f, 9.978306146e-1f, 2.892262651e-2f, -3.538406435e-3f,  //  2: delay 2/48
+    5.025863647e-3f, -3.902435303e-2f, 9.951210022e-1f, 4.422760010e-2f, -5.350112915e-3f,  //  3: delay 3/48
+    6.608876672e-3f, -5.083751286e-2f, 9.913315008e-1f, 6.008069702e-2f, -7.183561600e-3f,  //  4: delay 4/48
+    8.139158963e-3f, -6.204189096e-2f, 9.864660663e-1f, 7.647023770e-2f, -9.033572036e-3f,  //  5: delay 5/48
+    9.613037109e-3f, -7.263183594e-2f, 9.805297852e-1f, 9.338378906e-2f, -1.089477539e-2f,  //  6: delay 6/48
+    1.102702608e-2f, -8.260244990e-2f, 9.735288738e-1f, 1.108081645e-1f, -1.276161445e-2f,  //  7: delay 7/48
+    1.237782922e-2f, -9.194958848e-2f, 9.654706790e-1f, 1.287294239e-1f, -1.462834362e-2f,  //  8: delay 8/48
+    1.366233826e-2f, -1.006698608e-1f, 9.563636780e-1f, 1.471328735e-1f, -1.648902893e-2f,  //  9: delay 9/48
+    1.487763330e-2f, -1.087606297e-1f, 9.462174781e-1f, 1.660030663e-1f, -1.833754802e-2f,  // 10: delay 10/48
+    1.602098284e-2f, -1.162200111e-1f, 9.350428169e-1f, 1.853238016e-1f, -2.016759017e-2f,  // 11: delay 11/48
+    1.708984375e-2f, -1.230468750e-1f, 9.228515625e-1f, 2.050781250e-1f, -2.197265625e-2f,  // 12: delay 12/48
+    1.808186127e-2f, -1.292408445e-1f, 9.096567130e-1f, 2.252483289e-1f, -2.374605877e-2f,  // 13: delay 13/48
+    1.899486903e-2f, -1.348022963e-1f, 8.954723970e-1f, 2.458159521e-1f, -2.548092187e-2f,  // 14: delay 14/48
+    1.982688904e-2f, -1.397323608e-1f, 8.803138733e-1f, 2.667617798e-1f, -2.717018127e-2f,  // 15: delay 15/48
+    2.057613169e-2f, -1.440329218e-1f, 8.641975309e-1f, 2.880658436e-1f, -2.880658436e-2f,  // 16: delay 16/48
+    2.124099574e-2f, -1.477066166e-1f, 8.471408891e-1f, 3.097074218e-1f, -3.038269012e-2f,  // 17: delay 17/48
+    2.182006836e-2f, -1.507568359e-1f, 8.291625977e-1f, 3.316650391e-1f, -3.189086914e-2f,  // 18: delay 18/48
+    2.231212506e-2f, -1.531877243e-1f, 8.102824364e-1f, 3.539164665e-1f, -3.332330366e-2f,  // 19: delay 19/48
+    2.271612976e-2f, -1.550041795e-1f, 7.905213156e-1f, 3.764387217e-1f, -3.467198753e-2f,  // 20: delay 20/48
+    2.303123474e-2f, -1.562118530e-1f, 7.699012756e-1f, 3.992080688e-1f, -3.592872620e-2f,  // 21: delay 21/48
+    2.325678068e-2f, -1.568171497e-1f, 7.484454873e-1f, 4.222000185e-1f, -3.708513676e-2f,  // 22: delay 22/48
+    2.339229662e-2f, -1.568272281e-1f, 7.261782517e-1f, 4.453893277e-1f, -3.813264792e-2f,  // 23: delay 23/48
+    2.343750000e-2f, -1.562500000e-1f, 7.031250000e-1f, 4.687500000e-1f, -3.906250000e-2f,  // 24: delay 24/48
+    2.339229662e-2f, -1.550941310e-1f, 6.793122939e-1f, 4.922552854e-1f, -3.986574495e-2f,  // 25: delay 25/48
+    2.325678068e-2f, -1.533690402e-1f, 6.547678253e-1f, 5.158776805e-1f, -4.053324633e-2f,  // 26: delay 26/48
+    2.303123474e-2f, -1.510848999e-1f, 6.295204163e-1f, 5.395889282e-1f, -4.105567932e-2f,  // 27: delay 27/48
+    2.271612976e-2f, -1.482526363e-1f, 6.036000193e-1f, 5.633600180e-1f, -4.142353074e-2f,  // 28: delay 28/48
+    2.231212506e-2f, -1.448839290e-1f, 5.770377171e-1f, 5.871611858e-1f, -4.162709899e-2f,  // 29: delay 29/48
+    2.182006836e-2f, -1.409912109e-1f, 5.498657227e-1f, 6.109619141e-1f, -4.165649414e-2f,  // 30: delay 30/48
+    2.124099574e-2f, -1.365876688e-1f, 5.221173793e-1f, 6.347309317e-1f, -4.150163784e-2f,  // 31: delay 31/48
+    2.057613169e-2f, -1.316872428e-1f, 4.938271605e-1f, 6.584362140e-1f, -4.115226337e-2f,  // 32: delay 32/48
+    1.982688904e-2f, -1.263046265e-1f, 4.650306702e-1f, 6.820449829e-1f, -4.059791565e-2f,  // 33: delay 33/48
+    1.899486903e-2f, -1.204552670e-1f, 4.357646424e-1f, 7.055237068e-1f, -3.982795119e-2f,  // 34: delay 34/48
+    1.808186127e-2f, -1.141553651e-1f, 4.060669416e-1f, 7.288381004e-1f, -3.883153813e-2f,  // 35: delay 35/48
+    1.708984375e-2f, -1.074218750e-1f, 3.759765625e-1f, 7.519531250e-1f, -3.759765625e-2f,  // 36: delay 36/48
+    1.602098284e-2f, -1.002725044e-1f, 3.455336300e-1f, 7.748329885e-1f, -3.611509692e-2f,  // 37: delay 37/48
+    1.487763330e-2f, -9.272571454e-2f, 3.147793994e-1f, 7.974411450e-1f, -3.437246315e-2f,  // 38: delay 38/48
+    1.366233826e-2f, -8.480072021e-2f, 2.837562561e-1f, 8.197402954e-1f, -3.235816956e-2f,  // 39: delay 39/48
+    1.237782922e-2f, -7.651748971e-2f, 2.525077160e-1f, 8.416923868e-1f, -3.006044239e-2f,  // 40: delay 40/48
+    1.102702608e-2f, -6.789674484e-2f, 2.210784253e-1f, 8.632586130e-1f, -2.746731950e-2f,  // 41: delay 41/48
+    9.613037109e-3f, -5.895996094e-2f, 1.895141602e-1f, 8.843994141e-1f, -2.456665039e-2f,  // 42: delay 42/48
+    8.139158963e-3f, -4.972936685e-2f, 1.578618273e-1f, 9.050744767e-1f, -2.134609615e-2f,  // 43: delay 43/48
+    6.608876672e-3f, -4.022794496e-2f, 1.261694637e-1f, 9.252427341e-1f, -1.779312950e-2f,  // 44: delay 44/48
+    5.025863647e-3f, -3.047943115e-2f, 9.448623657e-2f, 9.448623657e-1f, -1.389503479e-2f,  // 45: delay 45/48
+    3.393981682e-3f, -2.050831485e-2f, 6.286244334e-2f, 9.638907978e-1f, -9.638907978e-3f,  // 46: delay 46/48
+    1.717280949e-3f, -1.033983898e-2f, 3.134951179e-2f, 9.822847029e-1f, -5.011656647e-3f,  // 47: delay 47/48
+};
+
+} // namespace lagrange_data
+
+#endif // LAGRANGE_MATRIX_DATA_H
@@ -33,6 +33,12 @@ enum class LFMVariant : uint8_t {
     HETERODYNE = 6          // 🆕 Для гетеродина (сопряжённый сигнал)
 };
 
+// Вычисление фазы ЛЧМ при генерации
+enum class PhaseMode : uint8_t {
+    DIRECT = 0,             // float по формуле для каждого отсчёта (ошибка растёт с длиной луча)
+    ACCUMULATED = 1         // double рекуррентно, свёрнута в [-π, π): ошибка ограничена при любой длине
+};
+
 enum class ErrorCode : int {
     SUCCESS = 0,
     INVALID_PARAMS = -1,
@@ -62,6 +68,9 @@ struct LFMParameters {
     // ДЛЯ ГЕТЕРОДИНА:
     bool apply_heterodyne = false;       // Применять ли сопряжение
 
+    // Фаза для длинных лучей (~1M отсчётов и больше) - PhaseMode::ACCUMULATED
+    PhaseMode phase_mode = PhaseMode::DIRECT;
+
     // ВАЛИДАЦИЯ (обновлена)
     bool IsValid() const noexcept {
         if(count_points > 0) {
@@ -97,6 +106,14 @@ struct LFMParameters {
         return static_cast<size_t>(duration * sample_rate);
     }
 
+    // Количество углов сетки [angle_start_deg, angle_stop_deg] с шагом angle_step_deg
+    size_t GetNumAngles() const noexcept {
+        if (angle_step_deg <= 0.0f || angle_stop_deg < angle_start_deg) {
+            return 0;
+        }
+        return static_cast<size_t>((angle_stop_deg - angle_start_deg) / angle_step_deg + 0.5f) + 1;
+    }
+
     float GetWavelength() const noexcept {
         float f_center = (f_start + f_stop) / 2.0f;
         return SPEED_OF_LIGHT / f_center;
@@ -119,6 +136,7 @@ struct NoiseParams {
     double phi = 0;         // initial phase
     double fdev = 0;        // frequency deviation (f2 - f1)
     double tau = 0;         // time shift
+    uint64_t seed = 0;      // noise seed (counter RNG: same seed - same noise)
 };
 
 // ═════════════════════════════════════════════════════════════════════
@@ -129,6 +147,7 @@ class LFMSignalGenerator {
 private:
     const LFMParameters params_;
     mutable GenerationStatistics stats_;
+    std::vector<float> window_table_;   // Кэш Hamming окна (ядра вариантов не считают cos окна)
 
     // HELPER METHODS
     inline std::complex<float> GenerateComplexSample(float phase) const noexcept {
@@ -140,31 +159,24 @@ private:
         return TWO_PI * (params_.f_start * t + 0.5f * chirp_rate * t * t) + phase_offset;
     }
 
-    // PRIVATE GENERATION METHODS
-    void GenerateVariant_Basic(std::complex<float>* beam_data, size_t num_samples) const noexcept;
-
-    void GenerateVariant_PhaseOffset(std::complex<float>* beam_data, size_t num_samples,
-        float phase_offset) const noexcept;
-
-    void GenerateVariant_Delay(std::complex<float>* beam_data, size_t num_samples,
-        float delay_samples) const noexcept;
-
-    void GenerateVariant_Beamforming(std::complex<float>* beam_data, size_t num_samples,
-        float phase_shift) const noexcept;
-
-    void GenerateVariant_Windowed(std::complex<float>* beam_data, size_t num_samples) const noexcept;
-
-    // 🆕 ПРИВАТНЫЕ ВСПОМОГАТЕЛЬНЫЕ МЕТОДЫ:
-    void GenerateVariant_AngleSweep(
-        std::complex<float>* beam_data,
-        size_t num_samples,
-        float angle_deg,
-        size_t element_index
-    ) const noexcept;
-
-    void GenerateVariant_Heterodyne(
-        std::complex<float>* beam_data,
-        size_t num_samples
+    // Hamming окно кадра [GetNumSamples()] для WINDOWED (считается в конструкторе)
+    std::vector<float> BuildWindowTable() const;
+
+    // data[i] *= conj(ref[i]), i in [begin, end)
+    static void MultiplyConjugate(
+        std::complex<float>* data,
+        const std::complex<float>* ref,
+        size_t begin,
+        size_t end
+    ) noexcept;
+
+    // Сигнал + шум для отсчётов [first_sample, first_sample + count) (поток шума stream)
+    void FillSignalWithNoise(
+        const NoiseParams& params,
+        uint64_t stream,
+        size_t first_sample,
+        std::complex<float>* out,
+        size_t count
     ) const noexcept;
 
 public:
@@ -174,6 +186,7 @@ public:
         if (!params_.IsValid()) {
             throw std::invalid_argument("Invalid LFM parameters");
         }
+        window_table_ = BuildWindowTable();
     }
 
     explicit LFMSignalGenerator(float f_start, float f_stop, float sample_rate, float duration)
@@ -204,16 +217,28 @@ public:
 
     const GenerationStatistics& GetStatistics() const noexcept { return stats_; }
 
-    // NEW: Generate signal with noise (vectorized, no loops)
+    // NEW: Generate signal with noise (parallel by sample blocks, reproducible for params.seed)
     std::pair<std::vector<std::complex<float>>, std::vector<double>>
     GetSignalWithNoise(const NoiseParams& params);
 
+    // Signal with noise written in place (time computed on the fly, no allocations)
+    // Single beam: samples [0, num_samples), noise stream `stream`
+    void GetSignalWithNoise(const NoiseParams& params, std::complex<float>* beam_data,
+        size_t num_samples, uint64_t stream = 0) const;
+
+    // All beams of an allocated buffer: beam b uses noise stream b
+    ErrorCode GetSignalWithNoise(const NoiseParams& params, SignalBuffer& buffer) const;
+
     // 🆕 НОВЫЙ МЕТОД 1: Генерация с задержкой по углам (0.5° шаг)
     float ComputeDelayForAngle(
         float angle_deg,      // Угол в градусах
         size_t element_index  // Индекс элемента (0, 1, 2, ...)
     ) const noexcept;
 
+    // Задержки для всей сетки углов: [angle][element], angle = start + i * step
+    // (формат delay_sets для ExecuteFractionalDelayFanOutCPU / ExecuteFractionalDelayFanOut)
+    std::vector<float> ComputeAngleGridDelays(size_t num_elements) const;
+
     // 🆕 НОВЫЙ МЕТОД 2: Создать сопряжённую копию буфера (гетеродин)
     SignalBuffer MakeConjugateCopy(const SignalBuffer& src) const;
 
@@ -226,6 +251,19 @@ public:
         const SignalBuffer& rx_signal,  // Принятый сигнал
         const SignalBuffer& ref_signal  // Опорный сигнал (ЛЧМ)
     ) const;
+
+    // 🆕 НОВЫЙ МЕТОД 5: Гетеродинирование на месте: rx[b][n] *= conj(ref[n])
+    // Одна опорная строка на все лучи (без выходного буфера и копий опоры по лучам)
+    void HeterodyneInPlace(
+        SignalBuffer& rx_signal,              // Принятый сигнал (результат записывается в него)
+        const std::complex<float>* ref_row    // Опорный сигнал [num_samples]
+    ) const;
+
+    // ref_signal из одного луча - общая опора, иначе опора для каждого луча
+    void HeterodyneInPlace(
+        SignalBuffer& rx_signal,
+        const SignalBuffer& ref_signal
+    ) const;
 };
 
 std::ostream& operator<<(std::ostream& os, const LFMParameters& params);
@@ -0,0 +1,162 @@
+#ifndef METRICS_EXPORTER_H
+#define METRICS_EXPORTER_H
+
+#include "profiling_engine.h"
+#include "gpu_profiling.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Живые метрики процесса в текстовом формате Prometheus
+ *
+ * Поток обработки вызывает Publish (после кадра или стадии): счётчики и
+ * гистограммы копятся в его собственном состоянии и копируются в один из
+ * двух буферов снимка. Буфер защищён seqlock-счётчиком: запись делает его
+ * нечётным, читатель копирует снимок и повторяет попытку, если счётчик
+ * изменился. Publish не берёт блокировок и не ждёт читателя; сервер, не
+ * успевший скопировать буфер до следующего кадра, просто перечитывает.
+ *
+ * Сервер - отдельный поток, HTTP/1.0 на Unix-domain сокете или на
+ * 127.0.0.1:port (curl --unix-socket <path> http://localhost/metrics).
+ *
+ * Длительности - в секундах (соглашение Prometheus). Имена длиннее
+ * MAX_NAME_LENGTH - 1 байт обрезаются по границе символа UTF-8 и получают
+ * суффикс "~<номер слота>", чтобы оставаться различными; метрики сверх
+ * MAX_STAGES / MAX_GPU_EVENTS не экспортируются.
+ */
+class MetricsExporter {
+public:
+    static constexpr size_t MAX_NAME_LENGTH = 48;
+    static constexpr size_t MAX_STAGES = 64;
+    static constexpr size_t MAX_GPU_EVENTS = 32;
+    static constexpr size_t HISTOGRAM_BUCKETS = 12;   // Последняя корзина - +Inf
+
+    /**
+     * @brief Где слушать (ровно одно из двух)
+     */
+    struct Options {
+        std::string unix_socket_path;   // Путь Unix-domain сокета (файл пересоздаётся)
+        uint16_t tcp_port;              // Порт на 127.0.0.1 (0 - не использовать)
+
+        Options() : tcp_port(0) {}
+    };
+
+    /**
+     * @brief Снимок метрик (тривиально копируемый: копируется в обход блокировок)
+     */
+    struct Snapshot {
+        struct Stage {
+            char name[MAX_NAME_LENGTH];
+            uint64_t calls;                          // Вызовов всего
+            double seconds;                          // Время всего
+            uint64_t buckets[HISTOGRAM_BUCKETS];     // Вызовов по длительности (не накопительно)
+        };
+
+        struct GpuEvent {
+            char name[MAX_NAME_LENGTH];
+            double queue_seconds;                    // Последний кадр: SUBMIT - QUEUED
+            double wait_seconds;                     // START - SUBMIT
+            double execution_seconds;                // END - START
+            double total_seconds;                    // END - QUEUED
+        };
+
+        uint64_t publications;
+        uint32_t num_stages;
+        uint32_t num_gpu_events;
+        double gpu_frame_seconds;                    // Сумма total событий последнего кадра
+        Stage stages[MAX_STAGES];
+        GpuEvent gpu_events[MAX_GPU_EVENTS];
+    };
+
+    /// Верхние границы корзин гистограммы, секунды (HISTOGRAM_BUCKETS - 1 конечных)
+    static const double BUCKET_BOUNDS[HISTOGRAM_BUCKETS - 1];
+
+    MetricsExporter();
+
+    /**
+     * @brief Деструктор (Stop)
+     */
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    /**
+     * @brief Открыть сокет и запустить поток сервера
+     * @param options Адрес
+     * @return true если успешно
+     */
+    bool Start(const Options& options);
+
+    /**
+     * @brief Остановить сервер (удаляет файл Unix-сокета)
+     */
+    void Stop();
+
+    /**
+     * @brief Опубликовать текущие метрики (один поток-писатель, без блокировок)
+     *
+     * metrics - накопительные агрегаты ProfilingEngine: вызовы, добавившиеся
+     * с прошлой публикации, попадают в счётчики и в гистограмму (со средней
+     * длительностью этих вызовов). После Reset профилировщика - ResetBaseline.
+     *
+     * @param metrics Метрики профилировщика
+     * @param gpu_events События GPU последнего кадра (событие, которого нет в кадре, сохраняет прежние значения)
+     */
+    void Publish(const ProfilingMetrics& metrics, const std::vector<GPUEventMetrics>& gpu_events);
+
+    /**
+     * @brief Забыть прежние агрегаты стадий (после ProfilingEngine::Reset; поток Publish)
+     */
+    void ResetBaseline();
+
+    /**
+     * @brief Согласованная копия последнего опубликованного снимка (любой поток)
+     */
+    void ReadSnapshot(Snapshot* snapshot) const;
+
+    /**
+     * @brief Снимок в текстовом формате Prometheus (version 0.0.4)
+     */
+    static std::string FormatPrometheus(const Snapshot& snapshot);
+
+    bool IsRunning() const { return server_.joinable(); }
+
+private:
+    struct alignas(64) SnapshotBuffer {
+        std::atomic<uint64_t> sequence;   // Нечётный - идёт запись
+        Snapshot data;
+    };
+
+    struct StageHistory {
+        size_t slot;
+        uint64_t last_calls;
+        double last_time_ms;
+    };
+
+    void ServerLoop();
+    void ServeClient(int client_fd, Snapshot* scratch);
+
+    // Состояние писателя (только поток Publish)
+    std::unique_ptr<Snapshot> state_;
+    std::unordered_map<std::string, StageHistory> stage_history_;
+    std::unordered_map<std::string, size_t> gpu_event_slots_;
+
+    // Двойной буфер: читатели берут buffers_[published_ & 1]
+    std::unique_ptr<SnapshotBuffer[]> buffers_;
+    std::atomic<uint64_t> published_;
+
+    // Сервер
+    int listen_fd_;
+    std::string unix_socket_path_;
+    std::atomic<bool> stop_;
+    std::thread server_;
+};
+
+#endif // METRICS_EXPORTER_H
@@ -0,0 +1,190 @@
+#ifndef METRICS_LOG_H
+#define METRICS_LOG_H
+
+#include "profiling_engine.h"
+#include "gpu_profiling.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Бинарный журнал метрик: запись кадров в фоне, отчёты - офлайн
+ *
+ * Формат (little-endian, как на хосте): заголовок файла {magic 'LCHM',
+ * version}, затем записи {type, payload_bytes, payload}. Имена метрик
+ * передаются один раз записью NAME и далее заменяются номером, поэтому
+ * запись кадра - фиксированные 32 байта на метрику и 40 на событие GPU.
+ * SESSION несёт системную информацию и параметры сигнала (действует
+ * последняя). Неизвестные типы записей читатель пропускает.
+ *
+ * JSON/Markdown отчёты строятся из журнала ConvertMetricsLog теми же
+ * функциями, что и синхронные отчёты (SaveReportToJson,
+ * SaveDetailedGPUProfilingToJson/ToMarkdown).
+ */
+
+/**
+ * @brief Метрики одного кадра
+ */
+struct MetricsFrame {
+    uint64_t frame_index;                    // Номер кадра
+    uint64_t timestamp_ns;                   // Время постановки (system_clock, нс от эпохи)
+    std::vector<TimingMetric> timings;       // Агрегаты ProfilingEngine за кадр
+    std::vector<GPUEventMetrics> gpu_events; // События GPU кадра
+
+    MetricsFrame() : frame_index(0), timestamp_ns(0) {}
+};
+
+/**
+ * @brief Контекст сеанса: к чему относятся кадры
+ */
+struct MetricsSession {
+    SystemInfo system_info;
+    std::map<std::string, std::string> signal_params;
+};
+
+/**
+ * @brief Фоновая запись журнала метрик
+ *
+ * Submit* только перемещают данные в ограниченную очередь; кодирование и
+ * запись в файл - в отдельном потоке. При заполненной очереди кадр
+ * отбрасывается (счётчик GetDroppedFrames), поток обработки не ждёт диск.
+ */
+class MetricsLogWriter {
+public:
+    /**
+     * @brief Конструктор
+     * @param queue_capacity Максимум записей в очереди (> 0)
+     */
+    explicit MetricsLogWriter(size_t queue_capacity = 256);
+
+    /**
+     * @brief Деструктор (Close)
+     */
+    ~MetricsLogWriter();
+
+    MetricsLogWriter(const MetricsLogWriter&) = delete;
+    MetricsLogWriter& operator=(const MetricsLogWriter&) = delete;
+
+    /**
+     * @brief Создать файл журнала (перезаписывается) и запустить поток записи
+     * @param filename Путь (директории создаются)
+     * @return true если успешно
+     */
+    bool Open(const std::string& filename);
+
+    /**
+     * @brief Дописать очередь, остановить поток и закрыть файл
+     */
+    void Close();
+
+    /**
+     * @brief Поставить в очередь контекст сеанса
+     * @return false если журнал не открыт или очередь заполнена
+     */
+    bool SubmitSession(MetricsSession session);
+
+    /**
+     * @brief Поставить в очередь кадр (без ожидания)
+     * @return false если журнал не открыт или очередь заполнена (кадр отброшен)
+     */
+    bool SubmitFrame(MetricsFrame frame);
+
+    /**
+     * @brief Кадр из агрегатов профилировщика и событий GPU
+     * @param frame_index Номер кадра
+     * @param metrics Метрики ProfilingEngine за кадр
+     * @param gpu_events События GPU кадра
+     * @return Кадр с текущим временем
+     */
+    static MetricsFrame MakeFrame(uint64_t frame_index,
+                                  const ProfilingMetrics& metrics,
+                                  const std::vector<GPUEventMetrics>& gpu_events);
+
+    bool IsOpen() const { return worker_.joinable(); }
+    uint64_t GetDroppedFrames() const { return dropped_frames_.load(std::memory_order_relaxed); }
+    uint64_t GetWrittenFrames() const { return written_frames_.load(std::memory_order_relaxed); }
+
+private:
+    struct PendingRecord {
+        bool is_session;
+        MetricsFrame frame;
+        MetricsSession session;
+    };
+
+    bool Enqueue(PendingRecord&& record);
+    void WorkerLoop();
+    void WriteRecord(uint32_t type, const std::vector<uint8_t>& payload);
+    uint32_t InternName(const std::string& name);
+    void WriteFrame(const MetricsFrame& frame);
+    void WriteSession(const MetricsSession& session);
+
+    const size_t queue_capacity_;
+    std::deque<PendingRecord> queue_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_;
+    std::thread worker_;
+
+    // Только поток записи
+    std::ofstream file_;
+    std::unordered_map<std::string, uint32_t> name_ids_;
+    bool write_failed_;
+
+    std::atomic<uint64_t> dropped_frames_;
+    std::atomic<uint64_t> written_frames_;
+};
+
+/**
+ * @brief Содержимое журнала
+ */
+struct MetricsLogContents {
+    MetricsSession session;
+    std::vector<MetricsFrame> frames;
+    bool truncated;   // Последняя запись оборвана (журнал не закрыт)
+
+    MetricsLogContents() : truncated(false) {}
+};
+
+/**
+ * @brief Прочитать журнал метрик
+ * @param filename Путь к журналу
+ * @param contents Выход
+ * @return true если успешно (оборванный хвост - не ошибка, см. truncated)
+ */
+bool ReadMetricsLog(const std::string& filename, MetricsLogContents* contents);
+
+/**
+ * @brief Сводка кадров журнала в форматы синхронных отчётов
+ *
+ * Метрики всех кадров сливаются в ProfilingEngine (суммы, min/max); события
+ * GPU усредняются по кадрам по имени (порядок - первое появление),
+ * total_gpu_time_ms - среднее за кадр. Для журнала из одного кадра отчёты
+ * совпадают с синхронными.
+ */
+void SummarizeMetricsLog(const MetricsLogContents& contents,
+                         ProfilingEngine* profiler,
+                         DetailedGPUProfiling* gpu_profiling);
+
+/**
+ * @brief Офлайн-конвертер: журнал -> JSON профилировщика, JSON и Markdown GPU
+ * @param log_filename Путь к журналу
+ * @param profile_json Отчёт ProfilingEngine (SaveReportToJson)
+ * @param gpu_json Детальный GPU отчёт (SaveDetailedGPUProfilingToJson)
+ * @param gpu_markdown Markdown отчёт (SaveDetailedGPUProfilingToMarkdown)
+ * @return true если все отчёты сохранены
+ */
+bool ConvertMetricsLog(const std::string& log_filename,
+                       const std::string& profile_json,
+                       const std::string& gpu_json,
+                       const std::string& gpu_markdown);
+
+#endif // METRICS_LOG_H
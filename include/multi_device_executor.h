@@ -0,0 +1,146 @@
+#ifndef MULTI_DEVICE_EXECUTOR_H
+#define MULTI_DEVICE_EXECUTOR_H
+
+#include "gpu_backend/igpu_backend.h"
+#include "signal_buffer.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Дробная задержка кадра на нескольких устройствах с разбиением по лучам
+ *
+ * Лучи независимы, поэтому кадр делится на непрерывные группы лучей (шарды)
+ * пропорционально измеренной производительности устройств. У каждого устройства
+ * свой backend (context, очередь, буферы) и свой поток хоста: сбор лучей шарда
+ * в staging, H2D, kernel, D2H и раскладка обратно в тот же SignalBuffer идут
+ * на всех устройствах одновременно. Производительность измеряется при Calibrate
+ * и уточняется по времени каждого кадра (скользящее среднее).
+ *
+ * Устройство, не прошедшее калибровку или отказавшее на шарде, исключается
+ * до конца жизни исполнителя; его шард кадра выполняется повторно на
+ * исправных устройствах.
+ *
+ * Без GPU несколько устройств даёт PoCL (POCL_DEVICES="cpu cpu" и
+ * GPUFactory::CreateOpenCLBackends(true)); для отладки подходят и CpuBackend'ы.
+ */
+class MultiDeviceExecutor {
+public:
+    /**
+     * @brief Конструктор
+     * @param backends Инициализированные backend'ы (по одному на устройство)
+     */
+    explicit MultiDeviceExecutor(std::vector<std::unique_ptr<IGPUBackend>> backends);
+
+    /**
+     * @brief Деструктор (освобождает буферы на устройствах)
+     */
+    ~MultiDeviceExecutor();
+
+    MultiDeviceExecutor(const MultiDeviceExecutor&) = delete;
+    MultiDeviceExecutor& operator=(const MultiDeviceExecutor&) = delete;
+
+    /**
+     * @brief Загрузить матрицу Лагранжа на все устройства
+     * @return true если успешно
+     */
+    bool Initialize();
+
+    /**
+     * @brief Измерить производительность устройств (по очереди, без конкуренции)
+     *
+     * Каждое устройство обрабатывает пробный кадр дважды: первый прогон
+     * (автотюнинг, выделение памяти) не учитывается, по второму считается
+     * производительность в отсчётах в секунду (H2D + kernel + D2H).
+     * Отказавшие устройства исключаются из разбиения.
+     *
+     * @param num_samples Отсчётов на луч в пробном кадре
+     * @param probe_beams Лучей в пробном кадре
+     * @return true если все устройства отработали (false - см. GetNumHealthyDevices)
+     */
+    bool Calibrate(size_t num_samples, size_t probe_beams = 8);
+
+    /**
+     * @brief Разбить лучи между устройствами пропорционально производительности
+     *
+     * Метод наибольших остатков: сумма долей равна num_beams. Исключённые
+     * устройства получают 0 лучей (все исключены - все доли 0).
+     *
+     * @param num_beams Количество лучей
+     * @return Число лучей для каждого устройства (лучи шарда i идут подряд за шардом i-1)
+     */
+    std::vector<size_t> PartitionBeams(size_t num_beams) const;
+
+    /**
+     * @brief Выполнить дробную задержку кадра на всех устройствах (in-place)
+     *
+     * При первом вызове без Calibrate калибровка выполняется на кадре этой длины.
+     * Шард отказавшего устройства повторяется на исправных.
+     *
+     * @param buffer Кадр (float хранилище), результат записывается в него же
+     * @param delays Задержки лучей [num_beams]
+     * @return true если все лучи обработаны
+     */
+    bool ExecuteFractionalDelay(SignalBuffer* buffer, const std::vector<float>& delays);
+
+    size_t GetNumDevices() const { return devices_.size(); }
+
+    /**
+     * @brief Устройств, не исключённых после отказа
+     */
+    size_t GetNumHealthyDevices() const;
+
+    bool IsDeviceHealthy(size_t device) const { return devices_[device].healthy; }
+
+    /**
+     * @brief Текущая оценка производительности устройства (отсчётов/с, 0 - не измерена)
+     */
+    double GetThroughput(size_t device) const { return devices_[device].throughput; }
+
+    IGPUBackend* GetBackend(size_t device) const { return devices_[device].backend.get(); }
+
+private:
+    using ComplexType = SignalBuffer::ComplexType;
+
+    /**
+     * @brief Состояние одного устройства
+     */
+    struct DeviceState {
+        std::unique_ptr<IGPUBackend> backend;
+        void* device_buffer;              // Буфер шарда на устройстве
+        size_t device_buffer_size;        // Размер буфера (байты)
+        double throughput;                // Отсчётов в секунду
+        bool healthy;                     // false - устройство отказало и не получает лучей
+        std::vector<ComplexType> staging; // Лучи шарда подряд (для одного H2D/D2H)
+    };
+
+    /**
+     * @brief Обработать шард на устройстве (вызывается из потока устройства)
+     * @param state Устройство
+     * @param buffer Кадр
+     * @param delays Задержки всех лучей
+     * @param beam_begin Первый луч шарда
+     * @param beam_count Лучей в шарде
+     * @param elapsed_seconds Время обработки шарда
+     * @return true если успешно
+     */
+    bool ExecuteShard(DeviceState& state, SignalBuffer* buffer, const float* delays,
+                      size_t beam_begin, size_t beam_count, double* elapsed_seconds);
+
+    /**
+     * @brief Повторить шард на исправных устройствах (по убыванию производительности)
+     * @return true если шард выполнен на одном из них
+     */
+    bool RetryShard(SignalBuffer* buffer, const float* delays, size_t beam_begin, size_t beam_count);
+
+    /**
+     * @brief Буфер на устройстве не меньше size_bytes (переиспользуется между кадрами)
+     */
+    bool EnsureDeviceBuffer(DeviceState& state, size_t size_bytes);
+
+    std::vector<DeviceState> devices_;
+    bool initialized_;
+    bool calibrated_;
+};
+
+#endif // MULTI_DEVICE_EXECUTOR_H
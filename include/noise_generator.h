@@ -0,0 +1,64 @@
+#ifndef NOISE_GENERATOR_H
+#define NOISE_GENERATOR_H
+
+#include "signal_buffer.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Комплексный гауссов шум от счётчикового генератора (Philox4x32-10)
+ *
+ * Отсчёт n потока s (луча) - функция только (seed, s, n): счётчик Philox
+ * {n/2, s}, ключ - seed, четыре 32-битных слова дают два комплексных
+ * отсчёта (Бокс-Мюллер: модуль из первого слова пары, фаза из второго).
+ * Состояния нет, поэтому лучи и блоки отсчётов генерируются параллельно
+ * в любом порядке, а результат при заданном seed побитово не зависит от
+ * числа потоков и разбиения на блоки. Kernel add_gaussian_noise
+ * (kernel_noise.cl) выдаёт те же целые числа; отсчёты совпадают
+ * с CPU до точности log/sin/cos устройства.
+ */
+
+/**
+ * @brief Один вызов Philox4x32-10
+ * @param counter Счётчик [4]
+ * @param key Ключ [2]
+ * @param output Четыре случайных 32-битных слова
+ */
+void Philox4x32(const uint32_t counter[4], const uint32_t key[2], uint32_t output[4]);
+
+/**
+ * @brief Сгенерировать шум для отсчётов [first_sample, first_sample + count) потока
+ *
+ * Каждая компонента (re, im) - N(0, sigma²).
+ *
+ * @param seed Seed генератора
+ * @param stream Номер потока (луча)
+ * @param first_sample Номер первого отсчёта в потоке
+ * @param sigma СКО компоненты
+ * @param output Выход [count]
+ * @param count Количество отсчётов
+ * @param accumulate true - прибавить шум к output, false - записать
+ */
+void GenerateGaussianNoiseCPU(
+    uint64_t seed,
+    uint64_t stream,
+    uint64_t first_sample,
+    float sigma,
+    SignalBuffer::ComplexType* output,
+    size_t count,
+    bool accumulate = false
+);
+
+/**
+ * @brief Прибавить шум ко всем лучам буфера (поток шума = номер луча)
+ *
+ * Работа делится по (луч, тайл отсчётов) в ThreadPool::Instance().
+ *
+ * @param buffer Буфер (float хранилище)
+ * @param seed Seed генератора
+ * @param sigma СКО компоненты
+ * @return true если успешно
+ */
+bool AddGaussianNoiseCPU(SignalBuffer* buffer, uint64_t seed, float sigma);
+
+#endif // NOISE_GENERATOR_H
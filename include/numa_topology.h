@@ -0,0 +1,132 @@
+#ifndef NUMA_TOPOLOGY_H
+#define NUMA_TOPOLOGY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <new>
+
+/**
+ * @brief Размещение лучей SignalBuffer по узлам NUMA
+ *
+ * NONE       - память касается (first touch) поток, выполняющий Resize.
+ * INTERLEAVE - луч b на узле b % num_nodes.
+ * PARTITION  - лучи делятся на num_nodes непрерывных диапазонов.
+ */
+enum class NumaPolicy : uint8_t {
+    NONE = 0,
+    INTERLEAVE = 1,
+    PARTITION = 2
+};
+
+/**
+ * @brief Топология NUMA: узлы и их ядра (из sysfs, без libnuma)
+ *
+ * Читает <root>/online и <root>/node<N>/cpulist. Если sysfs недоступен
+ * (не Linux, контейнер), считается, что есть один узел 0 со всеми ядрами.
+ */
+class NumaTopology {
+public:
+    /**
+     * @brief Топология машины (определяется один раз)
+     */
+    static const NumaTopology& Get();
+
+    /**
+     * @brief Прочитать топологию
+     * @param sysfs_root Директория узлов (по умолчанию /sys/devices/system/node)
+     */
+    static NumaTopology Detect(const std::string& sysfs_root = "/sys/devices/system/node");
+
+    size_t GetNumNodes() const { return node_cpus_.size(); }
+    bool IsNuma() const { return node_cpus_.size() > 1; }
+
+    /**
+     * @brief Ядра узла (порядковый номер узла 0..GetNumNodes()-1)
+     */
+    const std::vector<int>& GetNodeCpus(size_t node) const { return node_cpus_[node]; }
+
+    /**
+     * @brief Узел ядра (-1 если ядро неизвестно)
+     */
+    int NodeOfCpu(int cpu) const;
+
+    /**
+     * @brief Список ядер для count потоков, поровну по узлам
+     *
+     * Ядра берутся по кругу: узел 0, узел 1, ..., затем следующие ядра узлов.
+     * Результат подходит для ThreadPool::Configure(count, cpus). Если ядер
+     * нет ни у одного узла, список пуст (потоки без привязки).
+     */
+    std::vector<int> SpreadCpus(size_t count) const;
+
+    /**
+     * @brief Узел для каждого луча по политике (пусто для NONE или одного узла)
+     */
+    std::vector<int> AssignBeams(size_t num_beams, NumaPolicy policy) const;
+
+    /**
+     * @brief Узел, на котором размещена страница адреса (-1 если неизвестно)
+     *
+     * Для проверки размещения; использует move_pages без перемещения.
+     */
+    int NodeOfAddress(const void* address) const;
+
+    /**
+     * @brief Разобрать список ядер формата sysfs ("0-3,8,10-11")
+     */
+    static std::vector<int> ParseCpuList(const std::string& list);
+
+private:
+    std::vector<int> node_ids_;                 // [узел] -> номер узла в ОС
+    std::vector<std::vector<int>> node_cpus_;   // [узел] -> ядра
+    std::vector<int> cpu_node_;                 // [ядро] -> узел
+};
+
+/**
+ * @brief Аллокатор лучей: большие блоки - свежие страницы через mmap
+ *
+ * malloc повторно отдаёт уже затронутую память (динамический порог mmap),
+ * и тогда first touch не определяет узел. Блоки от PAGE_ALLOCATOR_MIN_BYTES
+ * всегда берутся новыми страницами: узел определяет поток, который первым
+ * записывает данные (SignalBuffer::Resize выполняет это на потоке узла луча).
+ */
+void* AllocatePages(size_t size_bytes);
+void FreePages(void* ptr, size_t size_bytes) noexcept;
+
+constexpr size_t PAGE_ALLOCATOR_MIN_BYTES = 1 << 20;
+
+template <typename T>
+class PageAllocator {
+public:
+    using value_type = T;
+
+    PageAllocator() noexcept = default;
+    template <typename U>
+    PageAllocator(const PageAllocator<U>&) noexcept {}
+
+    T* allocate(size_t count) {
+        const size_t bytes = count * sizeof(T);
+        if (bytes < PAGE_ALLOCATOR_MIN_BYTES) {
+            return static_cast<T*>(::operator new(bytes));
+        }
+        return static_cast<T*>(AllocatePages(bytes));
+    }
+
+    void deallocate(T* ptr, size_t count) noexcept {
+        const size_t bytes = count * sizeof(T);
+        if (bytes < PAGE_ALLOCATOR_MIN_BYTES) {
+            ::operator delete(ptr);
+        } else {
+            FreePages(ptr, bytes);
+        }
+    }
+
+    template <typename U>
+    bool operator==(const PageAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const PageAllocator<U>&) const noexcept { return false; }
+};
+
+#endif // NUMA_TOPOLOGY_H
@@ -4,6 +4,9 @@
 #include "signal_buffer.h"
 #include "filter_bank.h"
 #include "gpu_backend/igpu_backend.h"
+#include "fir_filter.h"
+#include "farrow_resampler.h"
+#include "decimator.h"
 #include "profiling_engine.h"
 #include <memory>
 
@@ -14,6 +17,22 @@
  * 1. H2D Transfer (загрузка данных на GPU)
  * 2. Дробная задержка (формирование матрицы с задержанными сигналами)
  * 3. Опционально: D2H Transfer (вывод с GPU для анализа)
+ * 
+ * Если кадр не помещается в память устройства, ExecuteFull обрабатывает его
+ * чанками: группами лучей, а если не помещается и один луч - окнами отсчётов
+ * с ореолом интерполятора Лагранжа. Чанки чередуются в двух буферах устройства
+ * и потоках backend'а: копирование одного чанка перекрывается с вычислением
+ * другого. Результат при этом всегда возвращается на хост.
+ * 
+ * Либо (ExecuteBeamforming) - с формированием лучей:
+ * 1. H2D Transfer сигналов элементов
+ * 2. Delay-and-sum: задержка и суммирование по элементам без записи матрицы
+ *    задержанных сигналов (в память попадает только направления × отсчёты)
+ * 3. D2H Transfer выходных лучей
+ * 
+ * ExecuteFiltering - потоковый FIR фильтр коэффициентами FilterBank.
+ * ExecuteResampling - потоковая передискретизация (с задержками лучей).
+ * ExecuteDecimation - прореживание на устройстве до D2H (передача в M раз меньше).
  */
 class ProcessingPipeline {
 public:
@@ -38,11 +57,86 @@ public:
     
     /**
      * @brief Выполнить pipeline обработки до формирования матрицы с задержанными сигналами
+     * 
+     * Кадр больше доступной памяти устройства обрабатывается чанками
+     * (результат копируется на хост независимо от copy_to_host).
+     * 
      * @param copy_to_host Опционально скопировать результат с GPU на хост для анализа
      * @return true если успешно
      */
     bool ExecuteFull(bool copy_to_host = false);
     
+    /**
+     * @brief Ограничить память устройства, доступную pipeline
+     * @param limit_bytes Лимит в байтах (0 - по GetDeviceMemorySize() backend'а)
+     */
+    void SetDeviceMemoryLimit(size_t limit_bytes) { device_memory_limit_ = limit_bytes; }
+    
+    /**
+     * @brief Выполнить pipeline с формированием лучей (delay-and-sum)
+     * 
+     * Лучи signal_buffer трактуются как сигналы элементов решётки.
+     * 
+     * @param delays Задержки [num_directions][num_elements] (в отсчётах)
+     * @param weights Комплексные веса [num_directions][num_elements] (nullptr - все 1)
+     * @param num_directions Количество направлений
+     * @param output Выходные лучи [num_directions][num_samples]
+     * @return true если успешно
+     */
+    bool ExecuteBeamforming(
+        const float* delays,
+        const SignalBuffer::ComplexType* weights,
+        size_t num_directions,
+        SignalBuffer* output
+    );
+    
+    /**
+     * @brief FIR фильтрация очередного блока коэффициентами filter_bank (in-place)
+     * 
+     * Лучи signal_buffer - очередной блок потока: история фильтра (последние
+     * L-1 отсчётов каждого луча) хранится на устройстве между вызовами,
+     * поэтому фильтрация блоками совпадает с фильтрацией сигнала целиком.
+     * Смена числа лучей или длины фильтра сбрасывает историю.
+     * 
+     * @param method Метод свёртки (AUTO - по точке пересечения, измеренной backend'ом)
+     * @return true если успешно
+     */
+    bool ExecuteFiltering(FirMethod method = FirMethod::AUTO);
+    
+    /**
+     * @brief Сбросить историю FIR фильтра (следующий блок - начало нового сигнала)
+     */
+    void ResetFilterState();
+    
+    /**
+     * @brief Передискретизация очередного блока (интерполятор Фарроу)
+     * 
+     * Лучи signal_buffer - очередной блок потока на частоте входа; история
+     * лучей хранится на устройстве и обнуляется в начале потока
+     * (resampler->IsStreamStart()). Задержки лучей resampler'а применяются
+     * в том же проходе.
+     * 
+     * @param resampler Настроенный передискретизатор (положение потока сдвигается)
+     * @param output Выходные лучи (переразмечаются под блок)
+     * @return true если успешно
+     */
+    bool ExecuteResampling(FarrowResampler* resampler, SignalBuffer* output);
+    
+    /**
+     * @brief Прореживание очередного блока с фильтрацией (например, после гетеродина)
+     * 
+     * Лучи signal_buffer - очередной блок потока; ФНЧ и понижение частоты
+     * выполняются на устройстве до копирования на хост, поэтому D2H и
+     * хранение результата уменьшаются в decimator->GetFactor() раз.
+     * История фильтра хранится на устройстве и обнуляется в начале потока
+     * (decimator->IsStreamStart()).
+     * 
+     * @param decimator Настроенный прореживатель (положение потока сдвигается)
+     * @param output Выходные лучи (переразмечаются под блок)
+     * @return true если успешно
+     */
+    bool ExecuteDecimation(Decimator* decimator, SignalBuffer* output);
+    
     /**
      * @brief Выполнить пошагово (для отладки)
      * @return true если успешно
@@ -72,6 +166,61 @@ private:
     void* device_buffer_;
     size_t device_buffer_size_;
     
+    // История FIR фильтра на устройстве [num_beams * (num_taps - 1)]
+    void* device_fir_history_;
+    size_t device_fir_history_size_;
+    size_t device_fir_num_taps_;
+    
+    // История передискретизации на устройстве [num_beams * history_size]
+    void* device_resample_history_;
+    size_t device_resample_history_size_;
+    
+    // История прореживателя на устройстве [num_beams * (num_taps - 1)]
+    void* device_decimate_history_;
+    size_t device_decimate_history_size_;
+    
+    // Лимит памяти устройства (0 - по backend'у)
+    size_t device_memory_limit_;
+    
+    /**
+     * @brief Чанк кадра: группа лучей × окно отсчётов с ореолом
+     */
+    struct Chunk {
+        size_t beam_begin;
+        size_t beam_count;
+        size_t output_begin;   // Выходные отсчёты [output_begin, output_end)
+        size_t output_end;
+        size_t input_begin;    // Загружаемые отсчёты (с ореолом) [input_begin, input_end)
+        size_t input_end;
+    };
+    
+    /**
+     * @brief Память устройства, доступная для буферов кадра
+     */
+    size_t GetUsableDeviceMemory() const;
+    
+    /**
+     * @brief Разбить кадр на чанки не больше max_chunk_bytes
+     * 
+     * Сначала группы лучей целиком; если не помещается один луч - окна
+     * отсчётов равной длины с ореолом [n - D_max - 2, n - D_min + 2]
+     * (5 узлов Лагранжа вокруг целой задержки луча).
+     * 
+     * @param delays Задержки лучей (в отсчётах)
+     * @param max_chunk_bytes Наибольший размер чанка
+     * @param chunks Выходной список чанков
+     * @return true если разбиение возможно
+     */
+    bool PlanChunks(const std::vector<float>& delays, size_t max_chunk_bytes,
+                    std::vector<Chunk>* chunks) const;
+    
+    /**
+     * @brief Дробная задержка кадра чанками (двойная буферизация, результат - на хост)
+     * @param delays Задержки лучей (в отсчётах)
+     * @return true если успешно
+     */
+    bool ExecuteFullChunked(const std::vector<float>& delays);
+    
     /**
      * @brief Выделить память на GPU
      * @return true если успешно
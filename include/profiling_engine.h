@@ -104,6 +104,12 @@ public:
      */
     const ProfilingMetrics& GetAllMetrics() const { return metrics_; }
     
+    /**
+     * @brief Добавить уже агрегированную метрику (слияние кадров журнала метрик)
+     * @param metric Метрика: суммы складываются, min/max объединяются
+     */
+    void AccumulateMetric(const TimingMetric& metric);
+    
     /**
      * @brief Сбросить все метрики
      */
@@ -3,6 +3,8 @@
 
 #include "signal_buffer.h"
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 
 /**
  * @brief Метрики сравнения результатов CPU и GPU
@@ -42,5 +44,74 @@ bool CompareResults(
     ComparisonMetrics* metrics
 );
 
+/**
+ * @brief Параметры выборочного сравнения
+ */
+struct SamplingOptions {
+    size_t num_points;             // Точек в выборке (страт)
+    double confidence;             // Доверительная вероятность границ (0, 1)
+    uint64_t seed;                 // Seed выборки (та же выборка при том же seed)
+    
+    SamplingOptions()
+        : num_points(65536),
+          confidence(0.99),
+          seed(0) {}
+};
+
+/**
+ * @brief Результат выборочного сравнения с доверительными границами
+ */
+struct SampledComparisonMetrics {
+    ComparisonMetrics metrics;         // Метрики по точкам выборки (total_points - размер выборки)
+    size_t population;                 // Всего точек в буфере
+    double confidence;                 // Доверительная вероятность границ
+    double error_rate;                 // Доля точек выборки с превышением tolerance
+    double error_rate_upper;           // Верхняя граница доли превышений во всём буфере
+    double errors_upper;               // Верхняя граница числа превышений во всём буфере
+    double avg_diff_upper;             // Верхняя граница средней разницы по модулю
+    double above_max_fraction_upper;   // Верхняя граница доли точек с разницей > max_diff_magnitude
+    
+    SampledComparisonMetrics()
+        : population(0),
+          confidence(0.0),
+          error_rate(0.0),
+          error_rate_upper(0.0),
+          errors_upper(0.0),
+          avg_diff_upper(0.0),
+          above_max_fraction_upper(0.0) {}
+};
+
+/**
+ * @brief Эталонное значение в точке (луч, отсчёт)
+ */
+using ReferenceFunction = std::function<SignalBuffer::ComplexType(size_t beam, size_t sample)>;
+
+/**
+ * @brief Выборочное сравнение: эталон считается только в точках стратифицированной выборки
+ * 
+ * Буфер делится на сетку страт (группы лучей × отрезки отсчётов) примерно
+ * равного размера, в каждой страте - одна случайная точка (Philox от seed
+ * и номера страты). Стратификация с пропорциональным размещением не
+ * увеличивает дисперсию относительно простой случайной выборки, поэтому
+ * границы считаются как для неё:
+ *  - доля превышений tolerance - точная граница Клоппера-Пирсона;
+ *  - средняя разница - нормальное приближение (n велико);
+ *  - доля точек с разницей больше наибольшей в выборке - 1 - (1 - c)^(1/n).
+ * 
+ * @param results Проверяемые результаты (например, GPU)
+ * @param reference Эталон в точке (должен быть потокобезопасным)
+ * @param tolerance Допустимая погрешность
+ * @param options Размер выборки, доверительная вероятность, seed
+ * @param metrics Выходные метрики и границы
+ * @return true если сравнение успешно, false при ошибке
+ */
+bool CompareResultsSampled(
+    const SignalBuffer* results,
+    const ReferenceFunction& reference,
+    float tolerance,
+    const SamplingOptions& options,
+    SampledComparisonMetrics* metrics
+);
+
 #endif // RESULT_COMPARATOR_H
 
@@ -7,6 +7,20 @@
 #include <fstream>
 #include <cstring>
 #include <cstdint>   
+#include "numa_topology.h"
+
+/**
+* @brief Формат хранения отсчётов
+*
+* FLOAT32 - основное хранилище complex<float> (8 байт на отсчёт).
+* INT16_IQ и FP16 - упакованное хранилище (4 байта на отсчёт), I и Q
+* чередуются: [луч][отсчёт][I, Q], каждый луч - отдельный блок (как float лучи).
+*/
+enum class SampleFormat : uint8_t {
+    FLOAT32 = 0,   // complex<float>
+    INT16_IQ = 1,  // int16 I/Q, значение = код * scale (формат АЦП)
+    FP16 = 2       // IEEE 754 half I/Q
+};
 
 /**
 * @brief Класс для управления сигнальными данными (лучами)
@@ -24,7 +38,8 @@
 class SignalBuffer {
 public:
     using ComplexType = std::complex<float>;
-    using BeamType = std::vector<ComplexType>;
+    using BeamType = std::vector<ComplexType, PageAllocator<ComplexType>>;
+    using PackedBeamType = std::vector<uint16_t, PageAllocator<uint16_t>>;
 
     /**
     * @brief Конструктор по умолчанию
@@ -38,6 +53,14 @@ public:
     */
     SignalBuffer(size_t num_beams, size_t num_samples);
 
+    /**
+    * @brief Конструктор с размещением лучей по узлам NUMA
+    * @param num_beams Количество лучей (1-256)
+    * @param num_samples Количество отсчётов на луч (100-1300000)
+    * @param numa_policy Политика размещения (см. SetNumaPolicy)
+    */
+    SignalBuffer(size_t num_beams, size_t num_samples, NumaPolicy numa_policy);
+
     /**
     * @brief Деструктор
     */
@@ -138,12 +161,136 @@ public:
     */
     bool IsValid() const;
 
+    // ---- Размещение по узлам NUMA ----
+
+    /**
+    * @brief Задать политику размещения лучей (действует со следующего Resize)
+    *
+    * Луч выделяется и обнуляется (first touch) потоком ThreadPool на узле
+    * луча, поэтому его страницы оказываются в памяти этого узла. Требует
+    * пула с привязкой потоков к ядрам (NumaTopology::SpreadCpus); на машине
+    * с одним узлом политика ни на что не влияет.
+    * Копия буфера размещается потоком, который её создаёт.
+    */
+    void SetNumaPolicy(NumaPolicy policy) noexcept { numa_policy_ = policy; }
+    NumaPolicy GetNumaPolicy() const noexcept { return numa_policy_; }
+
+    /**
+    * @brief Узлы лучей [num_beams] (пусто - размещение не задано)
+    *
+    * Передаётся в ThreadPool::NumaHint, чтобы луч обрабатывался на своём узле.
+    */
+    const std::vector<int>& GetBeamNodes() const noexcept { return beam_nodes_; }
+
+    /**
+    * @brief Лучи, память которых оказалась не на узле из GetBeamNodes
+    *
+    * Проверяются float и упакованное хранилища луча: первая, средняя и
+    * последняя страницы блоков от
+    * PAGE_ALLOCATOR_MIN_BYTES (меньшие берутся из кучи, и first touch их узел
+    * не определяет). Узел, который ОС не сообщила, не считается ошибкой.
+    */
+    size_t CountMisplacedBeams() const;
+
+    // ---- Упакованное хранилище (int16 IQ / fp16) ----
+
+    /**
+    * @brief Размер одного отсчёта в байтах для формата
+    */
+    static size_t BytesPerSample(SampleFormat format) noexcept {
+        return format == SampleFormat::FLOAT32 ? sizeof(ComplexType) : 2 * sizeof(uint16_t);
+    }
+
+    /**
+    * @brief Упаковать float данные в формат пониженной точности
+    *
+    * Для INT16_IQ код = round(значение / scale), scale = full_scale / 32767,
+    * значения вне диапазона насыщаются. Float данные не изменяются.
+    * Упакованные лучи размещаются по тем же узлам NUMA, что и float лучи;
+    * поиск пика и квантование идут тайлами (луч, отсчёты) в ThreadPool.
+    *
+    * @param format INT16_IQ или FP16
+    * @param full_scale Амплитуда, соответствующая коду 32767 (только INT16_IQ;
+    *                   0 - по пиковому значению буфера)
+    * @return true если успешно
+    */
+    bool Pack(SampleFormat format, float full_scale = 0.0f);
+
+    /**
+    * @brief Распаковать упакованные данные в float хранилище (beams_)
+    * @return true если успешно
+    */
+    bool Unpack();
+
+    /**
+    * @brief Загрузить упакованные данные напрямую (например, int16 IQ от АЦП)
+    * @param format INT16_IQ или FP16
+    * @param data Данные [num_beams][num_samples][I, Q]
+    * @param num_beams Количество лучей
+    * @param num_samples Количество отсчётов на луч
+    * @param scale Масштаб кода INT16_IQ (значение = код * scale)
+    * @return true если успешно
+    */
+    bool LoadPacked(SampleFormat format, const void* data,
+                    size_t num_beams, size_t num_samples, float scale = 1.0f);
+
+    /**
+    * @brief Освободить float хранилище (данные остаются только в упакованном виде)
+    *
+    * Размеры сохраняются; Unpack() снова выделяет float хранилище.
+    */
+    void ReleaseFloatData();
+
+    /**
+    * @brief Освободить упакованное хранилище
+    */
+    void ReleasePacked();
+
+    bool HasPackedData() const noexcept { return !packed_.empty(); }
+    SampleFormat GetPackedFormat() const noexcept { return packed_format_; }
+    float GetPackedScale() const noexcept { return packed_scale_; }
+
+    /**
+    * @brief Указатель на упакованные данные луча (int16_t или half, I/Q чередуются)
+    *
+    * Лучи хранятся раздельно (каждый на своём узле NUMA), поэтому единого
+    * указателя на весь кадр нет: для передачи на устройство лучи собираются
+    * в непрерывный буфер, как и float данные.
+    */
+    uint16_t* GetPackedBeamData(size_t beam_id);
+    const uint16_t* GetPackedBeamData(size_t beam_id) const;
+
+    /**
+    * @brief Размер упакованных данных в байтах
+    */
+    size_t PackedSizeBytes() const noexcept {
+        return packed_.empty() ? 0 : num_beams_ * num_samples_ * 2 * sizeof(uint16_t);
+    }
+
     std::vector<BeamType> beams_; // [beam_id][sample_id]
 
 private:
     size_t num_beams_;
     size_t num_samples_;
 
+    // Упакованные отсчёты: [beam][sample][I, Q] как uint16 (int16 или half)
+    std::vector<PackedBeamType> packed_;
+    SampleFormat packed_format_;
+    float packed_scale_;
+
+    NumaPolicy numa_policy_;
+    std::vector<int> beam_nodes_;   // [beam] -> узел NUMA (пусто - без размещения)
+
+    /**
+    * @brief Выделить и обнулить beams_ (с учётом numa_policy_)
+    */
+    void AllocateBeams();
+
+    /**
+    * @brief Выделить packed_ на узлах лучей (first touch как в AllocateBeams)
+    */
+    void AllocatePacked();
+
     /**
     * @brief Валидация индекса луча
     * @param beam_id Индекс луча
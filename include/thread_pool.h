@@ -0,0 +1,227 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <exception>
+#include <cstdint>
+
+/**
+ * @brief Общий пул потоков с перехватом работы (work stealing) для CPU стадий
+ *
+ * У каждого рабочего потока своя очередь задач: владелец берёт задачи с конца
+ * (LIFO, данные ещё в кэше), остальные потоки забирают с начала (FIFO).
+ * Вызывающий поток участвует в выполнении и при ожидании выполняет любые
+ * задачи пула, поэтому вложенные ParallelFor (например, FFT внутри стадии,
+ * уже распараллеленной по лучам) не создают лишних потоков и не блокируются.
+ *
+ * Все CPU реализации используют ThreadPool::Instance(); количество потоков
+ * и привязка к ядрам задаются один раз через Configure (или переменной
+ * окружения LCH_FARROW_THREADS).
+ *
+ * NUMA: если рабочие потоки привязаны к ядрам, каждый знает свой узел.
+ * Задачи с NumaHint ставятся в очереди потоков узла, владеющего памятью
+ * элемента, а перехват идёт сначала внутри узла и только потом с других узлов.
+ * С NumaHint::node_local задачи попадают в общую очередь узла, которую берут
+ * только его рабочие потоки: так выполняется first touch памяти.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Привязка элементов к узлам NUMA (для размещения задач и счётчиков)
+     */
+    struct NumaHint {
+        const std::vector<int>* item_nodes;  // Узел памяти элемента/строки (SignalBuffer::GetBeamNodes)
+        size_t bytes_per_item;               // Трафик памяти на элемент (в 2D - на отсчёт); 0 - не считать
+        bool node_local;                     // Только потоки узла элемента: без перехвата другими узлами
+                                             // и без вызывающего потока (узел без потоков - как обычно)
+
+        NumaHint() : item_nodes(nullptr), bytes_per_item(0), node_local(false) {}
+    };
+
+    /**
+     * @brief Счётчики трафика узла: байты, обработанные потоками узла
+     */
+    struct NodeTraffic {
+        uint64_t local_bytes = 0;    // Память элемента на том же узле
+        uint64_t remote_bytes = 0;   // Память элемента на другом узле (через межсокетную шину)
+        uint64_t busy_ns = 0;        // Время выполнения задач с трафиком
+
+        double GetBandwidthGBps() const {
+            return busy_ns > 0 ? static_cast<double>(local_bytes + remote_bytes) / busy_ns : 0.0;
+        }
+    };
+
+    /// body(begin, end) - обработать элементы [begin, end)
+    using RangeFunction = std::function<void(size_t begin, size_t end)>;
+    /// body(row, begin, end) - обработать отсчёты [begin, end) строки row (луча)
+    using TileFunction = std::function<void(size_t row, size_t begin, size_t end)>;
+
+    /**
+     * @brief Конструктор
+     * @param num_threads Всего потоков вместе с вызывающим (0 - hardware_concurrency)
+     * @param cpu_affinity Номера ядер для рабочих потоков (пусто - без привязки);
+     *        рабочий поток i привязывается к cpu_affinity[(i + 1) % size].
+     *        cpu_affinity[0] рабочим потокам не достаётся; вызывающий поток
+     *        пул не привязывает (при необходимости это делает сам вызывающий)
+     */
+    explicit ThreadPool(size_t num_threads = 0,
+                        const std::vector<int>& cpu_affinity = std::vector<int>());
+
+    /**
+     * @brief Деструктор (дожидается завершения рабочих потоков)
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Общий пул процесса (создаётся при первом обращении)
+     */
+    static ThreadPool& Instance();
+
+    /**
+     * @brief Пересоздать общий пул с новыми параметрами
+     *
+     * Вызывать до запуска обработки: ссылки, полученные через Instance(),
+     * после вызова недействительны.
+     *
+     * @param num_threads Всего потоков (0 - LCH_FARROW_THREADS или hardware_concurrency)
+     * @param cpu_affinity Номера ядер (см. конструктор)
+     */
+    static void Configure(size_t num_threads,
+                          const std::vector<int>& cpu_affinity = std::vector<int>());
+
+    /**
+     * @brief Количество потоков, выполняющих задачи (рабочие + вызывающий)
+     */
+    size_t GetNumThreads() const { return workers_.size() + 1; }
+
+    /**
+     * @brief Параллельно выполнить body над [0, count) кусками по grain элементов
+     *
+     * Возвращает управление после выполнения всех кусков. Исключение из body
+     * пробрасывается вызывающему (первое из возникших).
+     *
+     * @param count Количество элементов
+     * @param grain Размер куска (0 - около 4 кусков на поток)
+     * @param body Функция обработки диапазона
+     * @param hint Узлы элементов (узел куска - узел его первого элемента)
+     */
+    void ParallelFor(size_t count, size_t grain, const RangeFunction& body,
+                     const NumaHint& hint = NumaHint());
+
+    /**
+     * @brief Параллельный обход (строка, тайл отсчётов): rows × ceil(cols / tile) задач
+     *
+     * @param rows Количество строк (лучей)
+     * @param cols Количество отсчётов в строке
+     * @param tile Отсчётов в тайле (0 - строка целиком)
+     * @param body Функция обработки тайла
+     * @param hint Узлы строк; bytes_per_item - байт на отсчёт
+     */
+    void ParallelFor2D(size_t rows, size_t cols, size_t tile, const TileFunction& body,
+                       const NumaHint& hint = NumaHint());
+
+    /**
+     * @brief Узел NUMA рабочего потока (-1 если поток не привязан к ядру)
+     */
+    int GetWorkerNode(size_t worker) const { return worker_nodes_[worker]; }
+
+    /**
+     * @brief Счётчики трафика по узлам (индекс - узел NumaTopology)
+     */
+    std::vector<NodeTraffic> GetNodeTraffic() const;
+
+    /**
+     * @brief Обнулить счётчики трафика
+     */
+    void ResetNodeTraffic();
+
+private:
+    using TrafficFunction = std::function<uint64_t(size_t begin, size_t end)>;
+
+    struct Job {
+        const RangeFunction* body;
+        const TrafficFunction* traffic;   // nullptr - без учёта трафика
+        std::atomic<size_t> remaining;
+        std::mutex error_mutex;
+        std::exception_ptr error;
+    };
+
+    struct Task {
+        Job* job;
+        size_t begin;
+        size_t end;
+        int node;    // Узел памяти куска (-1 - не задан)
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    struct NodeQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::atomic<size_t> pending{0};
+    };
+
+    struct NodeCounters {
+        std::atomic<uint64_t> local_bytes{0};
+        std::atomic<uint64_t> remote_bytes{0};
+        std::atomic<uint64_t> busy_ns{0};
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;  // По одной на рабочий поток
+    std::vector<std::thread> workers_;
+    std::vector<int> worker_nodes_;                     // [рабочий] -> узел (-1 - не привязан)
+    std::vector<std::vector<size_t>> node_workers_;     // [узел] -> рабочие потоки узла
+    std::vector<std::vector<size_t>> steal_order_;      // [очередь] -> порядок обхода при перехвате
+    std::vector<std::unique_ptr<NodeQueue>> node_queues_; // [узел] -> задачи только для потоков узла
+    std::vector<std::unique_ptr<NodeCounters>> traffic_;
+
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> pending_;      // Задачи в очередях (ещё не взятые)
+    std::atomic<size_t> next_queue_;   // Раздача задач от внешних потоков
+    bool stop_;
+
+    void WorkerLoop(size_t index);
+
+    /**
+     * @brief Общая часть ParallelFor / ParallelFor2D
+     */
+    void Run(size_t count, size_t grain, const RangeFunction& body,
+             const std::vector<int>* item_nodes, const TrafficFunction* traffic, bool node_local);
+
+    /**
+     * @brief Очередь для куска: поток узла памяти по кругу, иначе по кругу среди всех
+     */
+    size_t SelectQueue(int node, size_t home, size_t* round_robin);
+
+    /**
+     * @brief Взять и выполнить одну задачу: своя очередь с конца, очередь узла,
+     *        чужие - с начала
+     * @param home Очередь текущего потока (queues_.size() - внешний поток)
+     * @return true если задача выполнена
+     */
+    bool TryRunTask(size_t home);
+
+    void RunTask(const Task& task);
+
+    /**
+     * @brief Индекс очереди текущего потока в этом пуле (queues_.size() - не рабочий поток)
+     */
+    size_t CurrentQueueIndex() const;
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,107 @@
+#ifndef TILE_DIGEST_H
+#define TILE_DIGEST_H
+
+#include "signal_buffer.h"
+#include "result_comparator.h"
+#include "gpu_backend/igpu_backend.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Дайджесты тайлов: сравнение движков без передачи буферов целиком
+ *
+ * Буфер делится на тайлы (луч × блок из tile_samples отсчётов), у каждого
+ * тайла - 64-битный хэш квантованных значений. Компоненты квантуются к
+ * сетке с шагом quantum (round-to-nearest-even, насыщение до int32, NaN -
+ * отдельное значение); квантованная пара и номер отсчёта в луче
+ * перемешиваются (финализатор SplitMix64) и суммируются по модулю 2^64.
+ * Сумма не зависит от порядка, поэтому на устройстве тайл сворачивается
+ * редукцией work group (kernel tile_digest, kernel_digest.cl), а результат
+ * побитово совпадает с CPU.
+ *
+ * Совпадение дайджестов означает, что у каждого отсчёта тайла обе компоненты
+ * в одной ячейке сетки (разница < quantum). Несовпадение - только повод
+ * забрать тайл и сравнить подробно: значения по разные стороны границы ячейки
+ * дают ложную тревогу, но не пропуск расхождения.
+ *
+ * digests[b * tiles_per_beam + t] - тайл t луча b.
+ */
+
+/**
+ * @brief Тайлов на луч (последний может быть неполным)
+ */
+size_t DigestTilesPerBeam(size_t num_samples, size_t tile_samples);
+
+/**
+ * @brief Дайджест отсчётов [first_sample, first_sample + count) луча
+ * @param data Отсчёты тайла [count] (data[0] - отсчёт first_sample)
+ * @param first_sample Номер первого отсчёта в луче
+ * @param count Количество отсчётов
+ * @param inv_quantum 1 / шаг квантования
+ * @return Хэш тайла
+ */
+uint64_t TileDigest(const SignalBuffer::ComplexType* data, size_t first_sample, size_t count, float inv_quantum);
+
+/**
+ * @brief Дайджесты всех тайлов буфера на CPU
+ * @param buffer Буфер (float хранилище)
+ * @param quantum Шаг квантования (> 0)
+ * @param tile_samples Отсчётов в тайле (> 0)
+ * @param digests Выход [num_beams * tiles_per_beam]
+ * @return true если успешно
+ */
+bool ComputeTileDigestsCPU(
+    const SignalBuffer* buffer,
+    float quantum,
+    size_t tile_samples,
+    std::vector<uint64_t>* digests
+);
+
+/**
+ * @brief Номера несовпадающих тайлов двух наборов дайджестов одинакового размера
+ */
+std::vector<size_t> FindMismatchedTiles(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b);
+
+/**
+ * @brief Результат сравнения по дайджестам
+ */
+struct DigestComparisonReport {
+    ComparisonMetrics metrics;            // Метрики по отсчётам несовпавших тайлов
+    size_t num_tiles;                     // Всего тайлов
+    size_t tile_samples;                  // Отсчётов в тайле
+    std::vector<size_t> mismatched_tiles; // Номера несовпавших тайлов
+    size_t fetched_bytes;                 // Байт прочитано с устройства (тайлы + дайджесты)
+
+    DigestComparisonReport()
+        : num_tiles(0), tile_samples(0), fetched_bytes(0) {}
+};
+
+/**
+ * @brief Сравнить буфер на устройстве с эталоном на хосте по дайджестам тайлов
+ *
+ * Дайджесты считаются на устройстве (ExecuteTileDigests) и на CPU; с
+ * устройства читаются только дайджесты и несовпавшие тайлы
+ * (CopyDeviceToHostRegion), по ним считаются ComparisonMetrics. В остальных
+ * тайлах разница каждой компоненты меньше quantum.
+ *
+ * @param backend Backend устройства
+ * @param device_buffer Лучи на устройстве [num_beams * num_samples]
+ * @param reference Эталон (размеры задают num_beams, num_samples)
+ * @param quantum Шаг квантования (для отсутствия ложных совпадений - не больше tolerance / sqrt(2))
+ * @param tolerance Допустимая погрешность для подсчёта превышений
+ * @param tile_samples Отсчётов в тайле
+ * @param report Выходной отчёт
+ * @return true если успешно (false - ошибка или backend не поддерживает дайджесты)
+ */
+bool CompareWithDeviceByDigests(
+    IGPUBackend* backend,
+    const void* device_buffer,
+    const SignalBuffer& reference,
+    float quantum,
+    float tolerance,
+    size_t tile_samples,
+    DigestComparisonReport* report
+);
+
+#endif // TILE_DIGEST_H
@@ -0,0 +1,67 @@
+/**
+ * @file kernel_decimate.cl
+ * @brief OpenCL kernel прореживания с фильтрацией (полифазная структура)
+ *
+ * Считаются только оставляемые отсчёты: work item выхода j свёртывает окно
+ * расширенного входа, заканчивающееся на позиции first_position + j * factor,
+ * поэтому фильтр не вычисляется для отбрасываемых отсчётов. Вход луча расширен
+ * историей (см. kernel_fir.cl): ext[i] = history[i] при i < L-1, иначе
+ * input[i - (L-1)]. История обновляется kernel'ом fir_update_history.
+ */
+
+/**
+ * @brief output[b][j] = sum_k h[k] * ext_b[first_position + j * factor - k]
+ *
+ * Внутренний цикл разбит без ветвлений на отводы из текущего блока и хвост
+ * истории (только для первых выходов блока). Grid-stride цикл по
+ * num_beams * num_output_samples (параметры от автотюнера).
+ *
+ * @param input Входной блок [num_beams * num_input_samples]
+ * @param history История [num_beams * (num_taps - 1)]
+ * @param coefficients Коэффициенты h[num_taps]
+ * @param output Выходной блок [num_beams * num_output_samples]
+ * @param num_taps Длина фильтра
+ * @param factor Коэффициент прореживания
+ * @param first_position Позиция первого выхода в ext (>= num_taps - 1)
+ * @param num_beams Количество лучей
+ * @param num_input_samples Отсчётов во входном блоке
+ * @param num_output_samples Отсчётов в выходном блоке
+ */
+__kernel void fir_decimate(
+    __global const float2* input,
+    __global const float2* history,
+    __global const float* coefficients,
+    __global float2* output,
+    const uint num_taps,
+    const uint factor,
+    const uint first_position,
+    const uint num_beams,
+    const uint num_input_samples,
+    const uint num_output_samples
+) {
+    const uint total_items = num_beams * num_output_samples;
+    const uint stride = get_global_size(0);
+    const uint history_size = num_taps - 1;
+
+    for (uint global_id = get_global_id(0); global_id < total_items; global_id += stride) {
+        uint beam = global_id / num_output_samples;
+        uint output_id = global_id % num_output_samples;
+
+        // Позиция последнего входного отсчёта окна в input (ext - history_size)
+        uint sample_id = first_position + output_id * factor - history_size;
+
+        __global const float2* x = input + (size_t)beam * num_input_samples;
+        __global const float2* h = history + (size_t)beam * history_size;
+
+        float2 acc = (float2)(0.0f, 0.0f);
+        uint block_taps = min(sample_id + 1, num_taps);
+        for (uint k = 0; k < block_taps; ++k) {
+            acc = mad((float2)(coefficients[k]), x[sample_id - k], acc);
+        }
+        for (uint k = block_taps; k < num_taps; ++k) {
+            acc = mad((float2)(coefficients[k]), h[sample_id + history_size - k], acc);
+        }
+
+        output[global_id] = acc;
+    }
+}
@@ -0,0 +1,84 @@
+/**
+ * @file kernel_digest.cl
+ * @brief OpenCL kernel дайджестов тайлов (сравнение движков без чтения буфера)
+ *
+ * Тот же хэш, что TileDigest (tile_digest.h): компоненты квантуются к сетке
+ * quantum, пара и номер отсчёта перемешиваются финализатором SplitMix64,
+ * дайджест тайла - сумма по модулю 2^64 (не зависит от порядка редукции).
+ */
+
+#define DIGEST_SAMPLE_MULTIPLIER 0x9E3779B97F4A7C15UL
+#define DIGEST_MIX_M1 0xBF58476D1CE4E5B9UL
+#define DIGEST_MIX_M2 0x94D049BB133111EBUL
+
+/**
+ * @brief Компонента -> int32 сетки: NaN - INT_MIN, иначе с насыщением до [-INT_MAX, INT_MAX]
+ */
+inline uint digest_quantize(float value, float inv_quantum) {
+    float scaled = value * inv_quantum;
+    if (isnan(scaled)) {
+        return 0x80000000u;
+    }
+    return as_uint(max(convert_int_sat_rte(scaled), -INT_MAX));
+}
+
+inline ulong digest_mix(float2 value, ulong sample, float inv_quantum) {
+    ulong z = ((ulong)digest_quantize(value.x, inv_quantum) << 32) |
+              (ulong)digest_quantize(value.y, inv_quantum);
+    z ^= sample * DIGEST_SAMPLE_MULTIPLIER;
+    z = (z ^ (z >> 30)) * DIGEST_MIX_M1;
+    z = (z ^ (z >> 27)) * DIGEST_MIX_M2;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Дайджест тайла: work group на тайл (измерение 0), луч - измерение 1
+ *
+ * Work item суммирует отсчёты тайла с шагом get_local_size(0) (чтение
+ * подряд по work group), затем редукция в локальной памяти. Размер work
+ * group - степень 2.
+ *
+ * @param data Лучи [num_beams * num_samples]
+ * @param digests Выход [num_beams * tiles_per_beam]
+ * @param inv_quantum 1 / шаг квантования
+ * @param num_samples Количество отсчётов на луч
+ * @param tile_samples Отсчётов в тайле
+ * @param tiles_per_beam Тайлов на луч
+ * @param partial Локальная память [get_local_size(0)]
+ */
+__kernel void tile_digest(
+    __global const float2* data,
+    __global ulong* digests,
+    const float inv_quantum,
+    const uint num_samples,
+    const uint tile_samples,
+    const uint tiles_per_beam,
+    __local ulong* partial
+) {
+    const uint lid = get_local_id(0);
+    const uint group_size = get_local_size(0);
+    const uint tile = get_group_id(0);
+    const uint beam = get_global_id(1);
+
+    const uint begin = tile * tile_samples;
+    const uint end = min(begin + tile_samples, num_samples);
+    __global const float2* beam_data = data + (size_t)beam * num_samples;
+
+    ulong sum = 0;
+    for (uint sample = begin + lid; sample < end; sample += group_size) {
+        sum += digest_mix(beam_data[sample], (ulong)sample, inv_quantum);
+    }
+    partial[lid] = sum;
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    for (uint stride = group_size / 2; stride > 0; stride >>= 1) {
+        if (lid < stride) {
+            partial[lid] += partial[lid + stride];
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    if (lid == 0) {
+        digests[(size_t)beam * tiles_per_beam + tile] = partial[0];
+    }
+}
@@ -0,0 +1,98 @@
+/**
+ * @file kernel_farrow_resample.cl
+ * @brief OpenCL kernel передискретизации в произвольное отношение (структура Фарроу)
+ *
+ * Тот же полином Лагранжа по 5 узлам, что в матрице 48×5 kernel_fractional_delay.cl,
+ * но дробная позиция μ не квантуется: 5 подфильтров дают коэффициенты c0..c4,
+ * значение - схема Горнера по μ. Вход луча расширен историей (см. kernel_fir.cl):
+ * ext[i] = history[i] при i < history_size, иначе input[i - history_size].
+ * История обновляется kernel'ом fir_update_history.
+ */
+
+/**
+ * @brief Отсчёт расширенного входа луча
+ */
+inline float2 resample_ext_sample(
+    __global const float2* input,
+    __global const float2* history,
+    const int index,
+    const uint history_size
+) {
+    return index < (int)history_size ? history[index] : input[index - (int)history_size];
+}
+
+/**
+ * @brief Передискретизация: output[b][j] = ext_b(start_position + j * step - delays[b])
+ *
+ * Позиция считается без double: j * step_hi раскладывается в точное
+ * произведение (prod + err через fma), step_lo = step - step_hi добавляется
+ * отдельно, поэтому целая и дробная части остаются точными на длинных блоках.
+ * Grid-stride цикл по num_beams * num_output_samples.
+ *
+ * @param input Входной блок [num_beams * num_input_samples]
+ * @param history История [num_beams * history_size]
+ * @param delays Задержки лучей [num_beams] (отсчёты входа)
+ * @param output Выходной блок [num_beams * num_output_samples]
+ * @param history_size Длина истории луча
+ * @param num_beams Количество лучей
+ * @param num_input_samples Отсчётов во входном блоке
+ * @param num_output_samples Отсчётов в выходном блоке
+ * @param start_position Позиция первого выходного отсчёта в ext
+ * @param step_hi Шаг по входу (старшая часть, float)
+ * @param step_lo Остаток шага step - step_hi
+ */
+__kernel void farrow_resample(
+    __global const float2* input,
+    __global const float2* history,
+    __global const float* delays,
+    __global float2* output,
+    const uint history_size,
+    const uint num_beams,
+    const uint num_input_samples,
+    const uint num_output_samples,
+    const float start_position,
+    const float step_hi,
+    const float step_lo
+) {
+    const uint total_items = num_beams * num_output_samples;
+    const uint stride = get_global_size(0);
+
+    for (uint global_id = get_global_id(0); global_id < total_items; global_id += stride) {
+        uint beam = global_id / num_output_samples;
+        float j = (float)(global_id % num_output_samples);
+
+        // Позиция = prod + small, prod - большое точное произведение
+        float prod = j * step_hi;
+        float err = fma(j, step_hi, -prod);
+        float small = err + j * step_lo + (start_position - delays[beam]);
+        float prod_base = floor(prod);
+        float frac = (prod - prod_base) + small;
+        float frac_base = floor(frac);
+        int base = (int)prod_base + (int)frac_base;
+        float mu = frac - frac_base;
+
+        __global const float2* x_in = input + (size_t)beam * num_input_samples;
+        __global const float2* x_hist = history + (size_t)beam * history_size;
+        float2 xm2 = resample_ext_sample(x_in, x_hist, base - 2, history_size);
+        float2 xm1 = resample_ext_sample(x_in, x_hist, base - 1, history_size);
+        float2 x0 = resample_ext_sample(x_in, x_hist, base, history_size);
+        float2 xp1 = resample_ext_sample(x_in, x_hist, base + 1, history_size);
+        float2 xp2 = resample_ext_sample(x_in, x_hist, base + 2, history_size);
+
+        // Подфильтры Фарроу (коэффициенты полиномов Лагранжа при степенях μ)
+        float2 outer = xm2 + xp2;
+        float2 inner = xm1 + xp1;
+        float2 outer_diff = xm2 - xp2;
+        float2 inner_diff = xp1 - xm1;
+
+        float2 c1 = (outer_diff + 8.0f * inner_diff) * (1.0f / 12.0f);
+        float2 c2 = (16.0f * inner - outer - 30.0f * x0) * (1.0f / 24.0f);
+        float2 c3 = (-outer_diff - 2.0f * inner_diff) * (1.0f / 12.0f);
+        float2 c4 = (outer - 4.0f * inner + 6.0f * x0) * (1.0f / 24.0f);
+
+        float2 acc = mad((float2)(mu), c4, c3);
+        acc = mad((float2)(mu), acc, c2);
+        acc = mad((float2)(mu), acc, c1);
+        output[global_id] = mad((float2)(mu), acc, x0);
+    }
+}
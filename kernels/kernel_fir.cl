@@ -0,0 +1,172 @@
+/**
+ * @file kernel_fir.cl
+ * @brief OpenCL kernels потокового FIR фильтра (прямая форма и overlap-save)
+ *
+ * Блок каждого луча продолжает предыдущий: отсчёты до начала блока берутся
+ * из буфера истории [num_beams * (num_taps - 1)]. Расширенный вход луча
+ * ext[j] = history[j] при j < L-1, иначе input[j - (L-1)].
+ * Overlap-save: сегменты ext собираются в буфер [num_beams * num_segments * fft_size],
+ * над ним на хосте выполняются FFT, умножение на спектр фильтра (hadamard_multiply)
+ * и обратное FFT, затем из каждого сегмента берутся отсчёты после первых L-1.
+ */
+
+/**
+ * @brief Прямая форма: y[n] = sum_k h[k] * ext[n + L-1 - k]
+ *
+ * Внутренний цикл разбит на две части без ветвлений: отсчёты текущего блока
+ * (k <= n) и хвост истории (k > n, только для первых L-1 отсчётов блока).
+ * Соседние work items читают перекрывающиеся окна - повторы обслуживает кэш.
+ * Grid-stride цикл по num_beams * num_samples (параметры от автотюнера).
+ *
+ * @param input Входной блок [num_beams * num_samples]
+ * @param history История [num_beams * (num_taps - 1)]
+ * @param coefficients Коэффициенты h[num_taps]
+ * @param output Выходной блок [num_beams * num_samples]
+ * @param num_taps Длина фильтра
+ * @param num_beams Количество лучей
+ * @param num_samples Отсчётов в блоке
+ */
+__kernel void fir_direct(
+    __global const float2* input,
+    __global const float2* history,
+    __global const float* coefficients,
+    __global float2* output,
+    const uint num_taps,
+    const uint num_beams,
+    const uint num_samples
+) {
+    const uint total_items = num_beams * num_samples;
+    const uint stride = get_global_size(0);
+    const uint history_size = num_taps - 1;
+
+    for (uint global_id = get_global_id(0); global_id < total_items; global_id += stride) {
+        uint beam = global_id / num_samples;
+        uint sample_id = global_id % num_samples;
+
+        __global const float2* x = input + (size_t)beam * num_samples;
+        __global const float2* h = history + (size_t)beam * history_size;
+
+        float2 acc = (float2)(0.0f, 0.0f);
+        uint block_taps = min(sample_id + 1, num_taps);
+        for (uint k = 0; k < block_taps; ++k) {
+            acc = mad((float2)(coefficients[k]), x[sample_id - k], acc);
+        }
+        // k > sample_id: ext индекс sample_id + L-1 - k < L-1 - из истории
+        for (uint k = block_taps; k < num_taps; ++k) {
+            acc = mad((float2)(coefficients[k]), h[sample_id + history_size - k], acc);
+        }
+
+        output[global_id] = acc;
+    }
+}
+
+/**
+ * @brief Новая история: последние L-1 отсчётов расширенного входа
+ *
+ * Пишется в отдельный буфер (старая история ещё читается), затем хост
+ * копирует его в буфер истории.
+ *
+ * @param input Входной блок [num_beams * num_samples]
+ * @param history Текущая история [num_beams * history_size]
+ * @param new_history Новая история [num_beams * history_size]
+ * @param history_size L-1
+ * @param num_beams Количество лучей
+ * @param num_samples Отсчётов в блоке
+ */
+__kernel void fir_update_history(
+    __global const float2* input,
+    __global const float2* history,
+    __global float2* new_history,
+    const uint history_size,
+    const uint num_beams,
+    const uint num_samples
+) {
+    const uint total_items = num_beams * history_size;
+    const uint stride = get_global_size(0);
+
+    for (uint global_id = get_global_id(0); global_id < total_items; global_id += stride) {
+        uint beam = global_id / history_size;
+        uint ext_index = num_samples + global_id % history_size;
+
+        new_history[global_id] = ext_index < history_size
+            ? history[(size_t)beam * history_size + ext_index]
+            : input[(size_t)beam * num_samples + (ext_index - history_size)];
+    }
+}
+
+/**
+ * @brief Overlap-save: собрать сегменты расширенного входа
+ *
+ * Сегмент s луча - ext[s * step .. s * step + fft_size), за концом блока нули.
+ *
+ * @param input Входной блок [num_beams * num_samples]
+ * @param history История [num_beams * history_size]
+ * @param segments Сегменты [num_beams * num_segments * fft_size]
+ * @param history_size L-1
+ * @param num_beams Количество лучей
+ * @param num_samples Отсчётов в блоке
+ * @param fft_size Размер сегмента M
+ * @param num_segments Сегментов на луч
+ */
+__kernel void fir_os_gather(
+    __global const float2* input,
+    __global const float2* history,
+    __global float2* segments,
+    const uint history_size,
+    const uint num_beams,
+    const uint num_samples,
+    const uint fft_size,
+    const uint num_segments
+) {
+    const uint step = fft_size - history_size;
+    const uint total_items = num_beams * num_segments * fft_size;
+    const uint stride = get_global_size(0);
+
+    for (uint global_id = get_global_id(0); global_id < total_items; global_id += stride) {
+        uint beam = global_id / (num_segments * fft_size);
+        uint segment = (global_id / fft_size) % num_segments;
+        uint ext_index = segment * step + global_id % fft_size;
+
+        float2 value = (float2)(0.0f, 0.0f);
+        if (ext_index < history_size) {
+            value = history[(size_t)beam * history_size + ext_index];
+        } else if (ext_index - history_size < num_samples) {
+            value = input[(size_t)beam * num_samples + (ext_index - history_size)];
+        }
+        segments[global_id] = value;
+    }
+}
+
+/**
+ * @brief Overlap-save: выходные отсчёты из сегментов после обратного FFT
+ *
+ * @param segments Сегменты [num_beams * num_segments * fft_size]
+ * @param output Выходной блок [num_beams * num_samples]
+ * @param history_size L-1 (отбрасываемые отсчёты сегмента)
+ * @param num_beams Количество лучей
+ * @param num_samples Отсчётов в блоке
+ * @param fft_size Размер сегмента M
+ * @param num_segments Сегментов на луч
+ */
+__kernel void fir_os_scatter(
+    __global const float2* segments,
+    __global float2* output,
+    const uint history_size,
+    const uint num_beams,
+    const uint num_samples,
+    const uint fft_size,
+    const uint num_segments
+) {
+    const uint step = fft_size - history_size;
+    const uint total_items = num_beams * num_samples;
+    const uint stride = get_global_size(0);
+
+    for (uint global_id = get_global_id(0); global_id < total_items; global_id += stride) {
+        uint beam = global_id / num_samples;
+        uint sample_id = global_id % num_samples;
+        uint segment = sample_id / step;
+
+        output[global_id] = segments[((size_t)beam * num_segments + segment) * fft_size
+                                     + history_size + sample_id % step];
+    }
+}
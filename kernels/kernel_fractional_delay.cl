@@ -4,7 +4,11 @@
  * 
  * Реализует дробную задержку сигнала с использованием полинома Лагранжа 5-го порядка.
  * Использует матрицу коэффициентов 48×5 для точной интерполяции.
- * Каждый work item обрабатывает один отсчёт одного луча.
+ * Ядра обходят выходные отсчёты циклом grid-stride: work item начинает с
+ * get_global_id(0) и шагает на get_global_size(0), пока не покроет все
+ * total_items отсчётов (лучи × отсчёты). Хост запускает сетку, уменьшенную в
+ * items_per_work_item раз (множитель подбирает WorkGroupTuner), поэтому каждый
+ * work item обрабатывает несколько отсчётов.
  * 
  * Оптимизировано для OpenCL C 3.0 (с обратной совместимостью с 1.2)
  */
@@ -17,6 +21,13 @@
     #endif
 #endif
 
+// USE_SUBGROUP_SHUFFLE задаёт хост, если устройство поддерживает
+// cl_khr_subgroups и cl_khr_subgroup_shuffle (только при сборке CL3.0)
+#ifdef USE_SUBGROUP_SHUFFLE
+    #pragma OPENCL EXTENSION cl_khr_subgroups : enable
+    #pragma OPENCL EXTENSION cl_khr_subgroup_shuffle : enable
+#endif
+
 /**
  * @brief Структура параметров задержки для каждого луча
  */
@@ -42,6 +53,114 @@ inline int reflect_boundary(int idx, const uint num_samples) {
     return idx;
 }
 
+/**
+ * @brief Вычислить один задержанный отсчёт (интерполяция Лагранжа, 5 точек)
+ *
+ * @param beam Указатель на начало луча
+ * @param sample_id Индекс выходного отсчёта в луче
+ * @param delay_integer Целая часть задержки
+ * @param coeffs Указатель на строку матрицы Лагранжа [5]
+ * @param num_samples Количество отсчётов на луч
+ * @return Задержанный отсчёт
+ */
+inline float2 lagrange_delay_sample(
+    __global const float2* beam,
+    const uint sample_id,
+    const int delay_integer,
+    __global const float* coeffs,
+    const uint num_samples
+) {
+    // Индекс для интерполяции (с целой частью задержки)
+    // Используем 5 точек: [n-2, n-1, n, n+1, n+2]
+    int interp_idx = (int)sample_id - delay_integer - 2;
+    
+    // Предвычисляем индексы для всех 5 точек
+    int idx0 = reflect_boundary(interp_idx + 0, num_samples);
+    int idx1 = reflect_boundary(interp_idx + 1, num_samples);
+    int idx2 = reflect_boundary(interp_idx + 2, num_samples);
+    int idx3 = reflect_boundary(interp_idx + 3, num_samples);
+    int idx4 = reflect_boundary(interp_idx + 4, num_samples);
+    
+    // Интерполяция с полной развёрткой цикла
+    // Проверяем границы только один раз перед использованием
+    float2 result = (float2)(0.0f, 0.0f);
+    if (idx0 >= 0 && idx0 < (int)num_samples) {
+        result = mad((float2)(coeffs[0]), beam[idx0], result);  // mad для быстрого умножения-сложения
+    }
+    if (idx1 >= 0 && idx1 < (int)num_samples) {
+        result = mad((float2)(coeffs[1]), beam[idx1], result);
+    }
+    if (idx2 >= 0 && idx2 < (int)num_samples) {
+        result = mad((float2)(coeffs[2]), beam[idx2], result);
+    }
+    if (idx3 >= 0 && idx3 < (int)num_samples) {
+        result = mad((float2)(coeffs[3]), beam[idx3], result);
+    }
+    if (idx4 >= 0 && idx4 < (int)num_samples) {
+        result = mad((float2)(coeffs[4]), beam[idx4], result);
+    }
+    return result;
+}
+
+#ifdef USE_SUBGROUP_SHUFFLE
+/**
+ * @brief Отсчёт луча в логической позиции (отражение границ, вне луча - ноль)
+ *
+ * Та же граница, что в lagrange_delay_sample: индекс после отражения
+ * вне [0, num_samples) (задержка больше длины луча) не даёт вклада.
+ */
+inline float2 load_reflected(
+    __global const float2* beam,
+    const int position,
+    const uint num_samples
+) {
+    int idx = reflect_boundary(position, num_samples);
+    return (idx >= 0 && idx < (int)num_samples) ? beam[idx] : (float2)(0.0f, 0.0f);
+}
+
+/**
+ * @brief Отсчёт из регистра другой линии подгруппы
+ *
+ * sub_group_shuffle определён только для скалярных типов.
+ */
+inline float2 shuffle_float2(const float2 value, const uint lane) {
+    return (float2)(sub_group_shuffle(value.x, lane), sub_group_shuffle(value.y, lane));
+}
+
+/**
+ * @brief Задержанный отсчёт линии подгруппы из общих регистров
+ *
+ * Подгруппа из S линий считает S подряд идущих отсчётов одного луча.
+ * Линия l держит отсчёт окна в позиции l (head), линии 0..3 - ещё четыре
+ * отсчёта за окном (tail, позиции S..S+3). Точки интерполяции линии l -
+ * позиции l..l+4 окна, их дают shuffle, а не чтения global памяти:
+ * на выходной отсчёт приходится (S + 4) / S чтений вместо 5.
+ * Вызывается всеми линиями подгруппы (shuffle - коллективная операция).
+ *
+ * @param head Отсчёт окна в позиции линии
+ * @param tail Отсчёт окна в позиции S + линия (линии 0..3)
+ * @param coeffs Указатель на строку матрицы Лагранжа [5]
+ * @return Задержанный отсчёт
+ */
+inline float2 lagrange_delay_sample_subgroup(
+    const float2 head,
+    const float2 tail,
+    __global const float* coeffs
+) {
+    const uint lane = get_sub_group_local_id();
+    const uint sub_group_size = get_sub_group_size();
+    
+    float2 result = (float2)(0.0f, 0.0f);
+    for (uint k = 0; k < 5; ++k) {
+        uint source = lane + k;
+        float2 from_head = shuffle_float2(head, min(source, sub_group_size - 1));
+        float2 from_tail = shuffle_float2(tail, source >= sub_group_size ? source - sub_group_size : 0);
+        result = mad((float2)(coeffs[k]), source < sub_group_size ? from_head : from_tail, result);
+    }
+    return result;
+}
+#endif
+
 /**
  * @brief Выполнить дробную задержку сигнала с интерполяцией Лагранжа
  * 
@@ -50,6 +169,10 @@ inline int reflect_boundary(int idx, const uint num_samples) {
  * - Улучшенная векторизация
  * - Оптимизированная работа с граничными условиями
  * 
+ * Grid-stride цикл: work item обрабатывает отсчёты global_id, global_id + global_size, ...
+ * Количество отсчётов на work item и размер work group подбирает автотюнер на хосте,
+ * grid дополняется до кратного размера work group.
+ * 
  * @param input Буфер входных данных [num_beams * num_samples]
  *              Каждый элемент - complex<float> (float2: x=real, y=imag)
  * @param output Буфер выходных данных [num_beams * num_samples] (in-place)
@@ -66,84 +189,320 @@ __kernel void fractional_delay(
     const uint num_beams,
     const uint num_samples
 ) {
-    // 1D grid: каждый work item обрабатывает один отсчёт одного луча
-    uint global_id = get_global_id(0);
-    uint total_items = num_beams * num_samples;
+    const uint total_items = num_beams * num_samples;
+    const uint stride = get_global_size(0);
+    const int LAGRANGE_COLS = 5;
     
-    // Проверка границ (ранний выход для лучшей производительности)
-    if (global_id >= total_items) {
-        return;
+#ifdef USE_SUBGROUP_SHUFFLE
+    // Число итераций одинаково у всех линий подгруппы: shuffle в однородном потоке управления
+    for (uint global_id = get_global_id(0); sub_group_any(global_id < total_items); global_id += stride) {
+        const uint lane = get_sub_group_local_id();
+        const uint first_id = sub_group_broadcast(global_id, 0);
+        const uint first_beam = first_id / num_samples;
+        const bool active = global_id < total_items;
+        
+        // Быстрый путь: подгруппа целиком в одном луче и отсчёты идут подряд по линиям
+        // (иначе - на границе лучей, в хвосте grid'а - обычное вычисление)
+        if (get_sub_group_size() > 4 &&
+            sub_group_all(active && global_id == first_id + lane && global_id / num_samples == first_beam)) {
+            DelayParams params = delay_params[first_beam];
+            __global const float2* beam = input + first_beam * num_samples;
+            int window_start = (int)(first_id % num_samples) - params.delay_integer - 2;
+            
+            float2 head = load_reflected(beam, window_start + (int)lane, num_samples);
+            float2 tail = (float2)(0.0f, 0.0f);
+            if (lane < 4) {
+                tail = load_reflected(beam, window_start + (int)(get_sub_group_size() + lane), num_samples);
+            }
+            
+            output[global_id] = lagrange_delay_sample_subgroup(
+                head, tail, lagrange_matrix + params.lagrange_row * LAGRANGE_COLS);
+        } else if (active) {
+            uint beam_id = global_id / num_samples;
+            DelayParams params = delay_params[beam_id];
+            output[global_id] = lagrange_delay_sample(
+                input + beam_id * num_samples,
+                global_id % num_samples,
+                params.delay_integer,
+                lagrange_matrix + params.lagrange_row * LAGRANGE_COLS,
+                num_samples);
+        }
     }
-    
-    // Определяем луч и отсчёт
-    uint beam_id = global_id / num_samples;
-    uint sample_id = global_id % num_samples;
-    
-    // Получаем параметры задержки для этого луча
-    DelayParams params = delay_params[beam_id];
-    int delay_integer = params.delay_integer;
-    int lagrange_row = params.lagrange_row;
-    
-    // Индекс для интерполяции (с целой частью задержки)
-    // Используем 5 точек: [n-2, n-1, n, n+1, n+2]
+#else
+    for (uint global_id = get_global_id(0); global_id < total_items; global_id += stride) {
+        // Определяем луч и отсчёт
+        uint beam_id = global_id / num_samples;
+        uint sample_id = global_id % num_samples;
+        
+        // Получаем параметры задержки для этого луча
+        DelayParams params = delay_params[beam_id];
+        
+        // Записать результат (in-place) - используем векторную запись
+        output[global_id] = lagrange_delay_sample(
+            input + beam_id * num_samples,
+            sample_id,
+            params.delay_integer,
+            lagrange_matrix + params.lagrange_row * LAGRANGE_COLS,
+            num_samples);
+    }
+#endif
+}
+
+/**
+ * @brief Индексы 5 точек интерполяции с отражением границ
+ *
+ * @param idx Выходные индексы [5]
+ * @param sample_id Индекс выходного отсчёта в луче
+ * @param delay_integer Целая часть задержки
+ * @param num_samples Количество отсчётов на луч
+ */
+inline void lagrange_tap_indices(
+    int idx[5],
+    const uint sample_id,
+    const int delay_integer,
+    const uint num_samples
+) {
     int interp_idx = (int)sample_id - delay_integer - 2;
+    for (int i = 0; i < 5; ++i) {
+        idx[i] = reflect_boundary(interp_idx + i, num_samples);
+    }
+}
+
+/**
+ * @brief Дробная задержка над упакованными int16 IQ отсчётами
+ *
+ * Отсчёты расширяются до float в регистрах, интерполяция во float,
+ * результат упаковывается обратно в int16 с насыщением до ±32767 и округлением к ближайшему.
+ * Интерполяция линейна, поэтому считаем прямо в единицах кода: масштаб
+ * (значение = код * scale) у входа и выхода один и тот же.
+ * Трафик памяти вдвое меньше, чем у fractional_delay.
+ *
+ * @param input Буфер входных данных [num_beams * num_samples] (short2: x=I, y=Q)
+ * @param output Буфер выходных данных [num_beams * num_samples] (отдельный от input)
+ * @param lagrange_matrix Матрица коэффициентов Лагранжа [48 * 5]
+ * @param delay_params Параметры задержки для каждого луча [num_beams]
+ * @param num_beams Количество лучей
+ * @param num_samples Количество отсчётов на луч
+ */
+__kernel void fractional_delay_int16(
+    __global const short2* input,
+    __global short2* output,
+    __global const float* lagrange_matrix,
+    __global const DelayParams* delay_params,
+    const uint num_beams,
+    const uint num_samples
+) {
+    const uint total_items = num_beams * num_samples;
+    const uint stride = get_global_size(0);
     
-    // Интерполяция Лагранжа (5 точек) - полностью развёрнутый цикл для лучшей производительности
-    float2 result = (float2)(0.0f, 0.0f);
-    const int LAGRANGE_COLS = 5;
-    
-    // Предвычисляем индексы для всех 5 точек
-    int idx0 = reflect_boundary(interp_idx + 0, num_samples);
-    int idx1 = reflect_boundary(interp_idx + 1, num_samples);
-    int idx2 = reflect_boundary(interp_idx + 2, num_samples);
-    int idx3 = reflect_boundary(interp_idx + 3, num_samples);
-    int idx4 = reflect_boundary(interp_idx + 4, num_samples);
-    
-    // Базовый индекс для этого луча
-    uint base_offset = beam_id * num_samples;
-    
-    // Базовый индекс в матрице Лагранжа
-    uint matrix_base = lagrange_row * LAGRANGE_COLS;
-    
-    // Загружаем коэффициенты Лагранжа (лучше для кэша)
-    float coeff0 = lagrange_matrix[matrix_base + 0];
-    float coeff1 = lagrange_matrix[matrix_base + 1];
-    float coeff2 = lagrange_matrix[matrix_base + 2];
-    float coeff3 = lagrange_matrix[matrix_base + 3];
-    float coeff4 = lagrange_matrix[matrix_base + 4];
-    
-    // Интерполяция с полной развёрткой цикла
-    // Проверяем границы только один раз перед использованием
-    if (idx0 >= 0 && idx0 < (int)num_samples) {
-        float2 sample = input[base_offset + idx0];
-        result.x = mad(coeff0, sample.x, result.x);  // Используем mad для быстрого умножения-сложения
-        result.y = mad(coeff0, sample.y, result.y);
+    for (uint global_id = get_global_id(0); global_id < total_items; global_id += stride) {
+        uint beam_id = global_id / num_samples;
+        uint sample_id = global_id % num_samples;
+        DelayParams params = delay_params[beam_id];
+        __global const short2* beam = input + beam_id * num_samples;
+        __global const float* coeffs = lagrange_matrix + params.lagrange_row * 5;
+        
+        int idx[5];
+        lagrange_tap_indices(idx, sample_id, params.delay_integer, num_samples);
+        
+        float2 result = (float2)(0.0f, 0.0f);
+        for (int i = 0; i < 5; ++i) {
+            if (idx[i] >= 0 && idx[i] < (int)num_samples) {
+                result = mad((float2)(coeffs[i]), convert_float2(beam[idx[i]]), result);
+            }
+        }
+        
+        // Симметричный диапазон ±32767, как SignalBuffer::Pack и CPU путь
+        output[global_id] = convert_short2_sat_rte(clamp(result, -32767.0f, 32767.0f));
     }
+}
+
+/**
+ * @brief Дробная задержка над упакованными fp16 IQ отсчётами
+ *
+ * Чтение и запись через vload_half2 / vstore_half2_rte (ядро OpenCL 1.2,
+ * расширение cl_khr_fp16 не требуется), вычисления во float.
+ *
+ * @param input Буфер входных данных [num_beams * num_samples * 2] (half: I, Q)
+ * @param output Буфер выходных данных [num_beams * num_samples * 2] (отдельный от input)
+ * @param lagrange_matrix Матрица коэффициентов Лагранжа [48 * 5]
+ * @param delay_params Параметры задержки для каждого луча [num_beams]
+ * @param num_beams Количество лучей
+ * @param num_samples Количество отсчётов на луч
+ */
+__kernel void fractional_delay_half(
+    __global const half* input,
+    __global half* output,
+    __global const float* lagrange_matrix,
+    __global const DelayParams* delay_params,
+    const uint num_beams,
+    const uint num_samples
+) {
+    const uint total_items = num_beams * num_samples;
+    const uint stride = get_global_size(0);
     
-    if (idx1 >= 0 && idx1 < (int)num_samples) {
-        float2 sample = input[base_offset + idx1];
-        result.x = mad(coeff1, sample.x, result.x);
-        result.y = mad(coeff1, sample.y, result.y);
+    for (uint global_id = get_global_id(0); global_id < total_items; global_id += stride) {
+        uint beam_id = global_id / num_samples;
+        uint sample_id = global_id % num_samples;
+        DelayParams params = delay_params[beam_id];
+        __global const half* beam = input + (size_t)beam_id * num_samples * 2;
+        __global const float* coeffs = lagrange_matrix + params.lagrange_row * 5;
+        
+        int idx[5];
+        lagrange_tap_indices(idx, sample_id, params.delay_integer, num_samples);
+        
+        float2 result = (float2)(0.0f, 0.0f);
+        for (int i = 0; i < 5; ++i) {
+            if (idx[i] >= 0 && idx[i] < (int)num_samples) {
+                result = mad((float2)(coeffs[i]), vload_half2(idx[i], beam), result);
+            }
+        }
+        
+        vstore_half2_rte(result, global_id, output);
     }
+}
+
+/**
+ * @brief Параметры задержки одного набора для одного луча (fan-out)
+ */
+typedef struct {
+    int delay_integer;    // Целая часть задержки
+    int lagrange_row;     // Индекс строки матрицы Лагранжа [0, 47]
+    int set_index;        // Номер набора задержек
+} FanOutEntry;
+
+/**
+ * @brief Группа наборов с близкими целыми задержками для одного луча (fan-out)
+ */
+typedef struct {
+    int beam;
+    int first_entry;
+    int num_entries;
+    int min_delay_integer;
+    int max_delay_integer;
+} FanOutGroup;
+
+/**
+ * @brief Fan-out дробной задержки: K наборов задержек за одно чтение входа
+ *
+ * Work group (измерение 0) обрабатывает тайл из get_local_size(0) отсчётов,
+ * измерение 1 - группа наборов (FanOutGroup). Окно входа (тайл + разброс
+ * целых задержек группы + 4) загружается в локальную память один раз,
+ * после чего каждый work item считает свой отсчёт для всех наборов группы.
+ *
+ * @param input Буфер входных данных [num_beams * num_samples]
+ * @param output Буфер выходных данных [K * num_beams * num_samples]
+ * @param lagrange_matrix Матрица коэффициентов Лагранжа [48 * 5]
+ * @param groups Группы наборов [число групп]
+ * @param entries Параметры наборов, упорядоченные по группам
+ * @param num_beams Количество лучей
+ * @param num_samples Количество отсчётов на луч
+ * @param window Локальная память [get_local_size(0) + max_span + 4]
+ */
+__kernel void fractional_delay_fanout(
+    __global const float2* input,
+    __global float2* output,
+    __global const float* lagrange_matrix,
+    __global const FanOutGroup* groups,
+    __global const FanOutEntry* entries,
+    const uint num_beams,
+    const uint num_samples,
+    __local float2* window
+) {
+    const int lid = (int)get_local_id(0);
+    const int tile_size = (int)get_local_size(0);
+    const int tile_start = (int)get_group_id(0) * tile_size;
+    const FanOutGroup group = groups[get_global_id(1)];
+    __global const float2* beam = input + (size_t)group.beam * num_samples;
     
-    if (idx2 >= 0 && idx2 < (int)num_samples) {
-        float2 sample = input[base_offset + idx2];
-        result.x = mad(coeff2, sample.x, result.x);
-        result.y = mad(coeff2, sample.y, result.y);
+    // Загрузка окна с ореолом, отражение границ разрешается здесь
+    const int window_start = tile_start - group.max_delay_integer - 2;
+    const int window_len = tile_size + group.max_delay_integer - group.min_delay_integer + 4;
+    for (int i = lid; i < window_len; i += tile_size) {
+        int idx = reflect_boundary(window_start + i, num_samples);
+        window[i] = (idx >= 0 && idx < (int)num_samples) ? beam[idx] : (float2)(0.0f, 0.0f);
     }
+    barrier(CLK_LOCAL_MEM_FENCE);
     
-    if (idx3 >= 0 && idx3 < (int)num_samples) {
-        float2 sample = input[base_offset + idx3];
-        result.x = mad(coeff3, sample.x, result.x);
-        result.y = mad(coeff3, sample.y, result.y);
+    const int sample_id = tile_start + lid;
+    if (sample_id >= (int)num_samples) {
+        return;
     }
     
-    if (idx4 >= 0 && idx4 < (int)num_samples) {
-        float2 sample = input[base_offset + idx4];
-        result.x = mad(coeff4, sample.x, result.x);
-        result.y = mad(coeff4, sample.y, result.y);
+    for (int e = 0; e < group.num_entries; ++e) {
+        const FanOutEntry entry = entries[group.first_entry + e];
+        __global const float* coeffs = lagrange_matrix + entry.lagrange_row * 5;
+        __local const float2* taps = window + lid + (group.max_delay_integer - entry.delay_integer);
+        
+        float2 result = (float2)(0.0f, 0.0f);
+        result = mad((float2)(coeffs[0]), taps[0], result);
+        result = mad((float2)(coeffs[1]), taps[1], result);
+        result = mad((float2)(coeffs[2]), taps[2], result);
+        result = mad((float2)(coeffs[3]), taps[3], result);
+        result = mad((float2)(coeffs[4]), taps[4], result);
+        
+        output[((size_t)entry.set_index * num_beams + group.beam) * num_samples + sample_id] = result;
     }
+}
+
+/**
+ * @brief Формирование лучей задержкой и суммированием (delay-and-sum)
+ *
+ * out[d][n] = sum_e w[d][e] * delay(x[e], tau[d][e])[n]
+ * Задержанные сигналы элементов не записываются в глобальную память:
+ * work item накапливает сумму по элементам в регистрах и пишет один отсчёт
+ * выходного луча. Соседние work items читают перекрывающиеся отсчёты,
+ * поэтому повторные чтения входа обслуживаются кэшем.
+ * Grid-stride цикл по num_directions * num_samples (параметры от автотюнера).
+ *
+ * @param input Сигналы элементов [num_elements * num_samples]
+ * @param output Выходные лучи [num_directions * num_samples]
+ * @param lagrange_matrix Матрица коэффициентов Лагранжа [48 * 5]
+ * @param delay_params Параметры задержки [num_directions * num_elements]
+ * @param weights Комплексные веса [num_directions * num_elements] (если use_weights)
+ * @param use_weights 0 - все веса равны 1
+ * @param num_elements Количество элементов решётки
+ * @param num_directions Количество направлений
+ * @param num_samples Количество отсчётов
+ */
+__kernel void delay_and_sum(
+    __global const float2* input,
+    __global float2* output,
+    __global const float* lagrange_matrix,
+    __global const DelayParams* delay_params,
+    __global const float2* weights,
+    const uint use_weights,
+    const uint num_elements,
+    const uint num_directions,
+    const uint num_samples
+) {
+    const uint total_items = num_directions * num_samples;
+    const uint stride = get_global_size(0);
     
-    // Записать результат (in-place) - используем векторную запись
-    output[global_id] = result;
+    for (uint global_id = get_global_id(0); global_id < total_items; global_id += stride) {
+        uint direction = global_id / num_samples;
+        uint sample_id = global_id % num_samples;
+        
+        __global const DelayParams* params = delay_params + direction * num_elements;
+        __global const float2* w = weights + direction * num_elements;
+        
+        float2 acc = (float2)(0.0f, 0.0f);
+        for (uint e = 0; e < num_elements; ++e) {
+            DelayParams p = params[e];
+            float2 v = lagrange_delay_sample(
+                input + (size_t)e * num_samples,
+                sample_id,
+                p.delay_integer,
+                lagrange_matrix + p.lagrange_row * 5,
+                num_samples);
+            if (use_weights) {
+                float2 we = w[e];
+                acc += (float2)(we.x * v.x - we.y * v.y, we.x * v.y + we.y * v.x);
+            } else {
+                acc += v;
+            }
+        }
+        
+        output[global_id] = acc;
+    }
 }
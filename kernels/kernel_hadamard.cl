@@ -22,31 +22,59 @@ __kernel void hadamard_multiply(
     const uint num_beams,
     const uint num_samples
 ) {
-    uint global_id = get_global_id(0);
-    uint total_items = num_beams * num_samples;
+    const uint total_items = num_beams * num_samples;
+    const uint stride = get_global_size(0);
     
-    if (global_id >= total_items) {
-        return;
+    // Grid-stride цикл: количество элементов на work item задаёт автотюнер на хосте
+    for (uint global_id = get_global_id(0); global_id < total_items; global_id += stride) {
+        // Определяем отсчёт (индекс в опорной FFT)
+        uint sample_id = global_id % num_samples;
+        
+        // Получаем значения
+        float2 beam_value = beams[global_id];
+        float2 ref_value = reference_fft[sample_id];
+        
+        // Умножение комплексных чисел: (a+bi) * (c+di) = (ac-bd) + (ad+bc)i
+        float2 result;
+        result.x = beam_value.x * ref_value.x - beam_value.y * ref_value.y;  // real
+        result.y = beam_value.x * ref_value.y + beam_value.y * ref_value.x;  // imag
+        
+        // Записываем результат in-place
+        beams[global_id] = result;
     }
-    
-    // Определяем луч и отсчёт
-    uint beam_id = global_id / num_samples;
-    uint sample_id = global_id % num_samples;
-    
-    // Индексы
-    uint beam_idx = beam_id * num_samples + sample_id;
-    uint ref_idx = sample_id;
-    
-    // Получаем значения
-    float2 beam_value = beams[beam_idx];
-    float2 ref_value = reference_fft[ref_idx];
-    
-    // Умножение комплексных чисел: (a+bi) * (c+di) = (ac-bd) + (ad+bc)i
-    float2 result;
-    result.x = beam_value.x * ref_value.x - beam_value.y * ref_value.y;  // real
-    result.y = beam_value.x * ref_value.y + beam_value.y * ref_value.x;  // imag
-    
-    // Записываем результат in-place
-    beams[beam_idx] = result;
 }
 
+/**
+ * @brief Гетеродинирование: умножение лучей на сопряжённую опору (in-place)
+ * 
+ * beams[b][n] *= conj(reference[b * reference_stride + n]).
+ * reference_stride = 0 - одна опорная строка на все лучи (без копий по лучам),
+ * reference_stride = num_samples - своя опора у каждого луча.
+ * 
+ * @param beams Буфер лучей [num_beams * num_samples] (in-place)
+ * @param reference Опорный сигнал [num_samples] или [num_beams * num_samples]
+ * @param reference_stride Шаг опоры между лучами (0 или num_samples)
+ * @param num_beams Количество лучей
+ * @param num_samples Количество отсчётов на луч
+ */
+__kernel void heterodyne_multiply(
+    __global float2* beams,
+    __global const float2* reference,
+    const uint reference_stride,
+    const uint num_beams,
+    const uint num_samples
+) {
+    const uint total_items = num_beams * num_samples;
+    const uint stride = get_global_size(0);
+    
+    for (uint global_id = get_global_id(0); global_id < total_items; global_id += stride) {
+        uint beam_id = global_id / num_samples;
+        uint sample_id = global_id % num_samples;
+        
+        float2 x = beams[global_id];
+        float2 h = reference[(size_t)beam_id * reference_stride + sample_id];
+        
+        // (a+bi) * (c-di) = (ac+bd) + (bc-ad)i
+        beams[global_id] = (float2)(x.x * h.x + x.y * h.y, x.y * h.x - x.x * h.y);
+    }
+}
@@ -0,0 +1,80 @@
+/**
+ * @file kernel_noise.cl
+ * @brief OpenCL kernel комплексного гауссова шума (Philox4x32-10 + Бокс-Мюллер)
+ *
+ * Тот же генератор, что GenerateGaussianNoiseCPU (noise_generator.h): отсчёт n
+ * луча b берёт слова вызова Philox со счётчиком {n/2, b} и ключом seed,
+ * поэтому шум не зависит от размера grid'а и совпадает с CPU по целым словам.
+ */
+
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+
+/**
+ * @brief Philox4x32-10: 10 раундов над счётчиком с ключом (k0, k1)
+ */
+inline uint4 philox4x32_10(uint4 counter, uint k0, uint k1) {
+    for (int round = 0; round < 10; ++round) {
+        uint hi0 = mul_hi(PHILOX_M0, counter.x);
+        uint lo0 = PHILOX_M0 * counter.x;
+        uint hi1 = mul_hi(PHILOX_M1, counter.z);
+        uint lo1 = PHILOX_M1 * counter.z;
+        counter = (uint4)(hi1 ^ counter.y ^ k0, lo1, hi0 ^ counter.w ^ k1, lo0);
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    return counter;
+}
+
+/**
+ * @brief Пара слов -> комплексный N(0, sigma²) по компонентам (Бокс-Мюллер)
+ */
+inline float2 box_muller(uint w_radius, uint w_angle, float sigma) {
+    const float UNIT_24 = 1.0f / 16777216.0f;
+    float radius = sigma * sqrt(-2.0f * log((float)((w_radius >> 8) + 1) * UNIT_24));
+    float cos_angle;
+    float sin_angle = sincos(2.0f * M_PI_F * (float)(w_angle >> 8) * UNIT_24, &cos_angle);
+    return (float2)(radius * cos_angle, radius * sin_angle);
+}
+
+/**
+ * @brief Прибавить шум к лучам: data[b][n] += noise(seed, b, n)
+ *
+ * Work item обрабатывает пару отсчётов (один вызов Philox). Grid-stride
+ * цикл по num_beams * ceil(num_samples / 2) (параметры от автотюнера).
+ *
+ * @param data Лучи [num_beams * num_samples] (in-place)
+ * @param seed_lo Младшие 32 бита seed
+ * @param seed_hi Старшие 32 бита seed
+ * @param sigma СКО компоненты
+ * @param num_beams Количество лучей
+ * @param num_samples Количество отсчётов на луч
+ */
+__kernel void add_gaussian_noise(
+    __global float2* data,
+    const uint seed_lo,
+    const uint seed_hi,
+    const float sigma,
+    const uint num_beams,
+    const uint num_samples
+) {
+    const uint pairs_per_beam = (num_samples + 1) / 2;
+    const uint total_items = num_beams * pairs_per_beam;
+    const uint stride = get_global_size(0);
+
+    for (uint global_id = get_global_id(0); global_id < total_items; global_id += stride) {
+        uint beam_id = global_id / pairs_per_beam;
+        uint pair_id = global_id % pairs_per_beam;
+
+        uint4 words = philox4x32_10((uint4)(pair_id, 0u, beam_id, 0u), seed_lo, seed_hi);
+
+        __global float2* beam = data + (size_t)beam_id * num_samples;
+        uint sample_id = 2 * pair_id;
+        beam[sample_id] += box_muller(words.x, words.y, sigma);
+        if (sample_id + 1 < num_samples) {
+            beam[sample_id + 1] += box_muller(words.z, words.w, sigma);
+        }
+    }
+}
@@ -5,6 +5,10 @@
 #include <ctime>
 #include <iomanip>
 #include <cstring>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <algorithm>
 
 #include "filter_bank.h"
 #include "lagrange_matrix.h"
@@ -18,16 +22,69 @@
 #include "gpu_backend/opencl_backend.h"
 #include "validator.h"
 #include "reporter.h"
+#include "thread_pool.h"
+#include "numa_topology.h"
+#include "metrics_log.h"
+#include "metrics_exporter.h"
+#include "multi_device_executor.h"
 
 namespace radar {
 
+namespace {
+
+// Шаг backend'а без OpenCL Events (CPU): замер по часам хоста
+bool RunHostTimedStep(DetailedGPUProfiling* gpu_profiling, const std::string& name,
+                      const std::function<bool()>& step) {
+    auto now_ns = []() {
+        return static_cast<cl_ulong>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    };
+    cl_ulong started = now_ns();
+    bool ok = step();
+    cl_ulong ended = now_ns();
+    gpu_profiling->gpu_events.push_back(CalculateEventMetrics(name, started, started, started, ended));
+    return ok;
+}
+
+} // namespace
+
 Application::Application(const Config& cfg)
     : cfg_(cfg),
-      signal_buffer_(cfg_.num_beams, static_cast<size_t>(cfg_.duration * cfg_.sample_rate)),
-      cpu_signal_buffer_(cfg_.num_beams, static_cast<size_t>(cfg_.duration * cfg_.sample_rate)),
-      gpu_signal_buffer_(cfg_.num_beams, static_cast<size_t>(cfg_.duration * cfg_.sample_rate)),
       delay_coeffs_(cfg_.num_beams)
 {
+    // Пул настраивается до выделения буферов: first touch лучей идёт его потоками
+    std::vector<int> cpu_affinity = cfg_.cpu_affinity;
+    if (cfg_.numa_policy != NumaPolicy::NONE && cpu_affinity.empty() && NumaTopology::Get().IsNuma()) {
+        size_t num_threads = cfg_.num_threads > 0 ? cfg_.num_threads
+                                                  : std::max<unsigned>(1, std::thread::hardware_concurrency());
+        cpu_affinity = NumaTopology::Get().SpreadCpus(num_threads);
+    }
+    ThreadPool::Configure(cfg_.num_threads, cpu_affinity);
+
+    const size_t num_samples = static_cast<size_t>(cfg_.duration * cfg_.sample_rate);
+    for (SignalBuffer* buffer : {&signal_buffer_, &cpu_signal_buffer_, &gpu_signal_buffer_}) {
+        buffer->SetNumaPolicy(cfg_.numa_policy);
+        buffer->Resize(cfg_.num_beams, num_samples);
+    }
+
+    if (!cfg_.metrics_log.empty()) {
+        metrics_writer_ = std::make_unique<MetricsLogWriter>();
+        if (!metrics_writer_->Open(cfg_.metrics_log)) {
+            std::cerr << "Журнал метрик недоступен, отчёты будут записаны синхронно\n";
+            metrics_writer_.reset();
+        }
+    }
+
+    if (!cfg_.metrics_socket.empty() || cfg_.metrics_port != 0) {
+        MetricsExporter::Options options;
+        options.unix_socket_path = cfg_.metrics_socket;
+        options.tcp_port = cfg_.metrics_socket.empty() ? cfg_.metrics_port : 0;
+        metrics_exporter_ = std::make_unique<MetricsExporter>();
+        if (!metrics_exporter_->Start(options)) {
+            std::cerr << "Сервер живых метрик не запущен\n";
+            metrics_exporter_.reset();
+        }
+    }
 }
 
 Application::~Application() = default;
@@ -37,11 +94,31 @@ int Application::Run() {
     std::cout << "LCH-Farrow OpenCL Benchmark (OOP)\n";
     std::cout << "========================================\n\n";
 
+    std::cout << "CPU потоков: " << ThreadPool::Instance().GetNumThreads()
+              << ", узлов NUMA: " << NumaTopology::Get().GetNumNodes() << "\n\n";
+
     if (!GenerateSignal()) return 1;
     if (!LoadLagrangeMatrix()) return 1;
-    if (!RunCpuFractionalDelay()) return 1;
-    if (!RunGpuFractionalDelay()) return 1;
-    if (!CompareAndReport()) return 1;
+    if (cfg_.validation_points > 0) {
+        // Эталон только в точках выборки: полный прогон CPU не нужен
+        if (!RunGpuFractionalDelay()) return 1;
+        PublishLiveMetrics();
+        if (!CompareSampledAndReport()) return 1;
+    } else {
+        if (!RunCpuFractionalDelay()) return 1;
+        PublishLiveMetrics();
+        if (!RunGpuFractionalDelay()) return 1;
+        PublishLiveMetrics();
+        if (!CompareAndReport()) return 1;
+    }
+    PublishLiveMetrics();
+
+    if (metrics_writer_) {
+        metrics_writer_->Close();
+        std::cout << "Журнал метрик " << cfg_.metrics_log << ": кадров записано "
+                  << metrics_writer_->GetWrittenFrames() << ", отброшено "
+                  << metrics_writer_->GetDroppedFrames() << "\n";
+    }
 
     std::cout << "Готово!\n";
     return 0;
@@ -61,12 +138,14 @@ bool Application::GenerateSignal() {
 
     size_t num_samples = static_cast<size_t>(cfg_.duration * cfg_.sample_rate);
     for (size_t beam = 0; beam < cfg_.num_beams; ++beam) {
-        auto* beam_data = signal_buffer_.GetBeamData(beam);
-        float delay_samples = beam * 0.125f;
-        lfm_generator.GenerateBeam(beam_data, num_samples,
-                                   radar::LFMVariant::DELAY, delay_samples);
-        delay_coeffs_[beam] = delay_samples;
+        delay_coeffs_[beam] = beam * 0.125f;
     }
+    ThreadPool::Instance().ParallelFor(cfg_.num_beams, 1, [&](size_t begin, size_t end) {
+        for (size_t beam = begin; beam < end; ++beam) {
+            lfm_generator.GenerateBeam(signal_buffer_.GetBeamData(beam), num_samples,
+                                       radar::LFMVariant::DELAY, delay_coeffs_[beam]);
+        }
+    });
 
     printf("✅ ЛЧМ сигнал сгенерирован для %zu лучей\n", cfg_.num_beams);
     printf("   Частота: %.0f - %.0f Гц\n", cfg_.f_start, cfg_.f_stop);
@@ -78,30 +157,15 @@ bool Application::GenerateSignal() {
 
 bool Application::LoadLagrangeMatrix() {
     std::cout << "Загрузка матрицы Лагранжа...\n";
-    LagrangeMatrix lagrange_matrix;
-    std::vector<std::string> possible_paths = {
-        "Doc/Example/lagrange_matrix.json",
-        "../Doc/Example/lagrange_matrix.json",
-        "../../Doc/Example/lagrange_matrix.json",
-        "/home/alex/C++/LCH-Farrow/Doc/Example/lagrange_matrix.json"
-    };
 
-    bool loaded = false;
-    for (const auto& path : possible_paths) {
-        if (lagrange_matrix.LoadFromJson(path)) {
-            std::cout << "Матрица загружена из: " << path << "\n";
-            loaded = true;
-            break;
-        }
-    }
-
-    if (!loaded) {
+    // Одна неизменяемая матрица на процесс: CPU движок получает указатель,
+    // на каждое GPU устройство она загружается один раз
+    lagrange_matrix_ = &LagrangeMatrix::Shared();
+    if (!lagrange_matrix_->IsValid()) {
         std::cerr << "Ошибка: не удалось загрузить матрицу Лагранжа\n";
         return false;
     }
 
-    // Запоминаем матрицу в GPU backend при выполнении GPU шага
-    // Чтобы не держать её тут как член класса, загрузка на GPU выполняется в соответствующем шаге
     return true;
 }
 
@@ -109,35 +173,23 @@ bool Application::RunCpuFractionalDelay() {
     std::cout << "\n=== CPU ВЕРСИЯ (дробная задержка) ===\n";
     size_t num_samples = static_cast<size_t>(cfg_.duration * cfg_.sample_rate);
 
-    // Копия данных для CPU
-    for (size_t beam = 0; beam < cfg_.num_beams; ++beam) {
-        const auto* src = signal_buffer_.GetBeamData(beam);
-        auto* dst = cpu_signal_buffer_.GetBeamData(beam);
-        if (src && dst) {
-            std::memcpy(dst, src, num_samples * sizeof(SignalBuffer::ComplexType));
+    // Копия данных для CPU (луч копируется на узле NUMA своей памяти)
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &cpu_signal_buffer_.GetBeamNodes();
+    ThreadPool::Instance().ParallelFor(cfg_.num_beams, 1, [&](size_t begin, size_t end) {
+        for (size_t beam = begin; beam < end; ++beam) {
+            const auto* src = signal_buffer_.GetBeamData(beam);
+            auto* dst = cpu_signal_buffer_.GetBeamData(beam);
+            if (src && dst) {
+                std::memcpy(dst, src, num_samples * sizeof(SignalBuffer::ComplexType));
+            }
         }
-    }
+    }, hint);
 
+    ThreadPool::Instance().ResetNodeTraffic();
     profiler_.StartTimer("FractionalDelay_CPU");
 
-    LagrangeMatrix lagrange_matrix;
-    // reuse default loading paths from main implementation
-    std::vector<std::string> possible_paths = {
-        "Doc/Example/lagrange_matrix.json",
-        "../Doc/Example/lagrange_matrix.json",
-        "../../Doc/Example/lagrange_matrix.json",
-        "/home/alex/C++/LCH-Farrow/Doc/Example/lagrange_matrix.json"
-    };
-    bool loaded = false;
-    for (const auto& path : possible_paths) {
-        if (lagrange_matrix.LoadFromJson(path)) { loaded = true; break; }
-    }
-    if (!loaded) {
-        std::cerr << "Ошибка: не удалось загрузить матрицу Лагранжа для CPU шага\n";
-        return false;
-    }
-
-    if (!ExecuteFractionalDelayCPU(&cpu_signal_buffer_, &lagrange_matrix,
+    if (!ExecuteFractionalDelayCPU(&cpu_signal_buffer_, lagrange_matrix_,
                                    delay_coeffs_.data(), cfg_.num_beams, num_samples)) {
         std::cerr << "Ошибка при выполнении CPU версии дробной задержки\n";
         return false;
@@ -145,10 +197,30 @@ bool Application::RunCpuFractionalDelay() {
 
     profiler_.StopTimer("FractionalDelay_CPU");
     std::cout << "✅ CPU версия выполнена\n";
+    ReportNodeTraffic("FractionalDelay_CPU");
     return true;
 }
 
+void Application::ReportNodeTraffic(const std::string& stage) {
+    const auto traffic = ThreadPool::Instance().GetNodeTraffic();
+    if (traffic.size() < 2) {
+        return;  // Один узел: локальность не влияет
+    }
+
+    std::cout << "   Трафик по узлам NUMA (" << stage << "):\n";
+    for (size_t node = 0; node < traffic.size(); ++node) {
+        const auto& t = traffic[node];
+        printf("     узел %zu: локально %.1f MB, удалённо %.1f MB, %.2f GB/s\n", node,
+               t.local_bytes / (1024.0 * 1024.0), t.remote_bytes / (1024.0 * 1024.0),
+               t.GetBandwidthGBps());
+    }
+}
+
 bool Application::RunGpuFractionalDelay() {
+    if (cfg_.multi_device) {
+        return RunMultiDeviceFractionalDelay();
+    }
+
     std::cout << "Инициализация GPU backend...\n";
     auto gpu_backend = GPUFactory::CreateBackend();
     if (!gpu_backend) {
@@ -160,30 +232,25 @@ bool Application::RunGpuFractionalDelay() {
     std::cout << "Устройство: " << gpu_backend->GetDeviceName() << "\n";
     std::cout << "Память: " << (gpu_backend->GetDeviceMemorySize() / (1024 * 1024)) << " MB\n\n";
 
-    // Загружаем матрицу Лагранжа на GPU
-    LagrangeMatrix lagrange_matrix;
-    std::vector<std::string> possible_paths = {
-        "Doc/Example/lagrange_matrix.json",
-        "../Doc/Example/lagrange_matrix.json",
-        "../../Doc/Example/lagrange_matrix.json",
-        "/home/alex/C++/LCH-Farrow/Doc/Example/lagrange_matrix.json"
-    };
-    bool loaded = false;
-    for (const auto& path : possible_paths) {
-        if (lagrange_matrix.LoadFromJson(path)) { loaded = true; break; }
-    }
-    if (!loaded) {
-        std::cerr << "Ошибка: не удалось загрузить матрицу Лагранжа для GPU шага\n";
-        return false;
-    }
-
-    if (!gpu_backend->UploadLagrangeMatrix(lagrange_matrix.GetData())) {
+    // Загружаем общую матрицу Лагранжа на GPU (один раз на устройство)
+    if (!gpu_backend->UploadLagrangeMatrix(lagrange_matrix_->GetData())) {
         std::cerr << "Ошибка: не удалось загрузить матрицу Лагранжа на GPU\n";
         return false;
     }
 
     std::cout << "Матрица Лагранжа загружена на GPU\n\n";
 
+    DetailedGPUProfiling gpu_profiling;
+    gpu_profiling.system_info = GetSystemInfo(gpu_backend.get());
+
+    if (cfg_.storage_format != SampleFormat::FLOAT32) {
+        if (!RunGpuFractionalDelayPacked(gpu_backend.get(), &gpu_profiling)) {
+            return false;
+        }
+        SaveGpuProfiling(&gpu_profiling);
+        return true;
+    }
+
     // Подготовка буферов
     size_t num_samples = static_cast<size_t>(cfg_.duration * cfg_.sample_rate);
     size_t buffer_size = cfg_.num_beams * num_samples * sizeof(SignalBuffer::ComplexType);
@@ -206,67 +273,80 @@ bool Application::RunGpuFractionalDelay() {
                     num_samples * sizeof(SignalBuffer::ComplexType));
     }
 
-    DetailedGPUProfiling gpu_profiling;
-    gpu_profiling.system_info = GetSystemInfo(gpu_backend.get());
-
-    cl::Event h2d_event;
     OpenCLBackend* opencl_backend = dynamic_cast<OpenCLBackend*>(gpu_backend.get());
-    if (opencl_backend && opencl_backend->CopyHostToDeviceWithProfiling(
-            gpu_buffer, host_buffer.data(), buffer_size, h2d_event)) {
-        h2d_event.wait();
-        cl_ulong queued, submitted, started, ended;
-        h2d_event.getProfilingInfo(CL_PROFILING_COMMAND_QUEUED, &queued);
-        h2d_event.getProfilingInfo(CL_PROFILING_COMMAND_SUBMIT, &submitted);
-        h2d_event.getProfilingInfo(CL_PROFILING_COMMAND_START, &started);
-        h2d_event.getProfilingInfo(CL_PROFILING_COMMAND_END, &ended);
-        gpu_profiling.gpu_events.push_back(
-            CalculateEventMetrics("H2D_Transfer", queued, submitted, started, ended)
-        );
-    } else {
-        std::cerr << "Ошибка при копировании данных на GPU с профилированием\n";
-        gpu_backend->FreeDeviceMemory(gpu_buffer);
-        return false;
-    }
+    std::vector<SignalBuffer::ComplexType> gpu_result_buffer(cfg_.num_beams * num_samples);
 
-    cl::Event kernel_event;
-    if (opencl_backend && opencl_backend->ExecuteFractionalDelayWithProfiling(
-            gpu_buffer, delay_coeffs_.data(), cfg_.num_beams, num_samples, kernel_event)) {
-        kernel_event.wait();
-        cl_ulong queued, submitted, started, ended;
-        kernel_event.getProfilingInfo(CL_PROFILING_COMMAND_QUEUED, &queued);
-        kernel_event.getProfilingInfo(CL_PROFILING_COMMAND_SUBMIT, &submitted);
-        kernel_event.getProfilingInfo(CL_PROFILING_COMMAND_START, &started);
-        kernel_event.getProfilingInfo(CL_PROFILING_COMMAND_END, &ended);
-        gpu_profiling.gpu_events.push_back(
-            CalculateEventMetrics("FractionalDelay_Kernel", queued, submitted, started, ended)
-        );
+    if (!opencl_backend) {
+        // Backend без OpenCL Events (CPU): шаги замеряются по часам хоста
+        bool ok = RunHostTimedStep(&gpu_profiling, "H2D_Transfer", [&]() {
+                return gpu_backend->CopyHostToDevice(gpu_buffer, host_buffer.data(), buffer_size);
+            }) &&
+            RunHostTimedStep(&gpu_profiling, "FractionalDelay_Kernel", [&]() {
+                return gpu_backend->ExecuteFractionalDelay(
+                    gpu_buffer, delay_coeffs_.data(), cfg_.num_beams, num_samples);
+            }) &&
+            RunHostTimedStep(&gpu_profiling, "D2H_Transfer", [&]() {
+                return gpu_backend->CopyDeviceToHost(gpu_result_buffer.data(), gpu_buffer, buffer_size);
+            });
+        if (!ok) {
+            std::cerr << "Ошибка при выполнении дробной задержки на backend " << gpu_backend->GetBackendName() << "\n";
+            gpu_backend->FreeDeviceMemory(gpu_buffer);
+            return false;
+        }
     } else {
-        std::cerr << "Ошибка при выполнении GPU версии дробной задержки с профилированием\n";
-        gpu_backend->FreeDeviceMemory(gpu_buffer);
-        return false;
-    }
+        cl::Event h2d_event;
+        if (opencl_backend && opencl_backend->CopyHostToDeviceWithProfiling(
+                gpu_buffer, host_buffer.data(), buffer_size, h2d_event)) {
+            h2d_event.wait();
+            cl_ulong queued, submitted, started, ended;
+            h2d_event.getProfilingInfo(CL_PROFILING_COMMAND_QUEUED, &queued);
+            h2d_event.getProfilingInfo(CL_PROFILING_COMMAND_SUBMIT, &submitted);
+            h2d_event.getProfilingInfo(CL_PROFILING_COMMAND_START, &started);
+            h2d_event.getProfilingInfo(CL_PROFILING_COMMAND_END, &ended);
+            gpu_profiling.gpu_events.push_back(
+                CalculateEventMetrics("H2D_Transfer", queued, submitted, started, ended)
+            );
+        } else {
+            std::cerr << "Ошибка при копировании данных на GPU с профилированием\n";
+            gpu_backend->FreeDeviceMemory(gpu_buffer);
+            return false;
+        }
 
-    std::vector<SignalBuffer::ComplexType> gpu_result_buffer(cfg_.num_beams * num_samples);
-    cl::Event d2h_event;
-    if (opencl_backend && opencl_backend->CopyDeviceToHostWithProfiling(
-            gpu_result_buffer.data(), gpu_buffer, buffer_size, d2h_event)) {
-        d2h_event.wait();
-        cl_ulong queued, submitted, started, ended;
-        d2h_event.getProfilingInfo(CL_PROFILING_COMMAND_QUEUED, &queued);
-        d2h_event.getProfilingInfo(CL_PROFILING_COMMAND_SUBMIT, &submitted);
-        d2h_event.getProfilingInfo(CL_PROFILING_COMMAND_START, &started);
-        d2h_event.getProfilingInfo(CL_PROFILING_COMMAND_END, &ended);
-        gpu_profiling.gpu_events.push_back(
-            CalculateEventMetrics("D2H_Transfer", queued, submitted, started, ended)
-        );
-    } else {
-        std::cerr << "Ошибка при копировании результатов с GPU с профилированием\n";
-        gpu_backend->FreeDeviceMemory(gpu_buffer);
-        return false;
-    }
+        cl::Event kernel_event;
+        if (opencl_backend && opencl_backend->ExecuteFractionalDelayWithProfiling(
+                gpu_buffer, delay_coeffs_.data(), cfg_.num_beams, num_samples, kernel_event)) {
+            kernel_event.wait();
+            cl_ulong queued, submitted, started, ended;
+            kernel_event.getProfilingInfo(CL_PROFILING_COMMAND_QUEUED, &queued);
+            kernel_event.getProfilingInfo(CL_PROFILING_COMMAND_SUBMIT, &submitted);
+            kernel_event.getProfilingInfo(CL_PROFILING_COMMAND_START, &started);
+            kernel_event.getProfilingInfo(CL_PROFILING_COMMAND_END, &ended);
+            gpu_profiling.gpu_events.push_back(
+                CalculateEventMetrics("FractionalDelay_Kernel", queued, submitted, started, ended)
+            );
+        } else {
+            std::cerr << "Ошибка при выполнении GPU версии дробной задержки с профилированием\n";
+            gpu_backend->FreeDeviceMemory(gpu_buffer);
+            return false;
+        }
 
-    for (const auto& event : gpu_profiling.gpu_events) {
-        gpu_profiling.total_gpu_time_ms += event.total_time_ms;
+        cl::Event d2h_event;
+        if (opencl_backend && opencl_backend->CopyDeviceToHostWithProfiling(
+                gpu_result_buffer.data(), gpu_buffer, buffer_size, d2h_event)) {
+            d2h_event.wait();
+            cl_ulong queued, submitted, started, ended;
+            d2h_event.getProfilingInfo(CL_PROFILING_COMMAND_QUEUED, &queued);
+            d2h_event.getProfilingInfo(CL_PROFILING_COMMAND_SUBMIT, &submitted);
+            d2h_event.getProfilingInfo(CL_PROFILING_COMMAND_START, &started);
+            d2h_event.getProfilingInfo(CL_PROFILING_COMMAND_END, &ended);
+            gpu_profiling.gpu_events.push_back(
+                CalculateEventMetrics("D2H_Transfer", queued, submitted, started, ended)
+            );
+        } else {
+            std::cerr << "Ошибка при копировании результатов с GPU с профилированием\n";
+            gpu_backend->FreeDeviceMemory(gpu_buffer);
+            return false;
+        }
     }
 
     for (size_t beam = 0; beam < cfg_.num_beams; ++beam) {
@@ -284,6 +364,137 @@ bool Application::RunGpuFractionalDelay() {
     gpu_backend->FreeDeviceMemory(gpu_buffer);
     std::cout << "✅ GPU версия выполнена\n";
 
+    SaveGpuProfiling(&gpu_profiling);
+    return true;
+}
+
+bool Application::RunGpuFractionalDelayPacked(IGPUBackend* gpu_backend, DetailedGPUProfiling* gpu_profiling) {
+    const SampleFormat format = cfg_.storage_format;
+    const size_t num_beams = cfg_.num_beams;
+    const size_t num_samples = static_cast<size_t>(cfg_.duration * cfg_.sample_rate);
+
+    // Упаковка на хосте: на устройство уходит 4 байта на отсчёт вместо 8
+    SignalBuffer packed = signal_buffer_;
+    if (!packed.Pack(format)) {
+        std::cerr << "Ошибка: не удалось упаковать входной сигнал\n";
+        return false;
+    }
+    packed.ReleaseFloatData();
+
+    const size_t buffer_size = packed.PackedSizeBytes();
+    void* device_input = gpu_backend->AllocateDeviceMemory(buffer_size);
+    void* device_output = gpu_backend->AllocateDeviceMemory(buffer_size);
+    if (!device_input || !device_output) {
+        std::cerr << "Ошибка: не удалось выделить память на GPU\n";
+        if (device_input) gpu_backend->FreeDeviceMemory(device_input);
+        if (device_output) gpu_backend->FreeDeviceMemory(device_output);
+        return false;
+    }
+
+    // Лучи хранятся раздельно (по узлам NUMA): собираем непрерывный кадр, как в float пути
+    const size_t beam_values = num_samples * 2;
+    std::vector<uint16_t> host_buffer(num_beams * beam_values);
+    for (size_t beam = 0; beam < num_beams; ++beam) {
+        const uint16_t* beam_data = packed.GetPackedBeamData(beam);
+        if (!beam_data) {
+            std::cerr << "Ошибка: не удалось получить упакованные данные для луча " << beam << "\n";
+            gpu_backend->FreeDeviceMemory(device_input);
+            gpu_backend->FreeDeviceMemory(device_output);
+            return false;
+        }
+        std::memcpy(host_buffer.data() + beam * beam_values, beam_data, beam_values * sizeof(uint16_t));
+    }
+
+    // Упакованный путь замеряется по часам хоста на любом backend'е
+    std::vector<uint16_t> result(buffer_size / sizeof(uint16_t));
+    bool ok = RunHostTimedStep(gpu_profiling, "H2D_Transfer", [&]() {
+            return gpu_backend->CopyHostToDevice(device_input, host_buffer.data(), buffer_size);
+        }) &&
+        RunHostTimedStep(gpu_profiling, "FractionalDelay_Packed_Kernel", [&]() {
+            return gpu_backend->ExecuteFractionalDelayPacked(
+                device_input, device_output, format, delay_coeffs_.data(), num_beams, num_samples);
+        }) &&
+        RunHostTimedStep(gpu_profiling, "D2H_Transfer", [&]() {
+            return gpu_backend->CopyDeviceToHost(result.data(), device_output, buffer_size);
+        });
+
+    gpu_backend->FreeDeviceMemory(device_input);
+    gpu_backend->FreeDeviceMemory(device_output);
+    if (!ok) {
+        std::cerr << "Ошибка при выполнении упакованной дробной задержки на backend "
+                  << gpu_backend->GetBackendName() << "\n";
+        return false;
+    }
+
+    gpu_packed_scale_ = packed.GetPackedScale();
+    if (!gpu_signal_buffer_.LoadPacked(format, result.data(), num_beams, num_samples, gpu_packed_scale_) ||
+        !gpu_signal_buffer_.Unpack()) {
+        std::cerr << "Ошибка: не удалось распаковать результат GPU\n";
+        return false;
+    }
+    gpu_signal_buffer_.ReleasePacked();
+
+    std::cout << "✅ GPU версия выполнена (упакованный формат, "
+              << SignalBuffer::BytesPerSample(format) << " байт на отсчёт)\n";
+    return true;
+}
+
+bool Application::RunMultiDeviceFractionalDelay() {
+    if (cfg_.storage_format != SampleFormat::FLOAT32) {
+        std::cerr << "Ошибка: несколько устройств поддерживают только формат float\n";
+        return false;
+    }
+
+    std::cout << "Инициализация OpenCL устройств...\n";
+    std::vector<std::unique_ptr<IGPUBackend>> backends = GPUFactory::CreateOpenCLBackends(cfg_.multi_device_cpu);
+    if (backends.empty()) {
+        std::cerr << "Ошибка: не найдено ни одного OpenCL устройства (--multi-device)\n";
+        return false;
+    }
+
+    DetailedGPUProfiling gpu_profiling;
+    gpu_profiling.system_info = GetSystemInfo(backends.front().get());
+
+    MultiDeviceExecutor executor(std::move(backends));
+    for (size_t device = 0; device < executor.GetNumDevices(); ++device) {
+        std::cout << "Устройство " << device << ": " << executor.GetBackend(device)->GetDeviceName() << "\n";
+    }
+    if (!executor.Initialize()) {
+        return false;
+    }
+
+    const size_t num_samples = static_cast<size_t>(cfg_.duration * cfg_.sample_rate);
+    if (!executor.Calibrate(num_samples)) {
+        std::cerr << "Предупреждение: часть устройств не прошла калибровку и не получит лучей\n";
+    }
+
+    // Шарды обрабатываются in-place: копия входа становится результатом GPU
+    gpu_signal_buffer_ = signal_buffer_;
+    const std::vector<size_t> counts = executor.PartitionBeams(cfg_.num_beams);
+    if (!RunHostTimedStep(&gpu_profiling, "FractionalDelay_MultiDevice", [&]() {
+            return executor.ExecuteFractionalDelay(&gpu_signal_buffer_, delay_coeffs_);
+        })) {
+        std::cerr << "Ошибка при выполнении дробной задержки на нескольких устройствах\n";
+        return false;
+    }
+
+    for (size_t device = 0; device < executor.GetNumDevices(); ++device) {
+        std::cout << "  " << executor.GetBackend(device)->GetDeviceName() << ": лучей " << counts[device]
+                  << ", " << executor.GetThroughput(device) / 1e6 << " Мотсч/с"
+                  << (executor.IsDeviceHealthy(device) ? "" : " (отказ, шард перераспределён)") << "\n";
+    }
+    std::cout << "✅ GPU версия выполнена (" << executor.GetNumHealthyDevices() << " из "
+              << executor.GetNumDevices() << " устройств)\n";
+
+    SaveGpuProfiling(&gpu_profiling);
+    return true;
+}
+
+void Application::SaveGpuProfiling(DetailedGPUProfiling* gpu_profiling) {
+    for (const auto& event : gpu_profiling->gpu_events) {
+        gpu_profiling->total_gpu_time_ms += event.total_time_ms;
+    }
+
     // Сохраняем расширенное профилирование
     std::time_t now = std::time(nullptr);
     std::tm* timeinfo = std::localtime(&now);
@@ -304,9 +515,15 @@ bool Application::RunGpuFractionalDelay() {
         ss << cfg_.duration << " сек"; signal_params["Длительность"] = ss.str(); ss.str(""); ss.clear();
         ss << cfg_.num_beams; signal_params["Количество лучей"] = ss.str(); ss.str(""); ss.clear();
     }
-    reporter_.SaveDetailedGPU(gpu_profiling, signal_params, extended_json_filename.str(), "Results/rezult_test_gpu.md");
-
-    return true;
+    frame_gpu_events_ = gpu_profiling->gpu_events;
+    if (metrics_writer_) {
+        MetricsSession session;
+        session.system_info = gpu_profiling->system_info;
+        session.signal_params = std::move(signal_params);
+        metrics_writer_->SubmitSession(std::move(session));
+    } else {
+        reporter_.SaveDetailedGPU(*gpu_profiling, signal_params, extended_json_filename.str(), "Results/rezult_test_gpu.md");
+    }
 }
 
 bool Application::CompareAndReport() {
@@ -328,14 +545,146 @@ bool Application::CompareAndReport() {
 
     if (metrics.errors_above_tolerance == 0) {
         std::cout << "✅ Результаты CPU и GPU идентичны (в пределах tolerance)\n";
+    } else if (cfg_.storage_format != SampleFormat::FLOAT32) {
+        std::cout << "ℹ️  GPU считал в упакованном формате: различия с float CPU ожидаемы (см. отчёт ниже)\n";
     } else {
         std::cout << "⚠️  Обнаружены различия между CPU и GPU результатами\n";
     }
 
+    if (!ReportPackedPrecision()) {
+        return false;
+    }
+
     profiler_.ReportMetrics();
+    SaveProfilingReports();
+
+    return true;
+}
+
+bool Application::CompareSampledAndReport() {
+    std::cout << "\n=== ВЫБОРОЧНОЕ СРАВНЕНИЕ (CPU эталон в точках выборки vs GPU) ===\n";
+    SamplingOptions options;
+    options.num_points = cfg_.validation_points;
+    options.confidence = cfg_.validation_confidence;
+    options.seed = cfg_.validation_seed;
+
+    SampledComparisonMetrics sampled;
+    profiler_.StartTimer("Validation_Sampled");
+    if (!validator_.ValidateSampled(signal_buffer_, gpu_signal_buffer_, delay_coeffs_.data(),
+                                    lagrange_matrix_->GetData(), cfg_.tolerance, options, &sampled)) {
+        std::cerr << "Ошибка при выборочном сравнении результатов\n";
+        return false;
+    }
+    profiler_.StopTimer("Validation_Sampled");
+
+    const ComparisonMetrics& metrics = sampled.metrics;
+    std::cout << "Метрики по выборке (" << metrics.total_points << " из " << sampled.population << " точек):\n";
+    std::cout << "  Максимальная разница (модуль): " << metrics.max_diff_magnitude << "\n";
+    std::cout << "  Средняя разница (модуль): " << metrics.avg_diff_magnitude << "\n";
+    std::cout << "  Максимальная относительная ошибка: " << metrics.max_relative_error << "\n";
+    std::cout << "  Точки с превышением tolerance (" << cfg_.tolerance << "): "
+              << metrics.errors_above_tolerance << " / " << metrics.total_points << "\n";
+    std::cout << "Границы для всего кадра (доверительная вероятность " << sampled.confidence << "):\n";
+    std::cout << "  Доля превышений tolerance: <= " << sampled.error_rate_upper
+              << " (<= " << sampled.errors_upper << " точек)\n";
+    std::cout << "  Средняя разница (модуль): <= " << sampled.avg_diff_upper << "\n";
+    std::cout << "  Доля точек с разницей > " << metrics.max_diff_magnitude << ": <= "
+              << sampled.above_max_fraction_upper << "\n";
+
+    if (metrics.errors_above_tolerance == 0) {
+        std::cout << "✅ В выборке нет превышений tolerance\n";
+    } else {
+        std::cout << "⚠️  В выборке есть превышения tolerance\n";
+    }
+
+    if (cfg_.storage_format != SampleFormat::FLOAT32) {
+        std::cout << "GPU считал в упакованном формате: выборка включает погрешность квантования; "
+                  << "отчёт о погрешности упакованного формата пропущен (нужен полный эталон CPU)\n";
+    }
+
+    profiler_.ReportMetrics();
+    SaveProfilingReports();
+
+    return true;
+}
+
+void Application::SaveProfilingReports() {
+    if (metrics_writer_) {
+        // Кадр уходит в очередь журнала; JSON/Markdown строит --convert-metrics-log
+        metrics_writer_->SubmitFrame(MetricsLogWriter::MakeFrame(0, profiler_.GetAllMetrics(), frame_gpu_events_));
+        return;
+    }
     reporter_.SaveProfiling(profiler_, "Results/JSON/profile_report.json");
+}
+
+void Application::PublishLiveMetrics() {
+    if (metrics_exporter_) {
+        metrics_exporter_->Publish(profiler_.GetAllMetrics(), frame_gpu_events_);
+    }
+}
+
+bool Application::ReportPackedPrecision() {
+    if (cfg_.storage_format == SampleFormat::FLOAT32) {
+        return true;
+    }
+
+    const char* format_name = cfg_.storage_format == SampleFormat::INT16_IQ ? "int16 IQ" : "fp16";
+    std::cout << "\n=== ПОГРЕШНОСТЬ УПАКОВАННОГО ФОРМАТА (" << format_name << " vs float) ===\n";
+
+    PackedPrecisionReport report;
+    SignalBuffer cpu_packed_result;
+    profiler_.StartTimer("FractionalDelay_CPU_Packed");
+    if (!EvaluatePackedDelayError(signal_buffer_, cpu_signal_buffer_, lagrange_matrix_,
+                                  delay_coeffs_.data(), cfg_.storage_format,
+                                  cfg_.tolerance, &report, &cpu_packed_result)) {
+        std::cerr << "Ошибка при оценке погрешности упакованного формата\n";
+        return false;
+    }
+    profiler_.StopTimer("FractionalDelay_CPU_Packed");
+
+    std::cout << "  Байт на отсчёт: " << report.bytes_per_sample
+              << " (float: " << SignalBuffer::BytesPerSample(SampleFormat::FLOAT32) << ")\n";
+    if (cfg_.storage_format == SampleFormat::INT16_IQ) {
+        std::cout << "  Масштаб int16: " << report.scale << "\n";
+    }
+    std::cout << "CPU (упакованный) vs CPU (float):\n";
+    PrintPackedPrecision(report);
+
+    PackedPrecisionReport device_report;
+    if (!EvaluatePackedResultError(cpu_signal_buffer_, gpu_signal_buffer_, cfg_.storage_format,
+                                   gpu_packed_scale_, cfg_.tolerance, &device_report)) {
+        std::cerr << "Ошибка при оценке погрешности упакованного результата GPU\n";
+        return false;
+    }
+    std::cout << "GPU (упакованный) vs CPU (float):\n";
+    PrintPackedPrecision(device_report);
+
+    // Оба упакованных пути: одинаковое квантование, расхождение - только в порядке операций ядра
+    ComparisonMetrics device_vs_cpu;
+    if (!validator_.Validate(cpu_packed_result, gpu_signal_buffer_, cfg_.tolerance, &device_vs_cpu)) {
+        std::cerr << "Ошибка при сравнении упакованных результатов CPU и GPU\n";
+        return false;
+    }
+    std::cout << "GPU (упакованный) vs CPU (упакованный):\n";
+    std::cout << "  Максимальная разница (модуль): " << device_vs_cpu.max_diff_magnitude;
+    if (cfg_.storage_format == SampleFormat::INT16_IQ) {
+        std::cout << " (" << std::max(device_vs_cpu.max_diff_real, device_vs_cpu.max_diff_imag) / gpu_packed_scale_
+                  << " кода int16)";
+    }
+    std::cout << "\n";
+    std::cout << "  Точки с превышением tolerance (" << cfg_.tolerance << "): "
+              << device_vs_cpu.errors_above_tolerance << " / " << device_vs_cpu.total_points << "\n";
 
     return true;
 }
 
+void Application::PrintPackedPrecision(const PackedPrecisionReport& report) const {
+    std::cout << "  Максимальная разница (модуль): " << report.metrics.max_diff_magnitude << "\n";
+    std::cout << "  Средняя разница (модуль): " << report.metrics.avg_diff_magnitude << "\n";
+    std::cout << "  Максимальная относительная ошибка: " << report.metrics.max_relative_error << "\n";
+    std::cout << "  SNR относительно float: " << report.snr_db << " дБ\n";
+    std::cout << "  Точки с превышением tolerance (" << cfg_.tolerance << "): "
+              << report.metrics.errors_above_tolerance << " / " << report.metrics.total_points << "\n";
+}
+
 } // namespace radar
@@ -5,10 +5,18 @@
 #include <map>
 #include <vector>
 #include "signal_buffer.h"
+#include "lagrange_matrix.h"
 #include "profiling_engine.h"
 #include "validator.h"
 #include "reporter.h"
 
+class MetricsLogWriter;
+class MetricsExporter;
+class IGPUBackend;
+struct GPUEventMetrics;
+struct DetailedGPUProfiling;
+struct PackedPrecisionReport;
+
 namespace radar {
 
 class Application {
@@ -22,6 +30,26 @@ public:
         float steering_angle = 30.0f;
         float tolerance = 1e-5f;
         size_t count_points =1024*8;  // Новое поле для количества точек в одном луче
+        // Упакованный формат: передача на GPU и ядро в нём, плюс отчёт о погрешности (FLOAT32 - выключено)
+        SampleFormat storage_format = SampleFormat::FLOAT32;
+        // Потоки CPU стадий (0 - LCH_FARROW_THREADS или все ядра) и привязка к ядрам (пусто - без привязки)
+        size_t num_threads = 0;
+        std::vector<int> cpu_affinity;
+        // Размещение лучей по узлам NUMA (не NONE и пустой cpu_affinity - потоки поровну по узлам)
+        NumaPolicy numa_policy = NumaPolicy::NONE;
+        // Выборочная проверка: > 0 - эталон CPU только в стольких точках (полный прогон CPU пропускается)
+        size_t validation_points = 0;
+        double validation_confidence = 0.99;
+        uint64_t validation_seed = 0;      // Seed выборки (та же выборка при том же seed)
+        // Бинарный журнал метрик (пусто - JSON/Markdown отчёты пишутся сразу, в потоке обработки)
+        std::string metrics_log;
+        // Живые метрики Prometheus: Unix-сокет или порт на 127.0.0.1 (пусто и 0 - сервер не запускается)
+        std::string metrics_socket;
+        uint16_t metrics_port = 0;
+        // Лучи кадра делятся между всеми OpenCL устройствами (MultiDeviceExecutor);
+        // multi_device_cpu - включая CPU устройства (PoCL: POCL_DEVICES="cpu cpu")
+        bool multi_device = false;
+        bool multi_device_cpu = false;
 
     bool IsValid() {
         if(count_points > 0) {
@@ -63,16 +91,30 @@ private:
     bool LoadLagrangeMatrix();
     bool RunCpuFractionalDelay();
     bool RunGpuFractionalDelay();
+    bool RunGpuFractionalDelayPacked(IGPUBackend* gpu_backend, DetailedGPUProfiling* gpu_profiling);
+    bool RunMultiDeviceFractionalDelay();
+    void SaveGpuProfiling(DetailedGPUProfiling* gpu_profiling);
     bool CompareAndReport();
+    bool CompareSampledAndReport();
+    bool ReportPackedPrecision();
+    void PrintPackedPrecision(const PackedPrecisionReport& report) const;
+    void ReportNodeTraffic(const std::string& stage);
+    void SaveProfilingReports();
+    void PublishLiveMetrics();
 
     // Вспомогательные структуры, доступные между шагами
     SignalBuffer signal_buffer_;
     SignalBuffer cpu_signal_buffer_;
     SignalBuffer gpu_signal_buffer_;
     std::vector<float> delay_coeffs_;
+    const LagrangeMatrix* lagrange_matrix_ = nullptr;  // Общая матрица процесса (LagrangeMatrix::Shared)
+    float gpu_packed_scale_ = 1.0f;                    // Масштаб int16 упакованного результата GPU
     ProfilingEngine profiler_;
     Validator validator_;
     Reporter reporter_;
+    std::unique_ptr<MetricsLogWriter> metrics_writer_;  // Фоновая запись кадров (cfg_.metrics_log)
+    std::vector<GPUEventMetrics> frame_gpu_events_;     // События GPU текущего кадра для журнала
+    std::unique_ptr<MetricsExporter> metrics_exporter_; // Сервер живых метрик (cfg_.metrics_socket / metrics_port)
 };
 
 } // namespace radar
@@ -0,0 +1,193 @@
+#include "beamformer.h"
+#include "thread_pool.h"
+#include "fractional_delay_cpu.h"
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const int LAGRANGE_COLS = 5;
+const int TILE = 1024;  // Отсчётов в тайле: аккумулятор + окно ~ 24 KB (L1/L2)
+
+/**
+ * @brief Один тайл одного направления: накопление по всем элементам
+ */
+void AccumulateTile(
+    const std::complex<float>* const* elements,
+    size_t num_elements,
+    int n,
+    const float* lagrange_data,
+    const FractionalDelayParams* element_delays,
+    const std::complex<float>* weights,
+    int tile_start,
+    int tile_len,
+    float* acc_re,
+    float* acc_im,
+    float* win_re,
+    float* win_im) {
+
+    std::fill(acc_re, acc_re + tile_len, 0.0f);
+    std::fill(acc_im, acc_im + tile_len, 0.0f);
+
+    for (size_t e = 0; e < num_elements; ++e) {
+        const std::complex<float>* x = elements[e];
+        const FractionalDelayParams& params = element_delays[e];
+        const float* c = lagrange_data + params.lagrange_row * LAGRANGE_COLS;
+
+        // Окно [tile_len + 4] с разрешённым отражением границ
+        const int window_start = tile_start - params.delay_integer - 2;
+        for (int i = 0; i < tile_len + LAGRANGE_COLS - 1; ++i) {
+            int idx = window_start + i;
+            if (idx < 0) {
+                idx = -idx;
+            }
+            if (idx >= n) {
+                idx = 2 * n - idx - 2;
+            }
+            if (idx >= 0 && idx < n) {
+                win_re[i] = x[idx].real();
+                win_im[i] = x[idx].imag();
+            } else {
+                win_re[i] = 0.0f;
+                win_im[i] = 0.0f;
+            }
+        }
+
+        const float w_re = weights ? weights[e].real() : 1.0f;
+        const float w_im = weights ? weights[e].imag() : 0.0f;
+
+        // Плоские float циклы без ветвлений - автовекторизация (SSE/AVX/NEON)
+        for (int i = 0; i < tile_len; ++i) {
+            float d_re = c[0] * win_re[i] + c[1] * win_re[i + 1] + c[2] * win_re[i + 2] +
+                         c[3] * win_re[i + 3] + c[4] * win_re[i + 4];
+            float d_im = c[0] * win_im[i] + c[1] * win_im[i + 1] + c[2] * win_im[i + 2] +
+                         c[3] * win_im[i + 3] + c[4] * win_im[i + 4];
+            acc_re[i] += w_re * d_re - w_im * d_im;
+            acc_im[i] += w_re * d_im + w_im * d_re;
+        }
+    }
+}
+
+/**
+ * @brief Общая часть: входы и выходы заданы указателями на лучи
+ */
+void DelayAndSumCore(
+    const std::complex<float>* const* elements,
+    size_t num_elements,
+    size_t num_samples,
+    const float* lagrange_data,
+    const float* delays,
+    const std::complex<float>* weights,
+    size_t num_directions,
+    std::complex<float>* const* outputs) {
+
+    std::vector<FractionalDelayParams> element_delays(num_directions * num_elements);
+    for (size_t i = 0; i < element_delays.size(); ++i) {
+        element_delays[i] = ComputeDelayParams(delays[i]);
+    }
+
+    const size_t num_tiles = (num_samples + TILE - 1) / TILE;
+    const size_t total_tasks = num_directions * num_tiles;
+
+    // Задачи (направление, тайл) раздаются общим пулом; буферы тайла - на кусок задач
+    ThreadPool::Instance().ParallelFor(total_tasks, 1, [&](size_t begin, size_t end) {
+        std::vector<float> acc_re(TILE), acc_im(TILE);
+        std::vector<float> win_re(TILE + LAGRANGE_COLS), win_im(TILE + LAGRANGE_COLS);
+
+        for (size_t task = begin; task < end; ++task) {
+            const size_t direction = task / num_tiles;
+            const int tile_start = static_cast<int>((task % num_tiles) * TILE);
+            const int tile_len = std::min<int>(TILE, static_cast<int>(num_samples) - tile_start);
+
+            AccumulateTile(
+                elements, num_elements, static_cast<int>(num_samples), lagrange_data,
+                element_delays.data() + direction * num_elements,
+                weights ? weights + direction * num_elements : nullptr,
+                tile_start, tile_len,
+                acc_re.data(), acc_im.data(), win_re.data(), win_im.data());
+
+            std::complex<float>* out = outputs[direction] + tile_start;
+            for (int i = 0; i < tile_len; ++i) {
+                out[i] = std::complex<float>(acc_re[i], acc_im[i]);
+            }
+        }
+    });
+}
+
+} // namespace
+
+bool ExecuteDelayAndSumCPU(
+    const SignalBuffer& elements,
+    const LagrangeMatrix* lagrange_matrix,
+    const float* delays,
+    const std::complex<float>* weights,
+    size_t num_directions,
+    SignalBuffer* output) {
+
+    if (!lagrange_matrix || !delays || !output || num_directions == 0) {
+        std::cerr << "Ошибка: неверные параметры для ExecuteDelayAndSumCPU" << std::endl;
+        return false;
+    }
+
+    if (!lagrange_matrix->IsValid()) {
+        std::cerr << "Ошибка: матрица Лагранжа не валидна" << std::endl;
+        return false;
+    }
+
+    const size_t num_elements = elements.GetNumBeams();
+    const size_t num_samples = elements.GetNumSamples();
+    if (!elements.IsValid()) {
+        std::cerr << "Ошибка: буфер элементов не валиден" << std::endl;
+        return false;
+    }
+
+    if (!output->IsValid() || output->GetNumBeams() != num_directions ||
+        output->GetNumSamples() != num_samples) {
+        output->Resize(num_directions, num_samples);
+    }
+
+    std::vector<const std::complex<float>*> element_ptrs(num_elements);
+    for (size_t e = 0; e < num_elements; ++e) {
+        element_ptrs[e] = elements.GetBeamData(e);
+    }
+    std::vector<std::complex<float>*> output_ptrs(num_directions);
+    for (size_t d = 0; d < num_directions; ++d) {
+        output_ptrs[d] = output->GetBeamData(d);
+    }
+
+    DelayAndSumCore(element_ptrs.data(), num_elements, num_samples, lagrange_matrix->GetData(),
+                    delays, weights, num_directions, output_ptrs.data());
+    return true;
+}
+
+bool ExecuteDelayAndSumCPU(
+    const std::complex<float>* elements,
+    size_t num_elements,
+    size_t num_samples,
+    const float* lagrange_data,
+    const float* delays,
+    const std::complex<float>* weights,
+    size_t num_directions,
+    std::complex<float>* output) {
+
+    if (!elements || !lagrange_data || !delays || !output ||
+        num_elements == 0 || num_samples == 0 || num_directions == 0) {
+        std::cerr << "Ошибка: неверные параметры для ExecuteDelayAndSumCPU" << std::endl;
+        return false;
+    }
+
+    std::vector<const std::complex<float>*> element_ptrs(num_elements);
+    for (size_t e = 0; e < num_elements; ++e) {
+        element_ptrs[e] = elements + e * num_samples;
+    }
+    std::vector<std::complex<float>*> output_ptrs(num_directions);
+    for (size_t d = 0; d < num_directions; ++d) {
+        output_ptrs[d] = output + d * num_samples;
+    }
+
+    DelayAndSumCore(element_ptrs.data(), num_elements, num_samples, lagrange_data,
+                    delays, weights, num_directions, output_ptrs.data());
+    return true;
+}
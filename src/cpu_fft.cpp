@@ -0,0 +1,128 @@
+#include "cpu_fft.h"
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+
+CpuFFT::CpuFFT(size_t size)
+    : size_(size), power_of_two_(IsPowerOfTwo(size)) {
+    if (size_ == 0) {
+        throw std::invalid_argument("CpuFFT: размер должен быть > 0");
+    }
+
+    const double PI = 3.14159265358979323846;
+
+    if (power_of_two_) {
+        twiddles_.resize(size_ / 2);
+        for (size_t j = 0; j < size_ / 2; ++j) {
+            double angle = -2.0 * PI * static_cast<double>(j) / static_cast<double>(size_);
+            twiddles_[j] = ComplexType(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+        }
+
+        size_t log2n = 0;
+        while ((size_t(1) << log2n) < size_) {
+            ++log2n;
+        }
+        bit_reverse_.resize(size_);
+        for (size_t i = 0; i < size_; ++i) {
+            size_t reversed = 0;
+            for (size_t b = 0; b < log2n; ++b) {
+                reversed |= ((i >> b) & 1) << (log2n - 1 - b);
+            }
+            bit_reverse_[i] = reversed;
+        }
+        return;
+    }
+
+    // Блюстейн: свёртка длины M >= 2N - 1 (степень двойки)
+    size_t m = 1;
+    while (m < 2 * size_ - 1) {
+        m <<= 1;
+    }
+    inner_.reset(new CpuFFT(m));
+
+    chirp_.resize(size_);
+    for (size_t k = 0; k < size_; ++k) {
+        // k^2 mod 2N - сохраняет точность фазы для больших k
+        unsigned long long k2 = (static_cast<unsigned long long>(k) * k) % (2ULL * size_);
+        double angle = -PI * static_cast<double>(k2) / static_cast<double>(size_);
+        chirp_[k] = ComplexType(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+    }
+
+    chirp_fft_.assign(m, ComplexType(0.0f, 0.0f));
+    chirp_fft_[0] = std::conj(chirp_[0]);
+    for (size_t k = 1; k < size_; ++k) {
+        chirp_fft_[k] = std::conj(chirp_[k]);
+        chirp_fft_[m - k] = std::conj(chirp_[k]);
+    }
+    inner_->Execute(chirp_fft_.data(), true);
+}
+
+void CpuFFT::Execute(ComplexType* data, bool forward) const {
+    if (data == nullptr) {
+        return;
+    }
+    if (power_of_two_) {
+        Radix2(data, forward);
+    } else {
+        Bluestein(data, forward);
+    }
+}
+
+void CpuFFT::Radix2(ComplexType* data, bool forward) const {
+    const size_t n = size_;
+
+    for (size_t i = 0; i < n; ++i) {
+        size_t j = bit_reverse_[i];
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const size_t half = len / 2;
+        const size_t step = n / len;
+        for (size_t start = 0; start < n; start += len) {
+            for (size_t k = 0; k < half; ++k) {
+                ComplexType w = twiddles_[k * step];
+                if (!forward) {
+                    w = std::conj(w);
+                }
+                ComplexType u = data[start + k];
+                ComplexType v = data[start + k + half] * w;
+                data[start + k] = u + v;
+                data[start + k + half] = u - v;
+            }
+        }
+    }
+
+    if (!forward) {
+        const float scale = 1.0f / static_cast<float>(n);
+        for (size_t i = 0; i < n; ++i) {
+            data[i] *= scale;
+        }
+    }
+}
+
+void CpuFFT::Bluestein(ComplexType* data, bool forward) const {
+    const size_t n = size_;
+    const size_t m = inner_->GetSize();
+
+    // Обратное преобразование через прямое: IFFT(x) = conj(FFT(conj(x))) / N
+    std::vector<ComplexType> work(m, ComplexType(0.0f, 0.0f));
+    for (size_t k = 0; k < n; ++k) {
+        ComplexType x = forward ? data[k] : std::conj(data[k]);
+        work[k] = x * chirp_[k];
+    }
+
+    inner_->Execute(work.data(), true);
+    for (size_t k = 0; k < m; ++k) {
+        work[k] *= chirp_fft_[k];
+    }
+    inner_->Execute(work.data(), false);
+
+    const float scale = forward ? 1.0f : 1.0f / static_cast<float>(n);
+    for (size_t k = 0; k < n; ++k) {
+        ComplexType y = work[k] * chirp_[k];
+        data[k] = forward ? y : std::conj(y) * scale;
+    }
+}
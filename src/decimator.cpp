@@ -0,0 +1,249 @@
+#include "decimator.h"
+#include "thread_pool.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Выходных отсчётов в тайле: аккумуляторы re/im 2 × 4 KB (L1), как в FirFilter
+constexpr size_t OUTPUT_TILE = 1024;
+
+/**
+ * @brief Рабочие буферы потока: фазы расширенного входа в раздельных re/im
+ *
+ * Фаза r - отсчёты ext[i·M + r], i = 0..phase_length-1 (хвост дополнен нулями).
+ */
+struct PolyphaseScratch {
+    std::vector<float> re;   // [M][phase_length]
+    std::vector<float> im;
+    std::vector<SignalBuffer::ComplexType> ext;
+};
+
+} // namespace
+
+std::vector<float> DesignDecimatorLowPass(size_t factor, size_t taps_per_phase) {
+    const size_t num_taps = std::max<size_t>(factor * taps_per_phase, 1);
+    std::vector<float> coefficients(num_taps, 0.0f);
+    if (factor <= 1 || num_taps == 1) {
+        coefficients.assign(1, 1.0f);
+        return coefficients;
+    }
+
+    const double PI = 3.14159265358979323846;
+    const double cutoff = 0.5 / static_cast<double>(factor);   // доля входной частоты
+    const double center = 0.5 * static_cast<double>(num_taps - 1);
+
+    double sum = 0.0;
+    for (size_t k = 0; k < num_taps; ++k) {
+        const double t = static_cast<double>(k) - center;
+        const double sinc = t == 0.0 ? 2.0 * cutoff : std::sin(2.0 * PI * cutoff * t) / (PI * t);
+        const double window = 0.54 - 0.46 * std::cos(2.0 * PI * static_cast<double>(k) / (num_taps - 1));
+        coefficients[k] = static_cast<float>(sinc * window);
+        sum += sinc * window;
+    }
+
+    // Единичное усиление на нуле частоты
+    for (float& c : coefficients) {
+        c = static_cast<float>(c / sum);
+    }
+    return coefficients;
+}
+
+std::vector<float> DesignCicResponse(size_t factor, size_t num_stages) {
+    factor = std::max<size_t>(factor, 1);
+    num_stages = std::max<size_t>(num_stages, 1);
+
+    // Свёртка N прямоугольных окон длины M (целые числа точны в double)
+    std::vector<double> response(1, 1.0);
+    for (size_t stage = 0; stage < num_stages; ++stage) {
+        std::vector<double> next(response.size() + factor - 1, 0.0);
+        for (size_t i = 0; i < response.size(); ++i) {
+            for (size_t k = 0; k < factor; ++k) {
+                next[i + k] += response[i];
+            }
+        }
+        response.swap(next);
+    }
+
+    const double gain = std::pow(static_cast<double>(factor), static_cast<double>(num_stages));
+    std::vector<float> coefficients(response.size());
+    for (size_t k = 0; k < response.size(); ++k) {
+        coefficients[k] = static_cast<float>(response[k] / gain);
+    }
+    return coefficients;
+}
+
+void DecimateBeamCPU(
+    const float* coefficients,
+    size_t num_taps,
+    size_t factor,
+    SignalBuffer::ComplexType* history,
+    const SignalBuffer::ComplexType* input,
+    size_t num_input_samples,
+    size_t first_position,
+    SignalBuffer::ComplexType* output,
+    size_t num_output_samples) {
+
+    const size_t history_size = num_taps - 1;
+    const size_t ext_size = history_size + num_input_samples;
+
+    // Буферы переиспользуются между лучами и блоками
+    thread_local PolyphaseScratch scratch;
+    scratch.ext.resize(ext_size);
+    std::copy(history, history + history_size, scratch.ext.begin());
+    std::copy(input, input + num_input_samples, scratch.ext.begin() + history_size);
+
+    if (num_output_samples > 0) {
+        // Разложение на фазы: ext[i·M + r] -> phase_r[i]
+        const size_t phase_length = (ext_size + factor - 1) / factor;
+        scratch.re.assign(factor * phase_length, 0.0f);
+        scratch.im.assign(factor * phase_length, 0.0f);
+        for (size_t i = 0; i < ext_size; ++i) {
+            const size_t index = (i % factor) * phase_length + i / factor;
+            scratch.re[index] = scratch.ext[i].real();
+            scratch.im[index] = scratch.ext[i].imag();
+        }
+
+        float acc_re[OUTPUT_TILE];
+        float acc_im[OUTPUT_TILE];
+        for (size_t tile_begin = 0; tile_begin < num_output_samples; tile_begin += OUTPUT_TILE) {
+            const size_t count = std::min(OUTPUT_TILE, num_output_samples - tile_begin);
+            std::fill(acc_re, acc_re + count, 0.0f);
+            std::fill(acc_im, acc_im + count, 0.0f);
+
+            for (size_t k = 0; k < num_taps; ++k) {
+                // ext[first + j·M - k] = phase_r[q + j], r = (first - k) mod M
+                const size_t position = first_position - k;
+                const size_t offset = (position % factor) * phase_length + position / factor + tile_begin;
+                const float c = coefficients[k];
+                const float* x_re = scratch.re.data() + offset;
+                const float* x_im = scratch.im.data() + offset;
+                for (size_t i = 0; i < count; ++i) {
+                    acc_re[i] += c * x_re[i];
+                    acc_im[i] += c * x_im[i];
+                }
+            }
+
+            for (size_t i = 0; i < count; ++i) {
+                output[tile_begin + i] = SignalBuffer::ComplexType(acc_re[i], acc_im[i]);
+            }
+        }
+    }
+
+    std::copy(scratch.ext.end() - history_size, scratch.ext.end(), history);
+}
+
+Decimator::Decimator()
+    : factor_(1), filter_(DecimatorFilter::CUSTOM), coefficients_(1, 1.0f),
+      output_position_(0), input_position_(0), num_beams_(0) {
+}
+
+bool Decimator::Configure(size_t factor, DecimatorFilter filter, size_t order) {
+    if (factor == 0 || order == 0) {
+        std::cerr << "Ошибка: некорректные параметры прореживания" << std::endl;
+        return false;
+    }
+
+    std::vector<float> coefficients;
+    switch (filter) {
+        case DecimatorFilter::LOWPASS:
+            coefficients = DesignDecimatorLowPass(factor, order);
+            break;
+        case DecimatorFilter::CIC:
+            coefficients = DesignCicResponse(factor, order);
+            break;
+        default:
+            std::cerr << "Ошибка: для CUSTOM фильтра нужны коэффициенты" << std::endl;
+            return false;
+    }
+
+    if (!Configure(factor, coefficients)) {
+        return false;
+    }
+    filter_ = filter;
+    return true;
+}
+
+bool Decimator::Configure(size_t factor, const std::vector<float>& coefficients) {
+    if (factor == 0 || coefficients.empty()) {
+        std::cerr << "Ошибка: некорректные параметры прореживания" << std::endl;
+        return false;
+    }
+
+    factor_ = factor;
+    filter_ = DecimatorFilter::CUSTOM;
+    coefficients_ = coefficients;
+    num_beams_ = 0;
+    history_.clear();
+    Reset();
+    return true;
+}
+
+void Decimator::Reset() {
+    output_position_ = 0;
+    input_position_ = 0;
+    std::fill(history_.begin(), history_.end(), ComplexType(0.0f, 0.0f));
+}
+
+DecimateBlock Decimator::PlanBlock(size_t num_input_samples) const {
+    // ext[0] - входной отсчёт input_position_ - (L-1); выход m заканчивается на входе m·M
+    DecimateBlock block;
+    block.first_position = static_cast<size_t>(output_position_ * factor_ - input_position_) + GetHistorySize();
+
+    const size_t ext_size = GetHistorySize() + num_input_samples;
+    block.num_output_samples = block.first_position < ext_size
+        ? (ext_size - block.first_position + factor_ - 1) / factor_ : 0;
+    return block;
+}
+
+void Decimator::Advance(size_t num_input_samples, size_t num_output_samples) {
+    input_position_ += num_input_samples;
+    output_position_ += num_output_samples;
+}
+
+bool Decimator::Process(const SignalBuffer& input, SignalBuffer* output) {
+    if (output == nullptr || input.GetNumBeams() == 0) {
+        std::cerr << "Ошибка: пустой буфер для прореживания" << std::endl;
+        return false;
+    }
+
+    const size_t num_beams = input.GetNumBeams();
+    const size_t num_samples = input.GetNumSamples();
+    const size_t history_size = GetHistorySize();
+
+    for (size_t beam = 0; beam < num_beams; ++beam) {
+        if (!input.GetBeamData(beam)) {
+            std::cerr << "Ошибка: не удалось получить данные для луча " << beam << std::endl;
+            return false;
+        }
+    }
+
+    if (num_beams != num_beams_) {
+        num_beams_ = num_beams;
+        history_.assign(num_beams * history_size, ComplexType(0.0f, 0.0f));
+    }
+
+    const DecimateBlock block = PlanBlock(num_samples);
+    if (output->GetNumBeams() != num_beams || output->GetNumSamples() != block.num_output_samples) {
+        output->SetNumaPolicy(input.GetNumaPolicy());
+        output->Resize(num_beams, block.num_output_samples);
+    }
+
+    // Луч - на узле памяти входа; трафик: чтение входа + запись выхода
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &input.GetBeamNodes();
+    hint.bytes_per_item = (num_samples + block.num_output_samples) * sizeof(ComplexType);
+
+    ThreadPool::Instance().ParallelFor(num_beams, 1, [&](size_t begin, size_t end) {
+        for (size_t beam = begin; beam < end; ++beam) {
+            DecimateBeamCPU(coefficients_.data(), coefficients_.size(), factor_,
+                            history_.data() + beam * history_size,
+                            input.GetBeamData(beam), num_samples, block.first_position,
+                            output->GetBeamData(beam), block.num_output_samples);
+        }
+    }, hint);
+
+    Advance(num_samples, block.num_output_samples);
+    return true;
+}
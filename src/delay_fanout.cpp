@@ -0,0 +1,68 @@
+#include "delay_fanout.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+
+bool BuildFanOutPlan(
+    const float* delay_sets,
+    size_t num_delay_sets,
+    size_t num_beams,
+    int max_span,
+    FanOutPlan* plan) {
+
+    if (!delay_sets || !plan || num_delay_sets == 0 || num_beams == 0 || max_span < 0) {
+        std::cerr << "Ошибка: неверные параметры для BuildFanOutPlan" << std::endl;
+        return false;
+    }
+
+    const int LAGRANGE_ROWS = 48;
+
+    plan->entries.clear();
+    plan->groups.clear();
+    plan->entries.reserve(num_delay_sets * num_beams);
+
+    std::vector<FanOutEntry> beam_entries(num_delay_sets);
+
+    for (size_t beam = 0; beam < num_beams; ++beam) {
+        for (size_t set = 0; set < num_delay_sets; ++set) {
+            float delay = delay_sets[set * num_beams + beam];
+            FanOutEntry& entry = beam_entries[set];
+            entry.delay_integer = static_cast<int>(std::floor(delay));
+            float delay_fraction = delay - entry.delay_integer;
+            if (delay_fraction < 0.0f) {
+                delay_fraction += 1.0f;
+                entry.delay_integer -= 1;
+            }
+            entry.lagrange_row = std::min(static_cast<int>(delay_fraction * LAGRANGE_ROWS), LAGRANGE_ROWS - 1);
+            entry.set_index = static_cast<int>(set);
+        }
+
+        std::sort(beam_entries.begin(), beam_entries.end(),
+                  [](const FanOutEntry& a, const FanOutEntry& b) {
+                      return a.delay_integer < b.delay_integer;
+                  });
+
+        // Жадное разбиение отсортированных задержек на группы с разбросом <= max_span
+        size_t first = 0;
+        while (first < beam_entries.size()) {
+            size_t last = first + 1;
+            while (last < beam_entries.size() &&
+                   beam_entries[last].delay_integer - beam_entries[first].delay_integer <= max_span) {
+                ++last;
+            }
+
+            FanOutGroup group;
+            group.beam = static_cast<int>(beam);
+            group.first_entry = static_cast<int>(plan->entries.size());
+            group.num_entries = static_cast<int>(last - first);
+            group.min_delay_integer = beam_entries[first].delay_integer;
+            group.max_delay_integer = beam_entries[last - 1].delay_integer;
+            plan->groups.push_back(group);
+
+            plan->entries.insert(plan->entries.end(), beam_entries.begin() + first, beam_entries.begin() + last);
+            first = last;
+        }
+    }
+
+    return true;
+}
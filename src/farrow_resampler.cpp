@@ -0,0 +1,221 @@
+#include "farrow_resampler.h"
+#include "thread_pool.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Ореол интерполятора: 2 отсчёта с каждой стороны + запас на округление позиции
+constexpr size_t INTERPOLATOR_HALO = 6;
+
+/**
+ * @brief Интерполяция Лагранжа по 5 узлам в форме Фарроу
+ *
+ * x указывает на узел 0 (x[-2..2] доступны). Подфильтры - коэффициенты
+ * полиномов Лагранжа при степенях μ:
+ *   c0 = x0
+ *   c1 = (x-2 - 8x-1 + 8x1 - x2) / 12
+ *   c2 = (-x-2 + 16x-1 - 30x0 + 16x1 - x2) / 24
+ *   c3 = (-x-2 + 2x-1 - 2x1 + x2) / 12
+ *   c4 = (x-2 - 4x-1 + 6x0 - 4x1 + x2) / 24
+ */
+inline SignalBuffer::ComplexType FarrowInterpolate(const SignalBuffer::ComplexType* x, float mu) {
+    const SignalBuffer::ComplexType xm2 = x[-2];
+    const SignalBuffer::ComplexType xm1 = x[-1];
+    const SignalBuffer::ComplexType x0 = x[0];
+    const SignalBuffer::ComplexType xp1 = x[1];
+    const SignalBuffer::ComplexType xp2 = x[2];
+
+    const SignalBuffer::ComplexType outer = xm2 + xp2;      // симметричные пары
+    const SignalBuffer::ComplexType inner = xm1 + xp1;
+    const SignalBuffer::ComplexType outer_diff = xm2 - xp2; // антисимметричные пары
+    const SignalBuffer::ComplexType inner_diff = xp1 - xm1;
+
+    const SignalBuffer::ComplexType c1 = (outer_diff + 8.0f * inner_diff) * (1.0f / 12.0f);
+    const SignalBuffer::ComplexType c2 = (16.0f * inner - outer - 30.0f * x0) * (1.0f / 24.0f);
+    const SignalBuffer::ComplexType c3 = (-outer_diff - 2.0f * inner_diff) * (1.0f / 12.0f);
+    const SignalBuffer::ComplexType c4 = (outer - 4.0f * inner + 6.0f * x0) * (1.0f / 24.0f);
+
+    return x0 + mu * (c1 + mu * (c2 + mu * (c3 + mu * c4)));
+}
+
+/**
+ * @brief Позиция выходного отсчёта m во входе потока: m·step - delay
+ *
+ * m·step раскладывается в точную сумму prod + err (fma), целая часть prod
+ * отделяется до добавления малых слагаемых: base и mu зависят только от m,
+ * step и delay и не теряют точность на длинных потоках.
+ */
+inline void StreamPosition(uint64_t m, double step, float delay, int64_t* base, float* mu) {
+    const double index = static_cast<double>(m);
+    const double prod = index * step;
+    const double err = std::fma(index, step, -prod);
+    const double prod_base = std::floor(prod);
+    const double frac = (prod - prod_base) + (err - static_cast<double>(delay));
+    const double frac_base = std::floor(frac);
+    *base = static_cast<int64_t>(prod_base) + static_cast<int64_t>(frac_base);
+    *mu = static_cast<float>(frac - frac_base);
+}
+
+} // namespace
+
+void FarrowResampleBeamCPU(
+    SignalBuffer::ComplexType* history,
+    size_t history_size,
+    const SignalBuffer::ComplexType* input,
+    size_t num_input_samples,
+    const ResampleBlock& block,
+    double step,
+    float delay,
+    SignalBuffer::ComplexType* output) {
+
+    // Рабочий буфер потока переиспользуется между лучами и блоками
+    thread_local std::vector<SignalBuffer::ComplexType> ext;
+    ext.resize(history_size + num_input_samples);
+    std::copy(history, history + history_size, ext.begin());
+    std::copy(input, input + num_input_samples, ext.begin() + history_size);
+
+    // Позиция - от номера отсчёта в потоке, а не от начала блока:
+    // результат не зависит от того, как поток разбит на блоки
+    for (size_t j = 0; j < block.num_output_samples; ++j) {
+        int64_t base = 0;
+        float mu = 0.0f;
+        StreamPosition(block.first_output_sample + j, step, delay, &base, &mu);
+        output[j] = FarrowInterpolate(ext.data() + static_cast<ptrdiff_t>(base - block.ext_origin), mu);
+    }
+
+    std::copy(ext.end() - history_size, ext.end(), history);
+}
+
+FarrowResampler::FarrowResampler()
+    : step_(1.0), min_delay_(0.0f), max_delay_(0.0f), history_size_(INTERPOLATOR_HALO),
+      output_position_(0), input_position_(0), num_beams_(0) {
+}
+
+bool FarrowResampler::Configure(double input_rate, double output_rate, const std::vector<float>& delays) {
+    if (!(input_rate > 0.0) || !(output_rate > 0.0)) {
+        std::cerr << "Ошибка: частоты передискретизации должны быть положительными" << std::endl;
+        return false;
+    }
+
+    step_ = input_rate / output_rate;
+    delays_ = delays;
+    min_delay_ = 0.0f;
+    max_delay_ = 0.0f;
+    for (float delay : delays_) {
+        if (!std::isfinite(delay)) {
+            std::cerr << "Ошибка: некорректная задержка луча" << std::endl;
+            return false;
+        }
+        min_delay_ = std::min(min_delay_, delay);
+        max_delay_ = std::max(max_delay_, delay);
+    }
+
+    // Первый выходной отсчёт блока может отставать от последнего отсчёта
+    // предыдущего блока на разброс задержек; в начале потока - на max_delay
+    history_size_ = INTERPOLATOR_HALO + static_cast<size_t>(std::ceil(max_delay_ - min_delay_));
+
+    num_beams_ = 0;
+    history_.clear();
+    Reset();
+    return true;
+}
+
+std::vector<float> FarrowResampler::GetBeamDelays(size_t num_beams) const {
+    return delays_.empty() ? std::vector<float>(num_beams, 0.0f) : delays_;
+}
+
+void FarrowResampler::Reset() {
+    output_position_ = 0;
+    input_position_ = 0;
+    std::fill(history_.begin(), history_.end(), ComplexType(0.0f, 0.0f));
+}
+
+ResampleBlock FarrowResampler::PlanBlock(size_t num_input_samples) const {
+    ResampleBlock block;
+    // ext[0] - входной отсчёт input_position_ - history_size_
+    block.start_position = static_cast<double>(output_position_) * step_
+                         - static_cast<double>(input_position_)
+                         + static_cast<double>(history_size_);
+    block.first_output_sample = output_position_;
+    block.ext_origin = static_cast<int64_t>(input_position_) - static_cast<int64_t>(history_size_);
+
+    // Отсчёт m выдаётся, если узел +2 самого позднего луча (min_delay) уже принят:
+    // m·step < (принято входных) - 2 + min_delay. Условие - в координатах потока,
+    // поэтому граница не зависит от разбиения на блоки
+    const double limit = static_cast<double>(input_position_ + num_input_samples) - 2.0 + min_delay_;
+    auto ready = [this, limit](uint64_t m) { return static_cast<double>(m) * step_ < limit; };
+    size_t count = 0;
+    if (ready(output_position_)) {
+        const double first = static_cast<double>(output_position_) * step_;
+        count = static_cast<size_t>(std::ceil((limit - first) / step_));
+        while (count > 0 && !ready(output_position_ + count - 1)) {
+            --count;
+        }
+        while (ready(output_position_ + count)) {
+            ++count;
+        }
+    }
+    block.num_output_samples = count;
+    return block;
+}
+
+void FarrowResampler::Advance(size_t num_input_samples, size_t num_output_samples) {
+    input_position_ += num_input_samples;
+    output_position_ += num_output_samples;
+}
+
+size_t FarrowResampler::GetMaxOutputSamples(size_t num_input_samples) const {
+    return static_cast<size_t>(std::ceil((history_size_ + num_input_samples) / step_)) + 1;
+}
+
+bool FarrowResampler::Process(const SignalBuffer& input, SignalBuffer* output) {
+    if (output == nullptr || input.GetNumBeams() == 0) {
+        std::cerr << "Ошибка: пустой буфер для передискретизации" << std::endl;
+        return false;
+    }
+
+    const size_t num_beams = input.GetNumBeams();
+    const size_t num_samples = input.GetNumSamples();
+    if (!delays_.empty() && delays_.size() != num_beams) {
+        std::cerr << "Ошибка: задержек " << delays_.size() << ", лучей " << num_beams << std::endl;
+        return false;
+    }
+
+    for (size_t beam = 0; beam < num_beams; ++beam) {
+        if (!input.GetBeamData(beam)) {
+            std::cerr << "Ошибка: не удалось получить данные для луча " << beam << std::endl;
+            return false;
+        }
+    }
+
+    if (num_beams != num_beams_) {
+        num_beams_ = num_beams;
+        history_.assign(num_beams * history_size_, ComplexType(0.0f, 0.0f));
+    }
+
+    const ResampleBlock block = PlanBlock(num_samples);
+    if (output->GetNumBeams() != num_beams || output->GetNumSamples() != block.num_output_samples) {
+        output->SetNumaPolicy(input.GetNumaPolicy());
+        output->Resize(num_beams, block.num_output_samples);
+    }
+
+    const std::vector<float> delays = GetBeamDelays(num_beams);
+
+    // Луч - на узле памяти входа; трафик: чтение входа + запись выхода
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &input.GetBeamNodes();
+    hint.bytes_per_item = (num_samples + block.num_output_samples) * sizeof(ComplexType);
+
+    ThreadPool::Instance().ParallelFor(num_beams, 1, [&](size_t begin, size_t end) {
+        for (size_t beam = begin; beam < end; ++beam) {
+            FarrowResampleBeamCPU(history_.data() + beam * history_size_, history_size_,
+                                  input.GetBeamData(beam), num_samples,
+                                  block, step_, delays[beam], output->GetBeamData(beam));
+        }
+    }, hint);
+
+    Advance(num_samples, block.num_output_samples);
+    return true;
+}
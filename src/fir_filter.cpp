@@ -0,0 +1,369 @@
+#include "fir_filter.h"
+#include "thread_pool.h"
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+namespace {
+
+// Отсчётов в тайле прямой формы: аккумуляторы re/im 2 × 4 KB (L1)
+constexpr size_t DIRECT_TILE = 1024;
+
+// Предел блока для замера точки пересечения: дальше стоимость на отсчёт постоянна
+constexpr size_t CROSSOVER_MAX_SAMPLES = 16384;
+
+// Наибольшая длина фильтра при замере
+constexpr size_t CROSSOVER_MAX_TAPS = 1024;
+
+size_t NextPowerOfTwo(size_t n) {
+    size_t result = 1;
+    while (result < n) {
+        result <<= 1;
+    }
+    return result;
+}
+
+size_t Log2(size_t power_of_two) {
+    size_t result = 0;
+    while ((static_cast<size_t>(1) << result) < power_of_two) {
+        ++result;
+    }
+    return result;
+}
+
+/**
+ * @brief Прямая форма: тайлы выходных отсчётов, внутренний цикл по отсчётам тайла
+ *
+ * Вход развёрнут в раздельные re/im массивы [L-1 + N] (история + блок);
+ * коэффициенты вещественные, поэтому re и im накапливаются независимо,
+ * и цикл по отсчётам векторизуется компилятором без перестановок.
+ */
+void FirDirectBeam(
+    const std::vector<float>& coefficients,
+    const float* ext_re,
+    const float* ext_im,
+    size_t num_samples,
+    SignalBuffer::ComplexType* output) {
+
+    const size_t num_taps = coefficients.size();
+    const size_t history = num_taps - 1;
+    float acc_re[DIRECT_TILE];
+    float acc_im[DIRECT_TILE];
+
+    for (size_t tile_begin = 0; tile_begin < num_samples; tile_begin += DIRECT_TILE) {
+        const size_t count = std::min(DIRECT_TILE, num_samples - tile_begin);
+        std::fill(acc_re, acc_re + count, 0.0f);
+        std::fill(acc_im, acc_im + count, 0.0f);
+
+        for (size_t k = 0; k < num_taps; ++k) {
+            const float c = coefficients[k];
+            const float* x_re = ext_re + tile_begin + history - k;
+            const float* x_im = ext_im + tile_begin + history - k;
+            for (size_t i = 0; i < count; ++i) {
+                acc_re[i] += c * x_re[i];
+                acc_im[i] += c * x_im[i];
+            }
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            output[tile_begin + i] = SignalBuffer::ComplexType(acc_re[i], acc_im[i]);
+        }
+    }
+}
+
+/**
+ * @brief Overlap-save: сегменты M отсчётов со сдвигом M-(L-1)
+ *
+ * Первые L-1 отсчётов циклической свёртки сегмента искажены и отбрасываются.
+ */
+void FirOverlapSaveBeam(
+    const FirPlanCPU& plan,
+    const SignalBuffer::ComplexType* ext,
+    size_t num_samples,
+    SignalBuffer::ComplexType* segment,
+    SignalBuffer::ComplexType* output) {
+
+    const size_t history = plan.GetHistorySize();
+    const size_t fft_size = plan.fft_size;
+    const size_t step = fft_size - history;
+    const size_t ext_size = history + num_samples;
+    const float* spectrum = reinterpret_cast<const float*>(plan.coefficients_fft.data());
+
+    for (size_t begin = 0; begin < num_samples; begin += step) {
+        const size_t available = std::min(fft_size, ext_size - begin);
+        std::copy(ext + begin, ext + begin + available, segment);
+        std::fill(segment + available, segment + fft_size, SignalBuffer::ComplexType(0.0f, 0.0f));
+
+        plan.fft->Execute(segment, true);
+
+        // Раздельные re/im операции (как в Hadamard CPU backend'а)
+        float* data = reinterpret_cast<float*>(segment);
+        for (size_t i = 0; i < fft_size; ++i) {
+            float a = data[2 * i];
+            float b = data[2 * i + 1];
+            float c = spectrum[2 * i];
+            float d = spectrum[2 * i + 1];
+            data[2 * i] = a * c - b * d;
+            data[2 * i + 1] = a * d + b * c;
+        }
+
+        plan.fft->Execute(segment, false);
+
+        const size_t count = std::min(step, num_samples - begin);
+        std::copy(segment + history, segment + history + count, output + begin);
+    }
+}
+
+} // namespace
+
+size_t SelectOverlapSaveFftSize(size_t num_taps, size_t num_samples) {
+    const size_t history = num_taps - 1;
+    // Одного сегмента такого размера достаточно для всего блока
+    const size_t limit = NextPowerOfTwo(history + std::max<size_t>(num_samples, 1));
+
+    size_t best_size = limit;
+    double best_cost = -1.0;
+    for (size_t fft_size = std::min(NextPowerOfTwo(2 * num_taps), limit);
+         fft_size <= limit; fft_size <<= 1) {
+        if (fft_size <= history) {
+            continue;
+        }
+        const size_t step = fft_size - history;
+        const size_t segments = (num_samples + step - 1) / step;
+        const double cost = static_cast<double>(segments) * fft_size * std::max<size_t>(Log2(fft_size), 1);
+        if (best_cost < 0.0 || cost < best_cost) {
+            best_cost = cost;
+            best_size = fft_size;
+        }
+    }
+    return best_size;
+}
+
+size_t MeasureFirCrossover(
+    const std::function<double(size_t num_taps, FirMethod method)>& time_method,
+    size_t max_taps) {
+
+    for (size_t num_taps = 4; num_taps <= max_taps; num_taps *= 2) {
+        double direct_time = time_method(num_taps, FirMethod::DIRECT);
+        double overlap_save_time = time_method(num_taps, FirMethod::OVERLAP_SAVE);
+        if (direct_time < 0.0 || overlap_save_time < 0.0) {
+            break;  // Замер не удался - остаёмся на прямой форме
+        }
+        if (overlap_save_time < direct_time) {
+            return num_taps;
+        }
+    }
+    return SIZE_MAX;
+}
+
+bool BuildFirPlanCPU(
+    const float* coefficients,
+    size_t num_taps,
+    FirMethod method,
+    size_t num_samples,
+    FirPlanCPU* plan) {
+
+    if (coefficients == nullptr || num_taps == 0 || num_samples == 0 || plan == nullptr) {
+        std::cerr << "Ошибка: некорректные параметры FIR фильтра" << std::endl;
+        return false;
+    }
+
+    if (method == FirMethod::AUTO) {
+        method = num_taps >= FirFilter::GetCpuCrossover(num_samples)
+                     ? FirMethod::OVERLAP_SAVE : FirMethod::DIRECT;
+    }
+
+    plan->method = method;
+    plan->coefficients.assign(coefficients, coefficients + num_taps);
+    plan->num_samples = num_samples;
+    plan->fft.reset();
+    plan->coefficients_fft.clear();
+    plan->fft_size = 0;
+
+    if (method == FirMethod::OVERLAP_SAVE) {
+        plan->fft_size = SelectOverlapSaveFftSize(num_taps, num_samples);
+        plan->fft.reset(new CpuFFT(plan->fft_size));
+        plan->coefficients_fft.assign(plan->fft_size, SignalBuffer::ComplexType(0.0f, 0.0f));
+        for (size_t k = 0; k < num_taps; ++k) {
+            plan->coefficients_fft[k] = SignalBuffer::ComplexType(coefficients[k], 0.0f);
+        }
+        plan->fft->Execute(plan->coefficients_fft.data(), true);
+    }
+
+    return true;
+}
+
+void FirFilterBeamCPU(
+    const FirPlanCPU& plan,
+    SignalBuffer::ComplexType* history,
+    const SignalBuffer::ComplexType* input,
+    SignalBuffer::ComplexType* output) {
+
+    const size_t history_size = plan.GetHistorySize();
+    const size_t num_samples = plan.num_samples;
+    const size_t ext_size = history_size + num_samples;
+
+    // Рабочие буферы потока переиспользуются между лучами и вызовами
+    thread_local std::vector<float> ext_re;
+    thread_local std::vector<float> ext_im;
+    thread_local std::vector<SignalBuffer::ComplexType> ext;
+    thread_local std::vector<SignalBuffer::ComplexType> segment;
+
+    if (plan.method == FirMethod::OVERLAP_SAVE) {
+        ext.resize(ext_size);
+        segment.resize(plan.fft_size);
+        std::copy(history, history + history_size, ext.begin());
+        std::copy(input, input + num_samples, ext.begin() + history_size);
+
+        FirOverlapSaveBeam(plan, ext.data(), num_samples, segment.data(), output);
+
+        std::copy(ext.begin() + num_samples, ext.end(), history);
+        return;
+    }
+
+    ext_re.resize(ext_size);
+    ext_im.resize(ext_size);
+    for (size_t i = 0; i < history_size; ++i) {
+        ext_re[i] = history[i].real();
+        ext_im[i] = history[i].imag();
+    }
+    for (size_t i = 0; i < num_samples; ++i) {
+        ext_re[history_size + i] = input[i].real();
+        ext_im[history_size + i] = input[i].imag();
+    }
+
+    FirDirectBeam(plan.coefficients, ext_re.data(), ext_im.data(), num_samples, output);
+
+    for (size_t i = 0; i < history_size; ++i) {
+        history[i] = SignalBuffer::ComplexType(ext_re[num_samples + i], ext_im[num_samples + i]);
+    }
+}
+
+FirFilter::FirFilter()
+    : requested_method_(FirMethod::AUTO), num_beams_(0) {
+}
+
+bool FirFilter::Configure(const std::vector<float>& coefficients, FirMethod method) {
+    if (coefficients.empty()) {
+        std::cerr << "Ошибка: FIR коэффициенты не заданы" << std::endl;
+        return false;
+    }
+
+    coefficients_ = coefficients;
+    requested_method_ = method;
+    plan_ = FirPlanCPU();
+    num_beams_ = 0;
+    history_.clear();
+    return true;
+}
+
+bool FirFilter::Configure(const FilterBank& filter_bank, FirMethod method) {
+    return Configure(filter_bank.GetCoefficients(), method);
+}
+
+void FirFilter::Reset() {
+    std::fill(history_.begin(), history_.end(), ComplexType(0.0f, 0.0f));
+}
+
+bool FirFilter::Process(SignalBuffer* buffer) {
+    if (coefficients_.empty()) {
+        std::cerr << "Ошибка: FIR фильтр не настроен" << std::endl;
+        return false;
+    }
+    if (buffer == nullptr || buffer->GetNumBeams() == 0 || buffer->GetNumSamples() == 0) {
+        std::cerr << "Ошибка: пустой буфер для FIR фильтра" << std::endl;
+        return false;
+    }
+
+    const size_t num_beams = buffer->GetNumBeams();
+    const size_t num_samples = buffer->GetNumSamples();
+
+    for (size_t beam = 0; beam < num_beams; ++beam) {
+        if (!buffer->GetBeamData(beam)) {
+            std::cerr << "Ошибка: не удалось получить данные для луча " << beam << std::endl;
+            return false;
+        }
+    }
+
+    if (plan_.num_samples != num_samples) {
+        if (!BuildFirPlanCPU(coefficients_.data(), coefficients_.size(), requested_method_,
+                             num_samples, &plan_)) {
+            return false;
+        }
+    }
+
+    const size_t history_size = plan_.GetHistorySize();
+    if (num_beams != num_beams_) {
+        num_beams_ = num_beams;
+        history_.assign(num_beams * history_size, ComplexType(0.0f, 0.0f));
+    }
+
+    // Луч - на узле его памяти; трафик: чтение + запись блока
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &buffer->GetBeamNodes();
+    hint.bytes_per_item = 2 * num_samples * sizeof(ComplexType);
+
+    ThreadPool::Instance().ParallelFor(num_beams, 1, [&](size_t begin, size_t end) {
+        for (size_t beam = begin; beam < end; ++beam) {
+            ComplexType* data = buffer->GetBeamData(beam);
+            FirFilterBeamCPU(plan_, history_.data() + beam * history_size, data, data);
+        }
+    }, hint);
+
+    return true;
+}
+
+size_t FirFilter::GetCpuCrossover(size_t num_samples) {
+    static std::mutex cache_mutex;
+    static std::map<size_t, size_t> cache;   // Класс размера блока -> точка пересечения
+
+    const size_t block = std::min(NextPowerOfTwo(std::max<size_t>(num_samples, 64)),
+                                  CROSSOVER_MAX_SAMPLES);
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = cache.find(block);
+    if (it != cache.end()) {
+        return it->second;
+    }
+
+    // Детерминированный широкополосный вход (значения не влияют на время)
+    std::vector<ComplexType> input(block);
+    uint32_t state = 12345u;
+    for (size_t i = 0; i < block; ++i) {
+        state = state * 1664525u + 1013904223u;
+        float re = static_cast<float>(state >> 8) / 16777216.0f - 0.5f;
+        state = state * 1664525u + 1013904223u;
+        float im = static_cast<float>(state >> 8) / 16777216.0f - 0.5f;
+        input[i] = ComplexType(re, im);
+    }
+    std::vector<ComplexType> output(block);
+
+    auto time_method = [&](size_t num_taps, FirMethod method) -> double {
+        std::vector<float> coefficients(num_taps, 1.0f / static_cast<float>(num_taps));
+        FirPlanCPU plan;
+        if (!BuildFirPlanCPU(coefficients.data(), num_taps, method, block, &plan)) {
+            return -1.0;
+        }
+        std::vector<ComplexType> history(plan.GetHistorySize());
+
+        // Минимум из нескольких повторов (первый прогревает кэш и буферы потока)
+        double best = -1.0;
+        for (int repeat = 0; repeat < 3; ++repeat) {
+            auto start = std::chrono::steady_clock::now();
+            FirFilterBeamCPU(plan, history.data(), input.data(), output.data());
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (best < 0.0 || seconds < best) {
+                best = seconds;
+            }
+        }
+        return best;
+    };
+
+    size_t crossover = MeasureFirCrossover(time_method, std::min(CROSSOVER_MAX_TAPS, block));
+    cache[block] = crossover;
+    return crossover;
+}
@@ -1,7 +1,177 @@
 #include "fractional_delay_cpu.h"
+#include "half_float.h"
+#include "delay_fanout.h"
+#include "thread_pool.h"
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <limits>
+
+namespace {
+
+const size_t LAGRANGE_ROWS = 48;
+const size_t LAGRANGE_COLS = 5;
+const size_t DELAY_TILE = 16384;  // Отсчётов в задаче пула (128 KB выхода)
+
+// Отсчёт у края луча: индексы за границами отражаются
+inline SignalBuffer::ComplexType EdgeSample(
+    const SignalBuffer::ComplexType* input,
+    int n,
+    int d,
+    const float* coeffs,
+    int sample) {
+    
+    SignalBuffer::ComplexType result(0.0f, 0.0f);
+    for (int i = 0; i < static_cast<int>(LAGRANGE_COLS); ++i) {
+        int idx = sample - d - 2 + i;
+        if (idx < 0) {
+            idx = -idx;
+        }
+        if (idx >= n) {
+            idx = 2 * n - idx - 2;
+        }
+        if (idx >= 0 && idx < n) {
+            result += coeffs[i] * input[idx];
+        }
+    }
+    return result;
+}
+
+// Внутренний отсчёт: все 5 точек внутри луча, без проверок
+inline SignalBuffer::ComplexType InteriorSample(
+    const SignalBuffer::ComplexType* input,
+    int d,
+    const float* coeffs,
+    int sample) {
+    
+    const SignalBuffer::ComplexType* t = input + (sample - d - 2);
+    return coeffs[0] * t[0] + coeffs[1] * t[1] + coeffs[2] * t[2] +
+           coeffs[3] * t[3] + coeffs[4] * t[4];
+}
+
+/**
+ * @brief Дробная задержка отсчётов [begin, end) одного луча
+ *
+ * Внутренние отсчёты (все 5 точек внутри луча) считаются без проверок границ,
+ * отражение - только у краёв; порядок суммирования как в исходном цикле.
+ */
+void DelayBeamRange(
+    const SignalBuffer::ComplexType* input,
+    SignalBuffer::ComplexType* output,
+    int n,
+    const FractionalDelayParams& params,
+    const float* coeffs,
+    int begin,
+    int end) {
+    
+    const int d = params.delay_integer;
+    
+    // Отсчёты, у которых все 5 точек внутри луча: [d + 2, n + d - 3]
+    const int interior_begin = std::min(end, std::max(begin, d + 2));
+    const int interior_end = std::max(interior_begin, std::min(end, n + d - 2));
+    
+    for (int sample = begin; sample < interior_begin; ++sample) {
+        output[sample] = EdgeSample(input, n, d, coeffs, sample);
+    }
+    
+    for (int sample = interior_begin; sample < interior_end; ++sample) {
+        output[sample] = InteriorSample(input, d, coeffs, sample);
+    }
+    
+    for (int sample = interior_end; sample < end; ++sample) {
+        output[sample] = EdgeSample(input, n, d, coeffs, sample);
+    }
+}
+
+/**
+ * @brief Задержка одного упакованного луча: чтение с расширением до float,
+ *        упаковка результата в том же формате
+ *
+ * Widen: uint16 -> float, Narrow: float -> uint16.
+ */
+template <typename Widen, typename Narrow>
+void DelayPackedBeam(
+    const uint16_t* input,
+    uint16_t* output,
+    size_t num_samples,
+    int delay_integer,
+    const float* coeffs,
+    Widen widen,
+    Narrow narrow) {
+
+    const int n = static_cast<int>(num_samples);
+    for (int sample = 0; sample < n; ++sample) {
+        int interp_idx = sample - delay_integer - 2;
+        float re = 0.0f;
+        float im = 0.0f;
+
+        for (int i = 0; i < static_cast<int>(LAGRANGE_COLS); ++i) {
+            int idx = interp_idx + i;
+            if (idx < 0) {
+                idx = -idx;
+            }
+            if (idx >= n) {
+                idx = 2 * n - idx - 2;
+            }
+            if (idx >= 0 && idx < n) {
+                re += coeffs[i] * widen(input[2 * idx]);
+                im += coeffs[i] * widen(input[2 * idx + 1]);
+            }
+        }
+
+        output[2 * sample] = narrow(re);
+        output[2 * sample + 1] = narrow(im);
+    }
+}
+
+// Результат в единицах кода -> int16: симметричный диапазон ±32767, как SignalBuffer::Pack
+inline uint16_t NarrowInt16(float value) {
+    float code = std::nearbyint(value);
+    code = std::min(32767.0f, std::max(-32767.0f, code));
+    return static_cast<uint16_t>(static_cast<int16_t>(code));
+}
+
+} // namespace
+
+FractionalDelayParams ComputeDelayParams(float delay) {
+    FractionalDelayParams params;
+    params.delay_integer = static_cast<int>(std::floor(delay));
+    float delay_fraction = delay - params.delay_integer;
+    if (delay_fraction < 0.0f) {
+        delay_fraction += 1.0f;
+        params.delay_integer -= 1;
+    }
+    params.lagrange_row = static_cast<int>(delay_fraction * LAGRANGE_ROWS);
+    if (params.lagrange_row >= static_cast<int>(LAGRANGE_ROWS)) {
+        params.lagrange_row = LAGRANGE_ROWS - 1;
+    }
+    return params;
+}
+
+void FractionalDelayPackedBeamCPU(
+    const uint16_t* input,
+    uint16_t* output,
+    size_t num_samples,
+    SampleFormat format,
+    float delay,
+    const float* lagrange_data) {
+    
+    const FractionalDelayParams params = ComputeDelayParams(delay);
+    const float* coeffs = lagrange_data + params.lagrange_row * LAGRANGE_COLS;
+    
+    if (format == SampleFormat::INT16_IQ) {
+        // Интерполяция линейна: считаем в единицах кода, масштаб не меняется
+        DelayPackedBeam(
+            input, output, num_samples, params.delay_integer, coeffs,
+            [](uint16_t code) { return static_cast<float>(static_cast<int16_t>(code)); },
+            NarrowInt16);
+    } else {
+        DelayPackedBeam(
+            input, output, num_samples, params.delay_integer, coeffs,
+            [](uint16_t bits) { return half_float::ToFloat(bits); },
+            [](float value) { return half_float::FromFloat(value); });
+    }
+}
 
 bool ExecuteFractionalDelayCPU(
     SignalBuffer* input_output,
@@ -26,104 +196,361 @@ bool ExecuteFractionalDelayCPU(
         return false;
     }
     
-    const size_t LAGRANGE_ROWS = 48;
-    const size_t LAGRANGE_COLS = 5;
-    
     // Вычисляем параметры задержки для каждого луча
-    struct DelayParams {
-        int delay_integer;
-        int lagrange_row;
-    };
+    std::vector<FractionalDelayParams> delay_params(num_beams);
+    for (size_t beam = 0; beam < num_beams; ++beam) {
+        delay_params[beam] = ComputeDelayParams(delay_coefficients[beam]);
+    }
     
-    std::vector<DelayParams> delay_params(num_beams);
+    // Указатели лучей проверяются до параллельной части
     for (size_t beam = 0; beam < num_beams; ++beam) {
-        float delay = delay_coefficients[beam];
-        delay_params[beam].delay_integer = static_cast<int>(std::floor(delay));
-        float delay_fraction = delay - delay_params[beam].delay_integer;
-        
-        // Обработка отрицательной дробной части
-        if (delay_fraction < 0.0f) {
-            delay_fraction += 1.0f;
-            delay_params[beam].delay_integer -= 1;
-        }
-        
-        // Вычисляем индекс строки матрицы Лагранжа
-        delay_params[beam].lagrange_row = static_cast<int>(delay_fraction * LAGRANGE_ROWS);
-        if (delay_params[beam].lagrange_row >= static_cast<int>(LAGRANGE_ROWS)) {
-            delay_params[beam].lagrange_row = LAGRANGE_ROWS - 1;
+        if (!input_output->GetBeamData(beam)) {
+            std::cerr << "Ошибка: не удалось получить данные для луча " << beam << std::endl;
+            return false;
         }
     }
     
-    // Создаём временный буфер для результатов (нужен для правильной in-place обработки)
-    std::vector<SignalBuffer::ComplexType> output_buffer(num_beams * num_samples);
+    // Временный буфер для результатов (нужен для правильной in-place обработки);
+    // лучи размещаются на тех же узлах NUMA, что и вход
+    SignalBuffer output_buffer(num_beams, num_samples, input_output->GetNumaPolicy());
+    
+    ThreadPool& pool = ThreadPool::Instance();
+    const int n = static_cast<int>(num_samples);
+    
+    // Задачи луча выполняются на узле его памяти; трафик: чтение + запись
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &input_output->GetBeamNodes();
+    hint.bytes_per_item = 2 * sizeof(SignalBuffer::ComplexType);
+    
+    // Тайлы (луч, отсчёты) по общему пулу: вход луча читается, пишется только output_buffer
+    pool.ParallelFor2D(num_beams, num_samples, DELAY_TILE,
+        [&](size_t beam, size_t begin, size_t end) {
+            const FractionalDelayParams& params = delay_params[beam];
+            // Строка матрицы Лагранжа для этого луча (без проверок на каждый отсчёт)
+            const float* coeffs = lagrange_matrix->GetData() + params.lagrange_row * LAGRANGE_COLS;
+            DelayBeamRange(input_output->GetBeamData(beam), output_buffer.GetBeamData(beam),
+                           n, params, coeffs, static_cast<int>(begin), static_cast<int>(end));
+        }, hint);
+    
+    // Копировать результаты обратно в SignalBuffer (in-place)
+    pool.ParallelFor2D(num_beams, num_samples, DELAY_TILE,
+        [&](size_t beam, size_t begin, size_t end) {
+            const SignalBuffer::ComplexType* src = output_buffer.GetBeamData(beam);
+            std::copy(src + begin, src + end, input_output->GetBeamData(beam) + begin);
+        }, hint);
+    
+    return true;
+}
+
+
+void FractionalDelayBeamCPU(
+    const SignalBuffer::ComplexType* input,
+    SignalBuffer::ComplexType* output,
+    size_t num_samples,
+    float delay,
+    const float* lagrange_data) {
+    
+    const FractionalDelayParams params = ComputeDelayParams(delay);
+    const int n = static_cast<int>(num_samples);
+    DelayBeamRange(input, output, n, params, lagrange_data + params.lagrange_row * LAGRANGE_COLS, 0, n);
+}
+
+SignalBuffer::ComplexType FractionalDelaySampleCPU(
+    const SignalBuffer::ComplexType* input,
+    size_t num_samples,
+    float delay,
+    const float* lagrange_data,
+    size_t sample) {
+    
+    const FractionalDelayParams params = ComputeDelayParams(delay);
+    const float* coeffs = lagrange_data + params.lagrange_row * LAGRANGE_COLS;
+    const int n = static_cast<int>(num_samples);
+    const int d = params.delay_integer;
+    const int s = static_cast<int>(sample);
+    
+    // Та же граница внутренней области, что в DelayBeamRange
+    if (s >= d + 2 && s < n + d - 2) {
+        return InteriorSample(input, d, coeffs, s);
+    }
+    return EdgeSample(input, n, d, coeffs, s);
+}
+
+bool ExecuteFractionalDelayCPUPacked(
+    SignalBuffer* input_output,
+    const LagrangeMatrix* lagrange_matrix,
+    const float* delay_coefficients,
+    size_t num_beams,
+    size_t num_samples) {
+    
+    if (!input_output || !lagrange_matrix || !delay_coefficients) {
+        std::cerr << "Ошибка: неверные параметры для ExecuteFractionalDelayCPUPacked" << std::endl;
+        return false;
+    }
+    
+    if (!lagrange_matrix->IsValid()) {
+        std::cerr << "Ошибка: матрица Лагранжа не валидна" << std::endl;
+        return false;
+    }
+    
+    if (!input_output->HasPackedData()) {
+        std::cerr << "Ошибка: буфер не содержит упакованных данных" << std::endl;
+        return false;
+    }
+    
+    if (input_output->GetNumBeams() != num_beams || 
+        input_output->GetNumSamples() != num_samples) {
+        std::cerr << "Ошибка: несоответствие размеров буфера" << std::endl;
+        return false;
+    }
+    
+    const SampleFormat format = input_output->GetPackedFormat();
     
-    // Для каждого луча
     for (size_t beam = 0; beam < num_beams; ++beam) {
-        const SignalBuffer::ComplexType* input_data = input_output->GetBeamData(beam);
-        if (!input_data) {
-            std::cerr << "Ошибка: не удалось получить данные для луча " << beam << std::endl;
+        if (!input_output->GetPackedBeamData(beam)) {
+            std::cerr << "Ошибка: не удалось получить упакованные данные для луча " << beam << std::endl;
             return false;
         }
+    }
+    
+    // Луч обрабатывается на узле своей упакованной памяти; трафик: чтение + запись
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &input_output->GetBeamNodes();
+    hint.bytes_per_item = 2 * num_samples * 2 * sizeof(uint16_t);
+    
+    ThreadPool::Instance().ParallelFor(num_beams, 1, [&](size_t begin, size_t end) {
+        // Временный буфер на один луч (вход луча нужен целиком до конца прохода)
+        std::vector<uint16_t> beam_output(num_samples * 2);
         
-        const DelayParams& params = delay_params[beam];
-        int delay_integer = params.delay_integer;
-        int lagrange_row = params.lagrange_row;
+        for (size_t beam = begin; beam < end; ++beam) {
+            uint16_t* beam_data = input_output->GetPackedBeamData(beam);
+            FractionalDelayPackedBeamCPU(beam_data, beam_output.data(), num_samples, format,
+                                         delay_coefficients[beam], lagrange_matrix->GetData());
+            std::copy(beam_output.begin(), beam_output.end(), beam_data);
+        }
+    }, hint);
+    
+    return true;
+}
+
+bool ExecuteFractionalDelayFanOutCPU(
+    const SignalBuffer& input,
+    const LagrangeMatrix* lagrange_matrix,
+    const float* delay_sets,
+    size_t num_delay_sets,
+    std::vector<SignalBuffer>* outputs) {
+    
+    if (!lagrange_matrix || !delay_sets || !outputs || num_delay_sets == 0) {
+        std::cerr << "Ошибка: неверные параметры для ExecuteFractionalDelayFanOutCPU" << std::endl;
+        return false;
+    }
+    
+    if (!lagrange_matrix->IsValid()) {
+        std::cerr << "Ошибка: матрица Лагранжа не валидна" << std::endl;
+        return false;
+    }
+    
+    const size_t num_beams = input.GetNumBeams();
+    const size_t num_samples = input.GetNumSamples();
+    
+    // Тайл 4096 отсчётов (32 KB) + ореол до 4096: окно помещается в L2
+    const int TILE = 4096;
+    const int MAX_SPAN = 4096;
+    
+    FanOutPlan plan;
+    if (!BuildFanOutPlan(delay_sets, num_delay_sets, num_beams, MAX_SPAN, &plan)) {
+        return false;
+    }
+    
+    outputs->resize(num_delay_sets);
+    for (auto& output : *outputs) {
+        if (output.GetNumBeams() != num_beams || output.GetNumSamples() != num_samples ||
+            output.beams_.size() != num_beams) {
+            output.SetNumaPolicy(input.GetNumaPolicy());
+            output.Resize(num_beams, num_samples);
+        }
+    }
+    
+    for (const FanOutGroup& group : plan.groups) {
+        if (!input.GetBeamData(group.beam)) {
+            return false;
+        }
+    }
+    
+    const int n = static_cast<int>(num_samples);
+    
+    // Группа выполняется на узле NUMA своего луча
+    std::vector<int> group_nodes;
+    if (!input.GetBeamNodes().empty()) {
+        for (const FanOutGroup& group : plan.groups) {
+            group_nodes.push_back(input.GetBeamNodes()[group.beam]);
+        }
+    }
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &group_nodes;
+    
+    // Группы пишут в непересекающиеся (набор, луч): параллельно по группам
+    ThreadPool::Instance().ParallelFor(plan.groups.size(), 1, [&](size_t first_group, size_t last_group) {
+        std::vector<SignalBuffer::ComplexType> window(TILE + MAX_SPAN + LAGRANGE_COLS);
         
-        // Для каждого отсчёта в луче
-        for (size_t sample = 0; sample < num_samples; ++sample) {
-            // Индекс для интерполяции (с целой частью задержки)
-            // Используем 5 точек: [n-2, n-1, n, n+1, n+2]
-            int interp_idx = static_cast<int>(sample) - delay_integer - 2;
+        for (size_t g = first_group; g < last_group; ++g) {
+            const FanOutGroup& group = plan.groups[g];
+            const SignalBuffer::ComplexType* beam_data = input.GetBeamData(group.beam);
             
-            // Интерполяция Лагранжа (5 точек)
-            SignalBuffer::ComplexType result(0.0f, 0.0f);
-            
-            for (int i = 0; i < static_cast<int>(LAGRANGE_COLS); ++i) {
-                int idx = interp_idx + i;
+            for (int tile_start = 0; tile_start < n; tile_start += TILE) {
+                const int tile_end = std::min(n, tile_start + TILE);
                 
-                // Обработка граничных условий (отражение, как в GPU kernel)
-                if (idx < 0) {
-                    idx = -idx;  // Отражение от начала
-                }
-                if (idx >= static_cast<int>(num_samples)) {
-                    idx = 2 * static_cast<int>(num_samples) - idx - 2;  // Отражение от конца
+                // Окно входа с ореолом: отражение границ разрешается один раз при загрузке
+                const int window_start = tile_start - group.max_delay_integer - 2;
+                const int window_len = (tile_end - tile_start) +
+                    group.max_delay_integer - group.min_delay_integer + 4;
+                for (int i = 0; i < window_len; ++i) {
+                    int idx = window_start + i;
+                    if (idx < 0) {
+                        idx = -idx;
+                    }
+                    if (idx >= n) {
+                        idx = 2 * n - idx - 2;
+                    }
+                    window[i] = (idx >= 0 && idx < n) ? beam_data[idx] : SignalBuffer::ComplexType(0.0f, 0.0f);
                 }
                 
-                // Безопасное извлечение отсчёта
-                if (idx >= 0 && idx < static_cast<int>(num_samples)) {
-                    SignalBuffer::ComplexType sample_data = input_data[idx];
-                    
-                    // Коэффициент из матрицы Лагранжа
-                    float coeff = lagrange_matrix->GetCoefficient(
-                        static_cast<size_t>(lagrange_row), 
-                        static_cast<size_t>(i)
-                    );
+                // Все наборы группы считаются из одного окна
+                for (int e = 0; e < group.num_entries; ++e) {
+                    const FanOutEntry& entry = plan.entries[group.first_entry + e];
+                    const float* coeffs = lagrange_matrix->GetData() + entry.lagrange_row * LAGRANGE_COLS;
+                    SignalBuffer::ComplexType* out = (*outputs)[entry.set_index].GetBeamData(group.beam);
+                    const SignalBuffer::ComplexType* src =
+                        window.data() + (group.max_delay_integer - entry.delay_integer);
                     
-                    // Применить коэффициент к комплексному числу
-                    result += coeff * sample_data;
+                    for (int sample = tile_start; sample < tile_end; ++sample) {
+                        const SignalBuffer::ComplexType* taps = src + (sample - tile_start);
+                        out[sample] = coeffs[0] * taps[0] + coeffs[1] * taps[1] + coeffs[2] * taps[2] +
+                                      coeffs[3] * taps[3] + coeffs[4] * taps[4];
+                    }
                 }
             }
-            
-            // Сохранить результат во временный буфер
-            size_t output_idx = beam * num_samples + sample;
-            output_buffer[output_idx] = result;
         }
+    }, hint);
+    
+    return true;
+}
+
+bool EvaluatePackedDelayError(
+    const SignalBuffer& input,
+    const SignalBuffer& float_reference,
+    const LagrangeMatrix* lagrange_matrix,
+    const float* delay_coefficients,
+    SampleFormat format,
+    float tolerance,
+    PackedPrecisionReport* report,
+    SignalBuffer* packed_result) {
+    
+    if (!report || format == SampleFormat::FLOAT32) {
+        std::cerr << "Ошибка: неверные параметры для EvaluatePackedDelayError" << std::endl;
+        return false;
     }
     
-    // Копировать результаты обратно в SignalBuffer (in-place)
+    const size_t num_beams = input.GetNumBeams();
+    const size_t num_samples = input.GetNumSamples();
+    
+    // Копия на тех же узлах NUMA, что и вход (упакованные лучи наследуют размещение)
+    SignalBuffer packed(num_beams, num_samples, input.GetNumaPolicy());
     for (size_t beam = 0; beam < num_beams; ++beam) {
-        SignalBuffer::ComplexType* output_data = input_output->GetBeamData(beam);
-        if (!output_data) {
-            std::cerr << "Ошибка: не удалось получить выходной буфер для луча " << beam << std::endl;
+        if (!input.GetBeamData(beam) || !packed.GetBeamData(beam)) {
             return false;
         }
-        
-        for (size_t sample = 0; sample < num_samples; ++sample) {
-            size_t idx = beam * num_samples + sample;
-            output_data[sample] = output_buffer[idx];
-        }
     }
     
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &packed.GetBeamNodes();
+    hint.bytes_per_item = 2 * sizeof(SignalBuffer::ComplexType);
+    ThreadPool::Instance().ParallelFor2D(num_beams, num_samples, DELAY_TILE,
+        [&](size_t beam, size_t begin, size_t end) {
+            const auto* src = input.GetBeamData(beam);
+            std::copy(src + begin, src + end, packed.GetBeamData(beam) + begin);
+        }, hint);
+    
+    if (!packed.Pack(format)) {
+        return false;
+    }
+    packed.ReleaseFloatData();
+    
+    if (!ExecuteFractionalDelayCPUPacked(&packed, lagrange_matrix, delay_coefficients,
+                                         num_beams, num_samples) ||
+        !packed.Unpack()) {
+        return false;
+    }
+    
+    if (!EvaluatePackedResultError(float_reference, packed, format, packed.GetPackedScale(),
+                                   tolerance, report)) {
+        return false;
+    }
+    
+    if (packed_result) {
+        packed.ReleasePacked();
+        *packed_result = packed;
+    }
     return true;
 }
 
+bool EvaluatePackedResultError(
+    const SignalBuffer& float_reference,
+    const SignalBuffer& packed_result,
+    SampleFormat format,
+    float scale,
+    float tolerance,
+    PackedPrecisionReport* report) {
+    
+    if (!report || format == SampleFormat::FLOAT32) {
+        std::cerr << "Ошибка: неверные параметры для EvaluatePackedResultError" << std::endl;
+        return false;
+    }
+    
+    const size_t num_beams = float_reference.GetNumBeams();
+    const size_t num_samples = float_reference.GetNumSamples();
+    
+    report->format = format;
+    report->scale = scale;
+    report->bytes_per_sample = SignalBuffer::BytesPerSample(format);
+    
+    if (!CompareResults(&float_reference, &packed_result, tolerance, &report->metrics)) {
+        return false;
+    }
+    
+    // SNR относительно float пути (в double, чтобы не терять малые ошибки):
+    // частичные суммы по задачам (луч, тайл) складываются по порядку задач,
+    // поэтому результат не зависит от числа потоков
+    const size_t num_tiles = (num_samples + DELAY_TILE - 1) / DELAY_TILE;
+    std::vector<double> tile_signal(num_beams * num_tiles, 0.0);
+    std::vector<double> tile_error(num_beams * num_tiles, 0.0);
+    
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &float_reference.GetBeamNodes();
+    hint.bytes_per_item = 2 * sizeof(SignalBuffer::ComplexType);
+    ThreadPool::Instance().ParallelFor2D(num_beams, num_samples, DELAY_TILE,
+        [&](size_t beam, size_t begin, size_t end) {
+            const auto* ref = float_reference.GetBeamData(beam);
+            const auto* got = packed_result.GetBeamData(beam);
+            double signal = 0.0;
+            double error = 0.0;
+            for (size_t sample = begin; sample < end; ++sample) {
+                signal += std::norm(std::complex<double>(ref[sample]));
+                error += std::norm(std::complex<double>(got[sample]) - std::complex<double>(ref[sample]));
+            }
+            const size_t task = beam * num_tiles + begin / DELAY_TILE;
+            tile_signal[task] = signal;
+            tile_error[task] = error;
+        }, hint);
+    
+    double signal_power = 0.0;
+    double error_power = 0.0;
+    for (size_t task = 0; task < tile_signal.size(); ++task) {
+        signal_power += tile_signal[task];
+        error_power += tile_error[task];
+    }
+    report->snr_db = error_power > 0.0
+        ? 10.0 * std::log10(signal_power / error_power)
+        : std::numeric_limits<double>::infinity();
+    
+    return true;
+}
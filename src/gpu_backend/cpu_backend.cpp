@@ -0,0 +1,506 @@
+#include "gpu_backend/cpu_backend.h"
+#include "fractional_delay_cpu.h"
+#include "beamformer.h"
+#include "farrow_resampler.h"
+#include "decimator.h"
+#include "noise_generator.h"
+#include "tile_digest.h"
+#include "thread_pool.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <new>
+#include <algorithm>
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Выравнивание "памяти устройства": строка кэша / AVX-512
+constexpr size_t DEVICE_ALIGNMENT = 64;
+
+// Отсчётов в задаче поэлементного умножения (2 × 128 KB на тайл)
+constexpr size_t HADAMARD_TILE = 16384;
+
+// Отсчётов в задаче генерации шума (чётное: тайлы не делят вызовы Philox)
+constexpr size_t NOISE_TILE = 4096;
+
+std::string ReadCpuModelName() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.compare(0, 10, "model name") == 0) {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) {
+                size_t start = line.find_first_not_of(" \t", colon + 1);
+                return start == std::string::npos ? std::string() : line.substr(start);
+            }
+        }
+    }
+    return "CPU";
+}
+
+size_t ReadPhysicalMemory() {
+#if defined(_SC_PHYS_PAGES) && defined(_SC_PAGE_SIZE)
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long page_size = sysconf(_SC_PAGE_SIZE);
+    if (pages > 0 && page_size > 0) {
+        return static_cast<size_t>(pages) * static_cast<size_t>(page_size);
+    }
+#endif
+    return 0;
+}
+
+} // namespace
+
+CpuBackend::CpuBackend()
+    : initialized_(false), memory_size_(0), lagrange_matrix_uploaded_(false),
+      fir_requested_method_(FirMethod::AUTO) {
+}
+
+CpuBackend::~CpuBackend() {
+    Cleanup();
+}
+
+bool CpuBackend::Initialize() {
+    if (initialized_) {
+        return true;
+    }
+
+    device_name_ = ReadCpuModelName();
+    memory_size_ = ReadPhysicalMemory();
+    initialized_ = true;
+    return true;
+}
+
+void CpuBackend::Cleanup() {
+    if (!initialized_) {
+        return;
+    }
+
+    fft_plan_.reset();
+    fir_plan_ = FirPlanCPU();
+    lagrange_matrix_.clear();
+    lagrange_matrix_uploaded_ = false;
+    initialized_ = false;
+}
+
+void* CpuBackend::AllocateDeviceMemory(size_t size_bytes) {
+    if (!initialized_) {
+        std::cerr << "Ошибка: backend не инициализирован" << std::endl;
+        return nullptr;
+    }
+
+    try {
+        return ::operator new(size_bytes, std::align_val_t(DEVICE_ALIGNMENT));
+    } catch (const std::bad_alloc&) {
+        std::cerr << "Ошибка при выделении памяти: " << size_bytes << " байт" << std::endl;
+        return nullptr;
+    }
+}
+
+void CpuBackend::FreeDeviceMemory(void* ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+    ::operator delete(ptr, std::align_val_t(DEVICE_ALIGNMENT));
+}
+
+bool CpuBackend::CopyHostToDevice(void* dst, const void* src, size_t size_bytes) {
+    if (!initialized_ || dst == nullptr || src == nullptr) {
+        return false;
+    }
+    if (dst != src) {
+        std::memcpy(dst, src, size_bytes);
+    }
+    return true;
+}
+
+bool CpuBackend::CopyDeviceToHost(void* dst, const void* src, size_t size_bytes) {
+    if (!initialized_ || dst == nullptr || src == nullptr) {
+        return false;
+    }
+    if (dst != src) {
+        std::memcpy(dst, src, size_bytes);
+    }
+    return true;
+}
+
+bool CpuBackend::CopyDeviceToHostRegion(void* dst, const void* src, size_t offset_bytes, size_t size_bytes) {
+    if (!initialized_ || dst == nullptr || src == nullptr) {
+        return false;
+    }
+    std::memcpy(dst, static_cast<const char*>(src) + offset_bytes, size_bytes);
+    return true;
+}
+
+bool CpuBackend::ExecuteFractionalDelay(
+    void* device_buffer,
+    const float* delay_coefficients,
+    size_t num_beams,
+    size_t num_samples) {
+
+    if (!initialized_ || device_buffer == nullptr || delay_coefficients == nullptr) {
+        return false;
+    }
+
+    if (!lagrange_matrix_uploaded_) {
+        std::cerr << "Ошибка: матрица Лагранжа не загружена" << std::endl;
+        return false;
+    }
+
+    ComplexType* data = static_cast<ComplexType*>(device_buffer);
+
+    // Куски лучей по пулу; результат луча во временный буфер, затем обратно (in-place)
+    ThreadPool::Instance().ParallelFor(num_beams, 1, [&](size_t begin, size_t end) {
+        std::vector<ComplexType> delayed(num_samples);
+        for (size_t beam = begin; beam < end; ++beam) {
+            ComplexType* beam_data = data + beam * num_samples;
+            FractionalDelayBeamCPU(beam_data, delayed.data(), num_samples,
+                                   delay_coefficients[beam], lagrange_matrix_.data());
+            std::memcpy(beam_data, delayed.data(), num_samples * sizeof(ComplexType));
+        }
+    });
+
+    return true;
+}
+
+bool CpuBackend::ExecuteFractionalDelayPacked(
+    const void* device_input,
+    void* device_output,
+    SampleFormat format,
+    const float* delay_coefficients,
+    size_t num_beams,
+    size_t num_samples) {
+
+    if (!initialized_ || device_input == nullptr || device_output == nullptr ||
+        delay_coefficients == nullptr) {
+        return false;
+    }
+
+    if (format != SampleFormat::INT16_IQ && format != SampleFormat::FP16) {
+        std::cerr << "Ошибка: ExecuteFractionalDelayPacked ожидает INT16_IQ или FP16" << std::endl;
+        return false;
+    }
+
+    if (device_input == device_output) {
+        std::cerr << "Ошибка: упакованная дробная задержка требует отдельный выходной буфер" << std::endl;
+        return false;
+    }
+
+    if (!lagrange_matrix_uploaded_) {
+        std::cerr << "Ошибка: матрица Лагранжа не загружена" << std::endl;
+        return false;
+    }
+
+    // Отсчёт - пара uint16 (I, Q); вход и выход раздельные, временный буфер не нужен
+    const uint16_t* input = static_cast<const uint16_t*>(device_input);
+    uint16_t* output = static_cast<uint16_t*>(device_output);
+    ThreadPool::Instance().ParallelFor(num_beams, 1, [&](size_t begin, size_t end) {
+        for (size_t beam = begin; beam < end; ++beam) {
+            FractionalDelayPackedBeamCPU(input + beam * num_samples * 2, output + beam * num_samples * 2,
+                                         num_samples, format, delay_coefficients[beam],
+                                         lagrange_matrix_.data());
+        }
+    });
+
+    return true;
+}
+
+bool CpuBackend::ExecuteDelayAndSum(
+    const void* device_input,
+    void* device_output,
+    const float* delays,
+    const ComplexType* weights,
+    size_t num_elements,
+    size_t num_directions,
+    size_t num_samples) {
+
+    if (!initialized_ || device_input == nullptr || device_output == nullptr) {
+        return false;
+    }
+
+    if (!lagrange_matrix_uploaded_) {
+        std::cerr << "Ошибка: матрица Лагранжа не загружена" << std::endl;
+        return false;
+    }
+
+    return ExecuteDelayAndSumCPU(
+        static_cast<const ComplexType*>(device_input), num_elements, num_samples,
+        lagrange_matrix_.data(), delays, weights, num_directions,
+        static_cast<ComplexType*>(device_output));
+}
+
+bool CpuBackend::ExecuteFIR(
+    const void* device_input,
+    void* device_output,
+    void* device_history,
+    const float* coefficients,
+    size_t num_taps,
+    FirMethod method,
+    size_t num_beams,
+    size_t num_samples) {
+
+    if (!initialized_ || device_input == nullptr || device_output == nullptr ||
+        coefficients == nullptr || num_taps == 0 || num_samples == 0) {
+        return false;
+    }
+    if (num_taps > 1 && device_history == nullptr) {
+        return false;
+    }
+
+    // План переиспользуется между блоками потока (меняется только при смене параметров)
+    if (fir_plan_.num_samples != num_samples || fir_requested_method_ != method ||
+        fir_plan_.coefficients.size() != num_taps ||
+        !std::equal(coefficients, coefficients + num_taps, fir_plan_.coefficients.begin())) {
+        if (!BuildFirPlanCPU(coefficients, num_taps, method, num_samples, &fir_plan_)) {
+            return false;
+        }
+        fir_requested_method_ = method;
+    }
+
+    const ComplexType* input = static_cast<const ComplexType*>(device_input);
+    ComplexType* output = static_cast<ComplexType*>(device_output);
+    ComplexType* history = static_cast<ComplexType*>(device_history);
+    const size_t history_size = fir_plan_.GetHistorySize();
+    const FirPlanCPU& plan = fir_plan_;
+
+    ThreadPool::Instance().ParallelFor(num_beams, 1, [&](size_t begin, size_t end) {
+        for (size_t beam = begin; beam < end; ++beam) {
+            FirFilterBeamCPU(plan, history + beam * history_size,
+                             input + beam * num_samples, output + beam * num_samples);
+        }
+    });
+
+    return true;
+}
+
+bool CpuBackend::ExecuteResample(
+    const void* device_input,
+    void* device_output,
+    void* device_history,
+    const float* delays,
+    size_t history_size,
+    const ResampleBlock& block,
+    double step,
+    size_t num_beams,
+    size_t num_input_samples) {
+
+    if (!initialized_ || device_input == nullptr || device_output == nullptr ||
+        device_history == nullptr || delays == nullptr || !(step > 0.0)) {
+        return false;
+    }
+
+    const ComplexType* input = static_cast<const ComplexType*>(device_input);
+    ComplexType* output = static_cast<ComplexType*>(device_output);
+    ComplexType* history = static_cast<ComplexType*>(device_history);
+
+    const size_t num_output_samples = block.num_output_samples;
+    ThreadPool::Instance().ParallelFor(num_beams, 1, [&](size_t begin, size_t end) {
+        for (size_t beam = begin; beam < end; ++beam) {
+            FarrowResampleBeamCPU(history + beam * history_size, history_size,
+                                  input + beam * num_input_samples, num_input_samples,
+                                  block, step, delays[beam],
+                                  output + beam * num_output_samples);
+        }
+    });
+
+    return true;
+}
+
+bool CpuBackend::ExecuteDecimate(
+    const void* device_input,
+    void* device_output,
+    void* device_history,
+    const float* coefficients,
+    size_t num_taps,
+    size_t factor,
+    size_t first_position,
+    size_t num_beams,
+    size_t num_input_samples,
+    size_t num_output_samples) {
+
+    if (!initialized_ || device_input == nullptr || device_output == nullptr ||
+        coefficients == nullptr || num_taps == 0 || factor == 0 || first_position + 1 < num_taps) {
+        return false;
+    }
+    if (num_taps > 1 && device_history == nullptr) {
+        return false;
+    }
+
+    const size_t history_size = num_taps - 1;
+    const ComplexType* input = static_cast<const ComplexType*>(device_input);
+    ComplexType* output = static_cast<ComplexType*>(device_output);
+    ComplexType* history = static_cast<ComplexType*>(device_history);
+
+    ThreadPool::Instance().ParallelFor(num_beams, 1, [&](size_t begin, size_t end) {
+        for (size_t beam = begin; beam < end; ++beam) {
+            DecimateBeamCPU(coefficients, num_taps, factor,
+                            history + beam * history_size,
+                            input + beam * num_input_samples, num_input_samples, first_position,
+                            output + beam * num_output_samples, num_output_samples);
+        }
+    });
+
+    return true;
+}
+
+bool CpuBackend::ExecuteAddNoise(
+    void* device_buffer,
+    uint64_t seed,
+    float sigma,
+    size_t num_beams,
+    size_t num_samples) {
+
+    if (!initialized_ || device_buffer == nullptr) {
+        return false;
+    }
+
+    ComplexType* data = static_cast<ComplexType*>(device_buffer);
+    ThreadPool::Instance().ParallelFor2D(num_beams, num_samples, NOISE_TILE, [&](size_t beam, size_t begin, size_t end) {
+        GenerateGaussianNoiseCPU(seed, beam, begin, sigma, data + beam * num_samples + begin, end - begin, true);
+    });
+
+    return true;
+}
+
+bool CpuBackend::ExecuteFFT(
+    void* device_buffer,
+    size_t num_beams,
+    size_t num_samples,
+    bool forward) {
+
+    if (!initialized_ || device_buffer == nullptr || num_samples == 0) {
+        return false;
+    }
+
+    if (!fft_plan_ || fft_plan_->GetSize() != num_samples) {
+        fft_plan_.reset(new CpuFFT(num_samples));
+    }
+
+    ComplexType* data = static_cast<ComplexType*>(device_buffer);
+    const CpuFFT& plan = *fft_plan_;
+
+    ThreadPool::Instance().ParallelFor(num_beams, 1, [&](size_t begin, size_t end) {
+        for (size_t beam = begin; beam < end; ++beam) {
+            plan.Execute(data + beam * num_samples, forward);
+        }
+    });
+
+    return true;
+}
+
+bool CpuBackend::ExecuteHadamardMultiply(
+    void* device_buffer,
+    const void* reference_fft,
+    size_t num_beams,
+    size_t num_samples) {
+
+    if (!initialized_ || device_buffer == nullptr || reference_fft == nullptr) {
+        return false;
+    }
+
+    ComplexType* data = static_cast<ComplexType*>(device_buffer);
+    const ComplexType* reference = static_cast<const ComplexType*>(reference_fft);
+
+    // Тайлы (луч, отсчёты): параллельно и при малом числе длинных лучей
+    ThreadPool::Instance().ParallelFor2D(num_beams, num_samples, HADAMARD_TILE,
+        [&](size_t beam, size_t begin, size_t end) {
+            // Раздельные re/im операции: без проверок NaN/Inf из operator* (векторизуется)
+            float* beam_data = reinterpret_cast<float*>(data + beam * num_samples);
+            const float* ref = reinterpret_cast<const float*>(reference);
+            for (size_t i = begin; i < end; ++i) {
+                float a = beam_data[2 * i];
+                float b = beam_data[2 * i + 1];
+                float c = ref[2 * i];
+                float d = ref[2 * i + 1];
+                beam_data[2 * i] = a * c - b * d;
+                beam_data[2 * i + 1] = a * d + b * c;
+            }
+        });
+
+    return true;
+}
+
+bool CpuBackend::ExecuteHeterodyne(
+    void* device_buffer,
+    const void* device_reference,
+    size_t num_reference_beams,
+    size_t num_beams,
+    size_t num_samples) {
+
+    if (!initialized_ || device_buffer == nullptr || device_reference == nullptr ||
+        (num_reference_beams != 1 && num_reference_beams != num_beams)) {
+        return false;
+    }
+
+    ComplexType* data = static_cast<ComplexType*>(device_buffer);
+    const ComplexType* reference = static_cast<const ComplexType*>(device_reference);
+    const size_t reference_stride = num_reference_beams == 1 ? 0 : num_samples;
+
+    ThreadPool::Instance().ParallelFor2D(num_beams, num_samples, HADAMARD_TILE,
+        [&](size_t beam, size_t begin, size_t end) {
+            float* beam_data = reinterpret_cast<float*>(data + beam * num_samples);
+            const float* ref = reinterpret_cast<const float*>(reference + beam * reference_stride);
+            for (size_t i = begin; i < end; ++i) {
+                float a = beam_data[2 * i];
+                float b = beam_data[2 * i + 1];
+                float c = ref[2 * i];
+                float d = ref[2 * i + 1];
+                beam_data[2 * i] = a * c + b * d;
+                beam_data[2 * i + 1] = b * c - a * d;
+            }
+        });
+
+    return true;
+}
+
+bool CpuBackend::ExecuteTileDigests(
+    const void* device_buffer,
+    float quantum,
+    size_t tile_samples,
+    size_t num_beams,
+    size_t num_samples,
+    uint64_t* digests) {
+
+    if (!initialized_ || device_buffer == nullptr || digests == nullptr ||
+        !(quantum > 0.0f) || tile_samples == 0) {
+        return false;
+    }
+
+    const ComplexType* data = static_cast<const ComplexType*>(device_buffer);
+    const size_t tiles_per_beam = DigestTilesPerBeam(num_samples, tile_samples);
+    const float inv_quantum = 1.0f / quantum;
+
+    ThreadPool::Instance().ParallelFor2D(num_beams, num_samples, tile_samples,
+        [&](size_t beam, size_t begin, size_t end) {
+            digests[beam * tiles_per_beam + begin / tile_samples] =
+                TileDigest(data + beam * num_samples + begin, begin, end - begin, inv_quantum);
+        });
+
+    return true;
+}
+
+std::string CpuBackend::GetBackendName() const {
+    return "CPU (" + std::to_string(ThreadPool::Instance().GetNumThreads()) + " потоков)";
+}
+
+std::string CpuBackend::GetDeviceName() const {
+    return device_name_;
+}
+
+size_t CpuBackend::GetDeviceMemorySize() const {
+    return memory_size_;
+}
+
+bool CpuBackend::UploadLagrangeMatrix(const float* lagrange_data) {
+    if (!initialized_ || lagrange_data == nullptr) {
+        return false;
+    }
+
+    lagrange_matrix_.assign(lagrange_data, lagrange_data + 48 * 5);
+    lagrange_matrix_uploaded_ = true;
+    return true;
+}
@@ -1,27 +1,107 @@
 #include "gpu_backend/gpu_factory.h"
+#include "gpu_backend/cpu_backend.h"
+#if OPENCL_ENABLED
 #include "gpu_backend/opencl_backend.h"
 #include <CL/cl.hpp>
+#endif
 #include <iostream>
+#include <cstdlib>
+#include <string>
+#include <algorithm>
+#include <cctype>
 
-std::unique_ptr<IGPUBackend> GPUFactory::CreateBackend() {
+namespace {
+
+// LCH_FARROW_BACKEND=cpu|opencl (регистр не важен)
+BackendType BackendTypeFromEnvironment(BackendType requested) {
+    if (requested != BackendType::AUTO) {
+        return requested;
+    }
+    const char* env = std::getenv("LCH_FARROW_BACKEND");
+    if (env == nullptr || env[0] == '\0') {
+        return requested;
+    }
+    std::string value(env);
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (value == "cpu") {
+        return BackendType::CPU;
+    }
+    if (value == "opencl") {
+        return BackendType::OPENCL;
+    }
+    std::cerr << "Предупреждение: неизвестное значение LCH_FARROW_BACKEND=" << env
+              << ", используем автоматический выбор" << std::endl;
+    return requested;
+}
+
+} // namespace
+
+std::unique_ptr<IGPUBackend> GPUFactory::CreateBackend(BackendType type) {
+    type = BackendTypeFromEnvironment(type);
+    
+    if (type == BackendType::CPU) {
+        return CreateCpuBackend();
+    }
+    
     // Приоритет: OpenCL
     if (IsOpenCLAvailable()) {
-        return CreateOpenCLBackend();
+        auto backend = CreateOpenCLBackend();
+        if (backend || type == BackendType::OPENCL) {
+            return backend;
+        }
+        std::cerr << "Предупреждение: OpenCL backend не инициализирован, используем CPU" << std::endl;
+    } else if (type == BackendType::OPENCL) {
+        std::cerr << "Ошибка: OpenCL устройство не найдено" << std::endl;
+        return nullptr;
+    } else {
+        std::cout << "OpenCL устройство не найдено, используем CPU backend" << std::endl;
     }
     
-    std::cerr << "Ошибка: не найдено доступных GPU backend" << std::endl;
-    return nullptr;
+    return CreateCpuBackend();
 }
 
 std::unique_ptr<IGPUBackend> GPUFactory::CreateOpenCLBackend() {
+#if OPENCL_ENABLED
     auto backend = std::make_unique<OpenCLBackend>();
     if (backend->Initialize()) {
         return backend;
     }
+#endif
+    return nullptr;
+}
+
+std::vector<std::unique_ptr<IGPUBackend>> GPUFactory::CreateOpenCLBackends(bool include_cpu_devices) {
+    std::vector<std::unique_ptr<IGPUBackend>> backends;
+#if OPENCL_ENABLED
+    const cl_device_type device_type = include_cpu_devices
+        ? (CL_DEVICE_TYPE_GPU | CL_DEVICE_TYPE_ACCELERATOR | CL_DEVICE_TYPE_CPU)
+        : (CL_DEVICE_TYPE_GPU | CL_DEVICE_TYPE_ACCELERATOR);
+    for (const cl::Device& device : OpenCLBackend::EnumerateDevices(device_type)) {
+        auto backend = std::make_unique<OpenCLBackend>(device);
+        if (backend->Initialize()) {
+            backends.push_back(std::move(backend));
+        } else {
+            std::cerr << "Предупреждение: устройство " << device.getInfo<CL_DEVICE_NAME>()
+                      << " не инициализировано, пропускаем" << std::endl;
+        }
+    }
+#else
+    (void)include_cpu_devices;
+#endif
+    return backends;
+}
+
+std::unique_ptr<IGPUBackend> GPUFactory::CreateCpuBackend() {
+    auto backend = std::make_unique<CpuBackend>();
+    if (backend->Initialize()) {
+        return backend;
+    }
     return nullptr;
 }
 
 bool GPUFactory::IsOpenCLAvailable() {
+#if OPENCL_ENABLED
     try {
         std::vector<cl::Platform> platforms;
         cl::Platform::get(&platforms);
@@ -41,9 +121,12 @@ bool GPUFactory::IsOpenCLAvailable() {
         
         return false;
     } catch (const cl::Error& e) {
+        // Нет платформ (CL_PLATFORM_NOT_FOUND_KHR) или устройств - не ошибка для AUTO
         std::cerr << "Ошибка OpenCL при проверке доступности: " << e.what() 
                   << " (код: " << e.err() << ")" << std::endl;
         return false;
     }
+#else
+    return false;
+#endif
 }
-
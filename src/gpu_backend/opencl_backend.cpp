@@ -1,18 +1,104 @@
 #include "gpu_backend/opencl_backend.h"
+#include "delay_fanout.h"
+#include "fractional_delay_cpu.h"
+#include "cpu_fft.h"
+#include "thread_pool.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace {
+
+/**
+ * @brief Расширение есть в строке CL_DEVICE_EXTENSIONS (точное совпадение имени)
+ */
+bool HasExtension(const std::string& extensions, const std::string& name) {
+    std::istringstream tokens(extensions);
+    std::string token;
+    while (tokens >> token) {
+        if (token == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+#if CLFFT_FOUND
+namespace {
+
+// clFFT - одна библиотека на процесс, а backend'ов может быть несколько
+// (по одному на устройство): setup при первом, teardown при последнем
+std::mutex clfft_mutex;
+size_t clfft_users = 0;
+
+bool AcquireClFFT() {
+    std::lock_guard<std::mutex> lock(clfft_mutex);
+    if (clfft_users == 0) {
+        cl_int status = clfftSetup(nullptr);
+        if (status != CLFFT_SUCCESS) {
+            std::cerr << "Ошибка инициализации clFFT: " << status << std::endl;
+            return false;
+        }
+    }
+    ++clfft_users;
+    return true;
+}
+
+void ReleaseClFFT() {
+    std::lock_guard<std::mutex> lock(clfft_mutex);
+    if (clfft_users > 0 && --clfft_users == 0) {
+        clfftTeardown();
+    }
+}
+
+} // namespace
+#endif
 
 OpenCLBackend::OpenCLBackend()
-    : device_memory_size_(0), initialized_(false)
+    : device_preselected_(false), device_memory_size_(0), max_work_group_size_(0), initialized_(false)
 #if CLFFT_FOUND
     , fft_plan_forward_(0), fft_plan_inverse_(0), fft_plans_created_(false)
+    , fft_plan_samples_(0), fft_plan_batch_(0), clfft_acquired_(false)
 #endif
     , lagrange_matrix_uploaded_(false)
 {
 }
 
+OpenCLBackend::OpenCLBackend(const cl::Device& device)
+    : OpenCLBackend() {
+    device_ = device;
+    device_preselected_ = true;
+}
+
+std::vector<cl::Device> OpenCLBackend::EnumerateDevices(cl_device_type device_type) {
+    std::vector<cl::Device> result;
+    try {
+        std::vector<cl::Platform> platforms;
+        cl::Platform::get(&platforms);
+        for (const auto& plat : platforms) {
+            std::vector<cl::Device> devices;
+            try {
+                plat.getDevices(device_type, &devices);
+            } catch (cl::Error&) {
+                continue;  // CL_DEVICE_NOT_FOUND - на платформе нет устройств этого типа
+            }
+            result.insert(result.end(), devices.begin(), devices.end());
+        }
+    } catch (cl::Error& e) {
+        std::cerr << "Ошибка при перечислении OpenCL устройств: " << e.what() 
+                  << " (код: " << e.err() << ")" << std::endl;
+    }
+    return result;
+}
+
 OpenCLBackend::~OpenCLBackend() {
     Cleanup();
 }
@@ -38,12 +124,22 @@ bool OpenCLBackend::Initialize() {
             return false;
         }
         
+        // Очереди асинхронных потоков (in-order: H2D -> kernel -> D2H чанка по порядку)
+        stream_queues_.clear();
+        for (size_t stream = 0; stream < NUM_STREAMS; ++stream) {
+            stream_queues_.emplace_back(context_, device_, 0, &err);
+            if (!CheckError(err, "создание command queue потока")) {
+                return false;
+            }
+        }
+        
         // Инициализируем clFFT
 #if CLFFT_FOUND
-        cl_int clfft_err = clfftSetup(nullptr);
-        if (clfft_err != CLFFT_SUCCESS) {
-            std::cerr << "Ошибка инициализации clFFT: " << clfft_err << std::endl;
-            return false;
+        if (!clfft_acquired_) {
+            if (!AcquireClFFT()) {
+                return false;
+            }
+            clfft_acquired_ = true;
         }
 #endif
         
@@ -57,6 +153,11 @@ bool OpenCLBackend::Initialize() {
         cl_ulong mem_size;
         device_.getInfo(CL_DEVICE_GLOBAL_MEM_SIZE, &mem_size);
         device_memory_size_ = static_cast<size_t>(mem_size);
+        device_.getInfo(CL_DRIVER_VERSION, &driver_version_);
+        device_.getInfo(CL_DEVICE_MAX_WORK_GROUP_SIZE, &max_work_group_size_);
+        
+        // Загружаем кэш параметров запуска (автотюнер)
+        work_group_tuner_.Load();
         
         initialized_ = true;
         return true;
@@ -69,12 +170,21 @@ bool OpenCLBackend::Initialize() {
 
 void OpenCLBackend::Cleanup() {
     if (!initialized_) {
+#if CLFFT_FOUND
+        // Инициализация могла прерваться после подключения clFFT
+        if (clfft_acquired_) {
+            ReleaseClFFT();
+            clfft_acquired_ = false;
+        }
+#endif
         return;
     }
     
     // Удаляем FFT планы
     DestroyFFTPlans();
     
+    stream_queues_.clear();
+    
     // Освобождаем матрицу Лагранжа
     if (lagrange_matrix_uploaded_) {
         lagrange_matrix_buffer_ = cl::Buffer();  // Освобождаем
@@ -82,8 +192,9 @@ void OpenCLBackend::Cleanup() {
     }
     
 #if CLFFT_FOUND
-    // Завершаем работу clFFT
-    clfftTeardown();
+    // Завершаем работу clFFT (последний backend процесса)
+    ReleaseClFFT();
+    clfft_acquired_ = false;
 #endif
     
     // OpenCL автоматически освобождает ресурсы при уничтожении объектов
@@ -163,6 +274,120 @@ bool OpenCLBackend::CopyDeviceToHost(void* dst, const void* src, size_t size_byt
     }
 }
 
+bool OpenCLBackend::CopyDeviceToHostRegion(void* dst, const void* src, size_t offset_bytes, size_t size_bytes) {
+    if (!initialized_ || dst == nullptr || src == nullptr) {
+        return false;
+    }
+    
+    try {
+        cl::Buffer* buffer = static_cast<cl::Buffer*>(const_cast<void*>(src));
+        cl_int err = queue_.enqueueReadBuffer(
+            *buffer,
+            CL_TRUE,  // blocking
+            offset_bytes,
+            size_bytes,
+            dst
+        );
+        return CheckError(err, "копирование части буфера D2H");
+    } catch (cl::Error& e) {
+        std::cerr << "Ошибка при копировании части буфера D2H: " << e.what() 
+                  << " (код: " << e.err() << ")" << std::endl;
+        return false;
+    }
+}
+
+size_t OpenCLBackend::GetNumStreams() const {
+    return stream_queues_.empty() ? 1 : stream_queues_.size();
+}
+
+bool OpenCLBackend::CopyHostToDeviceAsync(void* dst, const void* src, size_t size_bytes, size_t stream) {
+    if (!initialized_ || dst == nullptr || src == nullptr || stream >= stream_queues_.size()) {
+        return false;
+    }
+    
+    try {
+        cl::Buffer* buffer = static_cast<cl::Buffer*>(dst);
+        cl_int err = stream_queues_[stream].enqueueWriteBuffer(
+            *buffer,
+            CL_FALSE,  // non-blocking: src живёт до Synchronize(stream)
+            0,
+            size_bytes,
+            src
+        );
+        return CheckError(err, "асинхронное копирование H2D");
+    } catch (cl::Error& e) {
+        std::cerr << "Ошибка при асинхронном копировании H2D: " << e.what() 
+                  << " (код: " << e.err() << ")" << std::endl;
+        return false;
+    }
+}
+
+bool OpenCLBackend::CopyDeviceToHostAsync(void* dst, const void* src, size_t size_bytes, size_t stream) {
+    if (!initialized_ || dst == nullptr || src == nullptr || stream >= stream_queues_.size()) {
+        return false;
+    }
+    
+    try {
+        cl::Buffer* buffer = static_cast<cl::Buffer*>(const_cast<void*>(src));
+        cl_int err = stream_queues_[stream].enqueueReadBuffer(
+            *buffer,
+            CL_FALSE,
+            0,
+            size_bytes,
+            dst
+        );
+        return CheckError(err, "асинхронное копирование D2H");
+    } catch (cl::Error& e) {
+        std::cerr << "Ошибка при асинхронном копировании D2H: " << e.what() 
+                  << " (код: " << e.err() << ")" << std::endl;
+        return false;
+    }
+}
+
+bool OpenCLBackend::ExecuteFractionalDelayAsync(
+    void* device_buffer,
+    const float* delay_coefficients,
+    size_t num_beams,
+    size_t num_samples,
+    size_t stream) {
+    
+    if (!initialized_ || device_buffer == nullptr || delay_coefficients == nullptr ||
+        stream >= stream_queues_.size()) {
+        return false;
+    }
+    
+    if (!lagrange_matrix_uploaded_) {
+        std::cerr << "Ошибка: матрица Лагранжа не загружена на GPU" << std::endl;
+        return false;
+    }
+    
+    try {
+        // Параметры задержки копируются при создании буфера, kernel захватывает
+        // аргументы при постановке в очередь - хост ничего не ждёт
+        cl::Buffer* buffer = static_cast<cl::Buffer*>(device_buffer);
+        return EnqueueFractionalDelay(*buffer, delay_coefficients, num_beams, num_samples,
+                                      nullptr, stream_queues_[stream]);
+    } catch (cl::Error& e) {
+        std::cerr << "Ошибка при асинхронной fractional_delay: " << e.what() 
+                  << " (код: " << e.err() << ")" << std::endl;
+        return false;
+    }
+}
+
+bool OpenCLBackend::Synchronize(size_t stream) {
+    if (!initialized_ || stream >= stream_queues_.size()) {
+        return false;
+    }
+    
+    try {
+        return CheckError(stream_queues_[stream].finish(), "синхронизация потока");
+    } catch (cl::Error& e) {
+        std::cerr << "Ошибка при синхронизации потока: " << e.what() 
+                  << " (код: " << e.err() << ")" << std::endl;
+        return false;
+    }
+}
+
 bool OpenCLBackend::ExecuteFractionalDelay(
     void* device_buffer,
     const float* delay_coefficients,
@@ -180,79 +405,772 @@ bool OpenCLBackend::ExecuteFractionalDelay(
     
     try {
         cl::Buffer* buffer = static_cast<cl::Buffer*>(device_buffer);
+        if (!EnqueueFractionalDelay(*buffer, delay_coefficients, num_beams, num_samples, nullptr, queue_)) {
+            return false;
+        }
+        
+        // Синхронизируем
+        queue_.finish();
+        return true;
+    } catch (cl::Error& e) {
+        std::cerr << "Ошибка при выполнении fractional_delay: " << e.what() 
+                  << " (код: " << e.err() << ")" << std::endl;
+        return false;
+    }
+}
+
+bool OpenCLBackend::ExecuteFractionalDelayPacked(
+    const void* device_input,
+    void* device_output,
+    SampleFormat format,
+    const float* delay_coefficients,
+    size_t num_beams,
+    size_t num_samples) {
+    
+    if (!initialized_ || device_input == nullptr || device_output == nullptr ||
+        delay_coefficients == nullptr) {
+        return false;
+    }
+    
+    if (format != SampleFormat::INT16_IQ && format != SampleFormat::FP16) {
+        std::cerr << "Ошибка: ExecuteFractionalDelayPacked ожидает INT16_IQ или FP16" << std::endl;
+        return false;
+    }
+    
+    if (device_input == device_output) {
+        std::cerr << "Ошибка: упакованная дробная задержка требует отдельный выходной буфер" << std::endl;
+        return false;
+    }
+    
+    if (!lagrange_matrix_uploaded_) {
+        std::cerr << "Ошибка: матрица Лагранжа не загружена на GPU" << std::endl;
+        return false;
+    }
+    
+    try {
+        const cl::Buffer* input = static_cast<const cl::Buffer*>(device_input);
+        cl::Buffer* output = static_cast<cl::Buffer*>(device_output);
+        if (!EnqueueFractionalDelayPacked(*input, *output, format, delay_coefficients,
+                                          num_beams, num_samples, nullptr)) {
+            return false;
+        }
+        
+        queue_.finish();
+        return true;
+    } catch (cl::Error& e) {
+        std::cerr << "Ошибка при выполнении упакованной fractional_delay: " << e.what() 
+                  << " (код: " << e.err() << ")" << std::endl;
+        return false;
+    }
+}
+
+bool OpenCLBackend::ExecuteFractionalDelayFanOut(
+    const void* device_input,
+    void* device_output,
+    const float* delay_sets,
+    size_t num_delay_sets,
+    size_t num_beams,
+    size_t num_samples) {
+    
+    if (!initialized_ || device_input == nullptr || device_output == nullptr ||
+        delay_sets == nullptr || num_delay_sets == 0) {
+        return false;
+    }
+    
+    if (!lagrange_matrix_uploaded_) {
+        std::cerr << "Ошибка: матрица Лагранжа не загружена на GPU" << std::endl;
+        return false;
+    }
+    
+    // Разброс целых задержек в группе ограничен ореолом окна в локальной памяти
+    const int MAX_SPAN = 256;
+    
+    FanOutPlan plan;
+    if (!BuildFanOutPlan(delay_sets, num_delay_sets, num_beams, MAX_SPAN, &plan)) {
+        return false;
+    }
+    
+    try {
+        // Размер тайла = размер work group (степень 2, не больше 256)
+        size_t kernel_max_wg = 0;
+        cl_ulong local_mem_size = 0;
+        kernel_fractional_delay_fanout_.getWorkGroupInfo(device_, CL_KERNEL_WORK_GROUP_SIZE, &kernel_max_wg);
+        device_.getInfo(CL_DEVICE_LOCAL_MEM_SIZE, &local_mem_size);
+        
+        size_t tile = 256;
+        while (tile > 1 && (tile > kernel_max_wg || tile > max_work_group_size_ ||
+               (tile + MAX_SPAN + 4) * sizeof(ComplexType) > local_mem_size)) {
+            tile /= 2;
+        }
+        const size_t window_bytes = (tile + MAX_SPAN + 4) * sizeof(ComplexType);
         
-        // Создаём буфер для коэффициентов задержки (целая и дробная часть)
-        // Для каждого луча нужно: delay_integer и lagrange_row
-        struct DelayParams {
-            int delay_integer;
-            int lagrange_row;
+        cl::Buffer groups_buf(
+            context_,
+            CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+            plan.groups.size() * sizeof(FanOutGroup),
+            plan.groups.data()
+        );
+        cl::Buffer entries_buf(
+            context_,
+            CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+            plan.entries.size() * sizeof(FanOutEntry),
+            plan.entries.data()
+        );
+        
+        const cl::Buffer* input = static_cast<const cl::Buffer*>(device_input);
+        cl::Buffer* output = static_cast<cl::Buffer*>(device_output);
+        
+        cl_int err = kernel_fractional_delay_fanout_.setArg(0, *input);
+        err |= kernel_fractional_delay_fanout_.setArg(1, *output);
+        err |= kernel_fractional_delay_fanout_.setArg(2, lagrange_matrix_buffer_);
+        err |= kernel_fractional_delay_fanout_.setArg(3, groups_buf);
+        err |= kernel_fractional_delay_fanout_.setArg(4, entries_buf);
+        err |= kernel_fractional_delay_fanout_.setArg(5, static_cast<cl_uint>(num_beams));
+        err |= kernel_fractional_delay_fanout_.setArg(6, static_cast<cl_uint>(num_samples));
+        err |= kernel_fractional_delay_fanout_.setArg(7, window_bytes, nullptr);  // __local окно
+        if (!CheckError(err, "установка аргументов fractional_delay_fanout")) {
+            return false;
+        }
+        
+        // 2D grid: (тайлы отсчётов) × (группы наборов)
+        size_t num_tiles = (num_samples + tile - 1) / tile;
+        err = queue_.enqueueNDRangeKernel(
+            kernel_fractional_delay_fanout_,
+            cl::NullRange,
+            cl::NDRange(num_tiles * tile, plan.groups.size()),
+            cl::NDRange(tile, 1)
+        );
+        if (!CheckError(err, "запуск kernel fractional_delay_fanout")) {
+            return false;
+        }
+        
+        queue_.finish();
+        return true;
+    } catch (cl::Error& e) {
+        std::cerr << "Ошибка при выполнении fractional_delay_fanout: " << e.what() 
+                  << " (код: " << e.err() << ")" << std::endl;
+        return false;
+    }
+}
+
+bool OpenCLBackend::ExecuteDelayAndSum(
+    const void* device_input,
+    void* device_output,
+    const float* delays,
+    const ComplexType* weights,
+    size_t num_elements,
+    size_t num_directions,
+    size_t num_samples) {
+    
+    if (!initialized_ || device_input == nullptr || device_output == nullptr ||
+        delays == nullptr || num_elements == 0 || num_directions == 0) {
+        return false;
+    }
+    
+    if (!lagrange_matrix_uploaded_) {
+        std::cerr << "Ошибка: матрица Лагранжа не загружена на GPU" << std::endl;
+        return false;
+    }
+    
+    try {
+        const size_t num_pairs = num_directions * num_elements;
+        cl::Buffer delay_params_buf = CreateDelayParamsBuffer(delays, num_pairs);
+        
+        // Без весов передаём буфер из одного элемента (аргумент обязан быть валидным)
+        std::vector<ComplexType> unit_weight(1, ComplexType(1.0f, 0.0f));
+        cl::Buffer weights_buf(
+            context_,
+            CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+            (weights ? num_pairs : 1) * sizeof(ComplexType),
+            const_cast<ComplexType*>(weights ? weights : unit_weight.data())
+        );
+        
+        auto bind_args = [&](const cl::Buffer& in, const cl::Buffer& out,
+                             const cl::Buffer& params, const cl::Buffer& w,
+                             cl_uint use_weights, size_t directions) {
+            cl_int arg_err = kernel_delay_and_sum_.setArg(0, in);
+            arg_err |= kernel_delay_and_sum_.setArg(1, out);
+            arg_err |= kernel_delay_and_sum_.setArg(2, lagrange_matrix_buffer_);
+            arg_err |= kernel_delay_and_sum_.setArg(3, params);
+            arg_err |= kernel_delay_and_sum_.setArg(4, w);
+            arg_err |= kernel_delay_and_sum_.setArg(5, use_weights);
+            arg_err |= kernel_delay_and_sum_.setArg(6, static_cast<cl_uint>(num_elements));
+            arg_err |= kernel_delay_and_sum_.setArg(7, static_cast<cl_uint>(directions));
+            arg_err |= kernel_delay_and_sum_.setArg(8, static_cast<cl_uint>(num_samples));
+            return arg_err;
         };
         
-        std::vector<DelayParams> delay_params(num_beams);
-        const size_t LAGRANGE_ROWS = 48;
+        const cl::Buffer* input = static_cast<const cl::Buffer*>(device_input);
+        cl::Buffer* output = static_cast<cl::Buffer*>(device_output);
         
-        for (size_t beam = 0; beam < num_beams; ++beam) {
-            float delay = delay_coefficients[beam];
-            delay_params[beam].delay_integer = static_cast<int>(std::floor(delay));
-            float delay_fraction = delay - delay_params[beam].delay_integer;
-            if (delay_fraction < 0.0f) {
-                delay_fraction += 1.0f;
-                delay_params[beam].delay_integer -= 1;
-            }
-            delay_params[beam].lagrange_row = static_cast<int>(delay_fraction * LAGRANGE_ROWS);
-            if (delay_params[beam].lagrange_row >= static_cast<int>(LAGRANGE_ROWS)) {
-                delay_params[beam].lagrange_row = LAGRANGE_ROWS - 1;
-            }
+        // Класс формы для тюнера - (направления, отсчёты); число элементов
+        // входит в имя kernel'а, так как определяет работу на отсчёт.
+        // Kernel out-of-place и вход только читает, поэтому замер идёт прямо на
+        // буферах вызывающего (выход сейчас будет перезаписан): копия входа
+        // elements × samples удвоила бы память устройства на больших кадрах
+        const std::string tune_name = "delay_and_sum_e" + std::to_string(num_elements);
+        WorkGroupTuner::LaunchConfig config = GetLaunchConfig(
+            kernel_delay_and_sum_, tune_name, num_directions, num_samples,
+            [&](size_t tune_directions, std::vector<cl::Buffer>& scratch) {
+                std::vector<float> scratch_delays(tune_directions * num_elements, 0.0f);
+                scratch.push_back(CreateDelayParamsBuffer(scratch_delays.data(), scratch_delays.size()));
+                return bind_args(*input, *output, scratch[0], weights_buf, 0,
+                                 tune_directions) == CL_SUCCESS;
+            });
+        
+        if (!CheckError(bind_args(*input, *output, delay_params_buf, weights_buf,
+                                  weights ? 1u : 0u, num_directions),
+                        "установка аргументов delay_and_sum")) {
+            return false;
+        }
+        
+        size_t global_size = WorkGroupTuner::PaddedGlobalSize(num_directions * num_samples, config);
+        cl_int err = queue_.enqueueNDRangeKernel(
+            kernel_delay_and_sum_,
+            cl::NullRange,
+            cl::NDRange(global_size),
+            cl::NDRange(config.local_size)
+        );
+        if (!CheckError(err, "запуск kernel delay_and_sum")) {
+            return false;
+        }
+        
+        queue_.finish();
+        return true;
+    } catch (cl::Error& e) {
+        std::cerr << "Ошибка при выполнении delay_and_sum: " << e.what() 
+                  << " (код: " << e.err() << ")" << std::endl;
+        return false;
+    }
+}
+
+bool OpenCLBackend::ExecuteFIR(
+    const void* device_input,
+    void* device_output,
+    void* device_history,
+    const float* coefficients,
+    size_t num_taps,
+    FirMethod method,
+    size_t num_beams,
+    size_t num_samples) {
+    
+    if (!initialized_ || device_input == nullptr || device_output == nullptr ||
+        coefficients == nullptr || num_taps == 0 || num_beams == 0 || num_samples == 0) {
+        return false;
+    }
+    if (num_taps > 1 && device_history == nullptr) {
+        return false;
+    }
+    
+    if (method == FirMethod::AUTO) {
+        method = num_taps >= GetFirCrossover(num_beams, num_samples)
+                     ? FirMethod::OVERLAP_SAVE : FirMethod::DIRECT;
+    }
+    
+    try {
+        const cl::Buffer* input = static_cast<const cl::Buffer*>(device_input);
+        cl::Buffer* output = static_cast<cl::Buffer*>(device_output);
+        
+        // При num_taps == 1 истории нет, но аргумент kernel'а обязан быть валидным
+        cl::Buffer unused_history;
+        if (device_history == nullptr) {
+            unused_history = cl::Buffer(context_, CL_MEM_READ_WRITE, sizeof(ComplexType));
+        }
+        cl::Buffer& history = device_history ? *static_cast<cl::Buffer*>(device_history) : unused_history;
+        
+        if (!EnqueueFIR(*input, *output, history, coefficients, num_taps, method,
+                        num_beams, num_samples)) {
+            return false;
+        }
+        
+        queue_.finish();
+        return true;
+    } catch (cl::Error& e) {
+        std::cerr << "Ошибка при выполнении FIR: " << e.what() 
+                  << " (код: " << e.err() << ")" << std::endl;
+        return false;
+    }
+}
+
+bool OpenCLBackend::EnqueueFIR(
+    const cl::Buffer& input,
+    cl::Buffer& output,
+    cl::Buffer& history,
+    const float* coefficients,
+    size_t num_taps,
+    FirMethod method,
+    size_t num_beams,
+    size_t num_samples) {
+    
+    const size_t history_size = num_taps - 1;
+    cl_int err = CL_SUCCESS;
+    
+    if (method == FirMethod::OVERLAP_SAVE) {
+        const size_t fft_size = SelectOverlapSaveFftSize(num_taps, num_samples);
+        const size_t step = fft_size - history_size;
+        const size_t num_segments = (num_samples + step - 1) / step;
+        const size_t segment_count = num_beams * num_segments;
+        
+        // Спектр фильтра (дополненного нулями до fft_size) - на хосте, он мал
+        std::vector<ComplexType> spectrum(fft_size, ComplexType(0.0f, 0.0f));
+        for (size_t k = 0; k < num_taps; ++k) {
+            spectrum[k] = ComplexType(coefficients[k], 0.0f);
         }
+        CpuFFT(fft_size).Execute(spectrum.data(), true);
         
-        cl::Buffer delay_params_buf(
+        cl::Buffer spectrum_buf(
             context_,
             CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
-            num_beams * sizeof(DelayParams),
-            delay_params.data()
+            fft_size * sizeof(ComplexType),
+            spectrum.data()
         );
+        cl::Buffer segments(context_, CL_MEM_READ_WRITE, segment_count * fft_size * sizeof(ComplexType));
         
-        // Устанавливаем аргументы kernel
-        cl_int err = kernel_fractional_delay_.setArg(0, *buffer);
-        err |= kernel_fractional_delay_.setArg(1, *buffer);  // in-place: input = output
-        err |= kernel_fractional_delay_.setArg(2, lagrange_matrix_buffer_);
-        err |= kernel_fractional_delay_.setArg(3, delay_params_buf);
-        err |= kernel_fractional_delay_.setArg(4, static_cast<cl_uint>(num_beams));
-        err |= kernel_fractional_delay_.setArg(5, static_cast<cl_uint>(num_samples));
+        err = kernel_fir_os_gather_.setArg(0, input);
+        err |= kernel_fir_os_gather_.setArg(1, history);
+        err |= kernel_fir_os_gather_.setArg(2, segments);
+        err |= kernel_fir_os_gather_.setArg(3, static_cast<cl_uint>(history_size));
+        err |= kernel_fir_os_gather_.setArg(4, static_cast<cl_uint>(num_beams));
+        err |= kernel_fir_os_gather_.setArg(5, static_cast<cl_uint>(num_samples));
+        err |= kernel_fir_os_gather_.setArg(6, static_cast<cl_uint>(fft_size));
+        err |= kernel_fir_os_gather_.setArg(7, static_cast<cl_uint>(num_segments));
+        if (!CheckError(err, "установка аргументов fir_os_gather") ||
+            !CheckError(EnqueueGridStride(kernel_fir_os_gather_, segment_count * fft_size),
+                        "запуск kernel fir_os_gather")) {
+            return false;
+        }
         
-        if (!CheckError(err, "установка аргументов fractional_delay")) {
+        // Свёртка сегментов: те же FFT и hadamard_multiply, что и в согласованном фильтре
+        if (!ExecuteFFT(&segments, segment_count, fft_size, true) ||
+            !ExecuteHadamardMultiply(&segments, &spectrum_buf, segment_count, fft_size) ||
+            !ExecuteFFT(&segments, segment_count, fft_size, false)) {
             return false;
         }
         
-        // Запускаем kernel (1D grid для совместимости)
-        // Каждый work item обрабатывает один отсчёт одного луча
-        size_t global_size = num_beams * num_samples;
+        err = kernel_fir_os_scatter_.setArg(0, segments);
+        err |= kernel_fir_os_scatter_.setArg(1, output);
+        err |= kernel_fir_os_scatter_.setArg(2, static_cast<cl_uint>(history_size));
+        err |= kernel_fir_os_scatter_.setArg(3, static_cast<cl_uint>(num_beams));
+        err |= kernel_fir_os_scatter_.setArg(4, static_cast<cl_uint>(num_samples));
+        err |= kernel_fir_os_scatter_.setArg(5, static_cast<cl_uint>(fft_size));
+        err |= kernel_fir_os_scatter_.setArg(6, static_cast<cl_uint>(num_segments));
+        if (!CheckError(err, "установка аргументов fir_os_scatter") ||
+            !CheckError(EnqueueGridStride(kernel_fir_os_scatter_, num_beams * num_samples),
+                        "запуск kernel fir_os_scatter")) {
+            return false;
+        }
+    } else {
+        cl::Buffer coefficients_buf(
+            context_,
+            CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+            num_taps * sizeof(float),
+            const_cast<float*>(coefficients)
+        );
+        
+        auto bind_args = [&](const cl::Buffer& in, const cl::Buffer& hist, const cl::Buffer& out,
+                             size_t beams) {
+            cl_int arg_err = kernel_fir_direct_.setArg(0, in);
+            arg_err |= kernel_fir_direct_.setArg(1, hist);
+            arg_err |= kernel_fir_direct_.setArg(2, coefficients_buf);
+            arg_err |= kernel_fir_direct_.setArg(3, out);
+            arg_err |= kernel_fir_direct_.setArg(4, static_cast<cl_uint>(num_taps));
+            arg_err |= kernel_fir_direct_.setArg(5, static_cast<cl_uint>(beams));
+            arg_err |= kernel_fir_direct_.setArg(6, static_cast<cl_uint>(num_samples));
+            return arg_err;
+        };
         
-        // Определяем оптимальный размер work group
-        size_t preferred_work_group_size = 256;  // Оптимально для RTX 3060
-        size_t work_group_size = std::min(preferred_work_group_size, global_size);
+        // Длина фильтра определяет работу на отсчёт - входит в имя для тюнера
+        const std::string tune_name = "fir_direct_t" + std::to_string(num_taps);
+        WorkGroupTuner::LaunchConfig config = GetLaunchConfig(
+            kernel_fir_direct_, tune_name, num_beams, num_samples,
+            [&](size_t tune_beams, std::vector<cl::Buffer>& scratch) {
+                scratch.emplace_back(context_, CL_MEM_READ_ONLY,
+                                     tune_beams * num_samples * sizeof(ComplexType));
+                scratch.emplace_back(context_, CL_MEM_READ_ONLY,
+                                     tune_beams * std::max<size_t>(history_size, 1) * sizeof(ComplexType));
+                scratch.emplace_back(context_, CL_MEM_WRITE_ONLY,
+                                     tune_beams * num_samples * sizeof(ComplexType));
+                return bind_args(scratch[0], scratch[1], scratch[2], tune_beams) == CL_SUCCESS;
+            });
         
+        if (!CheckError(bind_args(input, history, output, num_beams), "установка аргументов fir_direct")) {
+            return false;
+        }
+        
+        size_t global_size = WorkGroupTuner::PaddedGlobalSize(num_beams * num_samples, config);
         err = queue_.enqueueNDRangeKernel(
-            kernel_fractional_delay_,
+            kernel_fir_direct_,
             cl::NullRange,
             cl::NDRange(global_size),
-            cl::NDRange(work_group_size)
+            cl::NDRange(config.local_size)
         );
+        if (!CheckError(err, "запуск kernel fir_direct")) {
+            return false;
+        }
+    }
+    
+    return EnqueueHistoryUpdate(input, history, history_size, num_beams, num_samples);
+}
+
+bool OpenCLBackend::EnqueueHistoryUpdate(
+    const cl::Buffer& input,
+    cl::Buffer& history,
+    size_t history_size,
+    size_t num_beams,
+    size_t num_samples) {
+    
+    if (history_size == 0) {
+        return true;
+    }
+    
+    // Новая история пишется в отдельный буфер: старая читается тем же kernel'ом
+    const size_t history_bytes = num_beams * history_size * sizeof(ComplexType);
+    cl::Buffer new_history(context_, CL_MEM_READ_WRITE, history_bytes);
+    cl_int err = kernel_fir_update_history_.setArg(0, input);
+    err |= kernel_fir_update_history_.setArg(1, history);
+    err |= kernel_fir_update_history_.setArg(2, new_history);
+    err |= kernel_fir_update_history_.setArg(3, static_cast<cl_uint>(history_size));
+    err |= kernel_fir_update_history_.setArg(4, static_cast<cl_uint>(num_beams));
+    err |= kernel_fir_update_history_.setArg(5, static_cast<cl_uint>(num_samples));
+    if (!CheckError(err, "установка аргументов fir_update_history") ||
+        !CheckError(EnqueueGridStride(kernel_fir_update_history_, num_beams * history_size),
+                    "запуск kernel fir_update_history")) {
+        return false;
+    }
+    
+    err = queue_.enqueueCopyBuffer(new_history, history, 0, 0, history_bytes);
+    return CheckError(err, "копирование истории");
+}
+
+bool OpenCLBackend::ExecuteResample(
+    const void* device_input,
+    void* device_output,
+    void* device_history,
+    const float* delays,
+    size_t history_size,
+    const ResampleBlock& block,
+    double step,
+    size_t num_beams,
+    size_t num_input_samples) {
+    
+    if (!initialized_ || device_input == nullptr || device_output == nullptr ||
+        device_history == nullptr || delays == nullptr || !(step > 0.0) || num_beams == 0) {
+        return false;
+    }
+    
+    // Позиция в float относительно начала блока (не побитово с CPU, см. farrow_resample)
+    const double start_position = block.start_position;
+    const size_t num_output_samples = block.num_output_samples;
+    
+    // Индекс выходного отсчёта в kernel'е - float (точен до 2^24)
+    if (num_output_samples >= (size_t(1) << 24)) {
+        std::cerr << "Ошибка: блок передискретизации больше 2^24 выходных отсчётов" << std::endl;
+        return false;
+    }
+    
+    try {
+        const cl::Buffer* input = static_cast<const cl::Buffer*>(device_input);
+        cl::Buffer* output = static_cast<cl::Buffer*>(device_output);
+        cl::Buffer* history = static_cast<cl::Buffer*>(device_history);
+        
+        if (num_output_samples > 0) {
+            cl::Buffer delays_buf(
+                context_,
+                CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                num_beams * sizeof(float),
+                const_cast<float*>(delays)
+            );
+            
+            const float step_hi = static_cast<float>(step);
+            const float step_lo = static_cast<float>(step - static_cast<double>(step_hi));
+            
+            auto bind_args = [&](const cl::Buffer& in, const cl::Buffer& hist, const cl::Buffer& d,
+                                 const cl::Buffer& out, size_t beams) {
+                cl_int arg_err = kernel_farrow_resample_.setArg(0, in);
+                arg_err |= kernel_farrow_resample_.setArg(1, hist);
+                arg_err |= kernel_farrow_resample_.setArg(2, d);
+                arg_err |= kernel_farrow_resample_.setArg(3, out);
+                arg_err |= kernel_farrow_resample_.setArg(4, static_cast<cl_uint>(history_size));
+                arg_err |= kernel_farrow_resample_.setArg(5, static_cast<cl_uint>(beams));
+                arg_err |= kernel_farrow_resample_.setArg(6, static_cast<cl_uint>(num_input_samples));
+                arg_err |= kernel_farrow_resample_.setArg(7, static_cast<cl_uint>(num_output_samples));
+                arg_err |= kernel_farrow_resample_.setArg(8, static_cast<float>(start_position));
+                arg_err |= kernel_farrow_resample_.setArg(9, step_hi);
+                arg_err |= kernel_farrow_resample_.setArg(10, step_lo);
+                return arg_err;
+            };
+            
+            WorkGroupTuner::LaunchConfig config = GetLaunchConfig(
+                kernel_farrow_resample_, "farrow_resample", num_beams, num_output_samples,
+                [&](size_t tune_beams, std::vector<cl::Buffer>& scratch) {
+                    std::vector<float> scratch_delays(tune_beams, 0.0f);
+                    scratch.emplace_back(context_, CL_MEM_READ_ONLY,
+                                         tune_beams * num_input_samples * sizeof(ComplexType));
+                    scratch.emplace_back(context_, CL_MEM_READ_ONLY,
+                                         tune_beams * history_size * sizeof(ComplexType));
+                    scratch.emplace_back(context_, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                                         tune_beams * sizeof(float), scratch_delays.data());
+                    scratch.emplace_back(context_, CL_MEM_WRITE_ONLY,
+                                         tune_beams * num_output_samples * sizeof(ComplexType));
+                    return bind_args(scratch[0], scratch[1], scratch[2], scratch[3], tune_beams) == CL_SUCCESS;
+                });
+            
+            if (!CheckError(bind_args(*input, *history, delays_buf, *output, num_beams),
+                            "установка аргументов farrow_resample")) {
+                return false;
+            }
+            
+            size_t global_size = WorkGroupTuner::PaddedGlobalSize(num_beams * num_output_samples, config);
+            cl_int err = queue_.enqueueNDRangeKernel(
+                kernel_farrow_resample_,
+                cl::NullRange,
+                cl::NDRange(global_size),
+                cl::NDRange(config.local_size)
+            );
+            if (!CheckError(err, "запуск kernel farrow_resample")) {
+                return false;
+            }
+        }
         
-        if (!CheckError(err, "запуск kernel fractional_delay")) {
+        if (!EnqueueHistoryUpdate(*input, *history, history_size, num_beams, num_input_samples)) {
             return false;
         }
         
-        // Синхронизируем
         queue_.finish();
         return true;
     } catch (cl::Error& e) {
-        std::cerr << "Ошибка при выполнении fractional_delay: " << e.what() 
+        std::cerr << "Ошибка при выполнении farrow_resample: " << e.what() 
+                  << " (код: " << e.err() << ")" << std::endl;
+        return false;
+    }
+}
+
+bool OpenCLBackend::ExecuteDecimate(
+    const void* device_input,
+    void* device_output,
+    void* device_history,
+    const float* coefficients,
+    size_t num_taps,
+    size_t factor,
+    size_t first_position,
+    size_t num_beams,
+    size_t num_input_samples,
+    size_t num_output_samples) {
+    
+    if (!initialized_ || device_input == nullptr || device_output == nullptr ||
+        coefficients == nullptr || num_taps == 0 || factor == 0 || num_beams == 0 ||
+        first_position + 1 < num_taps) {
+        return false;
+    }
+    if (num_taps > 1 && device_history == nullptr) {
+        return false;
+    }
+    
+    try {
+        const cl::Buffer* input = static_cast<const cl::Buffer*>(device_input);
+        cl::Buffer* output = static_cast<cl::Buffer*>(device_output);
+        
+        // При num_taps == 1 истории нет, но аргумент kernel'а обязан быть валидным
+        cl::Buffer unused_history;
+        if (device_history == nullptr) {
+            unused_history = cl::Buffer(context_, CL_MEM_READ_WRITE, sizeof(ComplexType));
+        }
+        cl::Buffer& history = device_history ? *static_cast<cl::Buffer*>(device_history) : unused_history;
+        const size_t history_size = num_taps - 1;
+        
+        if (num_output_samples > 0) {
+            cl::Buffer coefficients_buf(
+                context_,
+                CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                num_taps * sizeof(float),
+                const_cast<float*>(coefficients)
+            );
+            
+            auto bind_args = [&](const cl::Buffer& in, const cl::Buffer& hist, const cl::Buffer& out,
+                                 size_t beams) {
+                cl_int arg_err = kernel_fir_decimate_.setArg(0, in);
+                arg_err |= kernel_fir_decimate_.setArg(1, hist);
+                arg_err |= kernel_fir_decimate_.setArg(2, coefficients_buf);
+                arg_err |= kernel_fir_decimate_.setArg(3, out);
+                arg_err |= kernel_fir_decimate_.setArg(4, static_cast<cl_uint>(num_taps));
+                arg_err |= kernel_fir_decimate_.setArg(5, static_cast<cl_uint>(factor));
+                arg_err |= kernel_fir_decimate_.setArg(6, static_cast<cl_uint>(first_position));
+                arg_err |= kernel_fir_decimate_.setArg(7, static_cast<cl_uint>(beams));
+                arg_err |= kernel_fir_decimate_.setArg(8, static_cast<cl_uint>(num_input_samples));
+                arg_err |= kernel_fir_decimate_.setArg(9, static_cast<cl_uint>(num_output_samples));
+                return arg_err;
+            };
+            
+            // Длина фильтра определяет работу на выходной отсчёт - входит в имя для тюнера
+            const std::string tune_name = "fir_decimate_t" + std::to_string(num_taps);
+            WorkGroupTuner::LaunchConfig config = GetLaunchConfig(
+                kernel_fir_decimate_, tune_name, num_beams, num_output_samples,
+                [&](size_t tune_beams, std::vector<cl::Buffer>& scratch) {
+                    scratch.emplace_back(context_, CL_MEM_READ_ONLY,
+                                         tune_beams * num_input_samples * sizeof(ComplexType));
+                    scratch.emplace_back(context_, CL_MEM_READ_ONLY,
+                                         tune_beams * std::max<size_t>(history_size, 1) * sizeof(ComplexType));
+                    scratch.emplace_back(context_, CL_MEM_WRITE_ONLY,
+                                         tune_beams * num_output_samples * sizeof(ComplexType));
+                    return bind_args(scratch[0], scratch[1], scratch[2], tune_beams) == CL_SUCCESS;
+                });
+            
+            if (!CheckError(bind_args(*input, history, *output, num_beams),
+                            "установка аргументов fir_decimate")) {
+                return false;
+            }
+            
+            size_t global_size = WorkGroupTuner::PaddedGlobalSize(num_beams * num_output_samples, config);
+            cl_int err = queue_.enqueueNDRangeKernel(
+                kernel_fir_decimate_,
+                cl::NullRange,
+                cl::NDRange(global_size),
+                cl::NDRange(config.local_size)
+            );
+            if (!CheckError(err, "запуск kernel fir_decimate")) {
+                return false;
+            }
+        }
+        
+        if (!EnqueueHistoryUpdate(*input, history, history_size, num_beams, num_input_samples)) {
+            return false;
+        }
+        
+        queue_.finish();
+        return true;
+    } catch (cl::Error& e) {
+        std::cerr << "Ошибка при выполнении fir_decimate: " << e.what() 
+                  << " (код: " << e.err() << ")" << std::endl;
+        return false;
+    }
+}
+
+bool OpenCLBackend::ExecuteAddNoise(
+    void* device_buffer,
+    uint64_t seed,
+    float sigma,
+    size_t num_beams,
+    size_t num_samples) {
+    
+    if (!initialized_ || device_buffer == nullptr) {
+        return false;
+    }
+    if (num_beams == 0 || num_samples == 0) {
+        return true;
+    }
+    
+    try {
+        cl::Buffer* buffer = static_cast<cl::Buffer*>(device_buffer);
+        const cl_uint seed_lo = static_cast<cl_uint>(seed);
+        const cl_uint seed_hi = static_cast<cl_uint>(seed >> 32);
+        
+        auto bind_args = [&](const cl::Buffer& data, size_t beams) {
+            cl_int arg_err = kernel_add_gaussian_noise_.setArg(0, data);
+            arg_err |= kernel_add_gaussian_noise_.setArg(1, seed_lo);
+            arg_err |= kernel_add_gaussian_noise_.setArg(2, seed_hi);
+            arg_err |= kernel_add_gaussian_noise_.setArg(3, sigma);
+            arg_err |= kernel_add_gaussian_noise_.setArg(4, static_cast<cl_uint>(beams));
+            arg_err |= kernel_add_gaussian_noise_.setArg(5, static_cast<cl_uint>(num_samples));
+            return arg_err;
+        };
+        
+        // Work item - пара отсчётов (один вызов Philox)
+        const size_t pairs_per_beam = (num_samples + 1) / 2;
+        WorkGroupTuner::LaunchConfig config = GetLaunchConfig(
+            kernel_add_gaussian_noise_, "add_gaussian_noise", num_beams, pairs_per_beam,
+            [&](size_t tune_beams, std::vector<cl::Buffer>& scratch) {
+                scratch.emplace_back(context_, CL_MEM_READ_WRITE, tune_beams * num_samples * sizeof(ComplexType));
+                return bind_args(scratch[0], tune_beams) == CL_SUCCESS;
+            });
+        
+        if (!CheckError(bind_args(*buffer, num_beams), "установка аргументов add_gaussian_noise")) {
+            return false;
+        }
+        
+        size_t global_size = WorkGroupTuner::PaddedGlobalSize(num_beams * pairs_per_beam, config);
+        cl_int err = queue_.enqueueNDRangeKernel(
+            kernel_add_gaussian_noise_,
+            cl::NullRange,
+            cl::NDRange(global_size),
+            cl::NDRange(config.local_size)
+        );
+        if (!CheckError(err, "запуск kernel add_gaussian_noise")) {
+            return false;
+        }
+        
+        queue_.finish();
+        return true;
+    } catch (cl::Error& e) {
+        std::cerr << "Ошибка при выполнении add_gaussian_noise: " << e.what() 
                   << " (код: " << e.err() << ")" << std::endl;
         return false;
     }
 }
 
+size_t OpenCLBackend::GetFirCrossover(size_t num_beams, size_t num_samples) {
+#if !CLFFT_FOUND
+    // Без clFFT FFT сегментов идёт через хост: прямая форма на устройстве всегда быстрее
+    (void)num_beams;
+    (void)num_samples;
+    return SIZE_MAX;
+#else
+    // Класс формы: блок - степень двойки (не больше 64K), объём замера до 4M отсчётов
+    size_t block = 64;
+    while (block < num_samples && block < (size_t(1) << 16)) {
+        block <<= 1;
+    }
+    const size_t beams = std::max<size_t>(1, std::min(num_beams, (size_t(1) << 22) / block));
+    const std::pair<size_t, size_t> key(beams, block);
+    
+    auto it = fir_crossover_.find(key);
+    if (it != fir_crossover_.end()) {
+        return it->second;
+    }
+    
+    size_t crossover = SIZE_MAX;
+    try {
+        const size_t max_taps = std::min<size_t>(1024, block);
+        std::vector<ComplexType> zeros(beams * std::max(block, max_taps), ComplexType(0.0f, 0.0f));
+        cl::Buffer input(context_, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                         beams * block * sizeof(ComplexType), zeros.data());
+        cl::Buffer output(context_, CL_MEM_READ_WRITE, beams * block * sizeof(ComplexType));
+        cl::Buffer history(context_, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+                           beams * max_taps * sizeof(ComplexType), zeros.data());
+        
+        auto time_method = [&](size_t num_taps, FirMethod method) -> double {
+            std::vector<float> coefficients(num_taps, 1.0f / static_cast<float>(num_taps));
+            // Первый запуск - прогрев (тюнер, планы clFFT), затем минимум из двух
+            double best = -1.0;
+            for (int repeat = 0; repeat < 3; ++repeat) {
+                auto start = std::chrono::steady_clock::now();
+                if (!EnqueueFIR(input, output, history, coefficients.data(), num_taps, method,
+                                beams, block)) {
+                    return -1.0;
+                }
+                queue_.finish();
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                if (repeat > 0 && (best < 0.0 || seconds < best)) {
+                    best = seconds;
+                }
+            }
+            return best;
+        };
+        
+        crossover = MeasureFirCrossover(time_method, max_taps);
+    } catch (cl::Error& e) {
+        std::cerr << "Предупреждение: замер FIR не выполнен: " << e.what() 
+                  << " (код: " << e.err() << "), используем прямую форму" << std::endl;
+    }
+    
+    fir_crossover_[key] = crossover;
+    return crossover;
+#endif
+}
+
+cl_int OpenCLBackend::EnqueueGridStride(cl::Kernel& kernel, size_t total_items) {
+    return queue_.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(total_items), cl::NullRange);
+}
+
 bool OpenCLBackend::ExecuteFFT(
     void* device_buffer,
     size_t num_beams,
@@ -267,7 +1185,11 @@ bool OpenCLBackend::ExecuteFFT(
     cl::Buffer* buffer = static_cast<cl::Buffer*>(device_buffer);
     cl_mem cl_buffer = (*buffer)();
     
-    // Создаём планы если ещё не созданы
+    // Планы создаются под размер и batch: другой размер (например, сегменты
+    // overlap-save FIR) требует новых планов
+    if (fft_plans_created_ && (fft_plan_samples_ != num_samples || fft_plan_batch_ != num_beams)) {
+        DestroyFFTPlans();
+    }
     if (!fft_plans_created_) {
         if (!CreateFFTPlans(num_samples, num_beams)) {
             return false;
@@ -293,13 +1215,40 @@ bool OpenCLBackend::ExecuteFFT(
     if (!CheckError(err, forward ? "clFFT forward" : "clFFT inverse")) {
         return false;
     }
-    
-    queue_.finish();
-    return true;
-#else
-    // Fallback: используем CPU FFT (медленно, но работает)
-    std::cerr << "Предупреждение: clFFT не найдена, используем CPU FFT (медленно!)" << std::endl;
-    return false;
+    
+    queue_.finish();
+    return true;
+#else
+    // Fallback: используем CPU FFT (медленно, но работает)
+    std::cerr << "Предупреждение: clFFT не найдена, используем CPU FFT (медленно!)" << std::endl;
+    if (!initialized_ || device_buffer == nullptr || num_samples == 0) {
+        return false;
+    }
+    
+    try {
+        cl::Buffer* buffer = static_cast<cl::Buffer*>(device_buffer);
+        const size_t size_bytes = num_beams * num_samples * sizeof(ComplexType);
+        std::vector<ComplexType> host(num_beams * num_samples);
+        
+        cl_int err = queue_.enqueueReadBuffer(*buffer, CL_TRUE, 0, size_bytes, host.data());
+        if (!CheckError(err, "чтение буфера для CPU FFT")) {
+            return false;
+        }
+        
+        CpuFFT plan(num_samples);
+        ThreadPool::Instance().ParallelFor(num_beams, 1, [&](size_t begin, size_t end) {
+            for (size_t beam = begin; beam < end; ++beam) {
+                plan.Execute(host.data() + beam * num_samples, forward);
+            }
+        });
+        
+        err = queue_.enqueueWriteBuffer(*buffer, CL_TRUE, 0, size_bytes, host.data());
+        return CheckError(err, "запись буфера после CPU FFT");
+    } catch (cl::Error& e) {
+        std::cerr << "Ошибка при CPU FFT: " << e.what() 
+                  << " (код: " << e.err() << ")" << std::endl;
+        return false;
+    }
 #endif
 }
 
@@ -317,23 +1266,36 @@ bool OpenCLBackend::ExecuteHadamardMultiply(
         cl::Buffer* buffer = static_cast<cl::Buffer*>(device_buffer);
         cl::Buffer* ref_buffer = static_cast<cl::Buffer*>(const_cast<void*>(reference_fft));
         
-        // Устанавливаем аргументы kernel
+        // Параметры запуска от автотюнера (временные буферы, чтобы не портить данные)
+        WorkGroupTuner::LaunchConfig config = GetLaunchConfig(
+            kernel_hadamard_, "hadamard_multiply", num_beams, num_samples,
+            [&](size_t tune_beams, std::vector<cl::Buffer>& scratch) {
+                scratch.emplace_back(context_, CL_MEM_READ_WRITE,
+                                     tune_beams * num_samples * sizeof(ComplexType));
+                scratch.emplace_back(context_, CL_MEM_READ_ONLY, num_samples * sizeof(ComplexType));
+                cl_int arg_err = kernel_hadamard_.setArg(0, scratch[0]);
+                arg_err |= kernel_hadamard_.setArg(1, scratch[1]);
+                arg_err |= kernel_hadamard_.setArg(2, static_cast<cl_uint>(tune_beams));
+                arg_err |= kernel_hadamard_.setArg(3, static_cast<cl_uint>(num_samples));
+                return arg_err == CL_SUCCESS;
+            });
+        
+        // Устанавливаем аргументы kernel (после автотюнера, который их перезаписывает)
         cl_int err = kernel_hadamard_.setArg(0, *buffer);
         err |= kernel_hadamard_.setArg(1, *ref_buffer);
         err |= kernel_hadamard_.setArg(2, static_cast<cl_uint>(num_beams));
         err |= kernel_hadamard_.setArg(3, static_cast<cl_uint>(num_samples));
-        
         if (!CheckError(err, "установка аргументов hadamard_multiply")) {
             return false;
         }
         
-        // Запускаем kernel
-        size_t global_size = num_beams * num_samples;
+        // Запускаем kernel (grid выровнен на размер work group)
+        size_t global_size = WorkGroupTuner::PaddedGlobalSize(num_beams * num_samples, config);
         err = queue_.enqueueNDRangeKernel(
             kernel_hadamard_,
             cl::NullRange,
             cl::NDRange(global_size),
-            cl::NullRange
+            cl::NDRange(config.local_size)
         );
         
         if (!CheckError(err, "запуск kernel hadamard_multiply")) {
@@ -350,6 +1312,130 @@ bool OpenCLBackend::ExecuteHadamardMultiply(
     }
 }
 
+bool OpenCLBackend::ExecuteHeterodyne(
+    void* device_buffer,
+    const void* device_reference,
+    size_t num_reference_beams,
+    size_t num_beams,
+    size_t num_samples) {
+    
+    if (!initialized_ || device_buffer == nullptr || device_reference == nullptr ||
+        (num_reference_beams != 1 && num_reference_beams != num_beams)) {
+        return false;
+    }
+    
+    try {
+        cl::Buffer* buffer = static_cast<cl::Buffer*>(device_buffer);
+        cl::Buffer* ref_buffer = static_cast<cl::Buffer*>(const_cast<void*>(device_reference));
+        const cl_uint reference_stride = num_reference_beams == 1 ? 0 : static_cast<cl_uint>(num_samples);
+        
+        auto bind_args = [&](const cl::Buffer& beams, const cl::Buffer& reference, size_t beams_count) {
+            cl_int arg_err = kernel_heterodyne_.setArg(0, beams);
+            arg_err |= kernel_heterodyne_.setArg(1, reference);
+            arg_err |= kernel_heterodyne_.setArg(2, reference_stride);
+            arg_err |= kernel_heterodyne_.setArg(3, static_cast<cl_uint>(beams_count));
+            arg_err |= kernel_heterodyne_.setArg(4, static_cast<cl_uint>(num_samples));
+            return arg_err;
+        };
+        
+        // Общая опора и опора по лучам различаются трафиком - разные записи тюнера
+        const std::string tune_name = num_reference_beams == 1 ? "heterodyne_broadcast" : "heterodyne_per_beam";
+        WorkGroupTuner::LaunchConfig config = GetLaunchConfig(
+            kernel_heterodyne_, tune_name, num_beams, num_samples,
+            [&](size_t tune_beams, std::vector<cl::Buffer>& scratch) {
+                const size_t reference_rows = num_reference_beams == 1 ? 1 : tune_beams;
+                scratch.emplace_back(context_, CL_MEM_READ_WRITE,
+                                     tune_beams * num_samples * sizeof(ComplexType));
+                scratch.emplace_back(context_, CL_MEM_READ_ONLY,
+                                     reference_rows * num_samples * sizeof(ComplexType));
+                return bind_args(scratch[0], scratch[1], tune_beams) == CL_SUCCESS;
+            });
+        
+        if (!CheckError(bind_args(*buffer, *ref_buffer, num_beams), "установка аргументов heterodyne_multiply")) {
+            return false;
+        }
+        
+        size_t global_size = WorkGroupTuner::PaddedGlobalSize(num_beams * num_samples, config);
+        cl_int err = queue_.enqueueNDRangeKernel(
+            kernel_heterodyne_,
+            cl::NullRange,
+            cl::NDRange(global_size),
+            cl::NDRange(config.local_size)
+        );
+        if (!CheckError(err, "запуск kernel heterodyne_multiply")) {
+            return false;
+        }
+        
+        queue_.finish();
+        return true;
+    } catch (cl::Error& e) {
+        std::cerr << "Ошибка при выполнении heterodyne_multiply: " << e.what() 
+                  << " (код: " << e.err() << ")" << std::endl;
+        return false;
+    }
+}
+
+bool OpenCLBackend::ExecuteTileDigests(
+    const void* device_buffer,
+    float quantum,
+    size_t tile_samples,
+    size_t num_beams,
+    size_t num_samples,
+    uint64_t* digests) {
+    
+    if (!initialized_ || device_buffer == nullptr || digests == nullptr ||
+        !(quantum > 0.0f) || tile_samples == 0) {
+        return false;
+    }
+    if (num_beams == 0 || num_samples == 0) {
+        return true;
+    }
+    
+    try {
+        // Размер work group - степень 2 (редукция в kernel), не больше 256
+        size_t kernel_max_wg = 0;
+        kernel_tile_digest_.getWorkGroupInfo(device_, CL_KERNEL_WORK_GROUP_SIZE, &kernel_max_wg);
+        size_t group = 256;
+        while (group > 1 && (group > kernel_max_wg || group > max_work_group_size_)) {
+            group /= 2;
+        }
+        
+        const size_t tiles_per_beam = (num_samples + tile_samples - 1) / tile_samples;
+        const size_t digests_bytes = num_beams * tiles_per_beam * sizeof(cl_ulong);
+        cl::Buffer digests_buf(context_, CL_MEM_WRITE_ONLY, digests_bytes);
+        
+        const cl::Buffer* buffer = static_cast<const cl::Buffer*>(device_buffer);
+        cl_int err = kernel_tile_digest_.setArg(0, *buffer);
+        err |= kernel_tile_digest_.setArg(1, digests_buf);
+        err |= kernel_tile_digest_.setArg(2, 1.0f / quantum);   // Тот же float, что у CPU
+        err |= kernel_tile_digest_.setArg(3, static_cast<cl_uint>(num_samples));
+        err |= kernel_tile_digest_.setArg(4, static_cast<cl_uint>(tile_samples));
+        err |= kernel_tile_digest_.setArg(5, static_cast<cl_uint>(tiles_per_beam));
+        err |= kernel_tile_digest_.setArg(6, group * sizeof(cl_ulong), nullptr);  // __local частичные суммы
+        if (!CheckError(err, "установка аргументов tile_digest")) {
+            return false;
+        }
+        
+        // 2D grid: (тайлы луча) × (лучи), work group на тайл
+        err = queue_.enqueueNDRangeKernel(
+            kernel_tile_digest_,
+            cl::NullRange,
+            cl::NDRange(tiles_per_beam * group, num_beams),
+            cl::NDRange(group, 1)
+        );
+        if (!CheckError(err, "запуск kernel tile_digest")) {
+            return false;
+        }
+        
+        err = queue_.enqueueReadBuffer(digests_buf, CL_TRUE, 0, digests_bytes, digests);
+        return CheckError(err, "чтение дайджестов тайлов");
+    } catch (cl::Error& e) {
+        std::cerr << "Ошибка при выполнении tile_digest: " << e.what() 
+                  << " (код: " << e.err() << ")" << std::endl;
+        return false;
+    }
+}
+
 std::string OpenCLBackend::GetBackendName() const {
     return "OpenCL";
 }
@@ -480,64 +1566,7 @@ bool OpenCLBackend::ExecuteFractionalDelayWithProfiling(
     
     try {
         cl::Buffer* buffer = static_cast<cl::Buffer*>(device_buffer);
-        
-        // Создаём буфер для коэффициентов задержки (как в обычной версии)
-        struct DelayParams {
-            int delay_integer;
-            int lagrange_row;
-        };
-        
-        std::vector<DelayParams> delay_params(num_beams);
-        const size_t LAGRANGE_ROWS = 48;
-        
-        for (size_t beam = 0; beam < num_beams; ++beam) {
-            float delay = delay_coefficients[beam];
-            delay_params[beam].delay_integer = static_cast<int>(std::floor(delay));
-            float delay_fraction = delay - delay_params[beam].delay_integer;
-            if (delay_fraction < 0.0f) {
-                delay_fraction += 1.0f;
-                delay_params[beam].delay_integer -= 1;
-            }
-            delay_params[beam].lagrange_row = static_cast<int>(delay_fraction * LAGRANGE_ROWS);
-            if (delay_params[beam].lagrange_row >= static_cast<int>(LAGRANGE_ROWS)) {
-                delay_params[beam].lagrange_row = LAGRANGE_ROWS - 1;
-            }
-        }
-        
-        cl::Buffer delay_params_buf(
-            context_,
-            CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
-            num_beams * sizeof(DelayParams),
-            delay_params.data()
-        );
-        
-        // Устанавливаем аргументы kernel
-        cl_int err = kernel_fractional_delay_.setArg(0, *buffer);
-        err |= kernel_fractional_delay_.setArg(1, *buffer);
-        err |= kernel_fractional_delay_.setArg(2, lagrange_matrix_buffer_);
-        err |= kernel_fractional_delay_.setArg(3, delay_params_buf);
-        err |= kernel_fractional_delay_.setArg(4, static_cast<cl_uint>(num_beams));
-        err |= kernel_fractional_delay_.setArg(5, static_cast<cl_uint>(num_samples));
-        
-        if (!CheckError(err, "установка аргументов fractional_delay")) {
-            return false;
-        }
-        
-        // Запускаем kernel с профилированием
-        size_t global_size = num_beams * num_samples;
-        size_t preferred_work_group_size = 256;
-        size_t work_group_size = std::min(preferred_work_group_size, global_size);
-        
-        err = queue_.enqueueNDRangeKernel(
-            kernel_fractional_delay_,
-            cl::NullRange,
-            cl::NDRange(global_size),
-            cl::NDRange(work_group_size),
-            nullptr,
-            &event_out
-        );
-        
-        return CheckError(err, "запуск kernel fractional_delay с профилированием");
+        return EnqueueFractionalDelay(*buffer, delay_coefficients, num_beams, num_samples, &event_out, queue_);
     } catch (cl::Error& e) {
         std::cerr << "Ошибка при выполнении fractional_delay с профилированием: " << e.what() 
                   << " (код: " << e.err() << ")" << std::endl;
@@ -576,6 +1605,14 @@ bool OpenCLBackend::CopyDeviceToHostWithProfiling(
 
 bool OpenCLBackend::SelectDevice() {
     try {
+        if (device_preselected_) {
+            cl_platform_id platform_id = nullptr;
+            device_.getInfo(CL_DEVICE_PLATFORM, &platform_id);
+            platform_ = cl::Platform(platform_id);
+            std::cout << "Выбрано устройство: " << device_.getInfo<CL_DEVICE_NAME>() << std::endl;
+            return true;
+        }
+        
         std::vector<cl::Platform> platforms;
         cl::Platform::get(&platforms);
         
@@ -647,31 +1684,78 @@ bool OpenCLBackend::BuildProgram() {
         // Загружаем источники kernel'ов
         std::string kernel_source = LoadKernelSource("kernel_fractional_delay.cl");
         kernel_source += "\n" + LoadKernelSource("kernel_hadamard.cl");
+        kernel_source += "\n" + LoadKernelSource("kernel_fir.cl");
+        kernel_source += "\n" + LoadKernelSource("kernel_farrow_resample.cl");
+        kernel_source += "\n" + LoadKernelSource("kernel_decimate.cl");
+        kernel_source += "\n" + LoadKernelSource("kernel_noise.cl");
+        kernel_source += "\n" + LoadKernelSource("kernel_digest.cl");
         
         if (kernel_source.empty()) {
             std::cerr << "Ошибка: не удалось загрузить kernel источники" << std::endl;
             return false;
         }
         
-        // Создаём программу
+        // Вариант fractional_delay с обменом отсчётами через sub_group_shuffle
+        // (подгруппы - возможность OpenCL C 2.0+, поэтому только для сборки CL3.0;
+        // откат на CL1.2 собирает обычный вариант)
+        std::string extensions;
+        device_.getInfo(CL_DEVICE_EXTENSIONS, &extensions);
+        const bool use_subgroup_shuffle = try_opencl_c_30 &&
+            HasExtension(extensions, "cl_khr_subgroups") &&
+            HasExtension(extensions, "cl_khr_subgroup_shuffle");
+        
+        // Опции компиляции: пробуем использовать OpenCL C 3.0, если поддерживается
+        const std::string options_cl30 = std::string("-cl-std=CL3.0 -cl-fast-relaxed-math -cl-mad-enable") +
+            (use_subgroup_shuffle ? " -DUSE_SUBGROUP_SHUFFLE" : "");
+        const std::string options_cl12 = "-cl-std=CL1.2 -cl-fast-relaxed-math -cl-mad-enable";
+        
+        // Ключ кэша бинарников: исходник + опции + устройство/драйвер/платформа
+        std::string dev_name, driver_version, platform_version;
+        device_.getInfo(CL_DEVICE_NAME, &dev_name);
+        device_.getInfo(CL_DRIVER_VERSION, &driver_version);
+        platform_.getInfo(CL_PLATFORM_VERSION, &platform_version);
+        auto make_key = [&](const std::string& options) {
+            return ProgramBinaryCache::MakeKey(kernel_source, options, dev_name, driver_version, platform_version);
+        };
+        
+        // 1. Пробуем загрузить скомпилированный бинарник из кэша
+        std::vector<std::string> option_sets;
+        if (try_opencl_c_30) {
+            option_sets.push_back(options_cl30);
+        }
+        option_sets.push_back(options_cl12);
+        
+        for (const auto& options : option_sets) {
+            if (LoadProgramFromBinaryCache(make_key(options), options)) {
+                std::cout << "✅ Программа загружена из кэша бинарников ("
+                          << program_binary_cache_.GetCacheDirectory() << ")" << std::endl;
+                return true;
+            }
+        }
+        
+        // 2. Компиляция из исходников
         cl::Program::Sources sources;
         sources.push_back({kernel_source.c_str(), kernel_source.length()});
         program_ = cl::Program(context_, sources);
         
-        // Опции компиляции: пробуем использовать OpenCL C 3.0, если поддерживается
         std::string build_options;
         if (try_opencl_c_30) {
             // Пробуем OpenCL C 3.0 с оптимизациями
-            build_options = "-cl-std=CL3.0 -cl-fast-relaxed-math -cl-mad-enable";
+            build_options = options_cl30;
             std::cout << "Попытка компиляции с OpenCL C 3.0 и оптимизациями..." << std::endl;
         } else {
             // OpenCL C 1.2 с оптимизациями
-            build_options = "-cl-std=CL1.2 -cl-fast-relaxed-math -cl-mad-enable";
+            build_options = options_cl12;
             std::cout << "Компиляция с OpenCL C 1.2 (устройство поддерживает: " << opencl_c_version << ")" << std::endl;
         }
         
-        // Компилируем
-        cl_int err = program_.build({device_}, build_options.c_str());
+        // Компилируем (с включёнными исключениями ошибка сборки приходит как cl::Error)
+        cl_int err = CL_SUCCESS;
+        try {
+            err = program_.build({device_}, build_options.c_str());
+        } catch (cl::Error& e) {
+            err = e.err();
+        }
         if (err != CL_SUCCESS) {
             std::string build_log;
             program_.getBuildInfo(device_, CL_PROGRAM_BUILD_LOG, &build_log);
@@ -680,7 +1764,8 @@ bool OpenCLBackend::BuildProgram() {
             // Если не удалось с OpenCL C 3.0, пробуем 1.2
             if (try_opencl_c_30) {
                 std::cerr << "\n⚠️  Не удалось скомпилировать с OpenCL C 3.0, пробуем OpenCL C 1.2..." << std::endl;
-                build_options = "-cl-std=CL1.2 -cl-fast-relaxed-math -cl-mad-enable";
+                build_options = options_cl12;
+                program_ = cl::Program(context_, sources);
                 err = program_.build({device_}, build_options.c_str());
                 if (err != CL_SUCCESS) {
                     std::string build_log2;
@@ -695,22 +1780,20 @@ bool OpenCLBackend::BuildProgram() {
         } else {
             if (try_opencl_c_30) {
                 std::cout << "✅ Компиляция успешна с OpenCL C 3.0!" << std::endl;
+                if (use_subgroup_shuffle) {
+                    std::cout << "   fractional_delay: вариант с sub_group_shuffle" << std::endl;
+                }
             } else {
                 std::cout << "✅ Компиляция успешна с OpenCL C 1.2" << std::endl;
             }
         }
         
-        // Создаём kernel объекты
-        kernel_fractional_delay_ = cl::Kernel(program_, "fractional_delay", &err);
-        if (!CheckError(err, "создание kernel fractional_delay")) {
-            return false;
-        }
-        
-        kernel_hadamard_ = cl::Kernel(program_, "hadamard_multiply", &err);
-        if (!CheckError(err, "создание kernel hadamard_multiply")) {
+        if (!CreateKernels()) {
             return false;
         }
         
+        // 3. Сохраняем бинарник для следующих запусков
+        StoreProgramBinary(make_key(build_options));
         return true;
     } catch (cl::Error& e) {
         std::cerr << "Ошибка при компиляции программы: " << e.what() 
@@ -719,6 +1802,134 @@ bool OpenCLBackend::BuildProgram() {
     }
 }
 
+bool OpenCLBackend::CreateKernels() {
+    cl_int err = CL_SUCCESS;
+    
+    // Создаём kernel объекты
+    kernel_fractional_delay_ = cl::Kernel(program_, "fractional_delay", &err);
+    if (!CheckError(err, "создание kernel fractional_delay")) {
+        return false;
+    }
+    
+    kernel_fractional_delay_int16_ = cl::Kernel(program_, "fractional_delay_int16", &err);
+    if (!CheckError(err, "создание kernel fractional_delay_int16")) {
+        return false;
+    }
+    
+    kernel_fractional_delay_half_ = cl::Kernel(program_, "fractional_delay_half", &err);
+    if (!CheckError(err, "создание kernel fractional_delay_half")) {
+        return false;
+    }
+    
+    kernel_fractional_delay_fanout_ = cl::Kernel(program_, "fractional_delay_fanout", &err);
+    if (!CheckError(err, "создание kernel fractional_delay_fanout")) {
+        return false;
+    }
+    
+    kernel_delay_and_sum_ = cl::Kernel(program_, "delay_and_sum", &err);
+    if (!CheckError(err, "создание kernel delay_and_sum")) {
+        return false;
+    }
+    
+    kernel_hadamard_ = cl::Kernel(program_, "hadamard_multiply", &err);
+    if (!CheckError(err, "создание kernel hadamard_multiply")) {
+        return false;
+    }
+    
+    kernel_heterodyne_ = cl::Kernel(program_, "heterodyne_multiply", &err);
+    if (!CheckError(err, "создание kernel heterodyne_multiply")) {
+        return false;
+    }
+    
+    kernel_fir_direct_ = cl::Kernel(program_, "fir_direct", &err);
+    if (!CheckError(err, "создание kernel fir_direct")) {
+        return false;
+    }
+    
+    kernel_fir_update_history_ = cl::Kernel(program_, "fir_update_history", &err);
+    if (!CheckError(err, "создание kernel fir_update_history")) {
+        return false;
+    }
+    
+    kernel_fir_os_gather_ = cl::Kernel(program_, "fir_os_gather", &err);
+    if (!CheckError(err, "создание kernel fir_os_gather")) {
+        return false;
+    }
+    
+    kernel_fir_os_scatter_ = cl::Kernel(program_, "fir_os_scatter", &err);
+    if (!CheckError(err, "создание kernel fir_os_scatter")) {
+        return false;
+    }
+    
+    kernel_farrow_resample_ = cl::Kernel(program_, "farrow_resample", &err);
+    if (!CheckError(err, "создание kernel farrow_resample")) {
+        return false;
+    }
+    
+    kernel_fir_decimate_ = cl::Kernel(program_, "fir_decimate", &err);
+    if (!CheckError(err, "создание kernel fir_decimate")) {
+        return false;
+    }
+    
+    kernel_add_gaussian_noise_ = cl::Kernel(program_, "add_gaussian_noise", &err);
+    if (!CheckError(err, "создание kernel add_gaussian_noise")) {
+        return false;
+    }
+    
+    kernel_tile_digest_ = cl::Kernel(program_, "tile_digest", &err);
+    if (!CheckError(err, "создание kernel tile_digest")) {
+        return false;
+    }
+    
+    return true;
+}
+
+bool OpenCLBackend::LoadProgramFromBinaryCache(const std::string& key, const std::string& build_options) {
+    std::vector<unsigned char> binary;
+    if (!program_binary_cache_.Load(key, &binary)) {
+        return false;
+    }
+    
+    try {
+        cl::Program::Binaries binaries;
+        binaries.push_back(binary);
+        std::vector<cl_int> binary_status;
+        cl_int err = CL_SUCCESS;
+        program_ = cl::Program(context_, {device_}, binaries, &binary_status, &err);
+        if (err != CL_SUCCESS || binary_status.empty() || binary_status[0] != CL_SUCCESS) {
+            throw cl::Error(err != CL_SUCCESS ? err : CL_INVALID_BINARY, "clCreateProgramWithBinary");
+        }
+        
+        // Для бинарника build() только выполняет компоновку - это быстро
+        program_.build({device_}, build_options.c_str());
+        
+        if (!CreateKernels()) {
+            throw cl::Error(CL_INVALID_BINARY, "clCreateKernel");
+        }
+        return true;
+    } catch (cl::Error& e) {
+        std::cerr << "Предупреждение: бинарник из кэша отвергнут (" << e.what()
+                  << ", код: " << e.err() << "), компилируем из исходников" << std::endl;
+        program_binary_cache_.Remove(key);
+        program_ = cl::Program();
+        return false;
+    }
+}
+
+void OpenCLBackend::StoreProgramBinary(const std::string& key) {
+    try {
+        std::vector<std::vector<unsigned char>> binaries;
+        program_.getInfo(CL_PROGRAM_BINARIES, &binaries);
+        if (binaries.empty() || binaries[0].empty()) {
+            return;  // Драйвер не отдаёт бинарник - работаем без кэша
+        }
+        program_binary_cache_.Store(key, binaries[0]);
+    } catch (cl::Error& e) {
+        std::cerr << "Предупреждение: не удалось получить бинарник программы: " << e.what()
+                  << " (код: " << e.err() << ")" << std::endl;
+    }
+}
+
 std::string OpenCLBackend::LoadKernelSource(const std::string& filename) const {
     // Используем абсолютный путь через OPENCL_KERNEL_DIR из CMake
     std::string kernel_dir = OPENCL_KERNEL_DIR;
@@ -760,6 +1971,251 @@ std::string OpenCLBackend::LoadKernelSource(const std::string& filename) const {
     return "";
 }
 
+bool OpenCLBackend::EnqueueFractionalDelay(
+    cl::Buffer& buffer,
+    const float* delay_coefficients,
+    size_t num_beams,
+    size_t num_samples,
+    cl::Event* event_out,
+    cl::CommandQueue& queue) {
+    
+    cl::Buffer delay_params_buf = CreateDelayParamsBuffer(delay_coefficients, num_beams);
+    
+    // Параметры запуска от автотюнера. Замер идёт на отдельных входном и выходном
+    // буферах, чтобы не испортить данные пользователя (kernel работает in-place)
+    WorkGroupTuner::LaunchConfig config = GetLaunchConfig(
+        kernel_fractional_delay_, "fractional_delay", num_beams, num_samples,
+        [&](size_t tune_beams, std::vector<cl::Buffer>& scratch) {
+            size_t scratch_bytes = tune_beams * num_samples * sizeof(ComplexType);
+            std::vector<float> scratch_delays(tune_beams, 0.0f);
+            scratch.emplace_back(context_, CL_MEM_READ_ONLY, scratch_bytes);
+            scratch.emplace_back(context_, CL_MEM_WRITE_ONLY, scratch_bytes);
+            scratch.push_back(CreateDelayParamsBuffer(scratch_delays.data(), tune_beams));
+            cl_int arg_err = kernel_fractional_delay_.setArg(0, scratch[0]);
+            arg_err |= kernel_fractional_delay_.setArg(1, scratch[1]);
+            arg_err |= kernel_fractional_delay_.setArg(2, lagrange_matrix_buffer_);
+            arg_err |= kernel_fractional_delay_.setArg(3, scratch[2]);
+            arg_err |= kernel_fractional_delay_.setArg(4, static_cast<cl_uint>(tune_beams));
+            arg_err |= kernel_fractional_delay_.setArg(5, static_cast<cl_uint>(num_samples));
+            return arg_err == CL_SUCCESS;
+        });
+    
+    // Устанавливаем аргументы kernel
+    cl_int err = kernel_fractional_delay_.setArg(0, buffer);
+    err |= kernel_fractional_delay_.setArg(1, buffer);  // in-place: input = output
+    err |= kernel_fractional_delay_.setArg(2, lagrange_matrix_buffer_);
+    err |= kernel_fractional_delay_.setArg(3, delay_params_buf);
+    err |= kernel_fractional_delay_.setArg(4, static_cast<cl_uint>(num_beams));
+    err |= kernel_fractional_delay_.setArg(5, static_cast<cl_uint>(num_samples));
+    
+    if (!CheckError(err, "установка аргументов fractional_delay")) {
+        return false;
+    }
+    
+    // Запускаем kernel (1D grid, grid-stride цикл внутри kernel)
+    // Глобальный размер дополнен до кратного размеру work group
+    size_t global_size = WorkGroupTuner::PaddedGlobalSize(num_beams * num_samples, config);
+    
+    err = queue.enqueueNDRangeKernel(
+        kernel_fractional_delay_,
+        cl::NullRange,
+        cl::NDRange(global_size),
+        cl::NDRange(config.local_size),
+        nullptr,
+        event_out
+    );
+    
+    return CheckError(err, "запуск kernel fractional_delay");
+}
+
+cl::Buffer OpenCLBackend::CreateDelayParamsBuffer(const float* delay_coefficients, size_t num_beams) {
+    // Для каждого луча: delay_integer и lagrange_row (раскладка DelayParams в kernel)
+    std::vector<FractionalDelayParams> delay_params(num_beams);
+    for (size_t beam = 0; beam < num_beams; ++beam) {
+        delay_params[beam] = ComputeDelayParams(delay_coefficients[beam]);
+    }
+    
+    return cl::Buffer(
+        context_,
+        CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+        num_beams * sizeof(FractionalDelayParams),
+        delay_params.data()
+    );
+}
+
+bool OpenCLBackend::EnqueueFractionalDelayPacked(
+    const cl::Buffer& input,
+    cl::Buffer& output,
+    SampleFormat format,
+    const float* delay_coefficients,
+    size_t num_beams,
+    size_t num_samples,
+    cl::Event* event_out) {
+    
+    cl::Kernel& kernel = format == SampleFormat::INT16_IQ
+        ? kernel_fractional_delay_int16_
+        : kernel_fractional_delay_half_;
+    const std::string kernel_name = format == SampleFormat::INT16_IQ
+        ? "fractional_delay_int16"
+        : "fractional_delay_half";
+    
+    cl::Buffer delay_params_buf = CreateDelayParamsBuffer(delay_coefficients, num_beams);
+    
+    auto bind_args = [&](const cl::Buffer& in, const cl::Buffer& out, const cl::Buffer& params, size_t beams) {
+        cl_int arg_err = kernel.setArg(0, in);
+        arg_err |= kernel.setArg(1, out);
+        arg_err |= kernel.setArg(2, lagrange_matrix_buffer_);
+        arg_err |= kernel.setArg(3, params);
+        arg_err |= kernel.setArg(4, static_cast<cl_uint>(beams));
+        arg_err |= kernel.setArg(5, static_cast<cl_uint>(num_samples));
+        return arg_err;
+    };
+    
+    WorkGroupTuner::LaunchConfig config = GetLaunchConfig(
+        kernel, kernel_name, num_beams, num_samples,
+        [&](size_t tune_beams, std::vector<cl::Buffer>& scratch) {
+            size_t scratch_bytes = tune_beams * num_samples * SignalBuffer::BytesPerSample(format);
+            std::vector<float> scratch_delays(tune_beams, 0.0f);
+            scratch.emplace_back(context_, CL_MEM_READ_ONLY, scratch_bytes);
+            scratch.emplace_back(context_, CL_MEM_WRITE_ONLY, scratch_bytes);
+            scratch.push_back(CreateDelayParamsBuffer(scratch_delays.data(), tune_beams));
+            return bind_args(scratch[0], scratch[1], scratch[2], tune_beams) == CL_SUCCESS;
+        });
+    
+    if (!CheckError(bind_args(input, output, delay_params_buf, num_beams),
+                    "установка аргументов " + kernel_name)) {
+        return false;
+    }
+    
+    size_t global_size = WorkGroupTuner::PaddedGlobalSize(num_beams * num_samples, config);
+    cl_int err = queue_.enqueueNDRangeKernel(
+        kernel,
+        cl::NullRange,
+        cl::NDRange(global_size),
+        cl::NDRange(config.local_size),
+        nullptr,
+        event_out
+    );
+    
+    return CheckError(err, "запуск kernel " + kernel_name);
+}
+
+WorkGroupTuner::LaunchConfig OpenCLBackend::GetLaunchConfig(
+    cl::Kernel& kernel,
+    const std::string& kernel_name,
+    size_t num_beams,
+    size_t num_samples,
+    const std::function<bool(size_t, std::vector<cl::Buffer>&)>& bind_scratch_args) {
+    
+    const std::string key = WorkGroupTuner::MakeKey(
+        device_name_, driver_version_, kernel_name, num_beams, num_samples);
+    
+    WorkGroupTuner::LaunchConfig config;
+    if (work_group_tuner_.Lookup(key, &config)) {
+        return config;
+    }
+    
+    // Ограничения устройства и kernel
+    size_t kernel_max_wg = 0;
+    size_t preferred_multiple = 0;
+    kernel.getWorkGroupInfo(device_, CL_KERNEL_WORK_GROUP_SIZE, &kernel_max_wg);
+    kernel.getWorkGroupInfo(device_, CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE, &preferred_multiple);
+    
+    std::vector<size_t> local_sizes = WorkGroupTuner::CandidateLocalSizes(
+        max_work_group_size_, kernel_max_wg, preferred_multiple);
+    
+    // Безопасный вариант на случай ошибки замера
+    WorkGroupTuner::LaunchConfig best(local_sizes.front(), 1, 0.0);
+    
+    // Временный буфер не больше 16M отсчётов (128 MB) - класс формы сохраняется
+    const size_t MAX_TUNE_ITEMS = size_t(1) << 24;
+    size_t tune_beams = std::max<size_t>(1, std::min(num_beams, MAX_TUNE_ITEMS / std::max<size_t>(num_samples, 1)));
+    size_t tune_items = tune_beams * num_samples;
+    
+    // Временные буферы живут до конца замера
+    std::vector<cl::Buffer> scratch;
+    
+    try {
+        if (!bind_scratch_args(tune_beams, scratch)) {
+            std::cerr << "Предупреждение: автотюнер " << kernel_name
+                      << " не смог установить аргументы, используем local=" << best.local_size << std::endl;
+            return best;
+        }
+    } catch (cl::Error& e) {
+        std::cerr << "Предупреждение: автотюнер " << kernel_name << " не смог создать временные буферы: "
+                  << e.what() << " (код: " << e.err() << "), используем local=" << best.local_size << std::endl;
+        return best;
+    }
+    
+    const int REPEATS = 3;
+    double best_time = std::numeric_limits<double>::max();
+    size_t measured = 0;
+    bool aborted = false;
+    
+    for (size_t local : local_sizes) {
+        for (size_t items : WorkGroupTuner::CandidateItemsPerWorkItem()) {
+            WorkGroupTuner::LaunchConfig candidate(local, items);
+            size_t global_size = WorkGroupTuner::PaddedGlobalSize(tune_items, candidate);
+            
+            double min_time = std::numeric_limits<double>::max();
+            try {
+                // Прогрев (компиляция под размер, кэши)
+                queue_.enqueueNDRangeKernel(
+                    kernel, cl::NullRange, cl::NDRange(global_size), cl::NDRange(local));
+                queue_.finish();
+                
+                for (int rep = 0; rep < REPEATS; ++rep) {
+                    cl::Event event;
+                    queue_.enqueueNDRangeKernel(
+                        kernel, cl::NullRange, cl::NDRange(global_size), cl::NDRange(local),
+                        nullptr, &event);
+                    event.wait();
+                    cl_ulong started = 0, ended = 0;
+                    event.getProfilingInfo(CL_PROFILING_COMMAND_START, &started);
+                    event.getProfilingInfo(CL_PROFILING_COMMAND_END, &ended);
+                    min_time = std::min(min_time, static_cast<double>(ended - started) / 1000000.0);
+                }
+            } catch (cl::Error& e) {
+                // Размер отвергнут устройством - пропускаем кандидата; прочие ошибки прерывают замер
+                if (e.err() == CL_INVALID_WORK_GROUP_SIZE || e.err() == CL_INVALID_WORK_ITEM_SIZE ||
+                    e.err() == CL_OUT_OF_RESOURCES) {
+                    continue;
+                }
+                std::cerr << "Предупреждение: автотюнер " << kernel_name << " прерван: " << e.what()
+                          << " (код: " << e.err() << ")" << std::endl;
+                aborted = true;
+                break;
+            }
+            
+            ++measured;
+            if (min_time < best_time) {
+                best_time = min_time;
+                best = candidate;
+                best.time_ms = min_time;
+            }
+        }
+        if (aborted) {
+            break;
+        }
+    }
+    
+    // Незавершённый замер в кэш не попадает: следующий запуск повторит его
+    if (aborted || measured == 0) {
+        std::cerr << "Предупреждение: автотюнер " << kernel_name << " не завершён (замерено кандидатов: "
+                  << measured << "), используем local=" << best.local_size
+                  << ", items/wi=" << best.items_per_work_item << " без сохранения в кэш" << std::endl;
+        return best;
+    }
+    
+    std::cout << "Автотюнер " << kernel_name << " [" << WorkGroupTuner::ShapeClass(num_beams, num_samples)
+              << "]: local=" << best.local_size << ", items/wi=" << best.items_per_work_item
+              << ", " << best.time_ms << " мс" << std::endl;
+    
+    work_group_tuner_.Store(key, best);
+    work_group_tuner_.Save();
+    return best;
+}
+
 bool OpenCLBackend::CheckError(cl_int err, const std::string& context) const {
     if (err != CL_SUCCESS) {
         std::cerr << "Ошибка OpenCL в " << context << ": код " << err << std::endl;
@@ -828,6 +2284,8 @@ bool OpenCLBackend::CreateFFTPlans(size_t num_samples, size_t num_beams) {
     }
     
     fft_plans_created_ = true;
+    fft_plan_samples_ = num_samples;
+    fft_plan_batch_ = num_beams;
     return true;
 #else
     return false;
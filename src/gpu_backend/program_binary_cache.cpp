@@ -0,0 +1,122 @@
+#include "gpu_backend/program_binary_cache.h"
+#include "gpu_backend/work_group_tuner.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <system_error>
+
+ProgramBinaryCache::ProgramBinaryCache(const std::string& cache_dir)
+    : cache_dir_(cache_dir) {
+    if (cache_dir_.empty()) {
+        cache_dir_ = WorkGroupTuner::DefaultCacheDirectory() + "/programs";
+    }
+}
+
+std::string ProgramBinaryCache::MakeKey(
+    const std::string& source,
+    const std::string& build_options,
+    const std::string& device_name,
+    const std::string& driver_version,
+    const std::string& platform_version) {
+
+    // Поля разделяются нулевым байтом, чтобы "ab"+"c" != "a"+"bc"
+    const std::string separator(1, '\0');
+    uint64_t hash = 14695981039346656037ULL;  // FNV offset basis
+    hash = Fnv1a64(source, hash);
+    hash = Fnv1a64(separator + build_options, hash);
+    hash = Fnv1a64(separator + device_name, hash);
+    hash = Fnv1a64(separator + driver_version, hash);
+    hash = Fnv1a64(separator + platform_version, hash);
+
+    std::ostringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return ss.str();
+}
+
+bool ProgramBinaryCache::Load(const std::string& key, std::vector<unsigned char>* binary) const {
+    if (binary == nullptr) {
+        return false;
+    }
+
+    std::ifstream file(PathForKey(key), std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::streamsize size = file.tellg();
+    if (size <= 0) {
+        return false;
+    }
+    file.seekg(0, std::ios::beg);
+
+    binary->resize(static_cast<size_t>(size));
+    if (!file.read(reinterpret_cast<char*>(binary->data()), size)) {
+        binary->clear();
+        return false;
+    }
+    return true;
+}
+
+bool ProgramBinaryCache::Store(const std::string& key, const std::vector<unsigned char>& binary) const {
+    if (binary.empty()) {
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(cache_dir_, ec);
+    if (ec) {
+        std::cerr << "Ошибка: не удалось создать директорию кэша программ "
+                  << cache_dir_ << ": " << ec.message() << std::endl;
+        return false;
+    }
+
+    // Пишем в свой временный файл (имя уникально для процесса и вызова) и
+    // переименовываем: параллельный писатель не затрёт его, а читатель
+    // никогда не увидит недописанный бинарник
+    const std::string final_path = PathForKey(key);
+    const std::string tmp_path = WorkGroupTuner::TempPathFor(final_path);
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Ошибка: не удалось создать файл " << tmp_path << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(binary.data()),
+                   static_cast<std::streamsize>(binary.size()));
+        if (!file) {
+            std::cerr << "Ошибка: не удалось записать бинарник программы " << tmp_path << std::endl;
+            file.close();
+            std::filesystem::remove(tmp_path, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tmp_path, final_path, ec);
+    if (ec) {
+        std::cerr << "Ошибка: не удалось сохранить бинарник программы "
+                  << final_path << ": " << ec.message() << std::endl;
+        std::filesystem::remove(tmp_path, ec);
+        return false;
+    }
+    return true;
+}
+
+void ProgramBinaryCache::Remove(const std::string& key) const {
+    std::error_code ec;
+    std::filesystem::remove(PathForKey(key), ec);
+}
+
+std::string ProgramBinaryCache::PathForKey(const std::string& key) const {
+    return cache_dir_ + "/" + key + ".bin";
+}
+
+uint64_t ProgramBinaryCache::Fnv1a64(const std::string& data, uint64_t hash) {
+    const uint64_t FNV_PRIME = 1099511628211ULL;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
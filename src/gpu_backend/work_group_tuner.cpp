@@ -0,0 +1,225 @@
+#include "gpu_backend/work_group_tuner.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <mutex>
+#include <atomic>
+#include <system_error>
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Записи файла кэша (отсутствие файла - пустой результат)
+void ReadCacheEntries(const std::string& filename,
+                      std::map<std::string, WorkGroupTuner::LaunchConfig>* entries) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        std::string key;
+        WorkGroupTuner::LaunchConfig config;
+        if (!std::getline(fields, key, '\t') ||
+            !(fields >> config.local_size >> config.items_per_work_item >> config.time_ms)) {
+            std::cerr << "Предупреждение: пропущена повреждённая строка кэша work group: "
+                      << line << std::endl;
+            continue;
+        }
+
+        if (config.local_size == 0 || config.items_per_work_item == 0) {
+            continue;
+        }
+        (*entries)[key] = config;
+    }
+}
+
+} // namespace
+
+WorkGroupTuner::WorkGroupTuner(const std::string& cache_filename)
+    : cache_filename_(cache_filename) {
+    if (cache_filename_.empty()) {
+        cache_filename_ = DefaultCacheDirectory() + "/work_group_cache.tsv";
+    }
+}
+
+bool WorkGroupTuner::Load() {
+    ReadCacheEntries(cache_filename_, &entries_);
+    return true;  // Отсутствие файла - не ошибка
+}
+
+bool WorkGroupTuner::Save() const {
+    // Backend'ы нескольких устройств (MultiDeviceExecutor) пишут общий файл из разных потоков
+    static std::mutex save_mutex;
+    std::lock_guard<std::mutex> lock(save_mutex);
+
+    try {
+        std::filesystem::path dir = std::filesystem::path(cache_filename_).parent_path();
+        if (!dir.empty()) {
+            std::filesystem::create_directories(dir);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Ошибка: не удалось создать директорию кэша: " << e.what() << std::endl;
+        return false;
+    }
+
+    // Файл мог дополнить другой backend или процесс после нашего Load:
+    // его записи сохраняются, совпадающие ключи берутся из памяти
+    std::map<std::string, LaunchConfig> merged;
+    ReadCacheEntries(cache_filename_, &merged);
+    for (const auto& pair : entries_) {
+        merged[pair.first] = pair.second;
+    }
+
+    // Запись во временный файл и rename: читатель не увидит недописанный кэш
+    const std::string tmp_path = TempPathFor(cache_filename_);
+    {
+        std::ofstream file(tmp_path, std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Ошибка: не удалось записать кэш work group " << tmp_path << std::endl;
+            return false;
+        }
+
+        file << "# key\tlocal_size\titems_per_work_item\ttime_ms\n";
+        for (const auto& pair : merged) {
+            file << pair.first << '\t'
+                 << pair.second.local_size << '\t'
+                 << pair.second.items_per_work_item << '\t'
+                 << std::fixed << std::setprecision(6) << pair.second.time_ms << '\n';
+        }
+
+        if (!file.good()) {
+            std::cerr << "Ошибка: не удалось записать кэш work group " << tmp_path << std::endl;
+            file.close();
+            std::error_code ec;
+            std::filesystem::remove(tmp_path, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, cache_filename_, ec);
+    if (ec) {
+        std::cerr << "Ошибка: не удалось переименовать кэш work group: " << ec.message() << std::endl;
+        std::filesystem::remove(tmp_path, ec);
+        return false;
+    }
+
+    return true;
+}
+
+bool WorkGroupTuner::Lookup(const std::string& key, LaunchConfig* config) const {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return false;
+    }
+    if (config) {
+        *config = it->second;
+    }
+    return true;
+}
+
+void WorkGroupTuner::Store(const std::string& key, const LaunchConfig& config) {
+    entries_[key] = config;
+}
+
+std::string WorkGroupTuner::MakeKey(
+    const std::string& device_name,
+    const std::string& driver_version,
+    const std::string& kernel_name,
+    size_t num_beams,
+    size_t num_samples) {
+
+    // Символы-разделители не должны попадать в поля ключа
+    auto sanitize = [](std::string value) {
+        std::replace(value.begin(), value.end(), '\t', ' ');
+        std::replace(value.begin(), value.end(), '|', '/');
+        return value;
+    };
+
+    return sanitize(device_name) + "|" + sanitize(driver_version) + "|" +
+           sanitize(kernel_name) + "|" + ShapeClass(num_beams, num_samples);
+}
+
+std::string WorkGroupTuner::ShapeClass(size_t num_beams, size_t num_samples) {
+    std::ostringstream ss;
+    ss << "b" << RoundUpPow2(num_beams) << "_s" << RoundUpPow2(num_samples);
+    return ss.str();
+}
+
+std::vector<size_t> WorkGroupTuner::CandidateLocalSizes(
+    size_t device_max_wg,
+    size_t kernel_max_wg,
+    size_t preferred_multiple) {
+
+    size_t limit = std::min(device_max_wg, kernel_max_wg);
+    if (limit == 0) {
+        limit = std::max(device_max_wg, kernel_max_wg);
+    }
+    if (limit == 0) {
+        limit = 256;
+    }
+
+    size_t first = std::max<size_t>(preferred_multiple, 32);
+    first = std::min(first, limit);
+
+    std::vector<size_t> candidates;
+    for (size_t local = first; local <= limit && local <= 1024; local *= 2) {
+        candidates.push_back(local);
+    }
+    if (candidates.empty()) {
+        candidates.push_back(limit);
+    }
+    return candidates;
+}
+
+std::vector<size_t> WorkGroupTuner::CandidateItemsPerWorkItem() {
+    return {1, 2, 4, 8};
+}
+
+size_t WorkGroupTuner::PaddedGlobalSize(size_t total_items, const LaunchConfig& config) {
+    size_t local = std::max<size_t>(config.local_size, 1);
+    size_t items = std::max<size_t>(config.items_per_work_item, 1);
+    size_t work_items = (total_items + items - 1) / items;
+    size_t groups = std::max<size_t>((work_items + local - 1) / local, 1);
+    return groups * local;
+}
+
+std::string WorkGroupTuner::TempPathFor(const std::string& path) {
+    static std::atomic<unsigned long> counter(0);
+    std::ostringstream name;
+    name << path << ".tmp.";
+#if defined(__unix__) || defined(__APPLE__)
+    name << static_cast<long>(getpid()) << ".";
+#endif
+    name << counter.fetch_add(1);
+    return name.str();
+}
+
+std::string WorkGroupTuner::DefaultCacheDirectory() {
+    const char* env_dir = std::getenv("LCH_FARROW_CACHE_DIR");
+    if (env_dir != nullptr && env_dir[0] != '\0') {
+        return std::string(env_dir);
+    }
+    return "Results/cache";
+}
+
+size_t WorkGroupTuner::RoundUpPow2(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
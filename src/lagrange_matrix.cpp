@@ -1,14 +1,46 @@
 #include "lagrange_matrix.h"
+#include "lagrange_matrix_data.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <cstdlib>
+
+static_assert(lagrange_data::ROWS == LagrangeMatrix::ROWS && lagrange_data::COLS == LagrangeMatrix::COLS,
+              "Встроенная таблица не совпадает с размером матрицы Лагранжа");
 
 LagrangeMatrix::LagrangeMatrix() {
     matrix_.resize(ROWS * COLS, 0.0f);
 }
 
+const LagrangeMatrix& LagrangeMatrix::Shared() {
+    // Инициализация локальной статической переменной потокобезопасна (C++11)
+    static const LagrangeMatrix shared = [] {
+        LagrangeMatrix matrix;
+        const char* json_path = std::getenv("LCH_FARROW_LAGRANGE_JSON");
+        if (json_path != nullptr && json_path[0] != '\0') {
+            if (matrix.LoadFromJson(json_path)) {
+                std::cout << "Матрица Лагранжа загружена из: " << json_path << std::endl;
+                return matrix;
+            }
+            std::cerr << "Предупреждение: используем встроенную матрицу Лагранжа" << std::endl;
+        }
+        matrix.LoadFromArray(lagrange_data::kMatrix);
+        return matrix;
+    }();
+    return shared;
+}
+
+bool LagrangeMatrix::LoadFromArray(const float* data) {
+    if (data == nullptr) {
+        std::cerr << "Ошибка: нулевой указатель на данные матрицы Лагранжа" << std::endl;
+        return false;
+    }
+    matrix_.assign(data, data + ROWS * COLS);
+    return true;
+}
+
 bool LagrangeMatrix::LoadFromJson(const std::string& filename) {
     std::ifstream file(filename);
     if (!file.is_open()) {
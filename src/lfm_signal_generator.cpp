@@ -1,4 +1,6 @@
 #include "../include/lfm_signal_generator.h"
+#include "../include/thread_pool.h"
+#include "../include/noise_generator.h"
 
 #include <cmath>
 #include <numeric>
@@ -6,79 +8,266 @@
 
 namespace radar {
 
-// ═════════════════════════════════════════════════════════════════════
-// PRIVATE IMPLEMENTATION
-// ═════════════════════════════════════════════════════════════════════
+namespace {
 
-void LFMSignalGenerator::GenerateVariant_Basic(
-    std::complex<float>* beam_data,
-    size_t num_samples) const noexcept {
-    const float inv_sample_rate = 1.0f / params_.sample_rate;
-    for (size_t sample = 0; sample < num_samples; ++sample) {
-        float t = static_cast<float>(sample) * inv_sample_rate;
-        float phase = ComputePhase(t);
-        beam_data[sample] = GenerateComplexSample(phase);
+// Отсчётов в задаче генерации (ParallelFor2D) и в блоке, по которому сразу
+// считается статистика (8 KB - блок ещё в L1)
+constexpr size_t STATS_TASK_TILE = 16384;
+constexpr size_t STATS_BLOCK = 1024;
+
+// Попарная сумма: ошибка O(log n · eps) вместо O(n · eps) у последовательной
+double PairwiseSum(const double* values, size_t count) {
+    if (count <= 8) {
+        double sum = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            sum += values[i];
+        }
+        return sum;
     }
+    const size_t half = count / 2;
+    return PairwiseSum(values, half) + PairwiseSum(values + half, count - half);
 }
 
-void LFMSignalGenerator::GenerateVariant_PhaseOffset(
-    std::complex<float>* beam_data,
-    size_t num_samples,
-    float phase_offset) const noexcept {
-    const float inv_sample_rate = 1.0f / params_.sample_rate;
-    for (size_t sample = 0; sample < num_samples; ++sample) {
-        float t = static_cast<float>(sample) * inv_sample_rate;
-        float phase = ComputePhase(t, phase_offset);
-        beam_data[sample] = GenerateComplexSample(phase);
+// Отсчётов между точными затравками фазы в режиме PhaseMode::ACCUMULATED
+constexpr size_t PHASE_RESEED_BLOCK = 4096;
+constexpr double TWO_PI_D = 6.28318530717958647692;
+
+// Поля LFMParameters, нужные ядрам генерации (ядра не зависят от класса)
+struct ChirpCore {
+    float f_start;
+    float chirp_rate;
+    float inv_sample_rate;
+    float inv_duration;
+
+    // PhaseMode::ACCUMULATED: фаза в периодах φ(n) = cycles_per_sample·n + half_rate_cycles·n²
+    bool accumulate_phase;
+    double cycles_per_sample;    // f_start / fs
+    double half_rate_cycles;     // chirp_rate / (2·fs²)
+};
+
+ChirpCore MakeChirpCore(const LFMParameters& params) {
+    ChirpCore core;
+    core.f_start = params.f_start;
+    core.chirp_rate = params.GetChirpRate();
+    core.inv_sample_rate = 1.0f / params.sample_rate;
+    core.inv_duration = 1.0f / params.duration;
+
+    const double sample_rate = static_cast<double>(params.sample_rate);
+    const double chirp_rate = (static_cast<double>(params.f_stop) - params.f_start) / params.duration;
+    core.accumulate_phase = params.phase_mode == PhaseMode::ACCUMULATED;
+    core.cycles_per_sample = params.f_start / sample_rate;
+    core.half_rate_cycles = 0.5 * chirp_rate / (sample_rate * sample_rate);
+    return core;
+}
+
+// Параметры луча: считаются один раз до цикла по отсчётам
+struct BeamPlan {
+    float phase_offset = 0.0f;   // PHASE_OFFSET, BEAMFORMING
+    int delay_int = 0;           // DELAY, ANGLE_SWEEP (целая часть задержки в отсчётах)
+};
+
+// Hamming w(n) = 0.54 - 0.46*cos(2πn), n - нормированное время отсчёта
+inline float HammingWindow(const ChirpCore& core, size_t sample) noexcept {
+    float t = static_cast<float>(sample) * core.inv_sample_rate;
+    float t_norm = t * core.inv_duration;
+    return 0.54f - 0.46f * std::cos(TWO_PI * t_norm);
+}
+
+// Свернуть фазу в периодах в [-0.5, 0.5)
+inline double WrapCycles(double cycles) noexcept {
+    return cycles - std::floor(cycles + 0.5);
+}
+
+template <bool kConjugate, bool kWindowed>
+inline void StoreChirpSample(std::complex<float>* out, size_t i, float phase, const float* window) noexcept {
+    float re = std::cos(phase);
+    float im = std::sin(phase);
+    if constexpr (kConjugate) {
+        im = -im;
+    }
+    if constexpr (kWindowed) {
+        re *= window[i];
+        im *= window[i];
     }
+    out[i] = std::complex<float>(re, im);
 }
 
-void LFMSignalGenerator::GenerateVariant_Delay(
-    std::complex<float>* beam_data,
-    size_t num_samples,
-    float delay_samples) const noexcept {
-    const int delay_int = static_cast<int>(delay_samples);
-    const float inv_sample_rate = 1.0f / params_.sample_rate;
-    for (size_t sample = 0; sample < num_samples; ++sample) {
-        int delayed_sample = static_cast<int>(sample) - delay_int;
-        if (delayed_sample < 0) {
-            beam_data[sample] = std::complex<float>(0.0f, 0.0f);
-        } else {
-            float t = static_cast<float>(delayed_sample) * inv_sample_rate;
-            float phase = ComputePhase(t);
-            beam_data[sample] = GenerateComplexSample(phase);
+/**
+ * @brief PhaseMode::DIRECT: фаза по формуле во float для каждого отсчёта
+ *
+ * Аргумент sin/cos растёт как t², на длинных лучах теряет точность.
+ */
+template <bool kConjugate, bool kWindowed>
+inline void ChirpBlockDirect(const ChirpCore& core, std::complex<float>* out, long long time_index,
+                             size_t count, float phase_offset, const float* window) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        float t = static_cast<float>(time_index + static_cast<long long>(i)) * core.inv_sample_rate;
+        float phase = TWO_PI * (core.f_start * t + 0.5f * core.chirp_rate * t * t) + phase_offset;
+        StoreChirpSample<kConjugate, kWindowed>(out, i, phase, window);
+    }
+}
+
+/**
+ * @brief PhaseMode::ACCUMULATED: фаза в периодах (double) рекуррентно второго порядка
+ *
+ * φ(n+1) = φ(n) + d(n), d(n+1) = d(n) + 2·half_rate_cycles; φ и d свёрнуты
+ * в [-0.5, 0.5), поэтому sin/cos получают аргумент из [-π, π) (без дорогой
+ * редукции). Каждые PHASE_RESEED_BLOCK отсчётов φ и d заново считаются по
+ * формуле в double: ошибка фазы ограничена (~eps float от π) при любой длине.
+ */
+template <bool kConjugate, bool kWindowed>
+inline void ChirpBlockAccumulated(const ChirpCore& core, std::complex<float>* out, long long time_index,
+                                  size_t count, float phase_offset, const float* window) noexcept {
+    const double offset_cycles = static_cast<double>(phase_offset) / TWO_PI_D;
+    const double step_delta = 2.0 * core.half_rate_cycles;
+
+    for (size_t begin = 0; begin < count; begin += PHASE_RESEED_BLOCK) {
+        const size_t end = std::min(count, begin + PHASE_RESEED_BLOCK);
+        const double n = static_cast<double>(time_index + static_cast<long long>(begin));
+
+        double cycles = WrapCycles(core.cycles_per_sample * n + core.half_rate_cycles * n * n + offset_cycles);
+        double step = WrapCycles(core.cycles_per_sample + core.half_rate_cycles * (2.0 * n + 1.0));
+
+        for (size_t i = begin; i < end; ++i) {
+            StoreChirpSample<kConjugate, kWindowed>(out, i, static_cast<float>(TWO_PI_D * cycles), window);
+
+            // |cycles|, |step| < 0.5 - свёртка одним условным вычитанием
+            cycles += step;
+            cycles -= (cycles >= 0.5) ? 1.0 : 0.0;
+            cycles += (cycles < -0.5) ? 1.0 : 0.0;
+            step += step_delta;
+            step -= (step >= 0.5) ? 1.0 : 0.0;
+            step += (step < -0.5) ? 1.0 : 0.0;
         }
     }
 }
 
-void LFMSignalGenerator::GenerateVariant_Beamforming(
-    std::complex<float>* beam_data,
-    size_t num_samples,
-    float phase_shift) const noexcept {
-    const float inv_sample_rate = 1.0f / params_.sample_rate;
-    for (size_t sample = 0; sample < num_samples; ++sample) {
-        float t = static_cast<float>(sample) * inv_sample_rate;
-        float phase = ComputePhase(t, phase_shift);
-        beam_data[sample] = GenerateComplexSample(phase);
+/**
+ * @brief Общее ядро: out[i] = exp(±j·phase(t)) [· window[i]], t = (time_index + i) / fs
+ *
+ * Без ветвлений по отсчётам: сопряжение и окно - параметры шаблона, режим
+ * фазы выбирается один раз на блок.
+ */
+template <bool kConjugate, bool kWindowed>
+inline void ChirpBlock(const ChirpCore& core, std::complex<float>* out, long long time_index,
+                       size_t count, float phase_offset, const float* window) noexcept {
+    if (core.accumulate_phase) {
+        ChirpBlockAccumulated<kConjugate, kWindowed>(core, out, time_index, count, phase_offset, window);
+    } else {
+        ChirpBlockDirect<kConjugate, kWindowed>(core, out, time_index, count, phase_offset, window);
     }
 }
 
-void LFMSignalGenerator::GenerateVariant_Windowed(
-    std::complex<float>* beam_data,
-    size_t num_samples) const noexcept {
-    const float inv_sample_rate = 1.0f / params_.sample_rate;
-    const float inv_duration = 1.0f / params_.duration;
-    for (size_t sample = 0; sample < num_samples; ++sample) {
-        float t = static_cast<float>(sample) * inv_sample_rate;
-        float t_norm = t * inv_duration;
-        // Hamming window: w(n) = 0.54 - 0.46*cos(2πn)
-        float window = 0.54f - 0.46f * std::cos(TWO_PI * t_norm);
-        float phase = ComputePhase(t);
-        auto sample_val = GenerateComplexSample(phase);
-        beam_data[sample] = sample_val * window;
+/**
+ * @brief Отсчёты [first_sample, first_sample + count) луча варианта kVariant
+ *
+ * Зависящие от отсчёта ветвления вынесены в точки разбиения блока: у задержки
+ * пролог из нулей (сигнал ещё не пришёл) и тело без проверки, у окна -
+ * часть внутри кэшированной таблицы и хвост за ней (только у GenerateBeam
+ * длиннее кадра).
+ */
+template <LFMVariant kVariant>
+void GenerateBlock(const ChirpCore& core, const BeamPlan& plan, const std::vector<float>& window_table,
+                   std::complex<float>* out, size_t first_sample, size_t count) noexcept {
+    const long long first = static_cast<long long>(first_sample);
+
+    if constexpr (kVariant == LFMVariant::DELAY || kVariant == LFMVariant::ANGLE_SWEEP) {
+        size_t lead = 0;
+        if (plan.delay_int > 0 && first < plan.delay_int) {
+            lead = std::min(count, static_cast<size_t>(plan.delay_int - first));
+        }
+        std::fill(out, out + lead, std::complex<float>(0.0f, 0.0f));
+        ChirpBlock<false, false>(core, out + lead, first + static_cast<long long>(lead) - plan.delay_int,
+                                 count - lead, 0.0f, nullptr);
+    } else if constexpr (kVariant == LFMVariant::WINDOWED) {
+        const size_t table_size = window_table.size();
+        const size_t head = first_sample < table_size ? std::min(count, table_size - first_sample) : 0;
+        ChirpBlock<false, true>(core, out, first, head, 0.0f, window_table.data() + first_sample);
+        ChirpBlock<false, false>(core, out + head, first + static_cast<long long>(head), count - head, 0.0f, nullptr);
+        for (size_t i = head; i < count; ++i) {
+            out[i] *= HammingWindow(core, first_sample + i);
+        }
+    } else if constexpr (kVariant == LFMVariant::HETERODYNE) {
+        ChirpBlock<true, false>(core, out, first, count, 0.0f, nullptr);
+    } else {
+        ChirpBlock<false, false>(core, out, first, count, plan.phase_offset, nullptr);
     }
 }
 
+/**
+ * @brief Сгенерировать все лучи варианта kVariant со статистикой в том же проходе
+ *
+ * Статистика считается, пока блок в L1: частичные суммы по задачам (луч, тайл),
+ * затем попарная редукция - результат не зависит от числа потоков, а ошибка
+ * суммы энергии растёт как log(числа задач).
+ */
+template <LFMVariant kVariant>
+void GenerateSweep(const ChirpCore& core, const std::vector<BeamPlan>& plans,
+                   const std::vector<float>& window_table, SignalBuffer& buffer, size_t num_samples,
+                   float* peak_amplitude, double* energy_total) {
+    const size_t num_beams = plans.size();
+    const size_t num_tiles = (num_samples + STATS_TASK_TILE - 1) / STATS_TASK_TILE;
+    std::vector<double> tile_energy(num_beams * num_tiles, 0.0);
+    std::vector<float> tile_peak_squared(num_beams * num_tiles, 0.0f);
+
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &buffer.GetBeamNodes();
+    hint.bytes_per_item = sizeof(std::complex<float>);
+
+    ThreadPool::Instance().ParallelFor2D(num_beams, num_samples, STATS_TASK_TILE,
+        [&](size_t beam, size_t begin, size_t end) {
+            std::complex<float>* beam_data = buffer.GetBeamData(beam);
+            double energy = 0.0;
+            float peak_squared = 0.0f;
+
+            for (size_t block = begin; block < end; block += STATS_BLOCK) {
+                const size_t count = std::min(STATS_BLOCK, end - block);
+                GenerateBlock<kVariant>(core, plans[beam], window_table, beam_data + block, block, count);
+
+                // |x|² без hypot: корень берётся один раз для пика
+                const float* values = reinterpret_cast<const float*>(beam_data + block);
+                float block_energy = 0.0f;
+                float block_peak = 0.0f;
+                for (size_t i = 0; i < count; ++i) {
+                    float re = values[2 * i];
+                    float im = values[2 * i + 1];
+                    float power = re * re + im * im;
+                    block_energy += power;
+                    block_peak = std::max(block_peak, power);
+                }
+                energy += block_energy;
+                peak_squared = std::max(peak_squared, block_peak);
+            }
+
+            const size_t task = beam * num_tiles + begin / STATS_TASK_TILE;
+            tile_energy[task] = energy;
+            tile_peak_squared[task] = peak_squared;
+        }, hint);
+
+    float peak_squared = 0.0f;
+    for (float value : tile_peak_squared) {
+        peak_squared = std::max(peak_squared, value);
+    }
+
+    *peak_amplitude = std::sqrt(peak_squared);
+    *energy_total = PairwiseSum(tile_energy.data(), tile_energy.size());
+}
+
+} // namespace
+
+// ═════════════════════════════════════════════════════════════════════
+// PRIVATE IMPLEMENTATION
+// ═════════════════════════════════════════════════════════════════════
+
+std::vector<float> LFMSignalGenerator::BuildWindowTable() const {
+    const ChirpCore core = MakeChirpCore(params_);
+    std::vector<float> window(params_.GetNumSamples());
+    for (size_t sample = 0; sample < window.size(); ++sample) {
+        window[sample] = HammingWindow(core, sample);
+    }
+    return window;
+}
+
 // ═════════════════════════════════════════════════════════════════════
 // PUBLIC API
 // ═════════════════════════════════════════════════════════════════════
@@ -113,67 +302,73 @@ ErrorCode LFMSignalGenerator::GenerateIntoBuffer(SignalBuffer& buffer, LFMVarian
         float element_spacing = wavelength / 2.0f;
         float steering_rad = params_.steering_angle * PI / 180.0f;
 
+        // Пролог: параметры лучей считаются один раз, ядро варианта выбирается
+        // один раз на кадр (а не на луч) и не ветвится по отсчётам
+        std::vector<BeamPlan> plans(params_.num_beams);
         for (size_t beam = 0; beam < params_.num_beams; ++beam) {
-            auto* beam_data = buffer.GetBeamData(beam);
-
+            BeamPlan& plan = plans[beam];
             switch (variant) {
-            case LFMVariant::BASIC:
-                GenerateVariant_Basic(beam_data, num_samples);
+            case LFMVariant::PHASE_OFFSET:
+                plan.phase_offset = TWO_PI * beam / params_.num_beams;
                 break;
 
-            case LFMVariant::PHASE_OFFSET: {
-                float phase_offset = TWO_PI * beam / params_.num_beams;
-                GenerateVariant_PhaseOffset(beam_data, num_samples, phase_offset);
-                break;
-            }
-
             case LFMVariant::DELAY: {
                 float delay_factor = static_cast<float>(beam) / params_.num_beams;
                 float delay_samples = delay_factor * (params_.sample_rate / (2.0f * params_.f_start));
-                GenerateVariant_Delay(beam_data, num_samples, delay_samples);
+                plan.delay_int = static_cast<int>(delay_samples);
                 break;
             }
 
             case LFMVariant::BEAMFORMING: {
                 float element_pos = static_cast<float>(beam) * element_spacing;
-                float phase_shift = TWO_PI * element_pos * std::sin(steering_rad) / wavelength;
-                GenerateVariant_Beamforming(beam_data, num_samples, phase_shift);
+                plan.phase_offset = TWO_PI * element_pos * std::sin(steering_rad) / wavelength;
                 break;
             }
 
-            case LFMVariant::WINDOWED:
-                GenerateVariant_Windowed(beam_data, num_samples);
-                break;
-
             case LFMVariant::ANGLE_SWEEP: {
                 float angle_deg = params_.angle_start_deg +
                     static_cast<float>(beam) * params_.angle_step_deg;
-                GenerateVariant_AngleSweep(beam_data, num_samples, angle_deg, beam);
-                break;
-            }
-
-            case LFMVariant::HETERODYNE: {
-                GenerateVariant_Heterodyne(beam_data, num_samples);
+                plan.delay_int = static_cast<int>(ComputeDelayForAngle(angle_deg, beam));
                 break;
             }
 
             default:
-                return ErrorCode::GENERATION_FAILED;
+                break;
             }
         }
 
-        // Compute statistics
-        float peak_amp = 0.0f;
-        float rms = 0.0f;
-        const auto* raw_data = buffer.RawData();
-        for (size_t i = 0; i < buffer.GetTotalSize(); ++i) {
-            float amp = std::abs(raw_data[i]);
-            peak_amp = std::max(peak_amp, amp);
-            rms += amp * amp;
+        const ChirpCore core = MakeChirpCore(params_);
+        float peak_amplitude = 0.0f;
+        double energy = 0.0;
+
+        switch (variant) {
+        case LFMVariant::BASIC:
+            GenerateSweep<LFMVariant::BASIC>(core, plans, window_table_, buffer, num_samples, &peak_amplitude, &energy);
+            break;
+        case LFMVariant::PHASE_OFFSET:
+            GenerateSweep<LFMVariant::PHASE_OFFSET>(core, plans, window_table_, buffer, num_samples, &peak_amplitude, &energy);
+            break;
+        case LFMVariant::DELAY:
+            GenerateSweep<LFMVariant::DELAY>(core, plans, window_table_, buffer, num_samples, &peak_amplitude, &energy);
+            break;
+        case LFMVariant::BEAMFORMING:
+            GenerateSweep<LFMVariant::BEAMFORMING>(core, plans, window_table_, buffer, num_samples, &peak_amplitude, &energy);
+            break;
+        case LFMVariant::WINDOWED:
+            GenerateSweep<LFMVariant::WINDOWED>(core, plans, window_table_, buffer, num_samples, &peak_amplitude, &energy);
+            break;
+        case LFMVariant::ANGLE_SWEEP:
+            GenerateSweep<LFMVariant::ANGLE_SWEEP>(core, plans, window_table_, buffer, num_samples, &peak_amplitude, &energy);
+            break;
+        case LFMVariant::HETERODYNE:
+            GenerateSweep<LFMVariant::HETERODYNE>(core, plans, window_table_, buffer, num_samples, &peak_amplitude, &energy);
+            break;
+        default:
+            return ErrorCode::GENERATION_FAILED;
         }
 
-        stats_.peak_amplitude = peak_amp;
-        stats_.rms_value = std::sqrt(rms / buffer.GetTotalSize());
+        stats_.peak_amplitude = peak_amplitude;
+        stats_.rms_value = static_cast<float>(std::sqrt(energy / buffer.GetTotalSize()));
         return ErrorCode::SUCCESS;
 
     } catch (const std::exception& e) {
@@ -191,51 +386,47 @@ void LFMSignalGenerator::GenerateBeam(
         throw std::invalid_argument("Invalid beam_data or num_samples");
     }
 
+    const ChirpCore core = MakeChirpCore(params_);
+    BeamPlan plan;
+
     switch (variant) {
     case LFMVariant::BASIC:
-        GenerateVariant_Basic(beam_data, num_samples);
+        GenerateBlock<LFMVariant::BASIC>(core, plan, window_table_, beam_data, 0, num_samples);
         break;
     case LFMVariant::PHASE_OFFSET:
     case LFMVariant::BEAMFORMING:
-        GenerateVariant_PhaseOffset(beam_data, num_samples, beam_param);
+        plan.phase_offset = beam_param;
+        GenerateBlock<LFMVariant::PHASE_OFFSET>(core, plan, window_table_, beam_data, 0, num_samples);
         break;
     case LFMVariant::DELAY:
-        GenerateVariant_Delay(beam_data, num_samples, beam_param);
+        plan.delay_int = static_cast<int>(beam_param);
+        GenerateBlock<LFMVariant::DELAY>(core, plan, window_table_, beam_data, 0, num_samples);
         break;
     case LFMVariant::WINDOWED:
-        GenerateVariant_Windowed(beam_data, num_samples);
+        GenerateBlock<LFMVariant::WINDOWED>(core, plan, window_table_, beam_data, 0, num_samples);
         break;
     default:
         break;
     }
 }
 
-std::pair<std::vector<std::complex<float>>, std::vector<double>>
-LFMSignalGenerator::GetSignalWithNoise(const NoiseParams& params) {
+void LFMSignalGenerator::FillSignalWithNoise(
+    const NoiseParams& params,
+    uint64_t stream,
+    size_t first_sample,
+    std::complex<float>* out,
+    size_t count) const noexcept {
     const double dt = 1.0 / params.fd;
-    const int N = static_cast<int>(params.ti * params.fd + 1e-6);
-    std::vector<std::complex<float>> X(N);
-    std::vector<double> t(N);
-
-    // 1. Создание временного вектора
-    for (int n = 0; n < N; ++n) {
-        t[n] = n * dt + params.tau;
-    }
 
-    // 2. Параметры ЛЧМ
-    const double chirp_rate = params.fdev / params.ti;
+    // Шум - поток stream счётчикового генератора (не зависит от разбиения на блоки)
+    GenerateGaussianNoiseCPU(params.seed, stream, first_sample, static_cast<float>(params.an), out, count);
 
-    // 3. Генерация случайного гауссова шума (Box-Muller transform)
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::normal_distribution<> dis(0.0, 1.0);
-
-    // 4. Основной расчёт (векторизированный)
-    for (int n = 0; n < N; ++n) {
-        double tn = t[n];
+    for (size_t i = 0; i < count; ++i) {
+        // Время считается на месте, вектор времени не нужен
+        double tn = static_cast<double>(first_sample + i) * dt + params.tau;
 
         if (tn < 0.0 || tn > params.ti) {
-            X[n] = 0.0f;
+            out[i] = 0.0f;
             continue;
         }
 
@@ -247,16 +438,69 @@ LFMSignalGenerator::GetSignalWithNoise(const NoiseParams& params) {
         float signal_real = static_cast<float>(params.a * cos(phase));
         float signal_imag = static_cast<float>(params.a * sin(phase));
 
-        float noise_real = static_cast<float>(params.an * dis(gen));
-        float noise_imag = static_cast<float>(params.an * dis(gen));
+        out[i] += std::complex<float>(signal_real, signal_imag);
+    }
+}
 
-        X[n] = std::complex<float>(signal_real + noise_real,
-                                   signal_imag + noise_imag);
+std::pair<std::vector<std::complex<float>>, std::vector<double>>
+LFMSignalGenerator::GetSignalWithNoise(const NoiseParams& params) {
+    const double dt = 1.0 / params.fd;
+    const int N = static_cast<int>(params.ti * params.fd + 1e-6);
+    std::vector<std::complex<float>> X(N);
+    std::vector<double> t(N);
+
+    // 1. Создание временного вектора
+    for (int n = 0; n < N; ++n) {
+        t[n] = n * dt + params.tau;
     }
 
+    // 2. Сигнал + шум параллельно по блокам отсчётов
+    GetSignalWithNoise(params, X.data(), X.size());
+
     return {X, t};
 }
 
+void LFMSignalGenerator::GetSignalWithNoise(
+    const NoiseParams& params,
+    std::complex<float>* beam_data,
+    size_t num_samples,
+    uint64_t stream) const {
+    const size_t NOISE_BLOCK = 16384;
+    ThreadPool::Instance().ParallelFor(num_samples, NOISE_BLOCK, [&](size_t begin, size_t end) {
+        FillSignalWithNoise(params, stream, begin, beam_data + begin, end - begin);
+    });
+}
+
+ErrorCode LFMSignalGenerator::GetSignalWithNoise(const NoiseParams& params, SignalBuffer& buffer) const {
+    if (params.fd <= 0.0 || params.ti <= 0.0) {
+        return ErrorCode::INVALID_PARAMS;
+    }
+
+    if (!buffer.IsAllocated()) {
+        return ErrorCode::MEMORY_ALLOCATION_FAILED;
+    }
+
+    const size_t num_beams = buffer.GetNumBeams();
+    const size_t num_samples = buffer.GetNumSamples();
+    for (size_t beam = 0; beam < num_beams; ++beam) {
+        if (!buffer.GetBeamData(beam)) {
+            return ErrorCode::INVALID_BEAM_INDEX;
+        }
+    }
+
+    // Один проход записи по кадру: луч b - поток шума b, тайлы лучей параллельно
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &buffer.GetBeamNodes();
+    hint.bytes_per_item = sizeof(std::complex<float>);
+
+    ThreadPool::Instance().ParallelFor2D(num_beams, num_samples, 16384,
+        [&](size_t beam, size_t begin, size_t end) {
+            FillSignalWithNoise(params, beam, begin, buffer.GetBeamData(beam) + begin, end - begin);
+        }, hint);
+
+    return ErrorCode::SUCCESS;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // МЕТОД 1: Вычисление задержки для угла (формула 5 из теории)
 // ═══════════════════════════════════════════════════════════════════════════
@@ -279,6 +523,22 @@ float LFMSignalGenerator::ComputeDelayForAngle(
     return delay_samples;
 }
 
+std::vector<float> LFMSignalGenerator::ComputeAngleGridDelays(
+    size_t num_elements
+) const {
+    const size_t num_angles = params_.GetNumAngles();
+    std::vector<float> delays(num_angles * num_elements);
+
+    for (size_t angle = 0; angle < num_angles; ++angle) {
+        float angle_deg = params_.angle_start_deg + static_cast<float>(angle) * params_.angle_step_deg;
+        for (size_t element = 0; element < num_elements; ++element) {
+            delays[angle * num_elements + element] = ComputeDelayForAngle(angle_deg, element);
+        }
+    }
+
+    return delays;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // МЕТОД 2: Создание сопряжённой копии
 // ═══════════════════════════════════════════════════════════════════════════
@@ -286,14 +546,17 @@ float LFMSignalGenerator::ComputeDelayForAngle(
 SignalBuffer LFMSignalGenerator::MakeConjugateCopy(
     const SignalBuffer& src
 ) const {
-    SignalBuffer dst(src.GetNumBeams(), src.GetNumSamples());
-    const std::complex<float>* src_data = src.RawData();
-    std::complex<float>* dst_data = dst.RawData();
-    size_t total_size = src.GetTotalSize();
-
-    for (size_t i = 0; i < total_size; ++i) {
-        dst_data[i] = std::conj(src_data[i]);
-    }
+    SignalBuffer dst(src.GetNumBeams(), src.GetNumSamples(), src.GetNumaPolicy());
+
+    // Лучи хранятся отдельно (RawData - только луч 0): обход по лучам
+    ThreadPool::Instance().ParallelFor2D(src.GetNumBeams(), src.GetNumSamples(), 16384,
+        [&](size_t beam, size_t begin, size_t end) {
+            const std::complex<float>* src_data = src.GetBeamData(beam);
+            std::complex<float>* dst_data = dst.GetBeamData(beam);
+            for (size_t i = begin; i < end; ++i) {
+                dst_data[i] = std::conj(src_data[i]);
+            }
+        });
 
     return dst;
 }
@@ -303,10 +566,14 @@ SignalBuffer LFMSignalGenerator::MakeConjugateCopy(
 // ═══════════════════════════════════════════════════════════════════════════
 
 void LFMSignalGenerator::ConjugateInPlace(SignalBuffer& buffer) const noexcept {
-    std::complex<float>* data = buffer.RawData();
-    size_t total_size = buffer.GetTotalSize();
-    for (size_t i = 0; i < total_size; ++i) {
-        data[i] = std::conj(data[i]);
+    for (size_t beam = 0; beam < buffer.GetNumBeams(); ++beam) {
+        std::complex<float>* data = buffer.GetBeamData(beam);
+        if (data == nullptr) {
+            continue;
+        }
+        for (size_t i = 0; i < buffer.GetNumSamples(); ++i) {
+            data[i] = std::conj(data[i]);
+        }
     }
 }
 
@@ -324,44 +591,92 @@ SignalBuffer LFMSignalGenerator::Heterodyne(
         );
     }
 
-    SignalBuffer result(rx_signal.GetNumBeams(), rx_signal.GetNumSamples());
-    const std::complex<float>* rx_data = rx_signal.RawData();
-    const std::complex<float>* ref_data = ref_signal.RawData();
-    std::complex<float>* out_data = result.RawData();
-    size_t total_size = rx_signal.GetTotalSize();
-
-    for (size_t i = 0; i < total_size; ++i) {
-        out_data[i] = rx_data[i] * std::conj(ref_data[i]);
-    }
+    SignalBuffer result(rx_signal.GetNumBeams(), rx_signal.GetNumSamples(), rx_signal.GetNumaPolicy());
+    const size_t num_samples = rx_signal.GetNumSamples();
+
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &result.GetBeamNodes();
+    hint.bytes_per_item = 3 * sizeof(std::complex<float>);
+
+    // Лучи хранятся отдельно: обход по лучам, тайлы (луч, отсчёты) в общем пуле
+    ThreadPool::Instance().ParallelFor2D(rx_signal.GetNumBeams(), num_samples, 16384,
+        [&](size_t beam, size_t begin, size_t end) {
+            const std::complex<float>* rx_data = rx_signal.GetBeamData(beam);
+            const std::complex<float>* ref_data = ref_signal.GetBeamData(beam);
+            std::complex<float>* out_data = result.GetBeamData(beam);
+            for (size_t i = begin; i < end; ++i) {
+                out_data[i] = rx_data[i] * std::conj(ref_data[i]);
+            }
+        }, hint);
 
     return result;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
-// ПРИВАТНЫЙ МЕТОД: Генерация варианта с задержкой по углам
+// МЕТОД 5: Гетеродинирование на месте (общая опорная строка или по лучам)
 // ═══════════════════════════════════════════════════════════════════════════
 
-void LFMSignalGenerator::GenerateVariant_AngleSweep(
-    std::complex<float>* beam_data,
-    size_t num_samples,
-    float angle_deg,
-    size_t element_index
-) const noexcept {
-    float delay_samples = ComputeDelayForAngle(angle_deg, element_index);
-    GenerateVariant_Delay(beam_data, num_samples, delay_samples);
+void LFMSignalGenerator::HeterodyneInPlace(
+    SignalBuffer& rx_signal,
+    const std::complex<float>* ref_row
+) const {
+    if (ref_row == nullptr) {
+        throw std::invalid_argument("Reference row is null");
+    }
+
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &rx_signal.GetBeamNodes();
+    hint.bytes_per_item = 2 * sizeof(std::complex<float>);   // опорная строка общая, в кэше
+
+    ThreadPool::Instance().ParallelFor2D(rx_signal.GetNumBeams(), rx_signal.GetNumSamples(), 16384,
+        [&](size_t beam, size_t begin, size_t end) {
+            MultiplyConjugate(rx_signal.GetBeamData(beam), ref_row, begin, end);
+        }, hint);
 }
 
-// ═══════════════════════════════════════════════════════════════════════════
-// ПРИВАТНЫЙ МЕТОД: Генерация варианта гетеродина (сопряжённый сигнал)
-// ═══════════════════════════════════════════════════════════════════════════
+void LFMSignalGenerator::HeterodyneInPlace(
+    SignalBuffer& rx_signal,
+    const SignalBuffer& ref_signal
+) const {
+    if (ref_signal.GetNumSamples() != rx_signal.GetNumSamples() ||
+        (ref_signal.GetNumBeams() != 1 && ref_signal.GetNumBeams() != rx_signal.GetNumBeams())) {
+        throw std::invalid_argument(
+            "Reference must have one beam or as many beams as the signal, with the same length"
+        );
+    }
 
-void LFMSignalGenerator::GenerateVariant_Heterodyne(
-    std::complex<float>* beam_data,
-    size_t num_samples
-) const noexcept {
-    GenerateVariant_Basic(beam_data, num_samples);
-    for (size_t i = 0; i < num_samples; ++i) {
-        beam_data[i] = std::conj(beam_data[i]);
+    if (ref_signal.GetNumBeams() == 1) {
+        HeterodyneInPlace(rx_signal, ref_signal.GetBeamData(0));
+        return;
+    }
+
+    // Опорные лучи хранятся отдельно - указатель луча берётся в тайле
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &rx_signal.GetBeamNodes();
+    hint.bytes_per_item = 3 * sizeof(std::complex<float>);
+
+    ThreadPool::Instance().ParallelFor2D(rx_signal.GetNumBeams(), rx_signal.GetNumSamples(), 16384,
+        [&](size_t beam, size_t begin, size_t end) {
+            MultiplyConjugate(rx_signal.GetBeamData(beam), ref_signal.GetBeamData(beam), begin, end);
+        }, hint);
+}
+
+void LFMSignalGenerator::MultiplyConjugate(
+    std::complex<float>* data,
+    const std::complex<float>* ref,
+    size_t begin,
+    size_t end
+) noexcept {
+    // Раздельные re/im операции: без проверок NaN/Inf из operator* (векторизуется)
+    float* x = reinterpret_cast<float*>(data);
+    const float* h = reinterpret_cast<const float*>(ref);
+    for (size_t i = begin; i < end; ++i) {
+        float a = x[2 * i];
+        float b = x[2 * i + 1];
+        float c = h[2 * i];
+        float d = h[2 * i + 1];
+        x[2 * i] = a * c + b * d;        // (a + ib)(c - id)
+        x[2 * i + 1] = b * c - a * d;
     }
 }
 
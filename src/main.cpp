@@ -1,6 +1,8 @@
 #include <iostream>
 #include <memory>
 #include <cstring>
+#include <cstdlib>
+#include <cerrno>
 #include <vector>
 #include "signal_buffer.h"
 #include "application.h"
@@ -12,6 +14,7 @@
 #include "lfm_signal_generator.h"
 #include "fractional_delay_cpu.h"
 #include "result_comparator.h"
+#include "metrics_log.h"
 //#include "gpu_profiling.h"
 //#include "gpu_backend/opencl_backend.h"
 #include <iomanip>
@@ -25,7 +28,86 @@
 
 using namespace radar;
 
+namespace {
+
+// Целое без знака в [min_value, max_value]; при ошибке - сообщение с именем опции
+bool ParseUnsigned(const char* option, const char* text, unsigned long long min_value,
+                   unsigned long long max_value, unsigned long long* value) {
+    char* end = nullptr;
+    errno = 0;
+    const unsigned long long parsed = std::strtoull(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || text[0] == '-' ||
+        parsed < min_value || parsed > max_value) {
+        std::cerr << "Ошибка: неверное значение " << option << " " << text
+                  << " (ожидается " << min_value << ".." << max_value << ")\n";
+        return false;
+    }
+    *value = parsed;
+    return true;
+}
+
+// Опции запуска: каждая принимает ровно одно значение
+const char* const kOptions[] = {
+    "--metrics-log", "--metrics-socket", "--metrics-port", "--storage-format", "--multi-device",
+    "--validation-points", "--confidence", "--validation-seed",
+    "--threads", "--cpu-affinity", "--numa-policy"
+};
+
+bool IsKnownOption(const char* option) {
+    for (const char* known : kOptions) {
+        if (std::strcmp(option, known) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Список ядер: "0,2,4-7"
+bool ParseCpuList(const char* text, std::vector<int>* cpus) {
+    cpus->clear();
+    std::stringstream list(text);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        const size_t dash = item.find('-');
+        unsigned long long first = 0;
+        unsigned long long last = 0;
+        const std::string first_text = item.substr(0, dash);
+        const std::string last_text = dash == std::string::npos ? first_text : item.substr(dash + 1);
+        if (first_text.empty() || last_text.empty()) {
+            std::cerr << "Ошибка: неверный список --cpu-affinity " << text << " (пример: 0,2,4-7)\n";
+            return false;
+        }
+        if (!ParseUnsigned("--cpu-affinity", first_text.c_str(), 0, 4095, &first) ||
+            !ParseUnsigned("--cpu-affinity", last_text.c_str(), first, 4095, &last)) {
+            return false;
+        }
+        for (unsigned long long cpu = first; cpu <= last; ++cpu) {
+            cpus->push_back(static_cast<int>(cpu));
+        }
+    }
+    if (cpus->empty()) {
+        std::cerr << "Ошибка: пустой список --cpu-affinity\n";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
 int main(int argc, char* argv[]) {
+    // Офлайн-конвертер: --convert-metrics-log <журнал> [директория, по умолчанию Results]
+    if (argc >= 2 && std::strcmp(argv[1], "--convert-metrics-log") == 0) {
+        if (argc < 3 || argc > 4) {
+            std::cerr << "Ошибка: использование --convert-metrics-log <журнал> [директория]\n";
+            return 1;
+        }
+        const std::string out_dir = argc >= 4 ? argv[3] : "Results";
+        return ConvertMetricsLog(argv[2],
+                                 out_dir + "/JSON/profile_report.json",
+                                 out_dir + "/JSON/profile_report_gpu.json",
+                                 out_dir + "/rezult_test_gpu.md") ? 0 : 1;
+    }
+
     Application::Config cfg;
     cfg.f_start = 100.0f;
     cfg.f_stop = 500.0f;
@@ -34,6 +116,101 @@ int main(int argc, char* argv[]) {
     cfg.num_beams = 8;
     cfg.steering_angle = 30.0f;
     cfg.count_points = 1024*8;  // Новое поле для количества точек
+    // --metrics-log <журнал>: отчёты пишет фоновый поток в бинарный журнал
+    // --metrics-socket <путь> / --metrics-port <порт>: живые метрики Prometheus
+    // --storage-format int16|fp16|float: упакованная передача и ядро GPU + отчёт о погрешности
+    // --multi-device gpu|all: лучи делятся между OpenCL устройствами (all - включая CPU, PoCL)
+    // --validation-points N [--confidence P] [--validation-seed S]: выборочная проверка вместо полного CPU эталона
+    // --threads N / --cpu-affinity 0,2,4-7 / --numa-policy none|interleave|partition: пул CPU стадий
+    // Неизвестная опция или опция без значения - ошибка, а не запуск с умолчаниями
+    for (int i = 1; i < argc; i += 2) {
+        if (!IsKnownOption(argv[i])) {
+            std::cerr << "Ошибка: неизвестная опция " << argv[i] << "\n";
+            return 1;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Ошибка: не задано значение опции " << argv[i] << "\n";
+            return 1;
+        }
+
+        if (std::strcmp(argv[i], "--metrics-log") == 0) {
+            cfg.metrics_log = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--metrics-socket") == 0) {
+            cfg.metrics_socket = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--metrics-port") == 0) {
+            unsigned long long port = 0;
+            if (!ParseUnsigned(argv[i], argv[i + 1], 1, 65535, &port)) {
+                return 1;
+            }
+            cfg.metrics_port = static_cast<uint16_t>(port);
+        } else if (std::strcmp(argv[i], "--storage-format") == 0) {
+            if (std::strcmp(argv[i + 1], "int16") == 0) {
+                cfg.storage_format = SampleFormat::INT16_IQ;
+            } else if (std::strcmp(argv[i + 1], "fp16") == 0) {
+                cfg.storage_format = SampleFormat::FP16;
+            } else if (std::strcmp(argv[i + 1], "float") == 0) {
+                cfg.storage_format = SampleFormat::FLOAT32;
+            } else {
+                std::cerr << "Ошибка: неизвестный формат --storage-format " << argv[i + 1]
+                          << " (int16, fp16 или float)\n";
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--multi-device") == 0) {
+            if (std::strcmp(argv[i + 1], "gpu") == 0) {
+                cfg.multi_device = true;
+            } else if (std::strcmp(argv[i + 1], "all") == 0) {
+                cfg.multi_device = true;
+                cfg.multi_device_cpu = true;
+            } else {
+                std::cerr << "Ошибка: неизвестное значение --multi-device " << argv[i + 1]
+                          << " (gpu или all)\n";
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--validation-points") == 0) {
+            unsigned long long points = 0;
+            if (!ParseUnsigned(argv[i], argv[i + 1], 1, 1ull << 32, &points)) {
+                return 1;
+            }
+            cfg.validation_points = static_cast<size_t>(points);
+        } else if (std::strcmp(argv[i], "--confidence") == 0) {
+            char* end = nullptr;
+            const double confidence = std::strtod(argv[i + 1], &end);
+            if (end == argv[i + 1] || *end != '\0' || !(confidence > 0.0 && confidence < 1.0)) {
+                std::cerr << "Ошибка: неверное значение --confidence " << argv[i + 1]
+                          << " (ожидается число в (0, 1))\n";
+                return 1;
+            }
+            cfg.validation_confidence = confidence;
+        } else if (std::strcmp(argv[i], "--validation-seed") == 0) {
+            unsigned long long seed = 0;
+            if (!ParseUnsigned(argv[i], argv[i + 1], 0, ~0ull, &seed)) {
+                return 1;
+            }
+            cfg.validation_seed = seed;
+        } else if (std::strcmp(argv[i], "--threads") == 0) {
+            unsigned long long threads = 0;
+            if (!ParseUnsigned(argv[i], argv[i + 1], 0, 4096, &threads)) {
+                return 1;
+            }
+            cfg.num_threads = static_cast<size_t>(threads);
+        } else if (std::strcmp(argv[i], "--cpu-affinity") == 0) {
+            if (!ParseCpuList(argv[i + 1], &cfg.cpu_affinity)) {
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--numa-policy") == 0) {
+            if (std::strcmp(argv[i + 1], "none") == 0) {
+                cfg.numa_policy = NumaPolicy::NONE;
+            } else if (std::strcmp(argv[i + 1], "interleave") == 0) {
+                cfg.numa_policy = NumaPolicy::INTERLEAVE;
+            } else if (std::strcmp(argv[i + 1], "partition") == 0) {
+                cfg.numa_policy = NumaPolicy::PARTITION;
+            } else {
+                std::cerr << "Ошибка: неизвестное значение --numa-policy " << argv[i + 1]
+                          << " (none, interleave или partition)\n";
+                return 1;
+            }
+        }
+    }
     if(!cfg.IsValid()) {
         std::cerr << "Неверные параметры конфигурации приложения\n";
         return 1;
@@ -0,0 +1,400 @@
+#include "metrics_exporter.h"
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Период проверки флага остановки сервером (мс)
+constexpr int POLL_TIMEOUT_MS = 200;
+// Максимальный размер заголовков запроса
+constexpr size_t MAX_REQUEST_BYTES = 4096;
+
+// Длинное имя обрезается по границе символа UTF-8 и получает суффикс "~<слот>":
+// имена с общим началом не сливаются в одну серию
+void CopyName(const std::string& name, size_t slot, char (&target)[MetricsExporter::MAX_NAME_LENGTH]) {
+    const size_t capacity = MetricsExporter::MAX_NAME_LENGTH - 1;
+    if (name.size() <= capacity) {
+        std::memcpy(target, name.data(), name.size());
+        target[name.size()] = '\0';
+        return;
+    }
+
+    const std::string suffix = "~" + std::to_string(slot);
+    size_t length = capacity - suffix.size();
+    while (length > 0 && (static_cast<unsigned char>(name[length]) & 0xC0) == 0x80) {
+        --length;   // name[length] - продолжение многобайтного символа
+    }
+    std::memcpy(target, name.data(), length);
+    std::memcpy(target + length, suffix.data(), suffix.size());
+    target[length + suffix.size()] = '\0';
+}
+
+std::string EscapeLabel(const char* value) {
+    std::string escaped;
+    for (const char* c = value; *c != '\0'; ++c) {
+        if (*c == '\\') {
+            escaped += "\\\\";
+        } else if (*c == '"') {
+            escaped += "\\\"";
+        } else if (*c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += *c;
+        }
+    }
+    return escaped;
+}
+
+void WriteHeader(std::ostringstream& out, const char* name, const char* type, const char* help) {
+    out << "# HELP " << name << ' ' << help << '\n';
+    out << "# TYPE " << name << ' ' << type << '\n';
+}
+
+} // namespace
+
+const double MetricsExporter::BUCKET_BOUNDS[MetricsExporter::HISTOGRAM_BUCKETS - 1] = {
+    1e-5, 5e-5, 1e-4, 5e-4, 1e-3, 5e-3, 1e-2, 5e-2, 0.1, 0.5, 1.0
+};
+
+MetricsExporter::MetricsExporter()
+    : state_(new Snapshot()),
+      buffers_(new SnapshotBuffer[2]),
+      published_(0),
+      listen_fd_(-1),
+      stop_(false) {
+    for (size_t i = 0; i < 2; ++i) {
+        buffers_[i].sequence.store(0, std::memory_order_relaxed);
+        std::memset(&buffers_[i].data, 0, sizeof(Snapshot));
+    }
+}
+
+MetricsExporter::~MetricsExporter() {
+    Stop();
+}
+
+void MetricsExporter::Publish(const ProfilingMetrics& metrics, const std::vector<GPUEventMetrics>& gpu_events) {
+    Snapshot& state = *state_;
+
+    for (const auto& pair : metrics.metrics) {
+        const TimingMetric& metric = pair.second;
+        auto it = stage_history_.find(metric.name);
+        if (it == stage_history_.end()) {
+            if (state.num_stages >= MAX_STAGES) {
+                continue;
+            }
+            const size_t slot = state.num_stages++;
+            CopyName(metric.name, slot, state.stages[slot].name);
+            it = stage_history_.emplace(metric.name, StageHistory{slot, 0, 0.0}).first;
+        }
+
+        StageHistory& history = it->second;
+        const uint64_t calls = metric.call_count;
+        if (calls <= history.last_calls) {
+            continue;
+        }
+
+        const uint64_t new_calls = calls - history.last_calls;
+        const double new_seconds = std::max(0.0, metric.time_ms - history.last_time_ms) / 1000.0;
+        const double avg_seconds = new_seconds / static_cast<double>(new_calls);
+        size_t bucket = 0;
+        while (bucket < HISTOGRAM_BUCKETS - 1 && avg_seconds > BUCKET_BOUNDS[bucket]) {
+            ++bucket;
+        }
+
+        Snapshot::Stage& stage = state.stages[history.slot];
+        stage.calls += new_calls;
+        stage.seconds += new_seconds;
+        stage.buckets[bucket] += new_calls;
+        history.last_calls = calls;
+        history.last_time_ms = metric.time_ms;
+    }
+
+    if (!gpu_events.empty()) {
+        for (const GPUEventMetrics& event : gpu_events) {
+            auto it = gpu_event_slots_.find(event.event_name);
+            if (it == gpu_event_slots_.end()) {
+                if (state.num_gpu_events >= MAX_GPU_EVENTS) {
+                    continue;
+                }
+                const size_t slot = state.num_gpu_events++;
+                CopyName(event.event_name, slot, state.gpu_events[slot].name);
+                it = gpu_event_slots_.emplace(event.event_name, slot).first;
+            }
+            Snapshot::GpuEvent& target = state.gpu_events[it->second];
+            target.queue_seconds = event.queue_time_ms / 1000.0;
+            target.wait_seconds = event.wait_time_ms / 1000.0;
+            target.execution_seconds = event.execution_time_ms / 1000.0;
+            target.total_seconds = event.total_time_ms / 1000.0;
+        }
+
+        double frame_seconds = 0.0;
+        for (const GPUEventMetrics& event : gpu_events) {
+            frame_seconds += event.total_time_ms / 1000.0;
+        }
+        state.gpu_frame_seconds = frame_seconds;
+    }
+
+    // Запись в буфер, который читатели сейчас не берут: seqlock нечётный на время копирования
+    const uint64_t next = published_.load(std::memory_order_relaxed) + 1;
+    state.publications = next;
+    SnapshotBuffer& buffer = buffers_[next & 1];
+    const uint64_t sequence = buffer.sequence.load(std::memory_order_relaxed);
+    buffer.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&buffer.data, &state, sizeof(Snapshot));
+    buffer.sequence.store(sequence + 2, std::memory_order_release);
+    published_.store(next, std::memory_order_release);
+}
+
+void MetricsExporter::ResetBaseline() {
+    for (auto& pair : stage_history_) {
+        pair.second.last_calls = 0;
+        pair.second.last_time_ms = 0.0;
+    }
+}
+
+void MetricsExporter::ReadSnapshot(Snapshot* snapshot) const {
+    // Повтор, только если писатель успел дважды опубликовать за время копирования
+    for (;;) {
+        const uint64_t published = published_.load(std::memory_order_acquire);
+        const SnapshotBuffer& buffer = buffers_[published & 1];
+        const uint64_t sequence = buffer.sequence.load(std::memory_order_acquire);
+        if (sequence & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::memcpy(snapshot, &buffer.data, sizeof(Snapshot));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (buffer.sequence.load(std::memory_order_relaxed) == sequence) {
+            return;
+        }
+    }
+}
+
+std::string MetricsExporter::FormatPrometheus(const Snapshot& snapshot) {
+    std::ostringstream out;
+    out << std::setprecision(12);
+
+    WriteHeader(out, "lch_farrow_publications_total", "counter", "Публикаций снимка метрик потоком обработки");
+    out << "lch_farrow_publications_total " << snapshot.publications << '\n';
+
+    const uint32_t num_stages = std::min<uint32_t>(snapshot.num_stages, MAX_STAGES);
+    WriteHeader(out, "lch_farrow_stage_calls_total", "counter", "Вызовов стадии ProfilingEngine");
+    for (uint32_t i = 0; i < num_stages; ++i) {
+        const Snapshot::Stage& stage = snapshot.stages[i];
+        out << "lch_farrow_stage_calls_total{stage=\"" << EscapeLabel(stage.name) << "\"} " << stage.calls << '\n';
+    }
+
+    WriteHeader(out, "lch_farrow_stage_seconds_total", "counter", "Суммарное время стадии, с");
+    for (uint32_t i = 0; i < num_stages; ++i) {
+        const Snapshot::Stage& stage = snapshot.stages[i];
+        out << "lch_farrow_stage_seconds_total{stage=\"" << EscapeLabel(stage.name) << "\"} " << stage.seconds << '\n';
+    }
+
+    WriteHeader(out, "lch_farrow_stage_duration_seconds", "histogram", "Длительность вызова стадии, с");
+    for (uint32_t i = 0; i < num_stages; ++i) {
+        const Snapshot::Stage& stage = snapshot.stages[i];
+        const std::string label = "stage=\"" + EscapeLabel(stage.name) + "\"";
+        uint64_t cumulative = 0;
+        for (size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket) {
+            cumulative += stage.buckets[bucket];
+            out << "lch_farrow_stage_duration_seconds_bucket{" << label << ",le=\"";
+            if (bucket < HISTOGRAM_BUCKETS - 1) {
+                out << BUCKET_BOUNDS[bucket];
+            } else {
+                out << "+Inf";
+            }
+            out << "\"} " << cumulative << '\n';
+        }
+        out << "lch_farrow_stage_duration_seconds_sum{" << label << "} " << stage.seconds << '\n';
+        out << "lch_farrow_stage_duration_seconds_count{" << label << "} " << stage.calls << '\n';
+    }
+
+    const uint32_t num_gpu_events = std::min<uint32_t>(snapshot.num_gpu_events, MAX_GPU_EVENTS);
+    WriteHeader(out, "lch_farrow_gpu_event_seconds", "gauge",
+                "Фазы события OpenCL в последнем кадре (queue, wait, execution, total), с");
+    for (uint32_t i = 0; i < num_gpu_events; ++i) {
+        const Snapshot::GpuEvent& event = snapshot.gpu_events[i];
+        const std::string label = "event=\"" + EscapeLabel(event.name) + "\",phase=\"";
+        out << "lch_farrow_gpu_event_seconds{" << label << "queue\"} " << event.queue_seconds << '\n';
+        out << "lch_farrow_gpu_event_seconds{" << label << "wait\"} " << event.wait_seconds << '\n';
+        out << "lch_farrow_gpu_event_seconds{" << label << "execution\"} " << event.execution_seconds << '\n';
+        out << "lch_farrow_gpu_event_seconds{" << label << "total\"} " << event.total_seconds << '\n';
+    }
+
+    WriteHeader(out, "lch_farrow_gpu_frame_seconds", "gauge", "Сумма времени событий GPU последнего кадра, с");
+    out << "lch_farrow_gpu_frame_seconds " << snapshot.gpu_frame_seconds << '\n';
+
+    return out.str();
+}
+
+bool MetricsExporter::Start(const Options& options) {
+#if defined(__linux__)
+    if (IsRunning()) {
+        std::cerr << "Ошибка: сервер метрик уже запущен" << std::endl;
+        return false;
+    }
+    if (options.unix_socket_path.empty() == (options.tcp_port == 0)) {
+        std::cerr << "Ошибка: для сервера метрик нужен ровно один адрес (Unix-сокет или порт)" << std::endl;
+        return false;
+    }
+
+    int fd = -1;
+    if (!options.unix_socket_path.empty()) {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (options.unix_socket_path.size() >= sizeof(address.sun_path)) {
+            std::cerr << "Ошибка: слишком длинный путь Unix-сокета " << options.unix_socket_path << std::endl;
+            return false;
+        }
+        std::memcpy(address.sun_path, options.unix_socket_path.c_str(), options.unix_socket_path.size());
+
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0) {
+            unlink(options.unix_socket_path.c_str());   // Сокет прошлого запуска
+            if (bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+                close(fd);
+                fd = -1;
+            }
+        }
+    } else {
+        sockaddr_in address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons(options.tcp_port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd >= 0) {
+            const int reuse = 1;
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+            if (bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+                close(fd);
+                fd = -1;
+            }
+        }
+    }
+
+    if (fd < 0 || listen(fd, 8) != 0) {
+        std::cerr << "Ошибка: не удалось открыть сокет сервера метрик: " << std::strerror(errno) << std::endl;
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+
+    listen_fd_ = fd;
+    unix_socket_path_ = options.unix_socket_path;
+    stop_.store(false);
+    server_ = std::thread(&MetricsExporter::ServerLoop, this);
+    return true;
+#else
+    (void)options;
+    std::cerr << "Ошибка: сервер метрик поддерживается только в Linux" << std::endl;
+    return false;
+#endif
+}
+
+void MetricsExporter::Stop() {
+    if (!server_.joinable()) {
+        return;
+    }
+
+    stop_.store(true);
+    server_.join();
+#if defined(__linux__)
+    close(listen_fd_);
+    listen_fd_ = -1;
+    if (!unix_socket_path_.empty()) {
+        unlink(unix_socket_path_.c_str());
+    }
+#endif
+}
+
+void MetricsExporter::ServerLoop() {
+#if defined(__linux__)
+    std::unique_ptr<Snapshot> scratch(new Snapshot());
+    while (!stop_.load()) {
+        pollfd listener;
+        listener.fd = listen_fd_;
+        listener.events = POLLIN;
+        listener.revents = 0;
+        if (poll(&listener, 1, POLL_TIMEOUT_MS) <= 0) {
+            continue;
+        }
+
+        const int client_fd = accept(listen_fd_, nullptr, nullptr);
+        if (client_fd < 0) {
+            continue;
+        }
+        ServeClient(client_fd, scratch.get());
+        close(client_fd);
+    }
+#endif
+}
+
+void MetricsExporter::ServeClient(int client_fd, Snapshot* scratch) {
+#if defined(__linux__)
+    // Клиент, не приславший заголовки за секунду, отключается
+    timeval timeout;
+    timeout.tv_sec = 1;
+    timeout.tv_usec = 0;
+    setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    std::string request;
+    char chunk[512];
+    while (request.size() < MAX_REQUEST_BYTES &&
+           request.find("\r\n\r\n") == std::string::npos &&
+           request.find("\n\n") == std::string::npos) {
+        const ssize_t received = recv(client_fd, chunk, sizeof(chunk), 0);
+        if (received <= 0) {
+            break;
+        }
+        request.append(chunk, static_cast<size_t>(received));
+    }
+
+    std::string status = "200 OK";
+    std::string body;
+    if (request.compare(0, 13, "GET /metrics ") == 0 || request.compare(0, 6, "GET / ") == 0) {
+        ReadSnapshot(scratch);
+        body = FormatPrometheus(*scratch);
+    } else {
+        status = "404 Not Found";
+        body = "Метрики: GET /metrics\n";
+    }
+
+    std::ostringstream response;
+    response << "HTTP/1.0 " << status << "\r\n"
+             << "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+             << "Content-Length: " << body.size() << "\r\n"
+             << "Connection: close\r\n\r\n"
+             << body;
+    const std::string data = response.str();
+
+    size_t sent = 0;
+    while (sent < data.size()) {
+        const ssize_t written = send(client_fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (written <= 0) {
+            break;
+        }
+        sent += static_cast<size_t>(written);
+    }
+#else
+    (void)client_fd;
+    (void)scratch;
+#endif
+}
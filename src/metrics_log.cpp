@@ -0,0 +1,540 @@
+#include "metrics_log.h"
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <type_traits>
+
+namespace {
+
+constexpr uint32_t LOG_MAGIC = 0x4D48434Cu;   // 'LCHM'
+constexpr uint32_t LOG_VERSION = 1;
+
+enum RecordType : uint32_t {
+    RECORD_NAME = 1,
+    RECORD_SESSION = 2,
+    RECORD_FRAME = 3
+};
+
+template <typename T>
+void AppendPod(std::vector<uint8_t>& out, const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "POD expected");
+    const size_t offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+void AppendString(std::vector<uint8_t>& out, const std::string& value) {
+    AppendPod(out, static_cast<uint32_t>(value.size()));
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+/**
+ * @brief Чтение payload с проверкой границ
+ */
+class PayloadReader {
+public:
+    PayloadReader(const uint8_t* data, size_t size) : data_(data), size_(size), offset_(0) {}
+
+    template <typename T>
+    bool Read(T* value) {
+        if (size_ - offset_ < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(value, data_ + offset_, sizeof(T));
+        offset_ += sizeof(T);
+        return true;
+    }
+
+    bool ReadString(std::string* value) {
+        uint32_t length = 0;
+        if (!Read(&length) || size_ - offset_ < length) {
+            return false;
+        }
+        value->assign(reinterpret_cast<const char*>(data_ + offset_), length);
+        offset_ += length;
+        return true;
+    }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t offset_;
+};
+
+bool ParseSession(PayloadReader& reader, MetricsSession* session) {
+    SystemInfo& info = session->system_info;
+    uint64_t memory_mb = 0;
+    uint64_t work_group = 0;
+    uint64_t compute_units = 0;
+    uint32_t num_params = 0;
+    if (!reader.ReadString(&info.device_name) || !reader.ReadString(&info.device_vendor) ||
+        !reader.ReadString(&info.device_version) || !reader.ReadString(&info.driver_version) ||
+        !reader.ReadString(&info.opencl_c_version) || !reader.ReadString(&info.platform_name) ||
+        !reader.ReadString(&info.platform_version) || !reader.ReadString(&info.os_name) ||
+        !reader.ReadString(&info.os_version) || !reader.Read(&memory_mb) ||
+        !reader.Read(&work_group) || !reader.Read(&compute_units) || !reader.Read(&num_params)) {
+        return false;
+    }
+    info.device_memory_mb = static_cast<size_t>(memory_mb);
+    info.max_work_group_size = static_cast<size_t>(work_group);
+    info.compute_units = static_cast<size_t>(compute_units);
+
+    session->signal_params.clear();
+    for (uint32_t i = 0; i < num_params; ++i) {
+        std::string key;
+        std::string value;
+        if (!reader.ReadString(&key) || !reader.ReadString(&value)) {
+            return false;
+        }
+        session->signal_params[key] = value;
+    }
+    return true;
+}
+
+bool ParseFrame(PayloadReader& reader, const std::vector<std::string>& names, MetricsFrame* frame) {
+    uint32_t num_timings = 0;
+    uint32_t num_events = 0;
+    if (!reader.Read(&frame->frame_index) || !reader.Read(&frame->timestamp_ns) ||
+        !reader.Read(&num_timings) || !reader.Read(&num_events)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < num_timings; ++i) {
+        uint32_t name_id = 0;
+        uint32_t call_count = 0;
+        TimingMetric metric;
+        if (!reader.Read(&name_id) || !reader.Read(&call_count) || !reader.Read(&metric.time_ms) ||
+            !reader.Read(&metric.min_time_ms) || !reader.Read(&metric.max_time_ms) ||
+            name_id >= names.size()) {
+            return false;
+        }
+        metric.name = names[name_id];
+        metric.call_count = call_count;
+        metric.avg_time_ms = call_count > 0 ? metric.time_ms / static_cast<double>(call_count) : 0.0;
+        frame->timings.push_back(metric);
+    }
+
+    for (uint32_t i = 0; i < num_events; ++i) {
+        uint32_t name_id = 0;
+        uint32_t reserved = 0;
+        double queued = 0.0;
+        double submitted = 0.0;
+        double started = 0.0;
+        double ended = 0.0;
+        if (!reader.Read(&name_id) || !reader.Read(&reserved) || !reader.Read(&queued) ||
+            !reader.Read(&submitted) || !reader.Read(&started) || !reader.Read(&ended) ||
+            name_id >= names.size()) {
+            return false;
+        }
+        // Метки - целые наносекунды cl_ulong: double хранит их точно до 2^53
+        frame->gpu_events.push_back(CalculateEventMetrics(
+            names[name_id], static_cast<cl_ulong>(queued), static_cast<cl_ulong>(submitted),
+            static_cast<cl_ulong>(started), static_cast<cl_ulong>(ended)));
+    }
+    return true;
+}
+
+bool EnsureParentDirectory(const std::string& filename) {
+    std::error_code error;
+    const std::filesystem::path dir = std::filesystem::path(filename).parent_path();
+    if (!dir.empty()) {
+        std::filesystem::create_directories(dir, error);
+    }
+    if (error) {
+        std::cerr << "Ошибка: не удалось создать директорию " << dir << ": " << error.message() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+MetricsLogWriter::MetricsLogWriter(size_t queue_capacity)
+    : queue_capacity_(queue_capacity > 0 ? queue_capacity : 1),
+      stop_(false),
+      write_failed_(false),
+      dropped_frames_(0),
+      written_frames_(0) {
+}
+
+MetricsLogWriter::~MetricsLogWriter() {
+    Close();
+}
+
+bool MetricsLogWriter::Open(const std::string& filename) {
+    if (IsOpen()) {
+        std::cerr << "Ошибка: журнал метрик уже открыт" << std::endl;
+        return false;
+    }
+    if (!EnsureParentDirectory(filename)) {
+        return false;
+    }
+
+    file_.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        std::cerr << "Ошибка: не удалось создать файл " << filename << std::endl;
+        return false;
+    }
+    file_.write(reinterpret_cast<const char*>(&LOG_MAGIC), sizeof(LOG_MAGIC));
+    file_.write(reinterpret_cast<const char*>(&LOG_VERSION), sizeof(LOG_VERSION));
+
+    name_ids_.clear();
+    write_failed_ = false;
+    stop_ = false;
+    dropped_frames_.store(0, std::memory_order_relaxed);
+    written_frames_.store(0, std::memory_order_relaxed);
+    worker_ = std::thread(&MetricsLogWriter::WorkerLoop, this);
+    return true;
+}
+
+void MetricsLogWriter::Close() {
+    if (!worker_.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    worker_.join();
+    file_.close();
+}
+
+bool MetricsLogWriter::SubmitSession(MetricsSession session) {
+    PendingRecord record;
+    record.is_session = true;
+    record.session = std::move(session);
+    return Enqueue(std::move(record));
+}
+
+bool MetricsLogWriter::SubmitFrame(MetricsFrame frame) {
+    PendingRecord record;
+    record.is_session = false;
+    record.frame = std::move(frame);
+    return Enqueue(std::move(record));
+}
+
+MetricsFrame MetricsLogWriter::MakeFrame(uint64_t frame_index,
+                                         const ProfilingMetrics& metrics,
+                                         const std::vector<GPUEventMetrics>& gpu_events) {
+    MetricsFrame frame;
+    frame.frame_index = frame_index;
+    frame.timestamp_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    frame.timings.reserve(metrics.metrics.size());
+    for (const auto& pair : metrics.metrics) {
+        frame.timings.push_back(pair.second);
+    }
+    frame.gpu_events = gpu_events;
+    return frame;
+}
+
+bool MetricsLogWriter::Enqueue(PendingRecord&& record) {
+    if (!IsOpen()) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_) {
+            return false;
+        }
+        if (queue_.size() >= queue_capacity_) {
+            dropped_frames_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        queue_.push_back(std::move(record));
+    }
+    wake_.notify_one();
+    return true;
+}
+
+void MetricsLogWriter::WorkerLoop() {
+    std::deque<PendingRecord> batch;
+    for (;;) {
+        bool stopping = false;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+            batch.swap(queue_);
+            stopping = stop_;
+        }
+
+        for (const PendingRecord& record : batch) {
+            if (record.is_session) {
+                WriteSession(record.session);
+            } else {
+                WriteFrame(record.frame);
+            }
+        }
+        batch.clear();
+
+        // Сброс на диск, когда очередь разобрана: журнал читаем и при аварийном завершении
+        file_.flush();
+        if (!file_ && !write_failed_) {
+            write_failed_ = true;
+            std::cerr << "Ошибка: запись журнала метрик не удалась, дальнейшие записи отбрасываются" << std::endl;
+        }
+
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+void MetricsLogWriter::WriteRecord(uint32_t type, const std::vector<uint8_t>& payload) {
+    if (write_failed_) {
+        return;
+    }
+    const uint32_t payload_bytes = static_cast<uint32_t>(payload.size());
+    file_.write(reinterpret_cast<const char*>(&type), sizeof(type));
+    file_.write(reinterpret_cast<const char*>(&payload_bytes), sizeof(payload_bytes));
+    file_.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+}
+
+uint32_t MetricsLogWriter::InternName(const std::string& name) {
+    auto it = name_ids_.find(name);
+    if (it != name_ids_.end()) {
+        return it->second;
+    }
+
+    const uint32_t id = static_cast<uint32_t>(name_ids_.size());
+    name_ids_.emplace(name, id);
+
+    std::vector<uint8_t> payload;
+    AppendPod(payload, id);
+    AppendString(payload, name);
+    WriteRecord(RECORD_NAME, payload);
+    return id;
+}
+
+void MetricsLogWriter::WriteFrame(const MetricsFrame& frame) {
+    std::vector<uint8_t> payload;
+    payload.reserve(24 + 32 * frame.timings.size() + 40 * frame.gpu_events.size());
+    AppendPod(payload, frame.frame_index);
+    AppendPod(payload, frame.timestamp_ns);
+    AppendPod(payload, static_cast<uint32_t>(frame.timings.size()));
+    AppendPod(payload, static_cast<uint32_t>(frame.gpu_events.size()));
+
+    // Записи NAME уходят в файл раньше кадра, который на них ссылается
+    for (const TimingMetric& metric : frame.timings) {
+        AppendPod(payload, InternName(metric.name));
+        AppendPod(payload, static_cast<uint32_t>(metric.call_count));
+        AppendPod(payload, metric.time_ms);
+        AppendPod(payload, metric.min_time_ms);
+        AppendPod(payload, metric.max_time_ms);
+    }
+    for (const GPUEventMetrics& event : frame.gpu_events) {
+        AppendPod(payload, InternName(event.event_name));
+        AppendPod(payload, static_cast<uint32_t>(0));
+        AppendPod(payload, event.time_queued_ns);
+        AppendPod(payload, event.time_submit_ns);
+        AppendPod(payload, event.time_start_ns);
+        AppendPod(payload, event.time_end_ns);
+    }
+
+    WriteRecord(RECORD_FRAME, payload);
+    written_frames_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MetricsLogWriter::WriteSession(const MetricsSession& session) {
+    const SystemInfo& info = session.system_info;
+    std::vector<uint8_t> payload;
+    AppendString(payload, info.device_name);
+    AppendString(payload, info.device_vendor);
+    AppendString(payload, info.device_version);
+    AppendString(payload, info.driver_version);
+    AppendString(payload, info.opencl_c_version);
+    AppendString(payload, info.platform_name);
+    AppendString(payload, info.platform_version);
+    AppendString(payload, info.os_name);
+    AppendString(payload, info.os_version);
+    AppendPod(payload, static_cast<uint64_t>(info.device_memory_mb));
+    AppendPod(payload, static_cast<uint64_t>(info.max_work_group_size));
+    AppendPod(payload, static_cast<uint64_t>(info.compute_units));
+    AppendPod(payload, static_cast<uint32_t>(session.signal_params.size()));
+    for (const auto& param : session.signal_params) {
+        AppendString(payload, param.first);
+        AppendString(payload, param.second);
+    }
+    WriteRecord(RECORD_SESSION, payload);
+}
+
+bool ReadMetricsLog(const std::string& filename, MetricsLogContents* contents) {
+    if (contents == nullptr) {
+        std::cerr << "Ошибка: неверные параметры для ReadMetricsLog" << std::endl;
+        return false;
+    }
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << filename << std::endl;
+        return false;
+    }
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if (!file || magic != LOG_MAGIC || version != LOG_VERSION) {
+        std::cerr << "Ошибка: " << filename << " - не журнал метрик (или другая версия формата)" << std::endl;
+        return false;
+    }
+
+    *contents = MetricsLogContents();
+    std::vector<std::string> names;
+    std::vector<uint8_t> payload;
+
+    for (;;) {
+        uint32_t type = 0;
+        uint32_t payload_bytes = 0;
+        file.read(reinterpret_cast<char*>(&type), sizeof(type));
+        if (file.gcount() == 0) {
+            break;
+        }
+        file.read(reinterpret_cast<char*>(&payload_bytes), sizeof(payload_bytes));
+        payload.resize(payload_bytes);
+        if (file) {
+            file.read(reinterpret_cast<char*>(payload.data()), payload_bytes);
+        }
+        if (!file) {
+            contents->truncated = true;
+            break;
+        }
+
+        PayloadReader reader(payload.data(), payload.size());
+        bool parsed = true;
+        if (type == RECORD_NAME) {
+            uint32_t id = 0;
+            std::string name;
+            parsed = reader.Read(&id) && reader.ReadString(&name) && id == names.size();
+            if (parsed) {
+                names.push_back(std::move(name));
+            }
+        } else if (type == RECORD_SESSION) {
+            parsed = ParseSession(reader, &contents->session);
+        } else if (type == RECORD_FRAME) {
+            MetricsFrame frame;
+            parsed = ParseFrame(reader, names, &frame);
+            if (parsed) {
+                contents->frames.push_back(std::move(frame));
+            }
+        }
+
+        if (!parsed) {
+            std::cerr << "Ошибка: повреждённая запись типа " << type << " в " << filename << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void SummarizeMetricsLog(const MetricsLogContents& contents,
+                         ProfilingEngine* profiler,
+                         DetailedGPUProfiling* gpu_profiling) {
+    if (profiler != nullptr) {
+        profiler->Reset();
+        for (const MetricsFrame& frame : contents.frames) {
+            for (const TimingMetric& metric : frame.timings) {
+                profiler->AccumulateMetric(metric);
+            }
+        }
+    }
+
+    if (gpu_profiling == nullptr) {
+        return;
+    }
+
+    *gpu_profiling = DetailedGPUProfiling();
+    gpu_profiling->system_info = contents.session.system_info;
+
+    std::map<std::string, size_t> event_index;
+    std::vector<size_t> event_count;
+    size_t frames_with_events = 0;
+    for (const MetricsFrame& frame : contents.frames) {
+        if (frame.gpu_events.empty()) {
+            continue;
+        }
+        ++frames_with_events;
+        for (const GPUEventMetrics& event : frame.gpu_events) {
+            auto inserted = event_index.emplace(event.event_name, gpu_profiling->gpu_events.size());
+            if (inserted.second) {
+                gpu_profiling->gpu_events.push_back(event);
+                event_count.push_back(1);
+                continue;
+            }
+            GPUEventMetrics& sum = gpu_profiling->gpu_events[inserted.first->second];
+            sum.time_queued_ns += event.time_queued_ns;
+            sum.time_submit_ns += event.time_submit_ns;
+            sum.time_start_ns += event.time_start_ns;
+            sum.time_end_ns += event.time_end_ns;
+            sum.queue_time_ns += event.queue_time_ns;
+            sum.wait_time_ns += event.wait_time_ns;
+            sum.execution_time_ns += event.execution_time_ns;
+            sum.total_time_ns += event.total_time_ns;
+            sum.queue_time_ms += event.queue_time_ms;
+            sum.wait_time_ms += event.wait_time_ms;
+            sum.execution_time_ms += event.execution_time_ms;
+            sum.total_time_ms += event.total_time_ms;
+            event_count[inserted.first->second]++;
+        }
+    }
+
+    double total_gpu_time_ms = 0.0;
+    for (size_t i = 0; i < gpu_profiling->gpu_events.size(); ++i) {
+        GPUEventMetrics& event = gpu_profiling->gpu_events[i];
+        const double scale = 1.0 / static_cast<double>(event_count[i]);
+        if (event_count[i] > 1) {
+            event.time_queued_ns *= scale;
+            event.time_submit_ns *= scale;
+            event.time_start_ns *= scale;
+            event.time_end_ns *= scale;
+            event.queue_time_ns *= scale;
+            event.wait_time_ns *= scale;
+            event.execution_time_ns *= scale;
+            event.total_time_ns *= scale;
+            event.queue_time_ms *= scale;
+            event.wait_time_ms *= scale;
+            event.execution_time_ms *= scale;
+            event.total_time_ms *= scale;
+        }
+        // Среднее за кадр: сумма по событиям всех кадров / число кадров с событиями
+        total_gpu_time_ms += event.total_time_ms * static_cast<double>(event_count[i]);
+    }
+    if (frames_with_events > 1) {
+        total_gpu_time_ms /= static_cast<double>(frames_with_events);
+    }
+    gpu_profiling->total_gpu_time_ms = total_gpu_time_ms;
+}
+
+bool ConvertMetricsLog(const std::string& log_filename,
+                       const std::string& profile_json,
+                       const std::string& gpu_json,
+                       const std::string& gpu_markdown) {
+    MetricsLogContents contents;
+    if (!ReadMetricsLog(log_filename, &contents)) {
+        return false;
+    }
+    if (contents.truncated) {
+        std::cerr << "Предупреждение: журнал " << log_filename << " оборван, последняя запись пропущена" << std::endl;
+    }
+
+    ProfilingEngine profiler;
+    DetailedGPUProfiling gpu_profiling;
+    SummarizeMetricsLog(contents, &profiler, &gpu_profiling);
+
+    if (!EnsureParentDirectory(gpu_json) || !EnsureParentDirectory(gpu_markdown)) {
+        return false;
+    }
+
+    const bool ok_profile = profiler.SaveReportToJson(profile_json);
+    const bool ok_json = SaveDetailedGPUProfilingToJson(gpu_profiling, gpu_json);
+    const bool ok_markdown = SaveDetailedGPUProfilingToMarkdown(gpu_profiling, contents.session.signal_params, gpu_markdown);
+
+    std::cout << "Журнал метрик " << log_filename << ": кадров " << contents.frames.size()
+              << ", событий GPU " << gpu_profiling.gpu_events.size() << std::endl;
+    return ok_profile && ok_json && ok_markdown;
+}
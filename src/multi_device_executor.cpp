@@ -0,0 +1,328 @@
+#include "multi_device_executor.h"
+#include "lagrange_matrix.h"
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+// Вес нового измерения в скользящей оценке производительности
+constexpr double THROUGHPUT_SMOOTHING = 0.5;
+
+} // namespace
+
+MultiDeviceExecutor::MultiDeviceExecutor(std::vector<std::unique_ptr<IGPUBackend>> backends)
+    : initialized_(false), calibrated_(false) {
+    for (auto& backend : backends) {
+        if (!backend) {
+            continue;
+        }
+        DeviceState state;
+        state.backend = std::move(backend);
+        state.device_buffer = nullptr;
+        state.device_buffer_size = 0;
+        state.throughput = 0.0;
+        state.healthy = true;
+        devices_.push_back(std::move(state));
+    }
+}
+
+MultiDeviceExecutor::~MultiDeviceExecutor() {
+    for (DeviceState& state : devices_) {
+        if (state.device_buffer) {
+            state.backend->FreeDeviceMemory(state.device_buffer);
+            state.device_buffer = nullptr;
+        }
+    }
+}
+
+bool MultiDeviceExecutor::Initialize() {
+    if (devices_.empty()) {
+        std::cerr << "Ошибка: нет устройств для MultiDeviceExecutor" << std::endl;
+        return false;
+    }
+
+    const float* lagrange_data = LagrangeMatrix::Shared().GetData();
+    for (size_t device = 0; device < devices_.size(); ++device) {
+        if (!devices_[device].backend->UploadLagrangeMatrix(lagrange_data)) {
+            std::cerr << "Ошибка: не удалось загрузить матрицу Лагранжа на устройство "
+                      << devices_[device].backend->GetDeviceName() << std::endl;
+            return false;
+        }
+    }
+
+    initialized_ = true;
+    return true;
+}
+
+bool MultiDeviceExecutor::EnsureDeviceBuffer(DeviceState& state, size_t size_bytes) {
+    if (state.device_buffer && state.device_buffer_size >= size_bytes) {
+        return true;
+    }
+
+    if (state.device_buffer) {
+        state.backend->FreeDeviceMemory(state.device_buffer);
+        state.device_buffer = nullptr;
+        state.device_buffer_size = 0;
+    }
+
+    state.device_buffer = state.backend->AllocateDeviceMemory(size_bytes);
+    if (!state.device_buffer) {
+        std::cerr << "Ошибка: не удалось выделить память на устройстве "
+                  << state.backend->GetDeviceName() << std::endl;
+        return false;
+    }
+    state.device_buffer_size = size_bytes;
+    return true;
+}
+
+bool MultiDeviceExecutor::ExecuteShard(DeviceState& state, SignalBuffer* buffer, const float* delays,
+                                       size_t beam_begin, size_t beam_count, double* elapsed_seconds) {
+    const auto start = std::chrono::steady_clock::now();
+
+    const size_t num_samples = buffer->GetNumSamples();
+    const size_t beam_bytes = num_samples * sizeof(ComplexType);
+    const size_t shard_bytes = beam_count * beam_bytes;
+
+    if (!EnsureDeviceBuffer(state, shard_bytes)) {
+        return false;
+    }
+
+    // Лучи шарда подряд: один H2D/D2H на шард вместо одного на луч
+    state.staging.resize(beam_count * num_samples);
+    for (size_t i = 0; i < beam_count; ++i) {
+        std::memcpy(state.staging.data() + i * num_samples, buffer->GetBeamData(beam_begin + i), beam_bytes);
+    }
+
+    if (!state.backend->CopyHostToDevice(state.device_buffer, state.staging.data(), shard_bytes) ||
+        !state.backend->ExecuteFractionalDelay(state.device_buffer, delays + beam_begin, beam_count, num_samples) ||
+        !state.backend->CopyDeviceToHost(state.staging.data(), state.device_buffer, shard_bytes)) {
+        std::cerr << "Ошибка: шард лучей [" << beam_begin << ", " << beam_begin + beam_count
+                  << ") не выполнен на устройстве " << state.backend->GetDeviceName() << std::endl;
+        return false;
+    }
+
+    for (size_t i = 0; i < beam_count; ++i) {
+        std::memcpy(buffer->GetBeamData(beam_begin + i), state.staging.data() + i * num_samples, beam_bytes);
+    }
+
+    *elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+bool MultiDeviceExecutor::Calibrate(size_t num_samples, size_t probe_beams) {
+    if (!initialized_ && !Initialize()) {
+        return false;
+    }
+    if (num_samples == 0 || probe_beams == 0) {
+        std::cerr << "Ошибка: пустой пробный кадр для калибровки" << std::endl;
+        return false;
+    }
+
+    SignalBuffer probe(probe_beams, num_samples);
+    const std::vector<float> delays(probe_beams, 0.0f);
+
+    bool success = true;
+    for (DeviceState& state : devices_) {
+        if (!state.healthy) {
+            continue;
+        }
+        // Первый прогон - автотюнинг и выделение памяти, не измеряется
+        double elapsed = 0.0;
+        if (!ExecuteShard(state, &probe, delays.data(), 0, probe_beams, &elapsed) ||
+            !ExecuteShard(state, &probe, delays.data(), 0, probe_beams, &elapsed)) {
+            state.throughput = 0.0;   // Устройство не получает лучей
+            state.healthy = false;
+            success = false;
+            continue;
+        }
+        state.throughput = elapsed > 0.0
+            ? static_cast<double>(probe_beams * num_samples) / elapsed : 0.0;
+
+        std::cout << "Устройство " << state.backend->GetDeviceName() << ": "
+                  << state.throughput / 1e6 << " Мотсч/с" << std::endl;
+    }
+
+    calibrated_ = true;
+    return success;
+}
+
+std::vector<size_t> MultiDeviceExecutor::PartitionBeams(size_t num_beams) const {
+    const size_t num_devices = devices_.size();
+    std::vector<size_t> counts(num_devices, 0);
+    if (num_devices == 0) {
+        return counts;
+    }
+
+    double total = 0.0;
+    size_t num_healthy = 0;
+    for (const DeviceState& state : devices_) {
+        if (state.healthy) {
+            total += state.throughput;
+            ++num_healthy;
+        }
+    }
+    if (num_healthy == 0) {
+        return counts;
+    }
+
+    // Производительность не измерена - поровну между исправными устройствами
+    std::vector<double> weights(num_devices, 0.0);
+    for (size_t device = 0; device < num_devices; ++device) {
+        if (!devices_[device].healthy) {
+            continue;
+        }
+        weights[device] = total > 0.0 ? devices_[device].throughput / total
+                                       : 1.0 / static_cast<double>(num_healthy);
+    }
+
+    // Целые части долей, остаток лучей - устройствам с наибольшими дробными частями
+    std::vector<std::pair<double, size_t>> remainders(num_devices);
+    size_t assigned = 0;
+    for (size_t device = 0; device < num_devices; ++device) {
+        const double share = weights[device] * static_cast<double>(num_beams);
+        counts[device] = static_cast<size_t>(share);
+        assigned += counts[device];
+        remainders[device] = std::make_pair(share - static_cast<double>(counts[device]), device);
+    }
+
+    std::stable_sort(remainders.begin(), remainders.end(),
+                     [](const std::pair<double, size_t>& a, const std::pair<double, size_t>& b) {
+                         return a.first > b.first;
+                     });
+    for (size_t i = 0; assigned < num_beams; i = (i + 1) % num_devices) {
+        if (weights[remainders[i].second] > 0.0) {
+            ++counts[remainders[i].second];
+            ++assigned;
+        }
+    }
+
+    return counts;
+}
+
+bool MultiDeviceExecutor::ExecuteFractionalDelay(SignalBuffer* buffer, const std::vector<float>& delays) {
+    if (buffer == nullptr || buffer->GetNumBeams() == 0 || buffer->GetNumSamples() == 0) {
+        std::cerr << "Ошибка: пустой буфер для дробной задержки" << std::endl;
+        return false;
+    }
+
+    const size_t num_beams = buffer->GetNumBeams();
+    const size_t num_samples = buffer->GetNumSamples();
+    if (delays.size() != num_beams) {
+        std::cerr << "Ошибка: количество задержек (" << delays.size()
+                  << ") не совпадает с количеством лучей (" << num_beams << ")" << std::endl;
+        return false;
+    }
+    for (size_t beam = 0; beam < num_beams; ++beam) {
+        if (!buffer->GetBeamData(beam)) {
+            std::cerr << "Ошибка: не удалось получить данные для луча " << beam << std::endl;
+            return false;
+        }
+    }
+
+    if (!initialized_ && !Initialize()) {
+        return false;
+    }
+    if (!calibrated_ && !Calibrate(num_samples)) {
+        // Не прошедшие калибровку устройства исключены; хватает и одного исправного
+        std::cerr << "Предупреждение: часть устройств не прошла калибровку и не получит лучей" << std::endl;
+    }
+
+    if (GetNumHealthyDevices() == 0) {
+        std::cerr << "Ошибка: нет исправных устройств для дробной задержки" << std::endl;
+        return false;
+    }
+
+    const size_t num_devices = devices_.size();
+    const std::vector<size_t> counts = PartitionBeams(num_beams);
+
+    std::vector<size_t> beam_begin(num_devices, 0);
+    for (size_t device = 1; device < num_devices; ++device) {
+        beam_begin[device] = beam_begin[device - 1] + counts[device - 1];
+    }
+
+    // vector<bool> не годится для записи из разных потоков
+    std::vector<char> results(num_devices, 1);
+    std::vector<double> elapsed(num_devices, 0.0);
+
+    auto run_shard = [&](size_t device) {
+        results[device] = ExecuteShard(devices_[device], buffer, delays.data(),
+                                       beam_begin[device], counts[device], &elapsed[device]) ? 1 : 0;
+    };
+
+    // Устройство 0 - в вызывающем потоке, остальные - в своих
+    std::vector<std::thread> workers;
+    for (size_t device = 1; device < num_devices; ++device) {
+        if (counts[device] > 0) {
+            workers.emplace_back(run_shard, device);
+        }
+    }
+    if (counts[0] > 0) {
+        run_shard(0);
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    for (size_t device = 0; device < num_devices; ++device) {
+        if (!results[device]) {
+            devices_[device].healthy = false;
+            devices_[device].throughput = 0.0;
+            continue;
+        }
+        if (counts[device] > 0 && elapsed[device] > 0.0) {
+            const double measured = static_cast<double>(counts[device] * num_samples) / elapsed[device];
+            devices_[device].throughput = (1.0 - THROUGHPUT_SMOOTHING) * devices_[device].throughput
+                                        + THROUGHPUT_SMOOTHING * measured;
+        }
+    }
+
+    // Шард отказавшего устройства не тронут (раскладка только после D2H):
+    // он целиком переходит к исправным устройствам, самому быстрому первым
+    for (size_t device = 0; device < num_devices; ++device) {
+        if (results[device]) {
+            continue;
+        }
+        if (!RetryShard(buffer, delays.data(), beam_begin[device], counts[device])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool MultiDeviceExecutor::RetryShard(SignalBuffer* buffer, const float* delays,
+                                     size_t beam_begin, size_t beam_count) {
+    std::vector<size_t> order;
+    for (size_t device = 0; device < devices_.size(); ++device) {
+        if (devices_[device].healthy) {
+            order.push_back(device);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return devices_[a].throughput > devices_[b].throughput;
+    });
+
+    for (size_t device : order) {
+        DeviceState& state = devices_[device];
+        double elapsed = 0.0;
+        if (ExecuteShard(state, buffer, delays, beam_begin, beam_count, &elapsed)) {
+            std::cerr << "Предупреждение: шард лучей [" << beam_begin << ", " << beam_begin + beam_count
+                      << ") выполнен повторно на устройстве " << state.backend->GetDeviceName() << std::endl;
+            return true;
+        }
+        state.healthy = false;
+        state.throughput = 0.0;
+    }
+
+    std::cerr << "Ошибка: шард лучей [" << beam_begin << ", " << beam_begin + beam_count
+              << ") не выполнен ни на одном устройстве" << std::endl;
+    return false;
+}
+
+size_t MultiDeviceExecutor::GetNumHealthyDevices() const {
+    return static_cast<size_t>(std::count_if(devices_.begin(), devices_.end(),
+                                             [](const DeviceState& state) { return state.healthy; }));
+}
@@ -0,0 +1,161 @@
+#include "noise_generator.h"
+#include "thread_pool.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Константы Philox4x32 (Salmon et al., Random123)
+constexpr uint32_t PHILOX_M0 = 0xD2511F53u;
+constexpr uint32_t PHILOX_M1 = 0xCD9E8D57u;
+constexpr uint32_t PHILOX_W0 = 0x9E3779B9u;
+constexpr uint32_t PHILOX_W1 = 0xBB67AE85u;
+
+// Вызовов Philox в тайле (2 отсчёта на вызов): 4 массива слов по 512 B в L1
+constexpr size_t TILE_BLOCKS = 128;
+constexpr size_t NOISE_TILE = 2 * TILE_BLOCKS;
+
+// 24 старших бита слова -> (0, 1] и [0, 1): точно представимы во float, log(u1) конечен
+constexpr float UNIT_24 = 1.0f / 16777216.0f;
+constexpr float TWO_PI_F = 6.28318530717958647692f;
+
+inline void PhiloxRounds(uint32_t& c0, uint32_t& c1, uint32_t& c2, uint32_t& c3,
+                         uint32_t k0, uint32_t k1) {
+    for (int round = 0; round < 10; ++round) {
+        const uint64_t product0 = static_cast<uint64_t>(PHILOX_M0) * c0;
+        const uint64_t product1 = static_cast<uint64_t>(PHILOX_M1) * c2;
+        const uint32_t hi0 = static_cast<uint32_t>(product0 >> 32);
+        const uint32_t lo0 = static_cast<uint32_t>(product0);
+        const uint32_t hi1 = static_cast<uint32_t>(product1 >> 32);
+        const uint32_t lo1 = static_cast<uint32_t>(product1);
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = lo1;
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = lo0;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+}
+
+/**
+ * @brief Шум для вызовов Philox [first_block, first_block + num_blocks) в раздельные re/im
+ *
+ * Сначала целые слова всех вызовов тайла (цикл без ветвлений по независимым
+ * счётчикам - векторизуется), затем преобразование Бокса-Мюллера.
+ */
+void NoiseTile(uint32_t k0, uint32_t k1, uint64_t stream, uint64_t first_block, size_t num_blocks,
+               float sigma, float* re, float* im) {
+    uint32_t w0[TILE_BLOCKS];
+    uint32_t w1[TILE_BLOCKS];
+    uint32_t w2[TILE_BLOCKS];
+    uint32_t w3[TILE_BLOCKS];
+
+    const uint32_t stream_lo = static_cast<uint32_t>(stream);
+    const uint32_t stream_hi = static_cast<uint32_t>(stream >> 32);
+    for (size_t i = 0; i < num_blocks; ++i) {
+        const uint64_t block = first_block + i;
+        uint32_t c0 = static_cast<uint32_t>(block);
+        uint32_t c1 = static_cast<uint32_t>(block >> 32);
+        uint32_t c2 = stream_lo;
+        uint32_t c3 = stream_hi;
+        PhiloxRounds(c0, c1, c2, c3, k0, k1);
+        w0[i] = c0;
+        w1[i] = c1;
+        w2[i] = c2;
+        w3[i] = c3;
+    }
+
+    for (size_t i = 0; i < num_blocks; ++i) {
+        const float radius0 = sigma * std::sqrt(-2.0f * std::log(static_cast<float>((w0[i] >> 8) + 1) * UNIT_24));
+        const float angle0 = TWO_PI_F * static_cast<float>(w1[i] >> 8) * UNIT_24;
+        const float radius1 = sigma * std::sqrt(-2.0f * std::log(static_cast<float>((w2[i] >> 8) + 1) * UNIT_24));
+        const float angle1 = TWO_PI_F * static_cast<float>(w3[i] >> 8) * UNIT_24;
+        re[2 * i] = radius0 * std::cos(angle0);
+        im[2 * i] = radius0 * std::sin(angle0);
+        re[2 * i + 1] = radius1 * std::cos(angle1);
+        im[2 * i + 1] = radius1 * std::sin(angle1);
+    }
+}
+
+} // namespace
+
+void Philox4x32(const uint32_t counter[4], const uint32_t key[2], uint32_t output[4]) {
+    uint32_t c0 = counter[0];
+    uint32_t c1 = counter[1];
+    uint32_t c2 = counter[2];
+    uint32_t c3 = counter[3];
+    PhiloxRounds(c0, c1, c2, c3, key[0], key[1]);
+    output[0] = c0;
+    output[1] = c1;
+    output[2] = c2;
+    output[3] = c3;
+}
+
+void GenerateGaussianNoiseCPU(
+    uint64_t seed,
+    uint64_t stream,
+    uint64_t first_sample,
+    float sigma,
+    SignalBuffer::ComplexType* output,
+    size_t count,
+    bool accumulate) {
+
+    const uint32_t k0 = static_cast<uint32_t>(seed);
+    const uint32_t k1 = static_cast<uint32_t>(seed >> 32);
+
+    float re[NOISE_TILE];
+    float im[NOISE_TILE];
+
+    // Отсчёт n - слово пары n % 2 вызова n / 2; нечётное начало - пропуск первого отсчёта тайла
+    size_t done = 0;
+    while (done < count) {
+        const uint64_t sample = first_sample + done;
+        const size_t skip = static_cast<size_t>(sample & 1);
+        const size_t length = std::min(NOISE_TILE - skip, count - done);
+        const size_t num_blocks = (skip + length + 1) / 2;
+
+        NoiseTile(k0, k1, stream, sample / 2, num_blocks, sigma, re, im);
+
+        SignalBuffer::ComplexType* out = output + done;
+        if (accumulate) {
+            for (size_t i = 0; i < length; ++i) {
+                out[i] += SignalBuffer::ComplexType(re[skip + i], im[skip + i]);
+            }
+        } else {
+            for (size_t i = 0; i < length; ++i) {
+                out[i] = SignalBuffer::ComplexType(re[skip + i], im[skip + i]);
+            }
+        }
+        done += length;
+    }
+}
+
+bool AddGaussianNoiseCPU(SignalBuffer* buffer, uint64_t seed, float sigma) {
+    if (buffer == nullptr || buffer->GetNumBeams() == 0) {
+        std::cerr << "Ошибка: пустой буфер для генерации шума" << std::endl;
+        return false;
+    }
+
+    const size_t num_beams = buffer->GetNumBeams();
+    const size_t num_samples = buffer->GetNumSamples();
+    for (size_t beam = 0; beam < num_beams; ++beam) {
+        if (!buffer->GetBeamData(beam)) {
+            std::cerr << "Ошибка: не удалось получить данные для луча " << beam << std::endl;
+            return false;
+        }
+    }
+
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &buffer->GetBeamNodes();
+    hint.bytes_per_item = 2 * sizeof(SignalBuffer::ComplexType);   // чтение + запись
+
+    // Тайл кратен NOISE_TILE и чётен: тайлы не делят вызовы Philox
+    ThreadPool::Instance().ParallelFor2D(num_beams, num_samples, 16 * NOISE_TILE,
+        [&](size_t beam, size_t begin, size_t end) {
+            GenerateGaussianNoiseCPU(seed, beam, begin, sigma,
+                                     buffer->GetBeamData(beam) + begin, end - begin, true);
+        }, hint);
+
+    return true;
+}
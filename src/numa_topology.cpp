@@ -0,0 +1,174 @@
+#include "numa_topology.h"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <thread>
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+bool ReadLine(const std::string& path, std::string* line) {
+    std::ifstream file(path);
+    return file.is_open() && std::getline(file, *line);
+}
+
+} // namespace
+
+const NumaTopology& NumaTopology::Get() {
+    static const NumaTopology topology = Detect();
+    return topology;
+}
+
+NumaTopology NumaTopology::Detect(const std::string& sysfs_root) {
+    NumaTopology topology;
+
+    std::string online;
+    if (ReadLine(sysfs_root + "/online", &online)) {
+        for (int node_id : ParseCpuList(online)) {
+            std::string cpulist;
+            if (!ReadLine(sysfs_root + "/node" + std::to_string(node_id) + "/cpulist", &cpulist)) {
+                continue;
+            }
+            std::vector<int> cpus = ParseCpuList(cpulist);
+            if (cpus.empty()) {
+                continue;  // Узел только с памятью: потоки на нём не запускаются
+            }
+            topology.node_ids_.push_back(node_id);
+            topology.node_cpus_.push_back(cpus);
+        }
+    }
+
+    if (topology.node_cpus_.empty()) {
+        // Нет sysfs: один узел со всеми ядрами
+        std::vector<int> cpus(std::max<unsigned>(1, std::thread::hardware_concurrency()));
+        for (size_t i = 0; i < cpus.size(); ++i) {
+            cpus[i] = static_cast<int>(i);
+        }
+        topology.node_ids_.push_back(0);
+        topology.node_cpus_.push_back(cpus);
+    }
+
+    for (size_t node = 0; node < topology.node_cpus_.size(); ++node) {
+        for (int cpu : topology.node_cpus_[node]) {
+            if (cpu >= static_cast<int>(topology.cpu_node_.size())) {
+                topology.cpu_node_.resize(cpu + 1, -1);
+            }
+            topology.cpu_node_[cpu] = static_cast<int>(node);
+        }
+    }
+
+    return topology;
+}
+
+int NumaTopology::NodeOfCpu(int cpu) const {
+    if (cpu < 0 || cpu >= static_cast<int>(cpu_node_.size())) {
+        return -1;
+    }
+    return cpu_node_[cpu];
+}
+
+std::vector<int> NumaTopology::SpreadCpus(size_t count) const {
+    std::vector<int> cpus;
+    cpus.reserve(count);
+
+    size_t round = 0;
+    while (cpus.size() < count) {
+        bool added = false;
+        for (size_t node = 0; node < node_cpus_.size() && cpus.size() < count; ++node) {
+            if (round < node_cpus_[node].size()) {
+                cpus.push_back(node_cpus_[node][round]);
+                added = true;
+            }
+        }
+        if (added) {
+            ++round;
+        } else if (round == 0) {
+            break;      // Ни у одного узла нет ядер: привязывать не к чему
+        } else {
+            round = 0;  // Потоков больше, чем ядер: второй круг по тем же ядрам
+        }
+    }
+
+    return cpus;
+}
+
+std::vector<int> NumaTopology::AssignBeams(size_t num_beams, NumaPolicy policy) const {
+    std::vector<int> beam_nodes;
+    if (policy == NumaPolicy::NONE || !IsNuma()) {
+        return beam_nodes;
+    }
+
+    const size_t num_nodes = GetNumNodes();
+    beam_nodes.resize(num_beams);
+    for (size_t beam = 0; beam < num_beams; ++beam) {
+        beam_nodes[beam] = policy == NumaPolicy::INTERLEAVE
+            ? static_cast<int>(beam % num_nodes)
+            : static_cast<int>(beam * num_nodes / num_beams);
+    }
+    return beam_nodes;
+}
+
+int NumaTopology::NodeOfAddress(const void* address) const {
+#if defined(__linux__) && defined(SYS_move_pages)
+    const uintptr_t page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    void* page = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(address) & ~(page_size - 1));
+    int status = -1;
+    if (syscall(SYS_move_pages, 0, 1UL, &page, nullptr, &status, 0) != 0 || status < 0) {
+        return -1;
+    }
+    auto it = std::find(node_ids_.begin(), node_ids_.end(), status);
+    return it == node_ids_.end() ? -1 : static_cast<int>(it - node_ids_.begin());
+#else
+    (void)address;
+    return -1;
+#endif
+}
+
+std::vector<int> NumaTopology::ParseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+        size_t dash = range.find('-');
+        try {
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        } catch (const std::exception&) {
+            return std::vector<int>();
+        }
+    }
+    return cpus;
+}
+
+void* AllocatePages(size_t size_bytes) {
+#if defined(__linux__)
+    void* ptr = mmap(nullptr, size_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+#else
+    return ::operator new(size_bytes);
+#endif
+}
+
+void FreePages(void* ptr, size_t size_bytes) noexcept {
+#if defined(__linux__)
+    if (ptr != nullptr) {
+        munmap(ptr, size_bytes);
+    }
+#else
+    (void)size_bytes;
+    ::operator delete(ptr);
+#endif
+}
@@ -2,6 +2,9 @@
 #include "lagrange_matrix.h"
 #include <iostream>
 #include <cstring>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 
 ProcessingPipeline::ProcessingPipeline(
     SignalBuffer* signal_buffer,
@@ -13,7 +16,15 @@ ProcessingPipeline::ProcessingPipeline(
       gpu_backend_(gpu_backend),
       profiler_(profiler),
       device_buffer_(nullptr),
-      device_buffer_size_(0) {
+      device_buffer_size_(0),
+      device_fir_history_(nullptr),
+      device_fir_history_size_(0),
+      device_fir_num_taps_(0),
+      device_resample_history_(nullptr),
+      device_resample_history_size_(0),
+      device_decimate_history_(nullptr),
+      device_decimate_history_size_(0),
+      device_memory_limit_(0) {
 }
 
 ProcessingPipeline::~ProcessingPipeline() {
@@ -26,6 +37,18 @@ bool ProcessingPipeline::ExecuteFull(bool copy_to_host) {
         return false;
     }
     
+    // TODO: Получить коэффициенты задержки (пока используем нули)
+    std::vector<float> delay_coeffs(signal_buffer_->GetNumBeams(), 0.0f);
+    
+    // Кадр больше памяти устройства - чанками, результат сразу на хост
+    const size_t frame_bytes = signal_buffer_->GetNumBeams() * signal_buffer_->GetNumSamples()
+                             * sizeof(SignalBuffer::ComplexType);
+    if (device_buffer_ == nullptr && frame_bytes > GetUsableDeviceMemory()) {
+        std::cout << "Кадр " << frame_bytes / (1024 * 1024) << " MB больше доступной памяти устройства ("
+                  << GetUsableDeviceMemory() / (1024 * 1024) << " MB): обработка чанками" << std::endl;
+        return ExecuteFullChunked(delay_coeffs);
+    }
+    
     // 1. Выделить память на GPU
     if (!AllocateDeviceMemory()) {
         return false;
@@ -41,8 +64,6 @@ bool ProcessingPipeline::ExecuteFull(bool copy_to_host) {
     
     // 3. Дробная задержка (формирование матрицы с задержанными сигналами)
     profiler_->StartTimer("FractionalDelay");
-    // TODO: Получить коэффициенты задержки (пока используем нули)
-    std::vector<float> delay_coeffs(signal_buffer_->GetNumBeams(), 0.0f);
     if (!gpu_backend_->ExecuteFractionalDelay(
             device_buffer_,
             delay_coeffs.data(),
@@ -69,6 +90,552 @@ bool ProcessingPipeline::ExecuteFull(bool copy_to_host) {
     return true;
 }
 
+size_t ProcessingPipeline::GetUsableDeviceMemory() const {
+    if (device_memory_limit_ > 0) {
+        return device_memory_limit_;
+    }
+    const size_t device_memory = gpu_backend_->GetDeviceMemorySize();
+    if (device_memory == 0) {
+        return SIZE_MAX;  // Размер неизвестен - не ограничиваем
+    }
+    // Запас под матрицу Лагранжа, параметры задержек и буферы автотюнера
+    return device_memory / 4 * 3;
+}
+
+bool ProcessingPipeline::PlanChunks(
+    const std::vector<float>& delays,
+    size_t max_chunk_bytes,
+    std::vector<Chunk>* chunks) const {
+    
+    const size_t num_beams = signal_buffer_->GetNumBeams();
+    const size_t num_samples = signal_buffer_->GetNumSamples();
+    const size_t beam_bytes = num_samples * sizeof(SignalBuffer::ComplexType);
+    chunks->clear();
+    
+    // Группы лучей целиком: ореол не нужен
+    if (max_chunk_bytes >= beam_bytes) {
+        const size_t group = std::min(num_beams, max_chunk_bytes / std::max<size_t>(beam_bytes, 1));
+        for (size_t beam = 0; beam < num_beams; beam += group) {
+            Chunk chunk;
+            chunk.beam_begin = beam;
+            chunk.beam_count = std::min(group, num_beams - beam);
+            chunk.output_begin = chunk.input_begin = 0;
+            chunk.output_end = chunk.input_end = num_samples;
+            chunks->push_back(chunk);
+        }
+        return true;
+    }
+    
+    // Окна отсчётов: выход n читает отсчёты [n - D - 2, n - D + 2], D = floor(delay)
+    long long d_min = 0;
+    long long d_max = 0;
+    for (size_t beam = 0; beam < num_beams; ++beam) {
+        const long long d = static_cast<long long>(std::floor(delays[beam]));
+        d_min = beam == 0 ? d : std::min(d_min, d);
+        d_max = beam == 0 ? d : std::max(d_max, d);
+    }
+    const size_t halo_left = static_cast<size_t>(std::max<long long>(0, d_max + 2));
+    const size_t halo_right = static_cast<size_t>(std::max<long long>(0, 2 - d_min));
+    
+    const size_t max_window_input = max_chunk_bytes / sizeof(SignalBuffer::ComplexType);
+    if (max_window_input <= halo_left + halo_right) {
+        std::cerr << "Ошибка: ореол задержки (" << halo_left + halo_right
+                  << " отсчётов) не помещается в память устройства" << std::endl;
+        return false;
+    }
+    
+    // Окна равной длины; окно не короче ореола, поэтому ореол окна не достаёт
+    // до окна на два назад (оно уже записано в signal_buffer при двойной буферизации)
+    const size_t max_window = max_window_input - halo_left - halo_right;
+    const size_t num_windows = (num_samples + max_window - 1) / max_window;
+    if (num_samples / num_windows < halo_left + halo_right + 1) {
+        std::cerr << "Ошибка: задержки лучей слишком велики для окна "
+                  << num_samples / num_windows << " отсчётов" << std::endl;
+        return false;
+    }
+    
+    for (size_t beam = 0; beam < num_beams; ++beam) {
+        for (size_t window = 0; window < num_windows; ++window) {
+            Chunk chunk;
+            chunk.beam_begin = beam;
+            chunk.beam_count = 1;
+            chunk.output_begin = window * num_samples / num_windows;
+            chunk.output_end = (window + 1) * num_samples / num_windows;
+            chunk.input_begin = chunk.output_begin > halo_left ? chunk.output_begin - halo_left : 0;
+            chunk.input_end = std::min(num_samples, chunk.output_end + halo_right);
+            chunks->push_back(chunk);
+        }
+    }
+    return true;
+}
+
+bool ProcessingPipeline::ExecuteFullChunked(const std::vector<float>& delays) {
+    const size_t NUM_SLOTS = 2;
+    
+    std::vector<Chunk> chunks;
+    if (!PlanChunks(delays, GetUsableDeviceMemory() / NUM_SLOTS, &chunks)) {
+        return false;
+    }
+    
+    size_t max_chunk_samples = 0;
+    for (const Chunk& chunk : chunks) {
+        max_chunk_samples = std::max(max_chunk_samples, chunk.beam_count * (chunk.input_end - chunk.input_begin));
+    }
+    const size_t slot_bytes = max_chunk_samples * sizeof(SignalBuffer::ComplexType);
+    
+    // Два буфера на устройстве и staging на хосте: чанк i - в слоте i % 2,
+    // в потоке backend'а slot % GetNumStreams()
+    void* device_slots[NUM_SLOTS] = {nullptr, nullptr};
+    std::vector<SignalBuffer::ComplexType> staging[NUM_SLOTS];
+    long pending[NUM_SLOTS] = {-1, -1};
+    const size_t num_streams = std::max<size_t>(gpu_backend_->GetNumStreams(), 1);
+    
+    bool ok = true;
+    for (size_t slot = 0; slot < NUM_SLOTS && ok; ++slot) {
+        device_slots[slot] = gpu_backend_->AllocateDeviceMemory(slot_bytes);
+        staging[slot].resize(max_chunk_samples);
+        if (device_slots[slot] == nullptr) {
+            std::cerr << "Ошибка: не удалось выделить память для чанка" << std::endl;
+            ok = false;
+        }
+    }
+    
+    // Дождаться чанка слота и записать его выходные отсчёты в signal_buffer
+    auto retire_slot = [&](size_t slot) {
+        if (pending[slot] < 0) {
+            return true;
+        }
+        const Chunk& chunk = chunks[static_cast<size_t>(pending[slot])];
+        pending[slot] = -1;
+        if (!gpu_backend_->Synchronize(slot % num_streams)) {
+            return false;
+        }
+        const size_t input_length = chunk.input_end - chunk.input_begin;
+        const size_t output_length = chunk.output_end - chunk.output_begin;
+        for (size_t beam = 0; beam < chunk.beam_count; ++beam) {
+            SignalBuffer::ComplexType* beam_data = signal_buffer_->GetBeamData(chunk.beam_begin + beam);
+            if (beam_data == nullptr) {
+                return false;
+            }
+            std::memcpy(
+                beam_data + chunk.output_begin,
+                staging[slot].data() + beam * input_length + (chunk.output_begin - chunk.input_begin),
+                output_length * sizeof(SignalBuffer::ComplexType)
+            );
+        }
+        return true;
+    };
+    
+    profiler_->StartTimer("ChunkedExecution");
+    for (size_t index = 0; index < chunks.size() && ok; ++index) {
+        const size_t slot = index % NUM_SLOTS;
+        const size_t stream = slot % num_streams;
+        const Chunk& chunk = chunks[index];
+        const size_t input_length = chunk.input_end - chunk.input_begin;
+        const size_t chunk_bytes = chunk.beam_count * input_length * sizeof(SignalBuffer::ComplexType);
+        
+        // Слот свободен после завершения чанка index - 2; пока ждём его,
+        // устройство выполняет чанк index - 1 из другого слота
+        if (!retire_slot(slot)) {
+            ok = false;
+            break;
+        }
+        
+        for (size_t beam = 0; beam < chunk.beam_count; ++beam) {
+            const SignalBuffer::ComplexType* beam_data = signal_buffer_->GetBeamData(chunk.beam_begin + beam);
+            if (beam_data == nullptr) {
+                ok = false;
+                break;
+            }
+            std::memcpy(
+                staging[slot].data() + beam * input_length,
+                beam_data + chunk.input_begin,
+                input_length * sizeof(SignalBuffer::ComplexType)
+            );
+        }
+        
+        // H2D -> задержка -> D2H в одном потоке (по порядку), без ожидания на хосте.
+        // D2H пишет в тот же staging: в потоке оно выполняется после H2D
+        ok = ok &&
+             gpu_backend_->CopyHostToDeviceAsync(device_slots[slot], staging[slot].data(), chunk_bytes, stream) &&
+             gpu_backend_->ExecuteFractionalDelayAsync(device_slots[slot], delays.data() + chunk.beam_begin,
+                                                       chunk.beam_count, input_length, stream) &&
+             gpu_backend_->CopyDeviceToHostAsync(staging[slot].data(), device_slots[slot], chunk_bytes, stream);
+        if (ok) {
+            pending[slot] = static_cast<long>(index);
+        }
+    }
+    
+    // Оставшиеся чанки; при ошибке - дождаться потоков (staging ещё может
+    // использоваться поставленными в очередь копированиями)
+    for (size_t slot = 0; slot < NUM_SLOTS; ++slot) {
+        if (ok) {
+            ok = retire_slot(slot);
+        } else {
+            gpu_backend_->Synchronize(slot % num_streams);
+        }
+    }
+    profiler_->StopTimer("ChunkedExecution");
+    
+    for (size_t slot = 0; slot < NUM_SLOTS; ++slot) {
+        if (device_slots[slot] != nullptr) {
+            gpu_backend_->FreeDeviceMemory(device_slots[slot]);
+        }
+    }
+    
+    if (ok) {
+        std::cout << "✅ Кадр обработан чанками (" << chunks.size() << "), результат скопирован на хост" << std::endl;
+    } else {
+        std::cerr << "Ошибка: обработка кадра чанками не выполнена" << std::endl;
+    }
+    return ok;
+}
+
+bool ProcessingPipeline::ExecuteBeamforming(
+    const float* delays,
+    const SignalBuffer::ComplexType* weights,
+    size_t num_directions,
+    SignalBuffer* output) {
+    
+    if (!signal_buffer_ || !gpu_backend_ || !profiler_ || !delays || !output || num_directions == 0) {
+        std::cerr << "Ошибка: не все компоненты инициализированы" << std::endl;
+        return false;
+    }
+    
+    const size_t num_elements = signal_buffer_->GetNumBeams();
+    const size_t num_samples = signal_buffer_->GetNumSamples();
+    
+    // 1. Память и H2D сигналов элементов
+    if (!AllocateDeviceMemory()) {
+        return false;
+    }
+    
+    profiler_->StartTimer("H2D_Transfer");
+    if (!CopyHostToDevice()) {
+        profiler_->StopTimer("H2D_Transfer");
+        return false;
+    }
+    profiler_->StopTimer("H2D_Transfer");
+    
+    const size_t output_size = num_directions * num_samples * sizeof(SignalBuffer::ComplexType);
+    void* device_output = gpu_backend_->AllocateDeviceMemory(output_size);
+    if (device_output == nullptr) {
+        std::cerr << "Ошибка: не удалось выделить память для выходных лучей" << std::endl;
+        return false;
+    }
+    
+    // 2. Delay-and-sum
+    profiler_->StartTimer("DelayAndSum");
+    bool ok = gpu_backend_->ExecuteDelayAndSum(
+        device_buffer_, device_output, delays, weights,
+        num_elements, num_directions, num_samples);
+    profiler_->StopTimer("DelayAndSum");
+    
+    // 3. D2H выходных лучей
+    if (ok) {
+        profiler_->StartTimer("D2H_Transfer");
+        std::vector<SignalBuffer::ComplexType> host_buffer(num_directions * num_samples);
+        ok = gpu_backend_->CopyDeviceToHost(host_buffer.data(), device_output, output_size);
+        if (ok) {
+            output->Resize(num_directions, num_samples);
+            for (size_t direction = 0; direction < num_directions; ++direction) {
+                std::memcpy(
+                    output->GetBeamData(direction),
+                    host_buffer.data() + direction * num_samples,
+                    num_samples * sizeof(SignalBuffer::ComplexType)
+                );
+            }
+        }
+        profiler_->StopTimer("D2H_Transfer");
+    } else {
+        std::cerr << "Ошибка: backend не выполнил delay-and-sum" << std::endl;
+    }
+    
+    gpu_backend_->FreeDeviceMemory(device_output);
+    return ok;
+}
+
+bool ProcessingPipeline::ExecuteFiltering(FirMethod method) {
+    if (!signal_buffer_ || !filter_bank_ || !gpu_backend_ || !profiler_) {
+        std::cerr << "Ошибка: не все компоненты инициализированы" << std::endl;
+        return false;
+    }
+    
+    const std::vector<float>& coefficients = filter_bank_->GetCoefficients();
+    if (coefficients.empty()) {
+        std::cerr << "Ошибка: FIR коэффициенты не загружены" << std::endl;
+        return false;
+    }
+    
+    const size_t num_beams = signal_buffer_->GetNumBeams();
+    const size_t num_samples = signal_buffer_->GetNumSamples();
+    const size_t num_taps = coefficients.size();
+    
+    // 1. Память и H2D блока
+    if (!AllocateDeviceMemory()) {
+        return false;
+    }
+    
+    profiler_->StartTimer("H2D_Transfer");
+    if (!CopyHostToDevice()) {
+        profiler_->StopTimer("H2D_Transfer");
+        return false;
+    }
+    profiler_->StopTimer("H2D_Transfer");
+    
+    // История остаётся на устройстве между блоками; новая - нулевая
+    const size_t history_size = num_beams * (num_taps - 1) * sizeof(SignalBuffer::ComplexType);
+    if (history_size != device_fir_history_size_ || num_taps != device_fir_num_taps_) {
+        ResetFilterState();
+        if (history_size > 0) {
+            device_fir_history_ = gpu_backend_->AllocateDeviceMemory(history_size);
+            if (device_fir_history_ == nullptr) {
+                std::cerr << "Ошибка: не удалось выделить память для истории FIR" << std::endl;
+                return false;
+            }
+            std::vector<SignalBuffer::ComplexType> zeros(num_beams * (num_taps - 1));
+            if (!gpu_backend_->CopyHostToDevice(device_fir_history_, zeros.data(), history_size)) {
+                ResetFilterState();
+                return false;
+            }
+        }
+        device_fir_history_size_ = history_size;
+        device_fir_num_taps_ = num_taps;
+    }
+    
+    void* device_output = gpu_backend_->AllocateDeviceMemory(device_buffer_size_);
+    if (device_output == nullptr) {
+        std::cerr << "Ошибка: не удалось выделить память для результата FIR" << std::endl;
+        return false;
+    }
+    
+    // 2. FIR
+    profiler_->StartTimer("FIR");
+    bool ok = gpu_backend_->ExecuteFIR(
+        device_buffer_, device_output, device_fir_history_,
+        coefficients.data(), num_taps, method, num_beams, num_samples);
+    profiler_->StopTimer("FIR");
+    
+    // 3. D2H результата обратно в signal_buffer
+    if (ok) {
+        profiler_->StartTimer("D2H_Transfer");
+        std::vector<SignalBuffer::ComplexType> host_buffer(num_beams * num_samples);
+        ok = gpu_backend_->CopyDeviceToHost(host_buffer.data(), device_output, device_buffer_size_);
+        for (size_t beam = 0; ok && beam < num_beams; ++beam) {
+            SignalBuffer::ComplexType* beam_data = signal_buffer_->GetBeamData(beam);
+            if (beam_data == nullptr) {
+                ok = false;
+                break;
+            }
+            std::memcpy(
+                beam_data,
+                host_buffer.data() + beam * num_samples,
+                num_samples * sizeof(SignalBuffer::ComplexType)
+            );
+        }
+        profiler_->StopTimer("D2H_Transfer");
+    } else {
+        std::cerr << "Ошибка: backend не выполнил FIR фильтрацию" << std::endl;
+    }
+    
+    gpu_backend_->FreeDeviceMemory(device_output);
+    return ok;
+}
+
+void ProcessingPipeline::ResetFilterState() {
+    if (device_fir_history_ != nullptr) {
+        gpu_backend_->FreeDeviceMemory(device_fir_history_);
+        device_fir_history_ = nullptr;
+    }
+    device_fir_history_size_ = 0;
+    device_fir_num_taps_ = 0;
+}
+
+bool ProcessingPipeline::ExecuteResampling(FarrowResampler* resampler, SignalBuffer* output) {
+    if (!signal_buffer_ || !gpu_backend_ || !profiler_ || !resampler || !output) {
+        std::cerr << "Ошибка: не все компоненты инициализированы" << std::endl;
+        return false;
+    }
+    
+    const size_t num_beams = signal_buffer_->GetNumBeams();
+    const size_t num_samples = signal_buffer_->GetNumSamples();
+    const size_t history_size = resampler->GetHistorySize();
+    const std::vector<float> delays = resampler->GetBeamDelays(num_beams);
+    if (delays.size() != num_beams) {
+        std::cerr << "Ошибка: задержек " << delays.size() << ", лучей " << num_beams << std::endl;
+        return false;
+    }
+    
+    // 1. Память и H2D блока
+    if (!AllocateDeviceMemory()) {
+        return false;
+    }
+    
+    profiler_->StartTimer("H2D_Transfer");
+    if (!CopyHostToDevice()) {
+        profiler_->StopTimer("H2D_Transfer");
+        return false;
+    }
+    profiler_->StopTimer("H2D_Transfer");
+    
+    // История на устройстве: новая или в начале потока - нулевая
+    const size_t history_bytes = num_beams * history_size * sizeof(SignalBuffer::ComplexType);
+    if (history_bytes != device_resample_history_size_ || resampler->IsStreamStart()) {
+        if (history_bytes != device_resample_history_size_) {
+            if (device_resample_history_ != nullptr) {
+                gpu_backend_->FreeDeviceMemory(device_resample_history_);
+            }
+            device_resample_history_size_ = 0;
+            device_resample_history_ = gpu_backend_->AllocateDeviceMemory(history_bytes);
+            if (device_resample_history_ == nullptr) {
+                std::cerr << "Ошибка: не удалось выделить память для истории передискретизации" << std::endl;
+                return false;
+            }
+            device_resample_history_size_ = history_bytes;
+        }
+        std::vector<SignalBuffer::ComplexType> zeros(num_beams * history_size);
+        if (!gpu_backend_->CopyHostToDevice(device_resample_history_, zeros.data(), history_bytes)) {
+            return false;
+        }
+    }
+    
+    const ResampleBlock block = resampler->PlanBlock(num_samples);
+    const size_t output_count = num_beams * block.num_output_samples;
+    // Пустой блок (короче шага) только обновляет историю
+    void* device_output = gpu_backend_->AllocateDeviceMemory(
+        std::max<size_t>(output_count, 1) * sizeof(SignalBuffer::ComplexType));
+    if (device_output == nullptr) {
+        std::cerr << "Ошибка: не удалось выделить память для результата передискретизации" << std::endl;
+        return false;
+    }
+    
+    // 2. Передискретизация
+    profiler_->StartTimer("Resample");
+    bool ok = gpu_backend_->ExecuteResample(
+        device_buffer_, device_output, device_resample_history_, delays.data(),
+        history_size, block, resampler->GetStep(), num_beams, num_samples);
+    profiler_->StopTimer("Resample");
+    
+    // 3. D2H результата
+    if (ok) {
+        resampler->Advance(num_samples, block.num_output_samples);
+        
+        profiler_->StartTimer("D2H_Transfer");
+        std::vector<SignalBuffer::ComplexType> host_buffer(output_count);
+        ok = output_count == 0 || gpu_backend_->CopyDeviceToHost(
+            host_buffer.data(), device_output, output_count * sizeof(SignalBuffer::ComplexType));
+        if (ok) {
+            output->Resize(num_beams, block.num_output_samples);
+            for (size_t beam = 0; beam < num_beams && block.num_output_samples > 0; ++beam) {
+                std::memcpy(
+                    output->GetBeamData(beam),
+                    host_buffer.data() + beam * block.num_output_samples,
+                    block.num_output_samples * sizeof(SignalBuffer::ComplexType)
+                );
+            }
+        }
+        profiler_->StopTimer("D2H_Transfer");
+    } else {
+        std::cerr << "Ошибка: backend не выполнил передискретизацию" << std::endl;
+    }
+    
+    gpu_backend_->FreeDeviceMemory(device_output);
+    return ok;
+}
+
+bool ProcessingPipeline::ExecuteDecimation(Decimator* decimator, SignalBuffer* output) {
+    if (!signal_buffer_ || !gpu_backend_ || !profiler_ || !decimator || !output) {
+        std::cerr << "Ошибка: не все компоненты инициализированы" << std::endl;
+        return false;
+    }
+    
+    const size_t num_beams = signal_buffer_->GetNumBeams();
+    const size_t num_samples = signal_buffer_->GetNumSamples();
+    const size_t history_size = decimator->GetHistorySize();
+    
+    // 1. Память и H2D блока
+    if (!AllocateDeviceMemory()) {
+        return false;
+    }
+    
+    profiler_->StartTimer("H2D_Transfer");
+    if (!CopyHostToDevice()) {
+        profiler_->StopTimer("H2D_Transfer");
+        return false;
+    }
+    profiler_->StopTimer("H2D_Transfer");
+    
+    // История на устройстве: новая или в начале потока - нулевая
+    const size_t history_bytes = num_beams * history_size * sizeof(SignalBuffer::ComplexType);
+    if (history_bytes != device_decimate_history_size_ || decimator->IsStreamStart()) {
+        if (history_bytes != device_decimate_history_size_) {
+            if (device_decimate_history_ != nullptr) {
+                gpu_backend_->FreeDeviceMemory(device_decimate_history_);
+                device_decimate_history_ = nullptr;
+            }
+            device_decimate_history_size_ = 0;
+            if (history_bytes > 0) {
+                device_decimate_history_ = gpu_backend_->AllocateDeviceMemory(history_bytes);
+                if (device_decimate_history_ == nullptr) {
+                    std::cerr << "Ошибка: не удалось выделить память для истории прореживания" << std::endl;
+                    return false;
+                }
+            }
+            device_decimate_history_size_ = history_bytes;
+        }
+        if (history_bytes > 0) {
+            std::vector<SignalBuffer::ComplexType> zeros(num_beams * history_size);
+            if (!gpu_backend_->CopyHostToDevice(device_decimate_history_, zeros.data(), history_bytes)) {
+                return false;
+            }
+        }
+    }
+    
+    const DecimateBlock block = decimator->PlanBlock(num_samples);
+    const size_t output_count = num_beams * block.num_output_samples;
+    // Пустой блок (короче коэффициента) только обновляет историю
+    void* device_output = gpu_backend_->AllocateDeviceMemory(
+        std::max<size_t>(output_count, 1) * sizeof(SignalBuffer::ComplexType));
+    if (device_output == nullptr) {
+        std::cerr << "Ошибка: не удалось выделить память для результата прореживания" << std::endl;
+        return false;
+    }
+    
+    // 2. ФНЧ + прореживание
+    profiler_->StartTimer("Decimate");
+    bool ok = gpu_backend_->ExecuteDecimate(
+        device_buffer_, device_output, device_decimate_history_,
+        decimator->GetCoefficients().data(), decimator->GetNumTaps(), decimator->GetFactor(),
+        block.first_position, num_beams, num_samples, block.num_output_samples);
+    profiler_->StopTimer("Decimate");
+    
+    // 3. D2H уже прореженного результата
+    if (ok) {
+        decimator->Advance(num_samples, block.num_output_samples);
+        
+        profiler_->StartTimer("D2H_Transfer");
+        std::vector<SignalBuffer::ComplexType> host_buffer(output_count);
+        ok = output_count == 0 || gpu_backend_->CopyDeviceToHost(
+            host_buffer.data(), device_output, output_count * sizeof(SignalBuffer::ComplexType));
+        if (ok) {
+            output->Resize(num_beams, block.num_output_samples);
+            for (size_t beam = 0; beam < num_beams && block.num_output_samples > 0; ++beam) {
+                std::memcpy(
+                    output->GetBeamData(beam),
+                    host_buffer.data() + beam * block.num_output_samples,
+                    block.num_output_samples * sizeof(SignalBuffer::ComplexType)
+                );
+            }
+        }
+        profiler_->StopTimer("D2H_Transfer");
+    } else {
+        std::cerr << "Ошибка: backend не выполнил прореживание" << std::endl;
+    }
+    
+    gpu_backend_->FreeDeviceMemory(device_output);
+    return ok;
+}
+
 bool ProcessingPipeline::ExecuteStepByStep() {
     // Реализация для пошаговой отладки
     return ExecuteFull();  // Пока используем полный pipeline
@@ -111,6 +678,19 @@ void ProcessingPipeline::FreeDeviceMemory() {
     }
     
     device_buffer_size_ = 0;
+    ResetFilterState();
+    
+    if (device_resample_history_ != nullptr) {
+        gpu_backend_->FreeDeviceMemory(device_resample_history_);
+        device_resample_history_ = nullptr;
+    }
+    device_resample_history_size_ = 0;
+    
+    if (device_decimate_history_ != nullptr) {
+        gpu_backend_->FreeDeviceMemory(device_decimate_history_);
+        device_decimate_history_ = nullptr;
+    }
+    device_decimate_history_size_ = 0;
 }
 
 bool ProcessingPipeline::CopyHostToDevice() {
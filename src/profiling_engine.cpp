@@ -3,6 +3,7 @@
 #include <fstream>
 #include <iomanip>
 #include <algorithm>
+#include <filesystem>
 
 ProfilingEngine::ProfilingEngine()
     : profiling_enabled_(true) {
@@ -86,11 +87,10 @@ void ProfilingEngine::ReportMetrics() const {
 
 bool ProfilingEngine::SaveReportToJson(const std::string& filename) const {
     // Создаём директорию если не существует
-    size_t last_slash = filename.find_last_of("/");
-    if (last_slash != std::string::npos) {
-        std::string dir = filename.substr(0, last_slash);
-        std::string cmd = "mkdir -p " + dir;
-        system(cmd.c_str());
+    std::error_code dir_error;
+    const std::filesystem::path dir = std::filesystem::path(filename).parent_path();
+    if (!dir.empty()) {
+        std::filesystem::create_directories(dir, dir_error);
     }
     
     std::ofstream file(filename);
@@ -139,6 +139,26 @@ const TimingMetric& ProfilingEngine::GetMetric(const std::string& name) const {
     return empty_metric;
 }
 
+void ProfilingEngine::AccumulateMetric(const TimingMetric& metric) {
+    if (metric.call_count == 0) {
+        return;
+    }
+    
+    auto& target = metrics_.metrics[metric.name];
+    if (target.call_count == 0) {
+        target.min_time_ms = metric.min_time_ms;
+        target.max_time_ms = metric.max_time_ms;
+    } else {
+        target.min_time_ms = std::min(target.min_time_ms, metric.min_time_ms);
+        target.max_time_ms = std::max(target.max_time_ms, metric.max_time_ms);
+    }
+    target.name = metric.name;
+    target.time_ms += metric.time_ms;
+    target.call_count += metric.call_count;
+    target.avg_time_ms = target.time_ms / static_cast<double>(target.call_count);
+    metrics_.total_time_ms += metric.time_ms;
+}
+
 void ProfilingEngine::Reset() {
     metrics_.metrics.clear();
     metrics_.total_time_ms = 0.0;
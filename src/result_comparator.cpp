@@ -1,7 +1,73 @@
 #include "result_comparator.h"
+#include "noise_generator.h"
+#include "thread_pool.h"
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <vector>
+
+namespace {
+
+// Поток Philox для выборки точек (отличается от потоков шума - номеров лучей)
+constexpr uint32_t SAMPLING_STREAM = 0x53414D50u;
+
+// Случайное целое из [0, range) по 32-битному слову (range < 2^32)
+inline size_t ScaleWord(uint32_t word, size_t range) {
+    return static_cast<size_t>((static_cast<uint64_t>(word) * range) >> 32);
+}
+
+// P(X <= k) для X ~ Bin(n, p), члены по рекуррентной формуле в логарифмах
+double BinomialCdf(size_t k, size_t n, double p) {
+    const double log_ratio = std::log(p) - std::log1p(-p);
+    double log_term = static_cast<double>(n) * std::log1p(-p);   // j = 0
+    double sum = std::exp(log_term);
+    for (size_t j = 0; j < k; ++j) {
+        log_term += std::log(static_cast<double>(n - j)) - std::log(static_cast<double>(j + 1)) + log_ratio;
+        sum += std::exp(log_term);
+    }
+    return std::min(sum, 1.0);
+}
+
+// Верхняя граница Клоппера-Пирсона доли при k событиях из n
+double ClopperPearsonUpper(size_t k, size_t n, double confidence) {
+    const double alpha = 1.0 - confidence;
+    if (n == 0 || k >= n) {
+        return 1.0;
+    }
+    if (k == 0) {
+        return 1.0 - std::pow(alpha, 1.0 / static_cast<double>(n));
+    }
+    
+    // P(X <= k | p) убывает по p: ищем p, при котором она равна alpha
+    double low = static_cast<double>(k) / static_cast<double>(n);
+    double high = 1.0;
+    for (int iteration = 0; iteration < 64; ++iteration) {
+        const double middle = 0.5 * (low + high);
+        if (BinomialCdf(k, n, middle) > alpha) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return high;
+}
+
+// Квантиль стандартного нормального распределения уровня probability
+double NormalQuantile(double probability) {
+    double low = -40.0;
+    double high = 40.0;
+    for (int iteration = 0; iteration < 100; ++iteration) {
+        const double middle = 0.5 * (low + high);
+        if (0.5 * std::erfc(-middle / std::sqrt(2.0)) < probability) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return 0.5 * (low + high);
+}
+
+} // namespace
 
 bool CompareResults(
     const SignalBuffer* cpu_results,
@@ -34,6 +100,69 @@ bool CompareResults(
         *metrics = ComparisonMetrics();  // Сброс метрик
     }
     
+    // Указатели лучей проверяются до параллельной части
+    for (size_t beam = 0; beam < num_beams; ++beam) {
+        if (!cpu_results->GetBeamData(beam) || !gpu_results->GetBeamData(beam)) {
+            std::cerr << "Ошибка: не удалось получить данные для луча " << beam << std::endl;
+            return false;
+        }
+    }
+    
+    // Частичные метрики по лучам; свёртка в порядке лучей - результат не зависит от числа потоков
+    struct BeamPartial {
+        float max_diff_real = 0.0f;
+        float max_diff_imag = 0.0f;
+        float max_diff_magnitude = 0.0f;
+        float sum_diff_magnitude = 0.0f;
+        float max_relative_error = 0.0f;
+        size_t errors_count = 0;
+    };
+    std::vector<BeamPartial> partials(num_beams);
+    
+    // Луч сравнивается на узле NUMA его памяти (по буферу cpu_results)
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &cpu_results->GetBeamNodes();
+    hint.bytes_per_item = num_samples * 2 * sizeof(SignalBuffer::ComplexType);
+    
+    // Сравнение по точкам
+    ThreadPool::Instance().ParallelFor(num_beams, 1, [&](size_t begin, size_t end) {
+        for (size_t beam = begin; beam < end; ++beam) {
+            const SignalBuffer::ComplexType* cpu_data = cpu_results->GetBeamData(beam);
+            const SignalBuffer::ComplexType* gpu_data = gpu_results->GetBeamData(beam);
+            BeamPartial& partial = partials[beam];
+            
+            for (size_t sample = 0; sample < num_samples; ++sample) {
+                SignalBuffer::ComplexType cpu_val = cpu_data[sample];
+                SignalBuffer::ComplexType gpu_val = gpu_data[sample];
+                
+                // Вычисляем разницу
+                float diff_real = std::abs(cpu_val.real() - gpu_val.real());
+                float diff_imag = std::abs(cpu_val.imag() - gpu_val.imag());
+                
+                // Максимальная разница по компонентам
+                partial.max_diff_real = std::max(partial.max_diff_real, diff_real);
+                partial.max_diff_imag = std::max(partial.max_diff_imag, diff_imag);
+                
+                // Вычисляем разницу по модулю
+                float diff_magnitude = std::abs(cpu_val - gpu_val);
+                partial.max_diff_magnitude = std::max(partial.max_diff_magnitude, diff_magnitude);
+                partial.sum_diff_magnitude += diff_magnitude;
+                
+                // Вычисляем относительную ошибку
+                float cpu_magnitude = std::abs(cpu_val);
+                if (cpu_magnitude > 1e-10f) {  // Избегаем деления на ноль
+                    float relative_error = diff_magnitude / cpu_magnitude;
+                    partial.max_relative_error = std::max(partial.max_relative_error, relative_error);
+                }
+                
+                // Проверяем превышение tolerance
+                if (diff_magnitude > tolerance) {
+                    partial.errors_count++;
+                }
+            }
+        }
+    }, hint);
+    
     float max_diff_real = 0.0f;
     float max_diff_imag = 0.0f;
     float max_diff_magnitude = 0.0f;
@@ -42,45 +171,13 @@ bool CompareResults(
     size_t errors_count = 0;
     size_t total_points = num_beams * num_samples;
     
-    // Сравнение по точкам
-    for (size_t beam = 0; beam < num_beams; ++beam) {
-        const SignalBuffer::ComplexType* cpu_data = cpu_results->GetBeamData(beam);
-        const SignalBuffer::ComplexType* gpu_data = gpu_results->GetBeamData(beam);
-        
-        if (!cpu_data || !gpu_data) {
-            std::cerr << "Ошибка: не удалось получить данные для луча " << beam << std::endl;
-            return false;
-        }
-        
-        for (size_t sample = 0; sample < num_samples; ++sample) {
-            SignalBuffer::ComplexType cpu_val = cpu_data[sample];
-            SignalBuffer::ComplexType gpu_val = gpu_data[sample];
-            
-            // Вычисляем разницу
-            float diff_real = std::abs(cpu_val.real() - gpu_val.real());
-            float diff_imag = std::abs(cpu_val.imag() - gpu_val.imag());
-            
-            // Максимальная разница по компонентам
-            max_diff_real = std::max(max_diff_real, diff_real);
-            max_diff_imag = std::max(max_diff_imag, diff_imag);
-            
-            // Вычисляем разницу по модулю
-            float diff_magnitude = std::abs(cpu_val - gpu_val);
-            max_diff_magnitude = std::max(max_diff_magnitude, diff_magnitude);
-            sum_diff_magnitude += diff_magnitude;
-            
-            // Вычисляем относительную ошибку
-            float cpu_magnitude = std::abs(cpu_val);
-            if (cpu_magnitude > 1e-10f) {  // Избегаем деления на ноль
-                float relative_error = diff_magnitude / cpu_magnitude;
-                max_relative_error = std::max(max_relative_error, relative_error);
-            }
-            
-            // Проверяем превышение tolerance
-            if (diff_magnitude > tolerance) {
-                errors_count++;
-            }
-        }
+    for (const BeamPartial& partial : partials) {
+        max_diff_real = std::max(max_diff_real, partial.max_diff_real);
+        max_diff_imag = std::max(max_diff_imag, partial.max_diff_imag);
+        max_diff_magnitude = std::max(max_diff_magnitude, partial.max_diff_magnitude);
+        sum_diff_magnitude += partial.sum_diff_magnitude;
+        max_relative_error = std::max(max_relative_error, partial.max_relative_error);
+        errors_count += partial.errors_count;
     }
     
     // Вычисляем среднюю разницу по модулю
@@ -103,3 +200,144 @@ bool CompareResults(
     return true;
 }
 
+bool CompareResultsSampled(
+    const SignalBuffer* results,
+    const ReferenceFunction& reference,
+    float tolerance,
+    const SamplingOptions& options,
+    SampledComparisonMetrics* metrics) {
+    
+    if (!results || !reference) {
+        std::cerr << "Ошибка: неверные параметры для CompareResultsSampled" << std::endl;
+        return false;
+    }
+    
+    if (options.num_points == 0 || !(options.confidence > 0.0 && options.confidence < 1.0)) {
+        std::cerr << "Ошибка: пустая выборка или доверительная вероятность вне (0, 1)" << std::endl;
+        return false;
+    }
+    
+    if (!results->IsValid()) {
+        std::cerr << "Ошибка: буфер не валиден" << std::endl;
+        return false;
+    }
+    
+    const size_t num_beams = results->GetNumBeams();
+    const size_t num_samples = results->GetNumSamples();
+    if (num_beams == 0 || num_samples == 0) {
+        std::cerr << "Ошибка: пустой буфер для выборочного сравнения" << std::endl;
+        return false;
+    }
+    
+    for (size_t beam = 0; beam < num_beams; ++beam) {
+        if (!results->GetBeamData(beam)) {
+            std::cerr << "Ошибка: не удалось получить данные для луча " << beam << std::endl;
+            return false;
+        }
+    }
+    
+    // Сетка страт: rows групп лучей × cols отрезков отсчётов, по точке на страту
+    const size_t rows = std::min(num_beams, options.num_points);
+    const size_t cols = std::max<size_t>(1, std::min(num_samples, options.num_points / rows));
+    const size_t num_points = rows * cols;
+    
+    const uint32_t key[2] = {
+        static_cast<uint32_t>(options.seed),
+        static_cast<uint32_t>(options.seed >> 32)
+    };
+    
+    // Частичные метрики по строкам страт; свёртка в порядке строк - результат не зависит от числа потоков
+    struct RowPartial {
+        float max_diff_real = 0.0f;
+        float max_diff_imag = 0.0f;
+        float max_diff_magnitude = 0.0f;
+        double sum_diff_magnitude = 0.0;
+        double sum_squared_diff_magnitude = 0.0;
+        float max_relative_error = 0.0f;
+        size_t errors_count = 0;
+    };
+    std::vector<RowPartial> partials(rows);
+    
+    // Точки выборки разбросаны по всему буферу: NUMA подсказка не нужна
+    ThreadPool::Instance().ParallelFor(rows, 1, [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row) {
+            const size_t beam_begin = row * num_beams / rows;
+            const size_t beam_count = (row + 1) * num_beams / rows - beam_begin;
+            RowPartial& partial = partials[row];
+            
+            for (size_t col = 0; col < cols; ++col) {
+                const size_t sample_begin = col * num_samples / cols;
+                const size_t sample_count = (col + 1) * num_samples / cols - sample_begin;
+                
+                const uint64_t stratum = static_cast<uint64_t>(row) * cols + col;
+                const uint32_t counter[4] = {
+                    static_cast<uint32_t>(stratum),
+                    static_cast<uint32_t>(stratum >> 32),
+                    SAMPLING_STREAM,
+                    0u
+                };
+                uint32_t words[4];
+                Philox4x32(counter, key, words);
+                
+                const size_t beam = beam_begin + ScaleWord(words[0], beam_count);
+                const size_t sample = sample_begin + ScaleWord(words[1], sample_count);
+                
+                const SignalBuffer::ComplexType expected = reference(beam, sample);
+                const SignalBuffer::ComplexType actual = results->GetBeamData(beam)[sample];
+                
+                partial.max_diff_real = std::max(partial.max_diff_real, std::abs(expected.real() - actual.real()));
+                partial.max_diff_imag = std::max(partial.max_diff_imag, std::abs(expected.imag() - actual.imag()));
+                
+                const float diff_magnitude = std::abs(expected - actual);
+                partial.max_diff_magnitude = std::max(partial.max_diff_magnitude, diff_magnitude);
+                partial.sum_diff_magnitude += diff_magnitude;
+                partial.sum_squared_diff_magnitude += static_cast<double>(diff_magnitude) * diff_magnitude;
+                
+                const float expected_magnitude = std::abs(expected);
+                if (expected_magnitude > 1e-10f) {
+                    partial.max_relative_error = std::max(partial.max_relative_error, diff_magnitude / expected_magnitude);
+                }
+                
+                if (diff_magnitude > tolerance) {
+                    partial.errors_count++;
+                }
+            }
+        }
+    });
+    
+    SampledComparisonMetrics local_metrics;
+    double sum_diff_magnitude = 0.0;
+    double sum_squared_diff_magnitude = 0.0;
+    for (const RowPartial& partial : partials) {
+        ComparisonMetrics& m = local_metrics.metrics;
+        m.max_diff_real = std::max(m.max_diff_real, partial.max_diff_real);
+        m.max_diff_imag = std::max(m.max_diff_imag, partial.max_diff_imag);
+        m.max_diff_magnitude = std::max(m.max_diff_magnitude, partial.max_diff_magnitude);
+        m.max_relative_error = std::max(m.max_relative_error, partial.max_relative_error);
+        m.errors_above_tolerance += partial.errors_count;
+        sum_diff_magnitude += partial.sum_diff_magnitude;
+        sum_squared_diff_magnitude += partial.sum_squared_diff_magnitude;
+    }
+    
+    const double n = static_cast<double>(num_points);
+    const double mean = sum_diff_magnitude / n;
+    const double variance = num_points > 1
+        ? std::max(0.0, (sum_squared_diff_magnitude - n * mean * mean) / (n - 1.0)) : 0.0;
+    
+    local_metrics.metrics.avg_diff_magnitude = static_cast<float>(mean);
+    local_metrics.metrics.total_points = num_points;
+    local_metrics.population = num_beams * num_samples;
+    local_metrics.confidence = options.confidence;
+    local_metrics.error_rate = static_cast<double>(local_metrics.metrics.errors_above_tolerance) / n;
+    local_metrics.error_rate_upper = ClopperPearsonUpper(local_metrics.metrics.errors_above_tolerance,
+                                                         num_points, options.confidence);
+    local_metrics.errors_upper = local_metrics.error_rate_upper * static_cast<double>(local_metrics.population);
+    local_metrics.avg_diff_upper = mean + NormalQuantile(options.confidence) * std::sqrt(variance / n);
+    local_metrics.above_max_fraction_upper = ClopperPearsonUpper(0, num_points, options.confidence);
+    
+    if (metrics) {
+        *metrics = local_metrics;
+    }
+    
+    return true;
+}
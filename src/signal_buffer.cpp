@@ -1,16 +1,54 @@
 #include "signal_buffer.h"
+#include "half_float.h"
+#include "thread_pool.h"
 #include <cstdint>
 #include <iostream>
 #include <cstring>
 #include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Отсчётов в задаче упаковки/распаковки (ParallelFor2D)
+constexpr size_t PACK_TILE = 16384;
+
+// Блок от PAGE_ALLOCATOR_MIN_BYTES, страницы которого не на узле node
+// (меньшие блоки из кучи и неизвестный ОС узел ошибкой не считаются)
+bool IsBlockMisplaced(const void* data, size_t bytes, int node) {
+    if (bytes < PAGE_ALLOCATOR_MIN_BYTES) {
+        return false;
+    }
+    const NumaTopology& topology = NumaTopology::Get();
+    const char* begin = static_cast<const char*>(data);
+    for (const char* page : {begin, begin + bytes / 2, begin + bytes - 1}) {
+        const int page_node = topology.NodeOfAddress(page);
+        if (page_node >= 0 && page_node != node) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
 
 
 SignalBuffer::SignalBuffer()
-    : num_beams_(0), num_samples_(0) {
+    : num_beams_(0), num_samples_(0),
+      packed_format_(SampleFormat::FLOAT32), packed_scale_(1.0f),
+      numa_policy_(NumaPolicy::NONE) {
 }
 
 SignalBuffer::SignalBuffer(size_t num_beams, size_t num_samples)
-    : num_beams_(num_beams), num_samples_(num_samples) {
+    : num_beams_(num_beams), num_samples_(num_samples),
+      packed_format_(SampleFormat::FLOAT32), packed_scale_(1.0f),
+      numa_policy_(NumaPolicy::NONE) {
+    Resize(num_beams, num_samples);
+}
+
+SignalBuffer::SignalBuffer(size_t num_beams, size_t num_samples, NumaPolicy numa_policy)
+    : num_beams_(num_beams), num_samples_(num_samples),
+      packed_format_(SampleFormat::FLOAT32), packed_scale_(1.0f),
+      numa_policy_(numa_policy) {
     Resize(num_beams, num_samples);
 }
 
@@ -100,7 +138,7 @@ bool SignalBuffer::SaveToFile(const std::string& filename) const {
 }
 
 SignalBuffer::ComplexType* SignalBuffer::GetBeamData(size_t beam_id) {
-    if (!ValidateBeamIndex(beam_id)) {
+    if (!ValidateBeamIndex(beam_id) || beam_id >= beams_.size()) {
         return nullptr;
     }
 
@@ -108,7 +146,7 @@ SignalBuffer::ComplexType* SignalBuffer::GetBeamData(size_t beam_id) {
 }
 
 const SignalBuffer::ComplexType* SignalBuffer::GetBeamData(size_t beam_id) const {
-    if (!ValidateBeamIndex(beam_id)) {
+    if (!ValidateBeamIndex(beam_id) || beam_id >= beams_.size()) {
         return nullptr;
     }
 
@@ -118,11 +156,91 @@ const SignalBuffer::ComplexType* SignalBuffer::GetBeamData(size_t beam_id) const
 void SignalBuffer::Resize(size_t num_beams, size_t num_samples) {
     num_beams_ = num_beams;
     num_samples_ = num_samples;
+    AllocateBeams();
+    ReleasePacked();
+}
+
+void SignalBuffer::AllocateBeams() {
     beams_.clear();
     beams_.resize(num_beams_);
-    for (auto& beam : beams_) {
-        beam.resize(num_samples_);
+    beam_nodes_ = NumaTopology::Get().AssignBeams(num_beams_, numa_policy_);
+
+    if (beam_nodes_.empty()) {
+        for (auto& beam : beams_) {
+            beam.resize(num_samples_);
+        }
+        return;
+    }
+
+    // First touch: луч выделяет и обнуляет только поток его узла
+    // (node_local - без перехвата чужими узлами и без вызывающего потока)
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &beam_nodes_;
+    hint.node_local = true;
+    ThreadPool::Instance().ParallelFor(num_beams_, 1, [this](size_t begin, size_t end) {
+        for (size_t beam = begin; beam < end; ++beam) {
+            beams_[beam].resize(num_samples_);
+        }
+    }, hint);
+
+    const size_t misplaced = CountMisplacedBeams();
+    if (misplaced > 0) {
+        std::cerr << "Предупреждение: " << misplaced << " из " << num_beams_
+                  << " лучей размещены не на своём узле NUMA (потоки пула не привязаны к ядрам узлов?)"
+                  << std::endl;
+    }
+}
+
+void SignalBuffer::AllocatePacked() {
+    packed_.clear();
+    packed_.resize(num_beams_);
+    // Узлы float лучей сохраняются: упакованный луч ложится рядом с float лучом
+    if (beam_nodes_.size() != num_beams_) {
+        beam_nodes_ = NumaTopology::Get().AssignBeams(num_beams_, numa_policy_);
+    }
+
+    const size_t beam_size = num_samples_ * 2;
+    if (beam_nodes_.empty()) {
+        for (auto& beam : packed_) {
+            beam.resize(beam_size);
+        }
+        return;
+    }
+
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &beam_nodes_;
+    hint.node_local = true;
+    ThreadPool::Instance().ParallelFor(num_beams_, 1, [this, beam_size](size_t begin, size_t end) {
+        for (size_t beam = begin; beam < end; ++beam) {
+            packed_[beam].resize(beam_size);
+        }
+    }, hint);
+
+    const size_t misplaced = CountMisplacedBeams();
+    if (misplaced > 0) {
+        std::cerr << "Предупреждение: " << misplaced << " из " << num_beams_
+                  << " упакованных лучей размещены не на своём узле NUMA (потоки пула не привязаны к ядрам узлов?)"
+                  << std::endl;
+    }
+}
+
+size_t SignalBuffer::CountMisplacedBeams() const {
+    if (beam_nodes_.size() != num_beams_) {
+        return 0;
+    }
+
+    size_t misplaced = 0;
+    for (size_t beam = 0; beam < num_beams_; ++beam) {
+        const int node = beam_nodes_[beam];
+        const bool float_misplaced = beam < beams_.size() &&
+            IsBlockMisplaced(beams_[beam].data(), beams_[beam].size() * sizeof(ComplexType), node);
+        const bool packed_misplaced = beam < packed_.size() &&
+            IsBlockMisplaced(packed_[beam].data(), packed_[beam].size() * sizeof(uint16_t), node);
+        if (float_misplaced || packed_misplaced) {
+            ++misplaced;
+        }
     }
+    return misplaced;
 }
 
 void SignalBuffer::Clear() {
@@ -153,6 +271,181 @@ bool SignalBuffer::IsValid() const {
     return true;
 }
 
+bool SignalBuffer::Pack(SampleFormat format, float full_scale) {
+    if (format == SampleFormat::FLOAT32) {
+        std::cerr << "Ошибка: Pack ожидает INT16_IQ или FP16" << std::endl;
+        return false;
+    }
+    if (!IsValid()) {
+        std::cerr << "Ошибка: буфер не валиден для упаковки" << std::endl;
+        return false;
+    }
+
+    ThreadPool& pool = ThreadPool::Instance();
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &beam_nodes_;
+    hint.bytes_per_item = sizeof(ComplexType);
+
+    float scale = 1.0f;
+    if (format == SampleFormat::INT16_IQ) {
+        if (full_scale <= 0.0f) {
+            // Полная шкала по пиковому значению I/Q: пик по задачам (луч, тайл)
+            const size_t num_tiles = (num_samples_ + PACK_TILE - 1) / PACK_TILE;
+            std::vector<float> tile_peak(num_beams_ * num_tiles, 0.0f);
+            pool.ParallelFor2D(num_beams_, num_samples_, PACK_TILE,
+                [&](size_t beam, size_t begin, size_t end) {
+                    const ComplexType* src = beams_[beam].data();
+                    float peak = 0.0f;
+                    for (size_t sample = begin; sample < end; ++sample) {
+                        peak = std::max(peak, std::max(std::fabs(src[sample].real()), std::fabs(src[sample].imag())));
+                    }
+                    tile_peak[beam * num_tiles + begin / PACK_TILE] = peak;
+                }, hint);
+            for (float peak : tile_peak) {
+                full_scale = std::max(full_scale, peak);
+            }
+            if (full_scale <= 0.0f) {
+                full_scale = 1.0f;
+            }
+        }
+        scale = full_scale / 32767.0f;
+    }
+
+    AllocatePacked();
+    packed_format_ = format;
+    packed_scale_ = scale;
+
+    // Трафик: чтение float + запись упакованного отсчёта
+    hint.bytes_per_item = sizeof(ComplexType) + 2 * sizeof(uint16_t);
+    const float inv_scale = 1.0f / scale;
+    pool.ParallelFor2D(num_beams_, num_samples_, PACK_TILE,
+        [&](size_t beam, size_t begin, size_t end) {
+            const ComplexType* src = beams_[beam].data();
+            uint16_t* dst = packed_[beam].data();
+
+            if (format == SampleFormat::INT16_IQ) {
+                auto quantize = [inv_scale](float value) {
+                    float code = std::nearbyint(value * inv_scale);
+                    code = std::min(32767.0f, std::max(-32767.0f, code));
+                    return static_cast<uint16_t>(static_cast<int16_t>(code));
+                };
+                for (size_t sample = begin; sample < end; ++sample) {
+                    dst[2 * sample] = quantize(src[sample].real());
+                    dst[2 * sample + 1] = quantize(src[sample].imag());
+                }
+            } else {
+                for (size_t sample = begin; sample < end; ++sample) {
+                    dst[2 * sample] = half_float::FromFloat(src[sample].real());
+                    dst[2 * sample + 1] = half_float::FromFloat(src[sample].imag());
+                }
+            }
+        }, hint);
+
+    return true;
+}
+
+bool SignalBuffer::Unpack() {
+    if (packed_.empty()) {
+        std::cerr << "Ошибка: нет упакованных данных для распаковки" << std::endl;
+        return false;
+    }
+
+    if (beams_.size() != num_beams_) {
+        AllocateBeams();
+    }
+
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &beam_nodes_;
+    hint.bytes_per_item = 2 * sizeof(uint16_t) + sizeof(ComplexType);
+
+    ThreadPool::Instance().ParallelFor2D(num_beams_, num_samples_, PACK_TILE,
+        [this](size_t beam, size_t begin, size_t end) {
+            const uint16_t* src = packed_[beam].data();
+            ComplexType* dst = beams_[beam].data();
+
+            if (packed_format_ == SampleFormat::INT16_IQ) {
+                for (size_t sample = begin; sample < end; ++sample) {
+                    dst[sample] = ComplexType(
+                        static_cast<int16_t>(src[2 * sample]) * packed_scale_,
+                        static_cast<int16_t>(src[2 * sample + 1]) * packed_scale_);
+                }
+            } else {
+                for (size_t sample = begin; sample < end; ++sample) {
+                    dst[sample] = ComplexType(
+                        half_float::ToFloat(src[2 * sample]),
+                        half_float::ToFloat(src[2 * sample + 1]));
+                }
+            }
+        }, hint);
+
+    return true;
+}
+
+bool SignalBuffer::LoadPacked(SampleFormat format, const void* data,
+                              size_t num_beams, size_t num_samples, float scale) {
+    if (format == SampleFormat::FLOAT32 || data == nullptr) {
+        std::cerr << "Ошибка: неверные параметры LoadPacked" << std::endl;
+        return false;
+    }
+    if (num_beams == 0 || num_beams > 256 || num_samples < 100 || num_samples > 1300000) {
+        std::cerr << "Ошибка: неверные размеры упакованных данных: "
+            << num_beams << " x " << num_samples << std::endl;
+        return false;
+    }
+    if (format == SampleFormat::INT16_IQ && !(scale > 0.0f)) {
+        std::cerr << "Ошибка: масштаб int16 IQ должен быть положительным" << std::endl;
+        return false;
+    }
+
+    // Float хранилище не выделяем: его создаст Unpack() при необходимости
+    num_beams_ = num_beams;
+    num_samples_ = num_samples;
+    beams_.clear();
+    beams_.shrink_to_fit();
+
+    AllocatePacked();
+
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &beam_nodes_;
+    hint.bytes_per_item = 2 * 2 * sizeof(uint16_t);
+
+    const uint16_t* src = static_cast<const uint16_t*>(data);
+    ThreadPool::Instance().ParallelFor2D(num_beams_, num_samples_, PACK_TILE,
+        [this, src](size_t beam, size_t begin, size_t end) {
+            const uint16_t* beam_src = src + beam * num_samples_ * 2;
+            std::copy(beam_src + 2 * begin, beam_src + 2 * end, packed_[beam].data() + 2 * begin);
+        }, hint);
+    packed_format_ = format;
+    packed_scale_ = format == SampleFormat::INT16_IQ ? scale : 1.0f;
+    return true;
+}
+
+void SignalBuffer::ReleaseFloatData() {
+    beams_.clear();
+    beams_.shrink_to_fit();
+}
+
+void SignalBuffer::ReleasePacked() {
+    packed_.clear();
+    packed_.shrink_to_fit();
+    packed_format_ = SampleFormat::FLOAT32;
+    packed_scale_ = 1.0f;
+}
+
+uint16_t* SignalBuffer::GetPackedBeamData(size_t beam_id) {
+    if (packed_.empty() || !ValidateBeamIndex(beam_id)) {
+        return nullptr;
+    }
+    return packed_[beam_id].data();
+}
+
+const uint16_t* SignalBuffer::GetPackedBeamData(size_t beam_id) const {
+    if (packed_.empty() || !ValidateBeamIndex(beam_id)) {
+        return nullptr;
+    }
+    return packed_[beam_id].data();
+}
+
 bool SignalBuffer::ValidateBeamIndex(size_t beam_id) const {
     if (beam_id >= num_beams_) {
         std::cerr << "Ошибка: неверный индекс луча: " << beam_id
@@ -0,0 +1,433 @@
+#include "thread_pool.h"
+#include "numa_topology.h"
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+// Рабочий поток знает свой пул и свою очередь (для вложенных ParallelFor)
+thread_local const ThreadPool* tls_pool = nullptr;
+thread_local size_t tls_queue_index = 0;
+
+std::mutex g_instance_mutex;
+std::unique_ptr<ThreadPool> g_instance;
+
+size_t DefaultThreadCount() {
+    const char* env = std::getenv("LCH_FARROW_THREADS");
+    if (env != nullptr && env[0] != '\0') {
+        char* end = nullptr;
+        long value = std::strtol(env, &end, 10);
+        if (end != env && *end == '\0' && value > 0) {
+            return static_cast<size_t>(value);
+        }
+        std::cerr << "Предупреждение: неверное значение LCH_FARROW_THREADS=" << env << std::endl;
+    }
+    return std::max<unsigned>(1, std::thread::hardware_concurrency());
+}
+
+void PinThread(std::thread& thread, int cpu) {
+#if defined(__linux__)
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu, &cpuset);
+    if (pthread_setaffinity_np(thread.native_handle(), sizeof(cpuset), &cpuset) != 0) {
+        std::cerr << "Предупреждение: не удалось привязать поток к ядру " << cpu << std::endl;
+    }
+#else
+    (void)thread;
+    (void)cpu;
+#endif
+}
+
+// Узел ядра, на котором сейчас выполняется поток (-1 если неизвестно)
+int CurrentNode() {
+#if defined(__linux__)
+    return NumaTopology::Get().NodeOfCpu(sched_getcpu());
+#else
+    return -1;
+#endif
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t num_threads, const std::vector<int>& cpu_affinity)
+    : pending_(0), next_queue_(0), stop_(false) {
+    if (num_threads == 0) {
+        num_threads = DefaultThreadCount();
+    }
+
+    const size_t num_workers = num_threads - 1;
+    const NumaTopology& topology = NumaTopology::Get();
+
+    queues_.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; ++i) {
+        queues_.emplace_back(new WorkerQueue());
+    }
+
+    // Узлы рабочих потоков известны только при привязке к ядрам
+    worker_nodes_.assign(num_workers, -1);
+    node_workers_.resize(topology.GetNumNodes());
+    if (!cpu_affinity.empty()) {
+        for (size_t i = 0; i < num_workers; ++i) {
+            int node = topology.NodeOfCpu(cpu_affinity[(i + 1) % cpu_affinity.size()]);
+            worker_nodes_[i] = node;
+            if (node >= 0) {
+                node_workers_[node].push_back(i);
+            }
+        }
+    }
+
+    // Перехват: сначала очереди своего узла, затем остальные (по кругу от соседней)
+    steal_order_.resize(num_workers + 1);
+    for (size_t home = 0; home <= num_workers; ++home) {
+        const int home_node = home < num_workers ? worker_nodes_[home] : -1;
+        for (int pass = 0; pass < 2; ++pass) {
+            for (size_t i = 1; i <= num_workers; ++i) {
+                size_t victim = (home + i) % (num_workers + 1);
+                if (victim == home || victim == num_workers) {
+                    continue;
+                }
+                bool same_node = home_node >= 0 && worker_nodes_[victim] == home_node;
+                if ((pass == 0) == same_node) {
+                    steal_order_[home].push_back(victim);
+                }
+            }
+        }
+    }
+
+    node_queues_.resize(topology.GetNumNodes());
+    for (auto& queue : node_queues_) {
+        queue.reset(new NodeQueue());
+    }
+
+    traffic_.resize(topology.GetNumNodes());
+    for (auto& counters : traffic_) {
+        counters.reset(new NodeCounters());
+    }
+
+    workers_.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; ++i) {
+        workers_.emplace_back(&ThreadPool::WorkerLoop, this, i);
+        if (!cpu_affinity.empty()) {
+            PinThread(workers_.back(), cpu_affinity[(i + 1) % cpu_affinity.size()]);
+        }
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::Instance() {
+    std::lock_guard<std::mutex> lock(g_instance_mutex);
+    if (!g_instance) {
+        g_instance.reset(new ThreadPool());
+    }
+    return *g_instance;
+}
+
+void ThreadPool::Configure(size_t num_threads, const std::vector<int>& cpu_affinity) {
+    std::lock_guard<std::mutex> lock(g_instance_mutex);
+    g_instance.reset();
+    g_instance.reset(new ThreadPool(num_threads, cpu_affinity));
+}
+
+void ThreadPool::ParallelFor(size_t count, size_t grain, const RangeFunction& body,
+                             const NumaHint& hint) {
+    if (hint.bytes_per_item == 0) {
+        Run(count, grain, body, hint.item_nodes, nullptr, hint.node_local);
+        return;
+    }
+
+    const size_t bytes_per_item = hint.bytes_per_item;
+    const TrafficFunction traffic = [bytes_per_item](size_t begin, size_t end) {
+        return static_cast<uint64_t>((end - begin) * bytes_per_item);
+    };
+    Run(count, grain, body, hint.item_nodes, &traffic, hint.node_local);
+}
+
+void ThreadPool::ParallelFor2D(size_t rows, size_t cols, size_t tile, const TileFunction& body,
+                               const NumaHint& hint) {
+    if (rows == 0 || cols == 0) {
+        return;
+    }
+    if (tile == 0 || tile > cols) {
+        tile = cols;
+    }
+
+    const size_t tiles_per_row = (cols + tile - 1) / tile;
+    auto tile_end = [cols, tile, tiles_per_row](size_t task) {
+        return std::min(cols, (task % tiles_per_row) * tile + tile);
+    };
+
+    // Узел задачи - узел её строки
+    std::vector<int> task_nodes;
+    if (hint.item_nodes != nullptr && hint.item_nodes->size() >= rows) {
+        task_nodes.resize(rows * tiles_per_row);
+        for (size_t task = 0; task < task_nodes.size(); ++task) {
+            task_nodes[task] = (*hint.item_nodes)[task / tiles_per_row];
+        }
+    }
+
+    const RangeFunction tiles = [&](size_t begin, size_t end) {
+        for (size_t task = begin; task < end; ++task) {
+            const size_t row = task / tiles_per_row;
+            const size_t col_begin = (task % tiles_per_row) * tile;
+            body(row, col_begin, tile_end(task));
+        }
+    };
+
+    const size_t bytes_per_sample = hint.bytes_per_item;
+    const TrafficFunction traffic = [&](size_t begin, size_t end) {
+        uint64_t bytes = 0;
+        for (size_t task = begin; task < end; ++task) {
+            bytes += (tile_end(task) - (task % tiles_per_row) * tile) * bytes_per_sample;
+        }
+        return bytes;
+    };
+
+    Run(rows * tiles_per_row, 1, tiles, task_nodes.empty() ? nullptr : &task_nodes,
+        bytes_per_sample > 0 ? &traffic : nullptr, hint.node_local);
+}
+
+std::vector<ThreadPool::NodeTraffic> ThreadPool::GetNodeTraffic() const {
+    std::vector<NodeTraffic> result(traffic_.size());
+    for (size_t node = 0; node < traffic_.size(); ++node) {
+        result[node].local_bytes = traffic_[node]->local_bytes.load();
+        result[node].remote_bytes = traffic_[node]->remote_bytes.load();
+        result[node].busy_ns = traffic_[node]->busy_ns.load();
+    }
+    return result;
+}
+
+void ThreadPool::ResetNodeTraffic() {
+    for (auto& counters : traffic_) {
+        counters->local_bytes = 0;
+        counters->remote_bytes = 0;
+        counters->busy_ns = 0;
+    }
+}
+
+void ThreadPool::Run(size_t count, size_t grain, const RangeFunction& body,
+                     const std::vector<int>* item_nodes, const TrafficFunction* traffic,
+                     bool node_local) {
+    if (count == 0) {
+        return;
+    }
+
+    if (grain == 0) {
+        grain = std::max<size_t>(1, count / (GetNumThreads() * 4));
+    }
+    const size_t num_chunks = (count + grain - 1) / grain;
+
+    Job job;
+    job.body = &body;
+    job.traffic = traffic;
+    job.remaining.store(num_chunks);
+
+    auto make_task = [&](size_t chunk) {
+        const size_t begin = chunk * grain;
+        const int node = item_nodes != nullptr && begin < item_nodes->size() ? (*item_nodes)[begin] : -1;
+        return Task{&job, begin, std::min(count, begin + grain), node};
+    };
+
+    // Кусок узла с рабочими потоками (node_local) выполняют только они
+    auto node_bound = [&](const Task& task) {
+        return node_local && task.node >= 0 && task.node < static_cast<int>(node_workers_.size()) &&
+               !node_workers_[task.node].empty();
+    };
+    bool any_node_bound = false;
+    if (node_local && item_nodes != nullptr) {
+        for (size_t chunk = 0; chunk < num_chunks && !any_node_bound; ++chunk) {
+            any_node_bound = node_bound(make_task(chunk));
+        }
+    }
+
+    if ((num_chunks == 1 && !any_node_bound) || workers_.empty()) {
+        for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+            RunTask(make_task(chunk));
+        }
+    } else {
+        // Вложенный вызов из рабочего потока без узлов - всё в свою очередь, остальные украдут;
+        // внешний поток - куски по очередям рабочих по кругу; с узлами - в очереди узла памяти
+        const size_t home = CurrentQueueIndex();
+        size_t round_robin = next_queue_.fetch_add(1);
+        size_t shared_chunks = 0;
+        for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+            Task task = make_task(chunk);
+            if (node_bound(task)) {
+                NodeQueue& target = *node_queues_[task.node];
+                std::lock_guard<std::mutex> lock(target.mutex);
+                target.tasks.push_back(task);
+                target.pending.fetch_add(1);
+                continue;
+            }
+            WorkerQueue& target = *queues_[SelectQueue(task.node, home, &round_robin)];
+            std::lock_guard<std::mutex> lock(target.mutex);
+            target.tasks.push_back(task);
+            ++shared_chunks;
+        }
+
+        pending_.fetch_add(shared_chunks);
+        {
+            // Пустая критическая секция: поток между проверкой условия и wait не пропустит сигнал
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+        }
+        wake_.notify_all();
+
+        // Вызывающий поток помогает, пока не выполнены все куски его задания
+        while (job.remaining.load(std::memory_order_acquire) > 0) {
+            if (!TryRunTask(home)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+size_t ThreadPool::SelectQueue(int node, size_t home, size_t* round_robin) {
+    if (node >= 0 && node < static_cast<int>(node_workers_.size()) && !node_workers_[node].empty()) {
+        const std::vector<size_t>& workers = node_workers_[node];
+        if (home < queues_.size() && worker_nodes_[home] == node) {
+            return home;
+        }
+        return workers[(*round_robin)++ % workers.size()];
+    }
+    if (home < queues_.size()) {
+        return home;
+    }
+    return (*round_robin)++ % queues_.size();
+}
+
+void ThreadPool::WorkerLoop(size_t index) {
+    tls_pool = this;
+    tls_queue_index = index;
+
+    while (true) {
+        if (TryRunTask(index)) {
+            continue;
+        }
+
+        const int node = worker_nodes_[index];
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wake_.wait(lock, [this, node]() {
+            return stop_ || pending_.load() > 0 || (node >= 0 && node_queues_[node]->pending.load() > 0);
+        });
+        if (stop_ && pending_.load() == 0) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::TryRunTask(size_t home) {
+    const int home_node = home < queues_.size() ? worker_nodes_[home] : -1;
+    NodeQueue* node_queue = home_node >= 0 ? node_queues_[home_node].get() : nullptr;
+
+    // Задачи очереди узла берутся раньше своих: их не выполнит никто, кроме потоков узла
+    if (node_queue != nullptr && node_queue->pending.load() > 0) {
+        Task task;
+        bool found = false;
+        {
+            std::lock_guard<std::mutex> lock(node_queue->mutex);
+            if (!node_queue->tasks.empty()) {
+                task = node_queue->tasks.front();
+                node_queue->tasks.pop_front();
+                node_queue->pending.fetch_sub(1);
+                found = true;
+            }
+        }
+        if (found) {
+            RunTask(task);
+            return true;
+        }
+    }
+
+    if (pending_.load() == 0) {
+        return false;
+    }
+
+    Task task;
+    bool found = false;
+
+    if (home < queues_.size()) {
+        std::lock_guard<std::mutex> lock(queues_[home]->mutex);
+        if (!queues_[home]->tasks.empty()) {
+            task = queues_[home]->tasks.back();
+            queues_[home]->tasks.pop_back();
+            found = true;
+        }
+    }
+
+    // Перехват: сначала очереди своего узла
+    for (size_t i = 0; !found && i < steal_order_[home].size(); ++i) {
+        WorkerQueue& victim = *queues_[steal_order_[home][i]];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    pending_.fetch_sub(1);
+    RunTask(task);
+    return true;
+}
+
+void ThreadPool::RunTask(const Task& task) {
+    Job* job = task.job;
+    try {
+        if (job->traffic == nullptr) {
+            (*job->body)(task.begin, task.end);
+        } else {
+            auto start = std::chrono::steady_clock::now();
+            (*job->body)(task.begin, task.end);
+            auto elapsed = std::chrono::steady_clock::now() - start;
+
+            // Учёт на узле исполнителя: локально, если память куска на том же узле
+            const int node = CurrentNode();
+            if (node >= 0 && node < static_cast<int>(traffic_.size())) {
+                NodeCounters& counters = *traffic_[node];
+                const uint64_t bytes = (*job->traffic)(task.begin, task.end);
+                if (task.node < 0 || task.node == node) {
+                    counters.local_bytes += bytes;
+                } else {
+                    counters.remote_bytes += bytes;
+                }
+                counters.busy_ns += static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            }
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(job->error_mutex);
+        if (!job->error) {
+            job->error = std::current_exception();
+        }
+    }
+    // После уменьшения счётчика задание может быть уничтожено владельцем
+    job->remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+size_t ThreadPool::CurrentQueueIndex() const {
+    return tls_pool == this ? tls_queue_index : queues_.size();
+}
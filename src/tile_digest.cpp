@@ -0,0 +1,183 @@
+#include "tile_digest.h"
+#include "thread_pool.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Множитель номера отсчёта (2^64 / золотое сечение) и константы финализатора SplitMix64
+constexpr uint64_t SAMPLE_MULTIPLIER = 0x9E3779B97F4A7C15ull;
+constexpr uint64_t MIX_M1 = 0xBF58476D1CE4E5B9ull;
+constexpr uint64_t MIX_M2 = 0x94D049BB133111EBull;
+
+// Компонента -> int32 сетки quantum (как convert_int_sat_rte в kernel_digest.cl)
+inline uint32_t Quantize(float value, float inv_quantum) {
+    const float scaled = value * inv_quantum;
+    if (std::isnan(scaled)) {
+        return 0x80000000u;   // INT32_MIN - только для NaN
+    }
+    if (scaled >= 2147483648.0f) {
+        return 0x7FFFFFFFu;
+    }
+    if (scaled <= -2147483648.0f) {
+        return static_cast<uint32_t>(-2147483647);
+    }
+    return static_cast<uint32_t>(static_cast<int32_t>(std::nearbyint(scaled)));
+}
+
+inline uint64_t MixSample(const SignalBuffer::ComplexType& value, uint64_t sample, float inv_quantum) {
+    uint64_t z = (static_cast<uint64_t>(Quantize(value.real(), inv_quantum)) << 32) |
+                 Quantize(value.imag(), inv_quantum);
+    z ^= sample * SAMPLE_MULTIPLIER;
+    z = (z ^ (z >> 30)) * MIX_M1;
+    z = (z ^ (z >> 27)) * MIX_M2;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
+size_t DigestTilesPerBeam(size_t num_samples, size_t tile_samples) {
+    return tile_samples == 0 ? 0 : (num_samples + tile_samples - 1) / tile_samples;
+}
+
+uint64_t TileDigest(const SignalBuffer::ComplexType* data, size_t first_sample, size_t count, float inv_quantum) {
+    uint64_t digest = 0;
+    for (size_t i = 0; i < count; ++i) {
+        digest += MixSample(data[i], first_sample + i, inv_quantum);
+    }
+    return digest;
+}
+
+bool ComputeTileDigestsCPU(
+    const SignalBuffer* buffer,
+    float quantum,
+    size_t tile_samples,
+    std::vector<uint64_t>* digests) {
+
+    if (buffer == nullptr || digests == nullptr || !(quantum > 0.0f) || tile_samples == 0) {
+        std::cerr << "Ошибка: неверные параметры для ComputeTileDigestsCPU" << std::endl;
+        return false;
+    }
+
+    const size_t num_beams = buffer->GetNumBeams();
+    const size_t num_samples = buffer->GetNumSamples();
+    for (size_t beam = 0; beam < num_beams; ++beam) {
+        if (!buffer->GetBeamData(beam)) {
+            std::cerr << "Ошибка: не удалось получить данные для луча " << beam << std::endl;
+            return false;
+        }
+    }
+
+    const size_t tiles_per_beam = DigestTilesPerBeam(num_samples, tile_samples);
+    const float inv_quantum = 1.0f / quantum;
+    digests->assign(num_beams * tiles_per_beam, 0);
+
+    ThreadPool::NumaHint hint;
+    hint.item_nodes = &buffer->GetBeamNodes();
+    hint.bytes_per_item = sizeof(SignalBuffer::ComplexType);
+
+    // Задача пула - ровно один тайл дайджеста
+    ThreadPool::Instance().ParallelFor2D(num_beams, num_samples, tile_samples,
+        [&](size_t beam, size_t begin, size_t end) {
+            (*digests)[beam * tiles_per_beam + begin / tile_samples] =
+                TileDigest(buffer->GetBeamData(beam) + begin, begin, end - begin, inv_quantum);
+        }, hint);
+
+    return true;
+}
+
+std::vector<size_t> FindMismatchedTiles(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b) {
+    std::vector<size_t> mismatched;
+    const size_t count = std::min(a.size(), b.size());
+    for (size_t tile = 0; tile < count; ++tile) {
+        if (a[tile] != b[tile]) {
+            mismatched.push_back(tile);
+        }
+    }
+    return mismatched;
+}
+
+bool CompareWithDeviceByDigests(
+    IGPUBackend* backend,
+    const void* device_buffer,
+    const SignalBuffer& reference,
+    float quantum,
+    float tolerance,
+    size_t tile_samples,
+    DigestComparisonReport* report) {
+
+    if (backend == nullptr || device_buffer == nullptr || report == nullptr) {
+        std::cerr << "Ошибка: неверные параметры для CompareWithDeviceByDigests" << std::endl;
+        return false;
+    }
+
+    const size_t num_beams = reference.GetNumBeams();
+    const size_t num_samples = reference.GetNumSamples();
+    const size_t tiles_per_beam = DigestTilesPerBeam(num_samples, tile_samples);
+
+    std::vector<uint64_t> host_digests;
+    if (!ComputeTileDigestsCPU(&reference, quantum, tile_samples, &host_digests)) {
+        return false;
+    }
+
+    std::vector<uint64_t> device_digests(host_digests.size());
+    if (!backend->ExecuteTileDigests(device_buffer, quantum, tile_samples, num_beams, num_samples,
+                                     device_digests.data())) {
+        std::cerr << "Ошибка: дайджесты тайлов не посчитаны на устройстве "
+                  << backend->GetDeviceName() << std::endl;
+        return false;
+    }
+
+    *report = DigestComparisonReport();
+    report->num_tiles = host_digests.size();
+    report->tile_samples = tile_samples;
+    report->mismatched_tiles = FindMismatchedTiles(host_digests, device_digests);
+    report->fetched_bytes = device_digests.size() * sizeof(uint64_t);
+
+    // Подробное сравнение только несовпавших тайлов (формулы как в CompareResults)
+    ComparisonMetrics& metrics = report->metrics;
+    double sum_diff_magnitude = 0.0;
+    std::vector<SignalBuffer::ComplexType> staging(tile_samples);
+
+    for (size_t tile : report->mismatched_tiles) {
+        const size_t beam = tile / tiles_per_beam;
+        const size_t begin = (tile % tiles_per_beam) * tile_samples;
+        const size_t count = std::min(tile_samples, num_samples - begin);
+        const size_t offset_bytes = (beam * num_samples + begin) * sizeof(SignalBuffer::ComplexType);
+        const size_t tile_bytes = count * sizeof(SignalBuffer::ComplexType);
+
+        if (!backend->CopyDeviceToHostRegion(staging.data(), device_buffer, offset_bytes, tile_bytes)) {
+            std::cerr << "Ошибка: не удалось прочитать тайл " << tile << " с устройства" << std::endl;
+            return false;
+        }
+        report->fetched_bytes += tile_bytes;
+
+        const SignalBuffer::ComplexType* expected = reference.GetBeamData(beam) + begin;
+        for (size_t i = 0; i < count; ++i) {
+            const SignalBuffer::ComplexType diff = expected[i] - staging[i];
+            metrics.max_diff_real = std::max(metrics.max_diff_real, std::abs(diff.real()));
+            metrics.max_diff_imag = std::max(metrics.max_diff_imag, std::abs(diff.imag()));
+
+            const float diff_magnitude = std::abs(diff);
+            metrics.max_diff_magnitude = std::max(metrics.max_diff_magnitude, diff_magnitude);
+            sum_diff_magnitude += diff_magnitude;
+
+            const float expected_magnitude = std::abs(expected[i]);
+            if (expected_magnitude > 1e-10f) {
+                metrics.max_relative_error = std::max(metrics.max_relative_error, diff_magnitude / expected_magnitude);
+            }
+
+            if (diff_magnitude > tolerance) {
+                metrics.errors_above_tolerance++;
+            }
+        }
+        metrics.total_points += count;
+    }
+
+    if (metrics.total_points > 0) {
+        metrics.avg_diff_magnitude = static_cast<float>(sum_diff_magnitude / metrics.total_points);
+    }
+
+    return true;
+}
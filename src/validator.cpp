@@ -1,5 +1,6 @@
 #include "validator.h"
 #include "result_comparator.h"
+#include "fractional_delay_cpu.h"
 #include <iostream>
 
 namespace radar {
@@ -18,4 +19,37 @@ bool Validator::Validate(const SignalBuffer& cpu, const SignalBuffer& gpu, float
     return true;
 }
 
+bool Validator::ValidateSampled(const SignalBuffer& input, const SignalBuffer& gpu, const float* delays,
+                                const float* lagrange_data, float tolerance, const SamplingOptions& options,
+                                SampledComparisonMetrics* out_metrics) {
+    if (input.GetNumBeams() != gpu.GetNumBeams() || input.GetNumSamples() != gpu.GetNumSamples()) {
+        std::cerr << "Validator: buffer sizes mismatch\n";
+        return false;
+    }
+
+    if (!delays || !lagrange_data) {
+        std::cerr << "Validator: delays or Lagrange matrix missing\n";
+        return false;
+    }
+
+    for (size_t beam = 0; beam < input.GetNumBeams(); ++beam) {
+        if (!input.GetBeamData(beam)) {
+            std::cerr << "Validator: input beam " << beam << " is not allocated\n";
+            return false;
+        }
+    }
+
+    const size_t num_samples = input.GetNumSamples();
+    auto reference = [&](size_t beam, size_t sample) {
+        return FractionalDelaySampleCPU(input.GetBeamData(beam), num_samples, delays[beam], lagrange_data, sample);
+    };
+
+    if (!CompareResultsSampled(&gpu, reference, tolerance, options, out_metrics)) {
+        std::cerr << "Validator: CompareResultsSampled returned false\n";
+        return false;
+    }
+
+    return true;
+}
+
 } // namespace radar
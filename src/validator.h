@@ -12,6 +12,12 @@ public:
 
     // Выполнить сравнение CPU vs GPU, вернуть true если успешно
     bool Validate(const SignalBuffer& cpu, const SignalBuffer& gpu, float tolerance, ComparisonMetrics* out_metrics);
+
+    // Выборочная проверка дробной задержки без полного прогона CPU: эталон
+    // (FractionalDelaySampleCPU) считается только в точках выборки по входу
+    bool ValidateSampled(const SignalBuffer& input, const SignalBuffer& gpu, const float* delays,
+                         const float* lagrange_data, float tolerance, const SamplingOptions& options,
+                         SampledComparisonMetrics* out_metrics);
 };
 
 } // namespace radar
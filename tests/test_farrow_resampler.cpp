@@ -0,0 +1,97 @@
+#include "farrow_resampler.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/**
+ * @brief Поблочная передискретизация должна побитово совпадать с одним блоком
+ *
+ * Поток режется на блоки случайной длины (от единиц отсчётов до тысяч),
+ * каждый блок проходит через FarrowResampler::Process; склеенный выход
+ * сравнивается с обработкой всего потока одним вызовом. Позиция выходного
+ * отсчёта считается от его номера в потоке, поэтому расхождение хотя бы
+ * в одном бите - регрессия.
+ */
+int main() {
+    using ComplexType = SignalBuffer::ComplexType;
+
+    const size_t num_beams = 3;
+    const size_t num_samples = 50000;
+    const std::vector<float> delays = {0.0f, 3.25f, -1.7f};
+    const double ratios[] = {1.0 / 3.3, 0.37, 2.5, 1.0, 0.999999, 1.0 / 7.0};
+    const size_t max_block_sizes[] = {7, 5000};
+
+    std::mt19937 rng(1);
+    std::normal_distribution<float> normal;
+    SignalBuffer stream(num_beams, num_samples);
+    for (size_t beam = 0; beam < num_beams; ++beam) {
+        ComplexType* data = stream.GetBeamData(beam);
+        for (size_t sample = 0; sample < num_samples; ++sample) {
+            data[sample] = ComplexType(normal(rng), normal(rng));
+        }
+    }
+
+    int failures = 0;
+    for (double ratio : ratios) {
+        FarrowResampler one_shot;
+        SignalBuffer reference;
+        if (!one_shot.Configure(1.0, ratio, delays) || !one_shot.Process(stream, &reference)) {
+            std::cerr << "Ошибка: обработка одним блоком, ratio " << ratio << std::endl;
+            return 1;
+        }
+
+        for (size_t max_block : max_block_sizes) {
+            FarrowResampler blocked;
+            blocked.Configure(1.0, ratio, delays);
+
+            size_t input_offset = 0;
+            size_t output_offset = 0;
+            size_t mismatches = 0;
+            bool overflow = false;
+            while (input_offset < num_samples) {
+                const size_t block_size = std::min<size_t>(num_samples - input_offset, 1 + rng() % max_block);
+                SignalBuffer block(num_beams, block_size);
+                for (size_t beam = 0; beam < num_beams; ++beam) {
+                    const ComplexType* src = stream.GetBeamData(beam) + input_offset;
+                    std::copy(src, src + block_size, block.GetBeamData(beam));
+                }
+
+                SignalBuffer output;
+                if (!blocked.Process(block, &output)) {
+                    std::cerr << "Ошибка: обработка блока, ratio " << ratio << std::endl;
+                    return 1;
+                }
+
+                const size_t block_outputs = output.GetNumSamples();
+                if (output_offset + block_outputs > reference.GetNumSamples()) {
+                    overflow = true;
+                    break;
+                }
+                for (size_t beam = 0; beam < num_beams && block_outputs > 0; ++beam) {
+                    const ComplexType* got = output.GetBeamData(beam);
+                    const ComplexType* expected = reference.GetBeamData(beam) + output_offset;
+                    for (size_t j = 0; j < block_outputs; ++j) {
+                        if (std::memcmp(&got[j], &expected[j], sizeof(ComplexType)) != 0) {
+                            ++mismatches;
+                        }
+                    }
+                }
+
+                input_offset += block_size;
+                output_offset += block_outputs;
+            }
+
+            const bool ok = !overflow && mismatches == 0 && output_offset == reference.GetNumSamples();
+            std::cout << (ok ? "OK  " : "FAIL") << " ratio " << ratio << ", блоки до " << max_block
+                      << ": выходных " << output_offset << " / " << reference.GetNumSamples()
+                      << ", расхождений " << mismatches << std::endl;
+            if (!ok) {
+                ++failures;
+            }
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+#include "noise_generator.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using ComplexType = SignalBuffer::ComplexType;
+
+const size_t NUM_BEAMS = 5;
+const size_t NUM_SAMPLES = 100003;
+const uint64_t SEED = 0x5EEDull;
+const float SIGMA = 0.25f;
+
+void FillSignal(SignalBuffer* buffer) {
+    for (size_t beam = 0; beam < NUM_BEAMS; ++beam) {
+        ComplexType* data = buffer->GetBeamData(beam);
+        for (size_t sample = 0; sample < NUM_SAMPLES; ++sample) {
+            data[sample] = ComplexType(0.001f * static_cast<float>(sample % 997), static_cast<float>(beam));
+        }
+    }
+}
+
+size_t CountMismatches(const SignalBuffer& got, const SignalBuffer& expected) {
+    size_t mismatches = 0;
+    for (size_t beam = 0; beam < NUM_BEAMS; ++beam) {
+        const ComplexType* a = got.GetBeamData(beam);
+        const ComplexType* b = expected.GetBeamData(beam);
+        for (size_t sample = 0; sample < NUM_SAMPLES; ++sample) {
+            if (std::memcmp(&a[sample], &b[sample], sizeof(ComplexType)) != 0) {
+                ++mismatches;
+            }
+        }
+    }
+    return mismatches;
+}
+
+} // namespace
+
+/**
+ * @brief Шум AddGaussianNoiseCPU побитово не зависит от числа потоков
+ *
+ * Один и тот же сигнал зашумляется пулом из 1 потока и пулами из N потоков;
+ * результаты сравниваются побитово между собой и с последовательной
+ * генерацией каждого луча целиком (GenerateGaussianNoiseCPU с first_sample = 0).
+ * Длина луча не кратна тайлу, чтобы проверить и хвост.
+ */
+int main() {
+    // Эталон: каждый луч одним последовательным вызовом
+    SignalBuffer reference(NUM_BEAMS, NUM_SAMPLES);
+    FillSignal(&reference);
+    for (size_t beam = 0; beam < NUM_BEAMS; ++beam) {
+        GenerateGaussianNoiseCPU(SEED, beam, 0, SIGMA, reference.GetBeamData(beam), NUM_SAMPLES, true);
+    }
+
+    std::vector<size_t> thread_counts = {1, 2, 3, 8};
+    thread_counts.push_back(std::max<size_t>(1, std::thread::hardware_concurrency()));
+
+    int failures = 0;
+    for (size_t num_threads : thread_counts) {
+        ThreadPool::Configure(num_threads);
+
+        SignalBuffer buffer(NUM_BEAMS, NUM_SAMPLES);
+        FillSignal(&buffer);
+        if (!AddGaussianNoiseCPU(&buffer, SEED, SIGMA)) {
+            std::cerr << "Ошибка: AddGaussianNoiseCPU, потоков " << num_threads << std::endl;
+            return 1;
+        }
+
+        const size_t mismatches = CountMismatches(buffer, reference);
+        std::cout << (mismatches == 0 ? "OK  " : "FAIL") << " потоков " << num_threads
+                  << ": расхождений " << mismatches << " / " << NUM_BEAMS * NUM_SAMPLES << std::endl;
+        if (mismatches != 0) {
+            ++failures;
+        }
+    }
+
+    ThreadPool::Configure(0);
+    return failures == 0 ? 0 : 1;
+}